@@ -179,6 +179,8 @@ gst_fd_mem_share (GstMemory * gmem, gssize offset, gssize size)
       GST_MINI_OBJECT_FLAG_LOCK_READONLY, mem->mem.allocator, parent,
       mem->mem.maxsize, mem->mem.align, mem->mem.offset + offset, size);
 
+  /* the mapping of the parent is used, report how it was made */
+  sub->flags = ((GstFdMemory *) parent)->flags;
   sub->fd = mem->fd;
   g_mutex_init (&sub->lock);
 
@@ -314,3 +316,24 @@ gst_fd_memory_get_fd (GstMemory * mem)
 
   return ((GstFdMemory *) mem)->fd;
 }
+
+/**
+ * gst_fd_memory_get_flags:
+ * @mem: #GstMemory
+ *
+ * Get the #GstFdMemoryFlags @mem was allocated with. Call
+ * gst_is_fd_memory() to check if @mem is backed by an fd.
+ *
+ * Returns: the flags of @mem
+ *
+ * Since: 1.8
+ */
+GstFdMemoryFlags
+gst_fd_memory_get_flags (GstMemory * mem)
+{
+  g_return_val_if_fail (mem != NULL, GST_FD_MEMORY_FLAG_NONE);
+  g_return_val_if_fail (GST_IS_FD_ALLOCATOR (mem->allocator),
+      GST_FD_MEMORY_FLAG_NONE);
+
+  return ((GstFdMemory *) mem)->flags;
+}
@@ -54,9 +54,25 @@ ensure_debug_category (void)
 
 #define INT_MATRIX_FACTOR_EXPONENT 10
 
+/* number of frames the block based kernels process at once */
+#define MIX_BLOCK_FRAMES 64
+
 typedef void (*MixFunc) (GstAudioChannelMix * mix, const gpointer src,
     gpointer dst, gint samples);
 
+/* classification of the matrix, used to select a specialised kernel */
+typedef enum
+{
+  /* each output is a copy of at most one input or silence */
+  MIX_MATRIX_PERMUTATION,
+  /* each output is at most one input, scaled */
+  MIX_MATRIX_DIAGONAL,
+  /* less than half of the coefficients are non-zero */
+  MIX_MATRIX_SPARSE,
+  /* everything else */
+  MIX_MATRIX_DENSE
+} MixMatrixType;
+
 struct _GstAudioChannelMix
 {
   GstAudioChannelMixFlags flags;
@@ -76,8 +92,22 @@ struct _GstAudioChannelMix
    * this is matrix * (2^10) as integers */
   gint **matrix_int;
 
+  MixMatrixType type;
+
+  /* PERMUTATION and DIAGONAL: the input of each output, or -1 for silence */
+  gint map[64];
+  /* SPARSE and DENSE: the number of terms summed for each output */
+  gint n_terms[64];
+  /* the input channel and coefficient of each term, out_channels rows of
+   * in_channels of which the first n_terms are used. DENSE matrices use
+   * all inputs, the other types only the non-zero coefficients */
+  gint *term_in;
+  gdouble *coef;
+  gint *coef_int;
+
   MixFunc func;
 
+  /* MIX_BLOCK_FRAMES frames of out_channels accumulators */
   gpointer tmp;
 };
 
@@ -103,6 +133,10 @@ gst_audio_channel_mix_free (GstAudioChannelMix * mix)
   g_free (mix->matrix_int);
   mix->matrix_int = NULL;
 
+  g_free (mix->term_in);
+  g_free (mix->coef);
+  g_free (mix->coef_int);
+
   g_free (mix->tmp);
   mix->tmp = NULL;
 
@@ -664,12 +698,92 @@ gst_audio_channel_mix_setup_matrix_int (GstAudioChannelMix * mix)
   }
 }
 
+static const gchar *
+mix_matrix_type_name (MixMatrixType type)
+{
+  switch (type) {
+    case MIX_MATRIX_PERMUTATION:
+      return "permutation";
+    case MIX_MATRIX_DIAGONAL:
+      return "diagonal";
+    case MIX_MATRIX_SPARSE:
+      return "sparse";
+    default:
+      return "dense";
+  }
+}
+
+/* classify the matrix and lay out the coefficients per output channel so
+ * that the kernels can walk them linearly */
+static void
+gst_audio_channel_mix_analyse_matrix (GstAudioChannelMix * mix)
+{
+  gint in, out, n_nonzero = 0;
+  gint inchannels = mix->in_channels, outchannels = mix->out_channels;
+  gboolean single = TRUE, unity = TRUE;
+
+  mix->term_in = g_new (gint, inchannels * outchannels);
+  mix->coef = g_new (gdouble, inchannels * outchannels);
+  mix->coef_int = g_new (gint, inchannels * outchannels);
+
+  for (out = 0; out < outchannels; out++) {
+    gint n = 0;
+
+    mix->map[out] = -1;
+    for (in = 0; in < inchannels; in++) {
+      if (mix->matrix[in][out] == 0.0)
+        continue;
+
+      if (n == 0)
+        mix->map[out] = in;
+      mix->term_in[out * inchannels + n] = in;
+      n++;
+
+      if (mix->matrix[in][out] != 1.0 ||
+          mix->matrix_int[in][out] != (1 << INT_MATRIX_FACTOR_EXPONENT))
+        unity = FALSE;
+    }
+    mix->n_terms[out] = n;
+    n_nonzero += n;
+    if (n > 1)
+      single = FALSE;
+  }
+
+  if (single && unity)
+    mix->type = MIX_MATRIX_PERMUTATION;
+  else if (single)
+    mix->type = MIX_MATRIX_DIAGONAL;
+  else if (n_nonzero * 2 < inchannels * outchannels)
+    mix->type = MIX_MATRIX_SPARSE;
+  else
+    mix->type = MIX_MATRIX_DENSE;
+
+  for (out = 0; out < outchannels; out++) {
+    gint *term_in = mix->term_in + out * inchannels;
+
+    /* not worth skipping the few zeros, keep the inner loops regular */
+    if (mix->type == MIX_MATRIX_DENSE) {
+      for (in = 0; in < inchannels; in++)
+        term_in[in] = in;
+      mix->n_terms[out] = inchannels;
+    }
+    for (in = 0; in < mix->n_terms[out]; in++) {
+      mix->coef[out * inchannels + in] = mix->matrix[term_in[in]][out];
+      mix->coef_int[out * inchannels + in] =
+          mix->matrix_int[term_in[in]][out];
+    }
+  }
+
+  GST_DEBUG ("%d -> %d matrix is %s with %d non-zero coefficients",
+      inchannels, outchannels, mix_matrix_type_name (mix->type), n_nonzero);
+}
+
 static void
 gst_audio_channel_mix_setup_matrix (GstAudioChannelMix * mix)
 {
   gint i, j;
 
-  mix->tmp = (gpointer) g_new (gdouble, mix->out_channels);
+  mix->tmp = (gpointer) g_new (gdouble, mix->out_channels * MIX_BLOCK_FRAMES);
 
   /* allocate */
   mix->matrix = g_new0 (gfloat *, mix->in_channels);
@@ -684,6 +798,8 @@ gst_audio_channel_mix_setup_matrix (GstAudioChannelMix * mix)
 
   gst_audio_channel_mix_setup_matrix_int (mix);
 
+  gst_audio_channel_mix_analyse_matrix (mix);
+
 #ifndef GST_DISABLE_GST_DEBUG
   /* debug */
   {
@@ -710,17 +826,42 @@ gst_audio_channel_mix_setup_matrix (GstAudioChannelMix * mix)
 #endif
 }
 
-/* IMPORTANT: out_data == in_data is possible, make sure to not overwrite data
- * you might need later on! */
+/* The kernels work on blocks of MIX_BLOCK_FRAMES frames. Each output channel
+ * of a block is first accumulated into its own contiguous row of mix->tmp so
+ * that the inner loops run over frames and can be vectorized by the compiler,
+ * then the rows are interleaved into the output.
+ *
+ * IMPORTANT: out_data == in_data is possible, make sure to not overwrite data
+ * you might need later on! A block is completely read before it is written
+ * and when there are more output than input channels the blocks are
+ * processed from the end, so the output never overwrites unread input. */
+#define MAKE_INTERLEAVE_FUNC(type,acctype)                              \
+static inline void                                                      \
+interleave_##type (const acctype * acc, type * out_data,                \
+    gint outchannels, gint len)                                         \
+{                                                                       \
+  gint out, k;                                                          \
+                                                                        \
+  for (out = 0; out < outchannels; out++) {                             \
+    const acctype *a = acc + out * MIX_BLOCK_FRAMES;                    \
+    type *o = out_data + out;                                           \
+                                                                        \
+    for (k = 0; k < len; k++)                                           \
+      o[k * outchannels] = a[k];                                        \
+  }                                                                     \
+}
+
+MAKE_INTERLEAVE_FUNC (gint32, gint64);
+MAKE_INTERLEAVE_FUNC (gdouble, gdouble);
+
+/* sum of the terms of each output, used for SPARSE and DENSE matrices */
 static void
 gst_audio_channel_mix_mix_int (GstAudioChannelMix * mix,
     const gint32 * in_data, gint32 * out_data, gint samples)
 {
-  gint in, out, n;
-  gint64 res;
+  gint b, n_blocks, inchannels, outchannels;
   gboolean backwards;
-  gint inchannels, outchannels;
-  gint32 *tmp = (gint32 *) mix->tmp;
+  gint64 *acc = (gint64 *) mix->tmp;
 
   g_return_if_fail (mix->tmp != NULL);
 
@@ -728,40 +869,145 @@ gst_audio_channel_mix_mix_int (GstAudioChannelMix * mix,
   outchannels = mix->out_channels;
   backwards = outchannels > inchannels;
 
-  /* FIXME: use orc here? */
-  for (n = (backwards ? samples - 1 : 0); n < samples && n >= 0;
-      backwards ? n-- : n++) {
+  n_blocks = (samples + MIX_BLOCK_FRAMES - 1) / MIX_BLOCK_FRAMES;
+  for (b = 0; b < n_blocks; b++) {
+    gint start = (backwards ? n_blocks - 1 - b : b) * MIX_BLOCK_FRAMES;
+    gint len = MIN (MIX_BLOCK_FRAMES, samples - start);
+    const gint32 *in = in_data + start * inchannels;
+    gint out, t, k;
+
     for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0;
-      for (in = 0; in < inchannels; in++) {
-        res += in_data[n * inchannels + in] * (gint64) mix->matrix_int[in][out];
+      const gint *term_in = mix->term_in + out * inchannels;
+      const gint *coef = mix->coef_int + out * inchannels;
+      gint64 *a = acc + out * MIX_BLOCK_FRAMES;
+
+      for (k = 0; k < len; k++)
+        a[k] = 0;
+
+      for (t = 0; t < mix->n_terms[out]; t++) {
+        const gint32 *s = in + term_in[t];
+        gint64 c = coef[t];
+
+        for (k = 0; k < len; k++)
+          a[k] += s[k * inchannels] * c;
       }
 
-      /* remove factor from int matrix */
-      res = res >> INT_MATRIX_FACTOR_EXPONENT;
+      /* remove factor from int matrix and clip */
+      for (k = 0; k < len; k++)
+        a[k] = CLAMP (a[k] >> INT_MATRIX_FACTOR_EXPONENT, G_MININT32,
+            G_MAXINT32);
+    }
+    interleave_gint32 (acc, out_data + start * outchannels, outchannels, len);
+  }
+}
 
-      /* clip (shouldn't we use doubles instead as intermediate format?) */
-      if (res < G_MININT32)
-        res = G_MININT32;
-      else if (res > G_MAXINT32)
-        res = G_MAXINT32;
-      tmp[out] = res;
+/* each output is one input or silence, used for PERMUTATION and DIAGONAL
+ * matrices */
+static void
+gst_audio_channel_mix_mix_int_single (GstAudioChannelMix * mix,
+    const gint32 * in_data, gint32 * out_data, gint samples)
+{
+  gint b, n_blocks, inchannels, outchannels;
+  gboolean backwards, unity;
+  gint64 *acc = (gint64 *) mix->tmp;
+
+  g_return_if_fail (mix->tmp != NULL);
+
+  inchannels = mix->in_channels;
+  outchannels = mix->out_channels;
+  backwards = outchannels > inchannels;
+  unity = mix->type == MIX_MATRIX_PERMUTATION;
+
+  n_blocks = (samples + MIX_BLOCK_FRAMES - 1) / MIX_BLOCK_FRAMES;
+  for (b = 0; b < n_blocks; b++) {
+    gint start = (backwards ? n_blocks - 1 - b : b) * MIX_BLOCK_FRAMES;
+    gint len = MIN (MIX_BLOCK_FRAMES, samples - start);
+    const gint32 *in = in_data + start * inchannels;
+    gint out, k;
+
+    for (out = 0; out < outchannels; out++) {
+      gint64 *a = acc + out * MIX_BLOCK_FRAMES;
+      const gint32 *s;
+      gint64 c;
+
+      if (mix->map[out] < 0) {
+        for (k = 0; k < len; k++)
+          a[k] = 0;
+        continue;
+      }
+
+      s = in + mix->map[out];
+      if (unity) {
+        for (k = 0; k < len; k++)
+          a[k] = s[k * inchannels];
+        continue;
+      }
+
+      c = mix->coef_int[out * inchannels];
+      for (k = 0; k < len; k++)
+        a[k] = CLAMP ((s[k * inchannels] * c) >> INT_MATRIX_FACTOR_EXPONENT,
+            G_MININT32, G_MAXINT32);
     }
-    memcpy (&out_data[n * outchannels], mix->tmp,
-        sizeof (gint32) * outchannels);
+    interleave_gint32 (acc, out_data + start * outchannels, outchannels, len);
   }
 }
 
+/* sum of the terms of each output, used for SPARSE and DENSE matrices */
 static void
 gst_audio_channel_mix_mix_double (GstAudioChannelMix * mix,
     const gdouble * in_data, gdouble * out_data, gint samples)
 {
-  gint in, out, n;
-  gdouble res;
+  gint b, n_blocks, inchannels, outchannels;
+  gboolean backwards;
+  gdouble *acc = (gdouble *) mix->tmp;
+
+  g_return_if_fail (mix->tmp != NULL);
+
+  inchannels = mix->in_channels;
+  outchannels = mix->out_channels;
+  backwards = outchannels > inchannels;
+
+  n_blocks = (samples + MIX_BLOCK_FRAMES - 1) / MIX_BLOCK_FRAMES;
+  for (b = 0; b < n_blocks; b++) {
+    gint start = (backwards ? n_blocks - 1 - b : b) * MIX_BLOCK_FRAMES;
+    gint len = MIN (MIX_BLOCK_FRAMES, samples - start);
+    const gdouble *in = in_data + start * inchannels;
+    gint out, t, k;
+
+    for (out = 0; out < outchannels; out++) {
+      const gint *term_in = mix->term_in + out * inchannels;
+      const gdouble *coef = mix->coef + out * inchannels;
+      gdouble *a = acc + out * MIX_BLOCK_FRAMES;
+
+      for (k = 0; k < len; k++)
+        a[k] = 0.0;
+
+      for (t = 0; t < mix->n_terms[out]; t++) {
+        const gdouble *s = in + term_in[t];
+        gdouble c = coef[t];
+
+        for (k = 0; k < len; k++)
+          a[k] += s[k * inchannels] * c;
+      }
+
+      /* clip */
+      for (k = 0; k < len; k++)
+        a[k] = CLAMP (a[k], -1.0, 1.0);
+    }
+    interleave_gdouble (acc, out_data + start * outchannels, outchannels,
+        len);
+  }
+}
+
+/* each output is one input or silence, used for PERMUTATION and DIAGONAL
+ * matrices */
+static void
+gst_audio_channel_mix_mix_double_single (GstAudioChannelMix * mix,
+    const gdouble * in_data, gdouble * out_data, gint samples)
+{
+  gint b, n_blocks, inchannels, outchannels;
   gboolean backwards;
-  gint inchannels, outchannels;
-  gdouble *tmp = (gdouble *) mix->tmp;
+  gdouble *acc = (gdouble *) mix->tmp;
 
   g_return_if_fail (mix->tmp != NULL);
 
@@ -769,25 +1015,32 @@ gst_audio_channel_mix_mix_double (GstAudioChannelMix * mix,
   outchannels = mix->out_channels;
   backwards = outchannels > inchannels;
 
-  /* FIXME: use orc here? */
-  for (n = (backwards ? samples - 1 : 0); n < samples && n >= 0;
-      backwards ? n-- : n++) {
+  n_blocks = (samples + MIX_BLOCK_FRAMES - 1) / MIX_BLOCK_FRAMES;
+  for (b = 0; b < n_blocks; b++) {
+    gint start = (backwards ? n_blocks - 1 - b : b) * MIX_BLOCK_FRAMES;
+    gint len = MIN (MIX_BLOCK_FRAMES, samples - start);
+    const gdouble *in = in_data + start * inchannels;
+    gint out, k;
+
     for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0.0;
-      for (in = 0; in < inchannels; in++) {
-        res += in_data[n * inchannels + in] * mix->matrix[in][out];
+      gdouble *a = acc + out * MIX_BLOCK_FRAMES;
+      const gdouble *s;
+      gdouble c;
+
+      if (mix->map[out] < 0) {
+        for (k = 0; k < len; k++)
+          a[k] = 0.0;
+        continue;
       }
 
-      /* clip (shouldn't we use doubles instead as intermediate format?) */
-      if (res < -1.0)
-        res = -1.0;
-      else if (res > 1.0)
-        res = 1.0;
-      tmp[out] = res;
+      /* a permutation also clips, like the generic function */
+      s = in + mix->map[out];
+      c = mix->coef[out * inchannels];
+      for (k = 0; k < len; k++)
+        a[k] = CLAMP (s[k * inchannels] * c, -1.0, 1.0);
     }
-    memcpy (&out_data[n * outchannels], mix->tmp,
-        sizeof (gdouble) * outchannels);
+    interleave_gdouble (acc, out_data + start * outchannels, outchannels,
+        len);
   }
 }
 
@@ -834,10 +1087,18 @@ gst_audio_channel_mix_new (GstAudioChannelMixFlags flags,
 
   switch (mix->format) {
     case GST_AUDIO_FORMAT_S32:
-      mix->func = (MixFunc) gst_audio_channel_mix_mix_int;
+      if (mix->type == MIX_MATRIX_PERMUTATION
+          || mix->type == MIX_MATRIX_DIAGONAL)
+        mix->func = (MixFunc) gst_audio_channel_mix_mix_int_single;
+      else
+        mix->func = (MixFunc) gst_audio_channel_mix_mix_int;
       break;
     case GST_AUDIO_FORMAT_F64:
-      mix->func = (MixFunc) gst_audio_channel_mix_mix_double;
+      if (mix->type == MIX_MATRIX_PERMUTATION
+          || mix->type == MIX_MATRIX_DIAGONAL)
+        mix->func = (MixFunc) gst_audio_channel_mix_mix_double_single;
+      else
+        mix->func = (MixFunc) gst_audio_channel_mix_mix_double;
       break;
     default:
       g_assert_not_reached ();
@@ -120,6 +120,11 @@ struct _GstAudioConverter
   GstAudioChannelMix *mix;
   AudioChain *mix_chain;
 
+  /* resample */
+  GstAudioResampler *resampler;
+  AudioChain *resample_chain;
+  gsize in_frames;
+
   /* convert out */
   AudioConvertFunc convert_out;
   AudioChain *convert_out_chain;
@@ -386,6 +391,27 @@ do_mix (AudioChain * chain, gsize samples, gpointer user_data)
   return TRUE;
 }
 
+static gboolean
+do_resample (AudioChain * chain, gsize samples, gpointer user_data)
+{
+  GstAudioConverter *convert = user_data;
+  gpointer *in, *out;
+  gsize in_frames;
+
+  in_frames = convert->in_frames;
+  in = audio_chain_get_samples (chain->prev, in_frames);
+  out = audio_chain_alloc_samples (chain, samples);
+  GST_LOG ("resample %p %p,%" G_GSIZE_FORMAT " %" G_GSIZE_FORMAT, in, out,
+      in_frames, samples);
+
+  gst_audio_resampler_resample (convert->resampler, in, in_frames, out,
+      samples);
+
+  chain->samples = out;
+
+  return TRUE;
+}
+
 static gboolean
 do_convert_out (AudioChain * chain, gsize samples, gpointer user_data)
 {
@@ -508,6 +534,35 @@ chain_mix (GstAudioConverter * convert, AudioChain * prev)
   return prev;
 }
 
+static AudioChain *
+chain_resample (GstAudioConverter * convert, AudioChain * prev)
+{
+  GstAudioInfo *in = &convert->in;
+  GstAudioInfo *out = &convert->out;
+  GstAudioResamplerFlags flags = 0;
+
+  if (in->rate == out->rate)
+    return prev;
+
+  if (convert->current_layout == GST_AUDIO_LAYOUT_NON_INTERLEAVED)
+    flags |= GST_AUDIO_RESAMPLER_FLAG_NON_INTERLEAVED;
+
+  GST_INFO ("resample format %s, channels %d, rate %d -> %d",
+      gst_audio_format_to_string (convert->current_format),
+      convert->current_channels, in->rate, out->rate);
+
+  convert->resampler =
+      gst_audio_resampler_new (flags, convert->current_format,
+      convert->current_channels, in->rate, out->rate, convert->config);
+
+  prev = convert->resample_chain = audio_chain_new (prev, convert);
+  prev->allow_ip = FALSE;
+  prev->pass_alloc = FALSE;
+  audio_chain_set_make_func (prev, do_resample, convert, NULL);
+
+  return prev;
+}
+
 static AudioChain *
 chain_convert_out (GstAudioConverter * convert, AudioChain * prev)
 {
@@ -686,7 +741,6 @@ gst_audio_converter_new (GstAudioInfo * in, GstAudioInfo * out,
 
   g_return_val_if_fail (in != NULL, FALSE);
   g_return_val_if_fail (out != NULL, FALSE);
-  g_return_val_if_fail (in->rate == out->rate, FALSE);
   g_return_val_if_fail (in->layout == GST_AUDIO_LAYOUT_INTERLEAVED, FALSE);
   g_return_val_if_fail (in->layout == out->layout, FALSE);
 
@@ -711,8 +765,15 @@ gst_audio_converter_new (GstAudioInfo * in, GstAudioInfo * out,
   prev = chain_unpack (convert);
   /* step 2, optional convert from S32 to F64 for channel mix */
   prev = chain_convert_in (convert, prev);
-  /* step 3, channel mix */
-  prev = chain_mix (convert, prev);
+  /* step 3, channel mix and resample, resample on the side with the least
+   * channels */
+  if (in->channels < out->channels) {
+    prev = chain_resample (convert, prev);
+    prev = chain_mix (convert, prev);
+  } else {
+    prev = chain_mix (convert, prev);
+    prev = chain_resample (convert, prev);
+  }
   /* step 4, optional convert for quantize */
   prev = chain_convert_out (convert, prev);
   /* step 5, optional quantize */
@@ -721,7 +782,8 @@ gst_audio_converter_new (GstAudioInfo * in, GstAudioInfo * out,
   convert->pack_chain = chain_pack (convert, prev);
 
   /* optimize */
-  if (out->finfo->format == in->finfo->format && convert->mix_passthrough) {
+  if (out->finfo->format == in->finfo->format && convert->mix_passthrough &&
+      convert->resampler == NULL) {
     GST_INFO ("same formats and passthrough mixing -> passthrough");
     convert->passthrough = TRUE;
   }
@@ -756,6 +818,8 @@ gst_audio_converter_free (GstAudioConverter * convert)
     audio_chain_free (convert->convert_in_chain);
   if (convert->mix_chain)
     audio_chain_free (convert->mix_chain);
+  if (convert->resample_chain)
+    audio_chain_free (convert->resample_chain);
   if (convert->convert_out_chain)
     audio_chain_free (convert->convert_out_chain);
   if (convert->quant_chain)
@@ -765,6 +829,8 @@ gst_audio_converter_free (GstAudioConverter * convert)
     gst_audio_quantize_free (convert->quant);
   if (convert->mix)
     gst_audio_channel_mix_free (convert->mix);
+  if (convert->resampler)
+    gst_audio_resampler_free (convert->resampler);
   gst_audio_info_init (&convert->in);
   gst_audio_info_init (&convert->out);
 
@@ -787,6 +853,11 @@ gsize
 gst_audio_converter_get_out_frames (GstAudioConverter * convert,
     gsize in_frames)
 {
+  g_return_val_if_fail (convert != NULL, 0);
+
+  if (convert->resampler)
+    return gst_audio_resampler_get_out_frames (convert->resampler, in_frames);
+
   return in_frames;
 }
 
@@ -804,6 +875,11 @@ gsize
 gst_audio_converter_get_in_frames (GstAudioConverter * convert,
     gsize out_frames)
 {
+  g_return_val_if_fail (convert != NULL, 0);
+
+  if (convert->resampler)
+    return gst_audio_resampler_get_in_frames (convert->resampler, out_frames);
+
   return out_frames;
 }
 
@@ -820,6 +896,11 @@ gst_audio_converter_get_in_frames (GstAudioConverter * convert,
 gsize
 gst_audio_converter_get_max_latency (GstAudioConverter * convert)
 {
+  g_return_val_if_fail (convert != NULL, 0);
+
+  if (convert->resampler)
+    return gst_audio_resampler_get_max_latency (convert->resampler);
+
   return 0;
 }
 
@@ -847,6 +928,10 @@ gst_audio_converter_get_max_latency (GstAudioConverter * convert)
  * can be less than @in_samples. The actual number of samples produced is
  * returned in @out_produced and can be less than @out_samples.
  *
+ * When the rates of @convert differ, the samples that are consumed but not
+ * yet produced are kept in @convert, use gst_audio_converter_get_out_frames()
+ * to find out how many output samples @in_samples will produce.
+ *
  * Returns: %TRUE is the conversion could be performed.
  */
 gboolean
@@ -865,9 +950,21 @@ gst_audio_converter_samples (GstAudioConverter * convert,
   g_return_val_if_fail (in_consumed != NULL, FALSE);
   g_return_val_if_fail (out_produced != NULL, FALSE);
 
-  in_samples = MIN (in_samples, out_samples);
+  if (convert->resampler) {
+    gsize frames;
+
+    frames = gst_audio_resampler_get_out_frames (convert->resampler,
+        in_samples);
+    if (frames > out_samples)
+      in_samples = gst_audio_resampler_get_in_frames (convert->resampler,
+          out_samples);
+    else
+      out_samples = frames;
+  } else {
+    in_samples = out_samples = MIN (in_samples, out_samples);
+  }
 
-  if (in_samples == 0) {
+  if (in_samples == 0 && out_samples == 0) {
     *in_consumed = 0;
     *out_produced = 0;
     return TRUE;
@@ -886,19 +983,20 @@ gst_audio_converter_samples (GstAudioConverter * convert,
   convert->flags = flags;
   convert->in_data = in;
   convert->out_data = out;
+  convert->in_frames = in_samples;
 
   /* get samples to pack */
-  tmp = audio_chain_get_samples (chain, in_samples);
+  tmp = audio_chain_get_samples (chain, out_samples);
 
   if (!convert->out_default) {
-    GST_LOG ("pack %p, %p %" G_GSIZE_FORMAT, tmp, out, in_samples);
+    GST_LOG ("pack %p, %p %" G_GSIZE_FORMAT, tmp, out, out_samples);
     /* and pack if needed */
     for (i = 0; i < chain->blocks; i++)
       convert->out.finfo->pack_func (convert->out.finfo, 0, tmp[i], out[i],
-          in_samples * chain->inc);
+          out_samples * chain->inc);
   }
 
-  *out_produced = in_samples;
+  *out_produced = out_samples;
   *in_consumed = in_samples;
 
   return TRUE;
@@ -32,10 +32,14 @@
 
 #include "gstaudiopack.h"
 #include "audio-quantize.h"
+#include "gstaudioutilsprivate.h"
 
 typedef void (*QuantizeFunc) (GstAudioQuantize * quant, const gpointer src,
     gpointer dst, gint count);
 
+/* number of interleaved generators producing random numbers in parallel */
+#define RANDOM_LANES 8
+
 struct _GstAudioQuantize
 {
   GstAudioDitherMethod dither;
@@ -49,6 +53,17 @@ struct _GstAudioQuantize
   guint shift;
   guint32 mask, bias;
 
+  /* random number generator, RANDOM_LANES generators that each advance
+   * RANDOM_LANES steps of the same sequence at once */
+  guint32 random_state[RANDOM_LANES];
+  guint32 random_mul, random_add;
+  /* generated random numbers that were not used yet */
+  guint32 random_left[RANDOM_LANES];
+  guint n_random_left;
+  /* buffer with random numbers for the dither */
+  guint random_size;
+  guint32 *random_buf;
+
   /* last random number generated per channel for hifreq TPDF dither */
   gpointer last_random;
   /* contains the past quantization errors, error[channels][count] */
@@ -89,27 +104,111 @@ gst_audio_quantize_quantize_int_none_none (GstAudioQuantize * quant,
       samples * quant->stride);
 }
 
-/* This is the base function, implementing a linear congruential generator
- * and returning a pseudo random number between 0 and 2^32 - 1.
+/* The random numbers come from a linear congruential generator returning
+ * pseudo random numbers between 0 and 2^32 - 1. To generate many numbers at
+ * once, RANDOM_LANES copies of the generator each produce every
+ * RANDOM_LANES-th number of the sequence, which the compiler can vectorize.
+ *
+ * Each quantizer gets its own seed so that the dither of two streams, or of
+ * two channels quantized separately, is not correlated. The unit tests
+ * reseed with _gst_audio_quantize_set_seed() to get a reproducible dither.
  */
-static inline guint32
-gst_fast_random_uint32 (void)
+#define RANDOM_MUL 1103515245
+#define RANDOM_ADD 12345
+#define RANDOM_SEED 0xdeadbeef
+
+static guint32
+get_random_seed (void)
+{
+  static gint seed_counter = 0;
+  guint32 count;
+
+  /* spread consecutive instances over the sequence */
+  count = g_atomic_int_add (&seed_counter, 1);
+  return RANDOM_SEED ^ (count * 0x9e3779b9);
+}
+
+static void
+setup_random (GstAudioQuantize * quant, guint32 seed)
+{
+  guint32 state = seed, mul = 1, add = 0;
+  gint i;
+
+  for (i = 0; i < RANDOM_LANES; i++) {
+    state = state * RANDOM_MUL + RANDOM_ADD;
+    quant->random_state[i] = state;
+    /* combine the steps to jump RANDOM_LANES ahead at once */
+    mul = mul * RANDOM_MUL;
+    add = add * RANDOM_MUL + RANDOM_ADD;
+  }
+  quant->random_mul = mul;
+  quant->random_add = add;
+  quant->n_random_left = 0;
+}
+
+/* test hook: restarts the random number generator of @quant from @seed so
+ * that the dither can be checked against the generator */
+void
+_gst_audio_quantize_set_seed (GstAudioQuantize * quant, guint32 seed)
 {
-  static guint32 state = 0xdeadbeef;
-  return (state = state * 1103515245 + 12345);
+  g_return_if_fail (quant != NULL);
+
+  setup_random (quant, seed);
 }
 
-static inline gint32
-gst_fast_random_int32 (void)
+static inline void
+generate_random (GstAudioQuantize * quant, guint32 * r)
 {
-  return (gint32) gst_fast_random_uint32 ();
+  guint32 *state = quant->random_state;
+  guint32 mul = quant->random_mul, add = quant->random_add;
+  gint i;
+
+  for (i = 0; i < RANDOM_LANES; i++) {
+    r[i] = state[i];
+    state[i] = state[i] * mul + add;
+  }
+}
+
+/* fill @r with the next @n random numbers of the sequence */
+static void
+fill_random (GstAudioQuantize * quant, guint32 * r, gint n)
+{
+  gint i = 0, left;
+
+  /* first the numbers left over from the previous call */
+  left = MIN (n, quant->n_random_left);
+  if (left > 0) {
+    memcpy (r, quant->random_left + RANDOM_LANES - quant->n_random_left,
+        left * sizeof (guint32));
+    quant->n_random_left -= left;
+    i = left;
+  }
+  for (; i + RANDOM_LANES <= n; i += RANDOM_LANES)
+    generate_random (quant, r + i);
+
+  if (i < n) {
+    generate_random (quant, quant->random_left);
+    left = n - i;
+    memcpy (r + i, quant->random_left, left * sizeof (guint32));
+    quant->n_random_left = RANDOM_LANES - left;
+  }
+}
+
+static guint32 *
+setup_random_buf (GstAudioQuantize * quant, gint len)
+{
+  if (quant->random_size < len) {
+    quant->random_size = len;
+    quant->random_buf = g_realloc (quant->random_buf, len * sizeof (guint32));
+  }
+  return quant->random_buf;
 }
 
 /* Assuming dither == 2^n,
- * returns one of 2^(n+1) possible random values:
+ * returns one of 2^(n+1) possible random values for random number r:
  * -dither <= retval < dither */
-#define RANDOM_INT_DITHER(dither)                                       \
-  (- dither + (gst_fast_random_int32 () & ((dither << 1) - 1)))
+#define RANDOM_INT_DITHER(r,dither)                                     \
+  (- dither + ((gint32) (r) & ((dither << 1) - 1)))
 
 static void
 setup_dither_buf (GstAudioQuantize * quant, gint samples)
@@ -118,7 +217,7 @@ setup_dither_buf (GstAudioQuantize * quant, gint samples)
   gint stride = quant->stride;
   gint i, len = samples * stride;
   guint shift = quant->shift;
-  guint32 bias;
+  guint32 bias, *r;
   gint32 dither, *d;
 
   if (quant->dither_size < len) {
@@ -139,27 +238,39 @@ setup_dither_buf (GstAudioQuantize * quant, gint samples)
       break;
 
     case GST_AUDIO_DITHER_RPDF:
+      /* bias + RANDOM_INT_DITHER (r[i], dither) */
       dither = 1 << (shift);
-      for (i = 0; i < len; i++)
-        d[i] = bias + RANDOM_INT_DITHER (dither);
+      r = setup_random_buf (quant, len);
+      fill_random (quant, r, len);
+      audio_orc_rpdf_dither (d, r, (dither << 1) - 1, bias - dither, len);
       break;
 
     case GST_AUDIO_DITHER_TPDF:
+      /* bias + RANDOM_INT_DITHER (r[i], dither) +
+       *     RANDOM_INT_DITHER (r[len + i], dither) */
       dither = 1 << (shift - 1);
-      for (i = 0; i < len; i++)
-        d[i] = bias + RANDOM_INT_DITHER (dither) + RANDOM_INT_DITHER (dither);
+      r = setup_random_buf (quant, 2 * len);
+      fill_random (quant, r, 2 * len);
+      audio_orc_tpdf_dither (d, r, r + len, (dither << 1) - 1,
+          bias - 2 * dither, len);
       break;
 
     case GST_AUDIO_DITHER_TPDF_HF:
     {
-      gint32 tmp, *last_random = quant->last_random;
+      gint32 *t, *last_random = quant->last_random;
 
+      /* the previous random value of each channel followed by the new
+       * ones, as dither values */
       dither = 1 << (shift - 1);
-      for (i = 0; i < len; i++) {
-        tmp = RANDOM_INT_DITHER (dither);
-        d[i] = bias + tmp - last_random[i % stride];
-        last_random[i % stride] = tmp;
-      }
+      r = setup_random_buf (quant, len + stride);
+      fill_random (quant, r + stride, len);
+      t = (gint32 *) r;
+      memcpy (t, last_random, stride * sizeof (gint32));
+      for (i = stride; i < len + stride; i++)
+        t[i] = RANDOM_INT_DITHER (r[i], dither);
+      for (i = 0; i < len; i++)
+        d[i] = bias + t[i + stride] - t[i];
+      memcpy (last_random, t + len, stride * sizeof (gint32));
       break;
     }
   }
@@ -179,13 +290,15 @@ static void
 setup_error_buf (GstAudioQuantize * quant, gint samples)
 {
   gint stride = quant->stride;
-  gint len = (samples + quant->n_coeffs) * stride;
+  /* error feedback has no coefficients but keeps one error per channel */
+  gint history = MAX (quant->n_coeffs, 1);
+  gint len = (samples + history) * stride;
 
   if (quant->error_size < len) {
     quant->error_buf = g_realloc (quant->error_buf, len * sizeof (gint32));
     if (quant->error_size == 0)
       memset ((gint32 *) quant->error_buf, 0,
-          stride * quant->n_coeffs * sizeof (gint32));
+          stride * history * sizeof (gint32));
     quant->error_size = len;
   }
 }
@@ -272,6 +385,105 @@ gst_audio_quantize_quantize_int_dither_noise_shape (GstAudioQuantize * quant,
   memmove (e, &e[len], sizeof (gint32) * stride * nc);
 }
 
+/* saturating add of two gint32 */
+#define ADDSS64(a,b) \
+    ((gint32) CLAMP ((gint64) (a) + (b), G_MININT32, G_MAXINT32))
+
+/* Error feedback and noise shaping are recursive over the samples of a
+ * channel but independent between channels. These versions handle one frame
+ * at a time with the channels in the inner loops. With the number of
+ * channels known at compile time, the compiler can unroll the channel loops
+ * and vectorize them for the target it builds for. The results are the same
+ * as the generic versions above.
+ *
+ * There are deliberately no ORC versions of these: an ORC function runs
+ * over independent elements, so it could only handle the channels of a
+ * single frame per call and the call overhead would dominate. The dither
+ * they add is generated with ORC in setup_dither_buf(). */
+#define MAKE_FEEDBACK_FUNC(channels)                                    \
+static void                                                             \
+gst_audio_quantize_quantize_int_dither_feedback_##channels              \
+    (GstAudioQuantize * quant, const gpointer src, gpointer dst,        \
+    gint samples)                                                       \
+{                                                                       \
+  const gint32 *s = src;                                                \
+  gint32 *dith, *d = dst, *e, v, o, err, mask;                          \
+  gint i, c;                                                            \
+                                                                        \
+  setup_dither_buf (quant, samples);                                    \
+  setup_error_buf (quant, samples);                                     \
+                                                                        \
+  dith = quant->dither_buf;                                             \
+  /* only the last error of each channel is needed */                   \
+  e = quant->error_buf;                                                 \
+  mask = ~quant->mask;                                                  \
+                                                                        \
+  for (i = 0; i < samples; i++) {                                       \
+    for (c = 0; c < channels; c++) {                                    \
+      o = s[c];                                                         \
+      err = dith[c] - e[c];                                             \
+      v = ADDSS64 (o, err) & mask;                                      \
+      e[c] += v - o;                                                    \
+      d[c] = v;                                                         \
+    }                                                                   \
+    s += channels;                                                      \
+    d += channels;                                                      \
+    dith += channels;                                                   \
+  }                                                                     \
+}
+
+#define MAKE_NOISE_SHAPE_FUNC(channels)                                 \
+static void                                                             \
+gst_audio_quantize_quantize_int_dither_noise_shape_##channels           \
+    (GstAudioQuantize * quant, const gpointer src, gpointer dst,        \
+    gint samples)                                                       \
+{                                                                       \
+  const gint32 *s = src;                                                \
+  gint32 *coef, *dith, *d = dst, *e, v, o, mask, acc[channels];         \
+  gint i, j, c, nc;                                                     \
+                                                                        \
+  setup_dither_buf (quant, samples);                                    \
+  setup_error_buf (quant, samples);                                     \
+                                                                        \
+  dith = quant->dither_buf;                                             \
+  e = quant->error_buf;                                                 \
+  coef = quant->coeffs;                                                 \
+  nc = quant->n_coeffs;                                                 \
+  mask = ~quant->mask;                                                  \
+                                                                        \
+  for (i = 0; i < samples; i++) {                                       \
+    /* combine the past errors of each channel */                       \
+    for (c = 0; c < channels; c++)                                      \
+      acc[c] = 0;                                                       \
+    for (j = 0; j < nc; j++) {                                          \
+      const gint32 *ej = e + (i + j) * channels;                        \
+                                                                        \
+      for (c = 0; c < channels; c++)                                    \
+        acc[c] -= ej[c] * coef[j];                                      \
+    }                                                                   \
+    for (c = 0; c < channels; c++) {                                    \
+      /* remove error */                                                \
+      o = v = ADDSS64 (s[c], (acc[c] + SROUND) >> SREDUCE);             \
+      /* add dither and quantize */                                     \
+      v = ADDSS64 (v, dith[c]) & mask;                                  \
+      /* store new error with reduced precision */                      \
+      e[(i + nc) * channels + c] = (v - o + RROUND) >> REDUCE;          \
+      d[c] = v;                                                         \
+    }                                                                   \
+    s += channels;                                                      \
+    d += channels;                                                      \
+    dith += channels;                                                   \
+  }                                                                     \
+  memmove (e, &e[samples * channels], sizeof (gint32) * channels * nc); \
+}
+
+MAKE_FEEDBACK_FUNC (2);
+MAKE_FEEDBACK_FUNC (6);
+MAKE_FEEDBACK_FUNC (8);
+MAKE_NOISE_SHAPE_FUNC (2);
+MAKE_NOISE_SHAPE_FUNC (6);
+MAKE_NOISE_SHAPE_FUNC (8);
+
 #define MAKE_QUANTIZE_FUNC_NAME(name)                                   \
 gst_audio_quantize_quantize_##name
 
@@ -394,6 +606,43 @@ gst_audio_quantize_setup_quantize_func (GstAudioQuantize * quant)
 
   index = 5 * quant->dither + quant->ns;
   quant->quantize = quantize_funcs[index];
+
+  /* use the versions for a fixed number of interleaved channels */
+  if (quant->ns == GST_AUDIO_NOISE_SHAPING_ERROR_FEEDBACK) {
+    switch (quant->stride) {
+      case 2:
+        quant->quantize = (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME
+            (int_dither_feedback_2);
+        break;
+      case 6:
+        quant->quantize = (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME
+            (int_dither_feedback_6);
+        break;
+      case 8:
+        quant->quantize = (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME
+            (int_dither_feedback_8);
+        break;
+      default:
+        break;
+    }
+  } else if (quant->ns != GST_AUDIO_NOISE_SHAPING_NONE) {
+    switch (quant->stride) {
+      case 2:
+        quant->quantize = (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME
+            (int_dither_noise_shape_2);
+        break;
+      case 6:
+        quant->quantize = (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME
+            (int_dither_noise_shape_6);
+        break;
+      case 8:
+        quant->quantize = (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME
+            (int_dither_noise_shape_8);
+        break;
+      default:
+        break;
+    }
+  }
 }
 
 static gint
@@ -457,6 +706,7 @@ gst_audio_quantize_new (GstAudioDitherMethod dither,
     quant->bias = 0;
   quant->mask = (1U << quant->shift) - 1;
 
+  setup_random (quant, get_random_seed ());
   gst_audio_quantize_setup_dither (quant);
   gst_audio_quantize_setup_noise_shaping (quant);
   gst_audio_quantize_setup_quantize_func (quant);
@@ -479,6 +729,7 @@ gst_audio_quantize_free (GstAudioQuantize * quant)
   g_free (quant->coeffs);
   g_free (quant->last_random);
   g_free (quant->dither_buf);
+  g_free (quant->random_buf);
 
   g_slice_free (GstAudioQuantize, quant);
 }
@@ -0,0 +1,702 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <math.h>
+
+#include "audio-resampler.h"
+
+/**
+ * SECTION:audioresampler
+ * @short_description: Utility structure for resampler information
+ *
+ * #GstAudioResampler converts the sample rate of audio with a windowed
+ * sinc filter. The filter is split in one set of taps for each phase of
+ * the output samples relative to the input samples (a polyphase filter).
+ * The taps for all phases are either computed up front or interpolated
+ * from a smaller oversampled table when the full table would use too
+ * much memory.
+ *
+ * Input samples are kept in a history buffer, one plane per channel, so
+ * that the filter always runs over contiguous memory. @in and @out of
+ * gst_audio_resampler_resample() can point to the same memory.
+ */
+
+#ifndef GST_DISABLE_GST_DEBUG
+#define GST_CAT_DEFAULT ensure_debug_category()
+static GstDebugCategory *
+ensure_debug_category (void)
+{
+  static gsize cat_gonce = 0;
+
+  if (g_once_init_enter (&cat_gonce)) {
+    gsize cat_done;
+
+    cat_done = (gsize) _gst_debug_category_new ("audio-resampler", 0,
+        "audio-resampler object");
+
+    g_once_init_leave (&cat_gonce, cat_done);
+  }
+
+  return (GstDebugCategory *) cat_gonce;
+}
+#else
+#define ensure_debug_category() /* NOOP */
+#endif /* GST_DISABLE_GST_DEBUG */
+
+typedef void (*DeinterleaveFunc) (GstAudioResampler * resampler,
+    gpointer sbuf[], gpointer in[], gsize in_frames);
+typedef void (*ResampleFunc) (GstAudioResampler * resampler, gpointer out[],
+    gsize out_frames);
+
+struct _GstAudioResampler
+{
+  GstAudioResamplerFlags flags;
+  GstAudioFormat format;
+  gint channels;
+  gint in_rate;
+  gint out_rate;
+  gint bps;
+  gint ostride;
+
+  gdouble cutoff;
+  gint n_taps;
+  GstAudioResamplerFilterMode filter_mode;
+
+  /* n_phases rows of n_taps. For the interpolated table, row i has the taps
+   * for phase i / oversample, the last row is the next input sample */
+  gpointer taps;
+  gint n_phases;
+  gint oversample;
+
+  /* history, one plane per channel */
+  gpointer *sbuf;
+  gsize sbuf_len;
+  gsize samples_avail;
+
+  /* position of the first tap for the next output sample */
+  gsize samp_index;
+  gint samp_phase;
+  gint samp_inc;
+  gint samp_frac;
+
+  DeinterleaveFunc deinterleave;
+  ResampleFunc resample;
+};
+
+#define DEFAULT_OPT_CUTOFF 0.94
+#define DEFAULT_OPT_N_TAPS 48
+#define DEFAULT_OPT_FILTER_MODE GST_AUDIO_RESAMPLER_FILTER_MODE_AUTO
+#define DEFAULT_OPT_FILTER_MODE_THRESHOLD 1048576
+
+/* phases of the interpolated tables, the error of the linear interpolation
+ * between two phases is below the 16 bits noise floor */
+#define DEFAULT_OVERSAMPLE 128
+
+#define PRECISION_S16 14
+#define PRECISION_S32 30
+
+/* Blackman-Nuttall window over [-n_taps/2, n_taps/2] */
+static gdouble
+get_window (gdouble x, gint n_taps)
+{
+  gdouble w = 2.0 * G_PI * (x / n_taps + 0.5);
+
+  return 0.3635819 - 0.4891775 * cos (w) + 0.1365995 * cos (2.0 * w)
+      - 0.0106411 * cos (3.0 * w);
+}
+
+static gdouble
+get_tap (gdouble x, gint n_taps, gdouble cutoff)
+{
+  gdouble s;
+
+  if (fabs (x) >= n_taps / 2.0)
+    return 0.0;
+
+  if (x == 0.0)
+    s = 1.0;
+  else
+    s = sin (G_PI * cutoff * x) / (G_PI * cutoff * x);
+
+  return s * get_window (x, n_taps);
+}
+
+/* the taps for an output sample @frac input samples after the center of
+ * the filter, normalized for unity gain */
+static void
+make_taps (GstAudioResampler * resampler, gdouble * tmp, gdouble frac)
+{
+  gint i, n_taps = resampler->n_taps;
+  gdouble sum = 0.0;
+
+  for (i = 0; i < n_taps; i++) {
+    tmp[i] = get_tap (i - (n_taps / 2 - 1) - frac, n_taps, resampler->cutoff);
+    sum += tmp[i];
+  }
+  for (i = 0; i < n_taps; i++)
+    tmp[i] /= sum;
+}
+
+#define MAKE_CONVERT_TAPS_INT_FUNC(type,precision)                      \
+static void                                                             \
+convert_taps_##type (gdouble * tmp, gpointer taps, gint n_taps)         \
+{                                                                       \
+  type *t = taps;                                                       \
+  gint i, center = n_taps / 2 - 1;                                      \
+  gint64 sum = 0;                                                       \
+                                                                        \
+  for (i = 0; i < n_taps; i++) {                                        \
+    t[i] = floor (0.5 + tmp[i] * (1 << precision));                     \
+    sum += t[i];                                                        \
+  }                                                                     \
+  /* keep the gain exact after rounding */                              \
+  if (tmp[center + 1] > tmp[center])                                    \
+    center++;                                                           \
+  t[center] += (1 << precision) - sum;                                  \
+}
+
+#define MAKE_CONVERT_TAPS_FLOAT_FUNC(type)                              \
+static void                                                             \
+convert_taps_##type (gdouble * tmp, gpointer taps, gint n_taps)         \
+{                                                                       \
+  type *t = taps;                                                       \
+  gint i;                                                               \
+                                                                        \
+  for (i = 0; i < n_taps; i++)                                          \
+    t[i] = tmp[i];                                                      \
+}
+
+MAKE_CONVERT_TAPS_INT_FUNC (gint16, PRECISION_S16);
+MAKE_CONVERT_TAPS_INT_FUNC (gint32, PRECISION_S32);
+MAKE_CONVERT_TAPS_FLOAT_FUNC (gfloat);
+MAKE_CONVERT_TAPS_FLOAT_FUNC (gdouble);
+
+/* n_taps is always a multiple of 4, the independent sums let the compiler
+ * vectorize the loop, also for floating point */
+#define MAKE_INNER_PRODUCT_FUNC(type,type2)                             \
+static inline type2                                                     \
+inner_product_##type (const type * a, const type * b, gint len)         \
+{                                                                       \
+  gint i;                                                               \
+  type2 r0 = 0, r1 = 0, r2 = 0, r3 = 0;                                 \
+                                                                        \
+  for (i = 0; i < len; i += 4) {                                        \
+    r0 += (type2) a[i + 0] * (type2) b[i + 0];                          \
+    r1 += (type2) a[i + 1] * (type2) b[i + 1];                          \
+    r2 += (type2) a[i + 2] * (type2) b[i + 2];                          \
+    r3 += (type2) a[i + 3] * (type2) b[i + 3];                          \
+  }                                                                     \
+  return (r0 + r1) + (r2 + r3);                                         \
+}
+
+MAKE_INNER_PRODUCT_FUNC (gint16, gint32);
+MAKE_INNER_PRODUCT_FUNC (gint32, gint64);
+MAKE_INNER_PRODUCT_FUNC (gfloat, gfloat);
+MAKE_INNER_PRODUCT_FUNC (gdouble, gdouble);
+
+#define STORE_INT(type,type2,precision,minval,maxval)                   \
+  res = (res + ((type2) 1 << (precision - 1))) >> precision;            \
+  *op = CLAMP (res, minval, maxval);
+#define STORE_S16 STORE_INT (gint16, gint32, PRECISION_S16, G_MININT16, G_MAXINT16)
+#define STORE_S32 STORE_INT (gint32, gint64, PRECISION_S32, G_MININT32, G_MAXINT32)
+#define STORE_FLOAT *op = res;
+
+#define GET_TAPS_FULL(type)                                             \
+  res = inner_product_##type (ip + samp_index,                          \
+      taps + samp_phase * n_taps, n_taps);
+
+#define GET_TAPS_INTERPOLATE(type)                                      \
+  G_STMT_START {                                                        \
+    gint pos = samp_phase * oversample;                                 \
+    gint idx = pos / out_rate;                                          \
+    gdouble frac = (gdouble) (pos - idx * out_rate) / out_rate;         \
+    const type *t = taps + idx * n_taps;                                \
+    __typeof__ (res) r0, r1;                                            \
+                                                                        \
+    r0 = inner_product_##type (ip + samp_index, t, n_taps);             \
+    r1 = inner_product_##type (ip + samp_index, t + n_taps, n_taps);    \
+    res = r0 + (r1 - r0) * frac;                                        \
+  } G_STMT_END;
+
+#define MAKE_RESAMPLE_FUNC(type,type2,mode,GET_TAPS,STORE)              \
+static void                                                             \
+resample_##type##_##mode (GstAudioResampler * resampler,                \
+    gpointer out[], gsize out_frames)                                   \
+{                                                                       \
+  gint c, channels = resampler->channels;                               \
+  gint n_taps = resampler->n_taps;                                      \
+  gint ostride = resampler->ostride;                                    \
+  gint out_rate = resampler->out_rate;                                  \
+  gint oversample = resampler->oversample;                              \
+  const type *taps = resampler->taps;                                   \
+  gsize samp_index = 0;                                                 \
+  gint samp_phase = 0;                                                  \
+                                                                        \
+  (void) oversample;                                                    \
+                                                                        \
+  for (c = 0; c < channels; c++) {                                      \
+    const type *ip = resampler->sbuf[c];                                \
+    type *op = ostride == 1 ? out[c] : (type *) out[0] + c;             \
+    gsize di;                                                           \
+                                                                        \
+    samp_index = resampler->samp_index;                                 \
+    samp_phase = resampler->samp_phase;                                 \
+                                                                        \
+    for (di = 0; di < out_frames; di++) {                               \
+      type2 res;                                                        \
+                                                                        \
+      GET_TAPS (type);                                                  \
+      STORE;                                                            \
+      op += ostride;                                                    \
+                                                                        \
+      samp_index += resampler->samp_inc;                                \
+      samp_phase += resampler->samp_frac;                               \
+      if (samp_phase >= out_rate) {                                     \
+        samp_phase -= out_rate;                                         \
+        samp_index++;                                                   \
+      }                                                                 \
+    }                                                                   \
+  }                                                                     \
+  resampler->samp_index = samp_index;                                   \
+  resampler->samp_phase = samp_phase;                                   \
+}
+
+MAKE_RESAMPLE_FUNC (gint16, gint32, full, GET_TAPS_FULL, STORE_S16);
+MAKE_RESAMPLE_FUNC (gint32, gint64, full, GET_TAPS_FULL, STORE_S32);
+MAKE_RESAMPLE_FUNC (gfloat, gfloat, full, GET_TAPS_FULL, STORE_FLOAT);
+MAKE_RESAMPLE_FUNC (gdouble, gdouble, full, GET_TAPS_FULL, STORE_FLOAT);
+
+MAKE_RESAMPLE_FUNC (gint16, gint32, interpolate, GET_TAPS_INTERPOLATE,
+    STORE_S16);
+MAKE_RESAMPLE_FUNC (gint32, gint64, interpolate, GET_TAPS_INTERPOLATE,
+    STORE_S32);
+MAKE_RESAMPLE_FUNC (gfloat, gfloat, interpolate, GET_TAPS_INTERPOLATE,
+    STORE_FLOAT);
+MAKE_RESAMPLE_FUNC (gdouble, gdouble, interpolate, GET_TAPS_INTERPOLATE,
+    STORE_FLOAT);
+
+/* copies new samples to the end of the history, floats are copied as
+ * integers of the same size */
+#define MAKE_DEINTERLEAVE_FUNC(type)                                    \
+static void                                                             \
+deinterleave_##type (GstAudioResampler * resampler, gpointer sbuf[],    \
+    gpointer in[], gsize in_frames)                                     \
+{                                                                       \
+  gint c, channels = resampler->channels;                               \
+  gsize i;                                                              \
+                                                                        \
+  for (c = 0; c < channels; c++) {                                      \
+    type *s = (type *) sbuf[c] + resampler->samples_avail;              \
+                                                                        \
+    if (G_UNLIKELY (in == NULL)) {                                      \
+      memset (s, 0, in_frames * sizeof (type));                         \
+    } else if (resampler->ostride == 1) {                               \
+      memcpy (s, in[c], in_frames * sizeof (type));                     \
+    } else {                                                            \
+      const type *ip = (type *) in[0] + c;                              \
+                                                                        \
+      for (i = 0; i < in_frames; i++, ip += channels)                   \
+        s[i] = *ip;                                                     \
+    }                                                                   \
+  }                                                                     \
+}
+
+MAKE_DEINTERLEAVE_FUNC (gint16);
+MAKE_DEINTERLEAVE_FUNC (gint32);
+MAKE_DEINTERLEAVE_FUNC (gint64);
+
+static gsize
+get_history_len (GstAudioResampler * resampler)
+{
+  /* the first output sample is centered on the first input sample */
+  return resampler->n_taps / 2 - 1;
+}
+
+static void
+ensure_history (GstAudioResampler * resampler, gsize frames)
+{
+  gint c;
+
+  if (frames <= resampler->sbuf_len)
+    return;
+
+  frames = MAX (frames, resampler->sbuf_len * 2);
+  GST_DEBUG ("history of %" G_GSIZE_FORMAT " frames", frames);
+
+  for (c = 0; c < resampler->channels; c++)
+    resampler->sbuf[c] = g_realloc (resampler->sbuf[c],
+        frames * resampler->bps);
+  resampler->sbuf_len = frames;
+}
+
+static void
+setup_taps (GstAudioResampler * resampler, gsize threshold,
+    void (*convert_taps) (gdouble *, gpointer, gint))
+{
+  gint i, n_taps = resampler->n_taps;
+  gsize row_size = n_taps * resampler->bps;
+  gdouble *tmp;
+
+  if (resampler->filter_mode == GST_AUDIO_RESAMPLER_FILTER_MODE_AUTO) {
+    if (resampler->out_rate * row_size <= threshold)
+      resampler->filter_mode = GST_AUDIO_RESAMPLER_FILTER_MODE_FULL;
+    else
+      resampler->filter_mode = GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED;
+  }
+
+  if (resampler->filter_mode == GST_AUDIO_RESAMPLER_FILTER_MODE_FULL) {
+    resampler->oversample = resampler->out_rate;
+    resampler->n_phases = resampler->out_rate;
+  } else {
+    resampler->oversample = DEFAULT_OVERSAMPLE;
+    resampler->n_phases = DEFAULT_OVERSAMPLE + 1;
+  }
+
+  GST_DEBUG ("%d taps, %d phases, cutoff %f, %s", n_taps,
+      resampler->n_phases, resampler->cutoff,
+      resampler->filter_mode == GST_AUDIO_RESAMPLER_FILTER_MODE_FULL ?
+      "full" : "interpolated");
+
+  resampler->taps = g_malloc (resampler->n_phases * row_size);
+
+  tmp = g_new (gdouble, n_taps);
+  for (i = 0; i < resampler->n_phases; i++) {
+    make_taps (resampler, tmp, (gdouble) i / resampler->oversample);
+    convert_taps (tmp, (guint8 *) resampler->taps + i * row_size, n_taps);
+  }
+  g_free (tmp);
+}
+
+/**
+ * gst_audio_resampler_new:
+ * @flags: #GstAudioResamplerFlags
+ * @format: the #GstAudioFormat, one of S16, S32, F32 or F64 in native
+ *     endianness
+ * @channels: the number of channels
+ * @in_rate: input rate
+ * @out_rate: output rate
+ * @options: (transfer none) (allow-none): extra options, see the
+ *     #GST_AUDIO_RESAMPLER_OPT_* fields
+ *
+ * Make a new resampler.
+ *
+ * Returns: (transfer full): a new #GstAudioResampler or %NULL when the
+ *     format is not supported.
+ *
+ * Since: 1.8
+ */
+GstAudioResampler *
+gst_audio_resampler_new (GstAudioResamplerFlags flags, GstAudioFormat format,
+    gint channels, gint in_rate, gint out_rate, GstStructure * options)
+{
+  GstAudioResampler *resampler;
+  void (*convert_taps) (gdouble *, gpointer, gint);
+  ResampleFunc full, interpolate;
+  guint threshold = DEFAULT_OPT_FILTER_MODE_THRESHOLD;
+  gdouble n_taps;
+  gint gcd, n;
+
+  g_return_val_if_fail (channels > 0, NULL);
+  g_return_val_if_fail (in_rate > 0, NULL);
+  g_return_val_if_fail (out_rate > 0, NULL);
+
+  resampler = g_slice_new0 (GstAudioResampler);
+  resampler->flags = flags;
+  resampler->format = format;
+  resampler->channels = channels;
+
+  switch (format) {
+    case GST_AUDIO_FORMAT_S16:
+      resampler->deinterleave = deinterleave_gint16;
+      convert_taps = convert_taps_gint16;
+      full = resample_gint16_full;
+      interpolate = resample_gint16_interpolate;
+      break;
+    case GST_AUDIO_FORMAT_S32:
+      resampler->deinterleave = deinterleave_gint32;
+      convert_taps = convert_taps_gint32;
+      full = resample_gint32_full;
+      interpolate = resample_gint32_interpolate;
+      break;
+    case GST_AUDIO_FORMAT_F32:
+      resampler->deinterleave = deinterleave_gint32;
+      convert_taps = convert_taps_gfloat;
+      full = resample_gfloat_full;
+      interpolate = resample_gfloat_interpolate;
+      break;
+    case GST_AUDIO_FORMAT_F64:
+      resampler->deinterleave = deinterleave_gint64;
+      convert_taps = convert_taps_gdouble;
+      full = resample_gdouble_full;
+      interpolate = resample_gdouble_interpolate;
+      break;
+    default:
+      goto wrong_format;
+  }
+  resampler->bps = GST_AUDIO_FORMAT_INFO_WIDTH (gst_audio_format_get_info
+      (format)) / 8;
+  resampler->ostride =
+      flags & GST_AUDIO_RESAMPLER_FLAG_NON_INTERLEAVED ? 1 : channels;
+
+  resampler->cutoff = DEFAULT_OPT_CUTOFF;
+  n = DEFAULT_OPT_N_TAPS;
+  resampler->filter_mode = DEFAULT_OPT_FILTER_MODE;
+  if (options) {
+    gint mode;
+
+    gst_structure_get_double (options, GST_AUDIO_RESAMPLER_OPT_CUTOFF,
+        &resampler->cutoff);
+    gst_structure_get_int (options, GST_AUDIO_RESAMPLER_OPT_N_TAPS, &n);
+    if (gst_structure_get_enum (options, GST_AUDIO_RESAMPLER_OPT_FILTER_MODE,
+            GST_TYPE_AUDIO_RESAMPLER_FILTER_MODE, &mode))
+      resampler->filter_mode = mode;
+    gst_structure_get_uint (options,
+        GST_AUDIO_RESAMPLER_OPT_FILTER_MODE_THRESHOLD, &threshold);
+  }
+
+  n_taps = MAX (n, 4);
+  if (in_rate > out_rate) {
+    /* downsampling, the filter has to cut at the output nyquist frequency
+     * so it gets longer with the same transition band */
+    resampler->cutoff = resampler->cutoff * out_rate / in_rate;
+    n_taps = n_taps * in_rate / out_rate;
+  }
+  resampler->n_taps = GST_ROUND_UP_4 ((gint) ceil (n_taps));
+
+  gcd = gst_util_greatest_common_divisor (in_rate, out_rate);
+  resampler->in_rate = in_rate / gcd;
+  resampler->out_rate = out_rate / gcd;
+  resampler->samp_inc = resampler->in_rate / resampler->out_rate;
+  resampler->samp_frac = resampler->in_rate % resampler->out_rate;
+
+  GST_DEBUG ("%d -> %d, %d channels, format %s", in_rate, out_rate, channels,
+      gst_audio_format_to_string (format));
+
+  setup_taps (resampler, threshold, convert_taps);
+  if (resampler->filter_mode == GST_AUDIO_RESAMPLER_FILTER_MODE_FULL)
+    resampler->resample = full;
+  else
+    resampler->resample = interpolate;
+
+  resampler->sbuf = g_new0 (gpointer, channels);
+  gst_audio_resampler_reset (resampler);
+
+  return resampler;
+
+  /* ERRORS */
+wrong_format:
+  {
+    GST_WARNING ("unsupported format %s", gst_audio_format_to_string (format));
+    g_slice_free (GstAudioResampler, resampler);
+    return NULL;
+  }
+}
+
+/**
+ * gst_audio_resampler_free:
+ * @resampler: a #GstAudioResampler
+ *
+ * Free a previously allocated #GstAudioResampler @resampler.
+ *
+ * Since: 1.8
+ */
+void
+gst_audio_resampler_free (GstAudioResampler * resampler)
+{
+  gint c;
+
+  g_return_if_fail (resampler != NULL);
+
+  for (c = 0; c < resampler->channels; c++)
+    g_free (resampler->sbuf[c]);
+  g_free (resampler->sbuf);
+  g_free (resampler->taps);
+  g_slice_free (GstAudioResampler, resampler);
+}
+
+/**
+ * gst_audio_resampler_reset:
+ * @resampler: a #GstAudioResampler
+ *
+ * Reset @resampler to the state it was when it was first created, discarding
+ * all sample history.
+ *
+ * Since: 1.8
+ */
+void
+gst_audio_resampler_reset (GstAudioResampler * resampler)
+{
+  gsize history;
+  gint c;
+
+  g_return_if_fail (resampler != NULL);
+
+  history = get_history_len (resampler);
+  ensure_history (resampler, history + resampler->n_taps);
+
+  for (c = 0; c < resampler->channels; c++)
+    memset (resampler->sbuf[c], 0, history * resampler->bps);
+
+  resampler->samples_avail = history;
+  resampler->samp_index = 0;
+  resampler->samp_phase = 0;
+}
+
+/**
+ * gst_audio_resampler_get_out_frames:
+ * @resampler: a #GstAudioResampler
+ * @in_frames: number of input frames
+ *
+ * Get the number of output frames that would be currently available when
+ * @in_frames are given to @resampler.
+ *
+ * Returns: The number of frames that would be availabe after giving
+ * @in_frames as input to @resampler.
+ *
+ * Since: 1.8
+ */
+gsize
+gst_audio_resampler_get_out_frames (GstAudioResampler * resampler,
+    gsize in_frames)
+{
+  guint64 avail, limit, pos;
+
+  g_return_val_if_fail (resampler != NULL, 0);
+
+  avail = resampler->samples_avail + in_frames;
+  if (avail < resampler->samp_index + resampler->n_taps)
+    return 0;
+
+  /* output samples can start up to the last complete filter */
+  limit = (avail - resampler->n_taps + 1) * resampler->out_rate;
+  pos = (guint64) resampler->samp_index * resampler->out_rate +
+      resampler->samp_phase;
+
+  return (limit - pos + resampler->in_rate - 1) / resampler->in_rate;
+}
+
+/**
+ * gst_audio_resampler_get_in_frames:
+ * @resampler: a #GstAudioResampler
+ * @out_frames: number of output frames
+ *
+ * Get the number of input frames that would currently be needed
+ * to produce @out_frames from @resampler.
+ *
+ * Returns: The number of input frames needed for producing
+ * @out_frames of data from @resampler.
+ *
+ * Since: 1.8
+ */
+gsize
+gst_audio_resampler_get_in_frames (GstAudioResampler * resampler,
+    gsize out_frames)
+{
+  guint64 last, need;
+
+  g_return_val_if_fail (resampler != NULL, 0);
+
+  if (out_frames == 0)
+    return 0;
+
+  last = (guint64) resampler->samp_index * resampler->out_rate +
+      resampler->samp_phase + (guint64) (out_frames - 1) * resampler->in_rate;
+  need = last / resampler->out_rate + resampler->n_taps;
+
+  return need > resampler->samples_avail ? need - resampler->samples_avail : 0;
+}
+
+/**
+ * gst_audio_resampler_get_max_latency:
+ * @resampler: a #GstAudioResampler
+ *
+ * Get the maximum number of input samples that the resampler would
+ * need before producing output.
+ *
+ * Returns: the latency of @resampler as expressed in the number of
+ * frames.
+ *
+ * Since: 1.8
+ */
+gsize
+gst_audio_resampler_get_max_latency (GstAudioResampler * resampler)
+{
+  g_return_val_if_fail (resampler != NULL, 0);
+
+  return resampler->n_taps - get_history_len (resampler);
+}
+
+/**
+ * gst_audio_resampler_resample:
+ * @resampler: a #GstAudioResampler
+ * @in: input samples or %NULL to push silence
+ * @in_frames: number of input frames
+ * @out: output samples
+ * @out_frames: number of output frames
+ *
+ * Perform resampling on @in_frames frames in @in and write @out_frames to @out.
+ *
+ * In case the samples are interleaved, @in and @out must point to an
+ * array with a single element pointing to a block of interleaved samples.
+ *
+ * If non-interleaved samples are used, @in and @out must point to an
+ * array with pointers to memory blocks, one for each channel.
+ *
+ * All of @in_frames are consumed. @out_frames must not be larger than what
+ * gst_audio_resampler_get_out_frames() returns for @in_frames, the
+ * remaining samples are kept for the next call. @in and @out can point to
+ * the same memory.
+ *
+ * Since: 1.8
+ */
+void
+gst_audio_resampler_resample (GstAudioResampler * resampler,
+    gpointer in[], gsize in_frames, gpointer out[], gsize out_frames)
+{
+  gsize consumed;
+  gint c;
+
+  g_return_if_fail (resampler != NULL);
+  g_return_if_fail (out != NULL || out_frames == 0);
+
+  ensure_history (resampler, resampler->samples_avail + in_frames);
+  resampler->deinterleave (resampler, resampler->sbuf, in, in_frames);
+  resampler->samples_avail += in_frames;
+
+  if (out_frames > 0)
+    resampler->resample (resampler, out, out_frames);
+
+  /* drop the history that the next output sample doesn't need */
+  consumed = MIN (resampler->samp_index, resampler->samples_avail);
+  if (consumed > 0) {
+    gsize left = resampler->samples_avail - consumed;
+
+    for (c = 0; c < resampler->channels; c++) {
+      guint8 *s = resampler->sbuf[c];
+
+      memmove (s, s + consumed * resampler->bps, left * resampler->bps);
+    }
+    resampler->samples_avail = left;
+    resampler->samp_index -= consumed;
+  }
+}
@@ -0,0 +1,116 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/gst.h>
+
+#include <gst/audio/audio.h>
+
+
+#ifndef __GST_AUDIO_RESAMPLER_H__
+#define __GST_AUDIO_RESAMPLER_H__
+
+typedef struct _GstAudioResampler GstAudioResampler;
+
+/**
+ * GST_AUDIO_RESAMPLER_OPT_CUTOFF:
+ *
+ * #G_TYPE_DOUBLE, cutoff frequency of the filter as a fraction of the
+ * nyquist frequency of the lowest of the two rates.
+ * Default is 0.94.
+ */
+#define GST_AUDIO_RESAMPLER_OPT_CUTOFF      "GstAudioResampler.cutoff"
+
+/**
+ * GST_AUDIO_RESAMPLER_OPT_N_TAPS:
+ *
+ * #G_TYPE_INT, the number of taps of the filter when upsampling. The
+ * number of taps grows with the ratio when downsampling.
+ * Default is 48.
+ */
+#define GST_AUDIO_RESAMPLER_OPT_N_TAPS      "GstAudioResampler.n-taps"
+
+/**
+ * GstAudioResamplerFilterMode:
+ * @GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED: Use interpolated filter tables. This
+ *     uses less memory but more CPU and is slightly less accurate.
+ * @GST_AUDIO_RESAMPLER_FILTER_MODE_FULL: Use a filter table for each
+ *     phase. This uses more memory but less CPU.
+ * @GST_AUDIO_RESAMPLER_FILTER_MODE_AUTO: Automatically choose between
+ *     interpolated and full filter tables, based on
+ *     #GST_AUDIO_RESAMPLER_OPT_FILTER_MODE_THRESHOLD.
+ *
+ * Select how the filter tables should be set up.
+ */
+typedef enum {
+  GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED = (0),
+  GST_AUDIO_RESAMPLER_FILTER_MODE_FULL,
+  GST_AUDIO_RESAMPLER_FILTER_MODE_AUTO,
+} GstAudioResamplerFilterMode;
+
+/**
+ * GST_AUDIO_RESAMPLER_OPT_FILTER_MODE:
+ *
+ * #GST_TYPE_AUDIO_RESAMPLER_FILTER_MODE: how the filter tables should be
+ * constructed.
+ * Default is #GST_AUDIO_RESAMPLER_FILTER_MODE_AUTO.
+ */
+#define GST_AUDIO_RESAMPLER_OPT_FILTER_MODE  "GstAudioResampler.filter-mode"
+
+/**
+ * GST_AUDIO_RESAMPLER_OPT_FILTER_MODE_THRESHOLD:
+ *
+ * #G_TYPE_UINT: the amount of memory to use for full filter tables before
+ * switching to interpolated filter tables.
+ * Default is 1048576.
+ */
+#define GST_AUDIO_RESAMPLER_OPT_FILTER_MODE_THRESHOLD "GstAudioResampler.filter-mode-threshold"
+
+/**
+ * GstAudioResamplerFlags:
+ * @GST_AUDIO_RESAMPLER_FLAG_NONE: no flags
+ * @GST_AUDIO_RESAMPLER_FLAG_NON_INTERLEAVED: samples are non-interleaved.
+ *
+ * Different resampler flags.
+ */
+typedef enum {
+  GST_AUDIO_RESAMPLER_FLAG_NONE                 = (0),
+  GST_AUDIO_RESAMPLER_FLAG_NON_INTERLEAVED      = (1 << 0),
+} GstAudioResamplerFlags;
+
+GstAudioResampler * gst_audio_resampler_new              (GstAudioResamplerFlags flags,
+                                                          GstAudioFormat format,
+                                                          gint channels,
+                                                          gint in_rate,
+                                                          gint out_rate,
+                                                          GstStructure *options);
+void                gst_audio_resampler_free             (GstAudioResampler *resampler);
+
+void                gst_audio_resampler_reset            (GstAudioResampler *resampler);
+
+gsize               gst_audio_resampler_get_out_frames   (GstAudioResampler *resampler,
+                                                          gsize in_frames);
+gsize               gst_audio_resampler_get_in_frames    (GstAudioResampler *resampler,
+                                                          gsize out_frames);
+
+gsize               gst_audio_resampler_get_max_latency  (GstAudioResampler *resampler);
+
+void                gst_audio_resampler_resample         (GstAudioResampler * resampler,
+                                                          gpointer in[], gsize in_frames,
+                                                          gpointer out[], gsize out_frames);
+
+#endif /* __GST_AUDIO_RESAMPLER_H__ */
@@ -70,10 +70,21 @@ struct _GstAudioBaseSinkPrivate
   /* number of nanoseconds to wait until creating a discontinuity */
   GstClockTime discont_wait;
 
+  /* put the ringbuffer in SPSC mode */
+  gboolean spsc;
+
   /* custom slaving algorithm callback */
   GstAudioBaseSinkCustomSlavingCallback custom_slaving_callback;
   gpointer custom_slaving_cb_data;
   GDestroyNotify custom_slaving_cb_notify;
+
+  /* statistics, protected by the object lock */
+  guint64 stats_dropped;
+  guint64 stats_inserted;
+  guint stats_resyncs;
+  guint stats_skew_corrections;
+  GstClockTime stats_skew_correction;
+  guint stats_fill[4];
 };
 
 /* BaseAudioSink signals and args */
@@ -104,6 +115,8 @@ enum
  * fix itself, or is a permanent offset */
 #define DEFAULT_DISCONT_WAIT        (1 * GST_SECOND)
 
+#define DEFAULT_SPSC                FALSE
+
 enum
 {
   PROP_0,
@@ -116,6 +129,8 @@ enum
   PROP_ALIGNMENT_THRESHOLD,
   PROP_DRIFT_TOLERANCE,
   PROP_DISCONT_WAIT,
+  PROP_SPSC,
+  PROP_STATS,
 
   PROP_LAST
 };
@@ -272,6 +287,75 @@ gst_audio_base_sink_class_init (GstAudioBaseSinkClass * klass)
           G_MAXUINT64 - 1, DEFAULT_DISCONT_WAIT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioBaseSink:spsc:
+   *
+   * Put the ringbuffer in single producer, single consumer mode when it is
+   * created, see gst_audio_ring_buffer_set_spsc(). The element must then be
+   * the only writer of the ringbuffer and the device the only reader. Only
+   * has an effect when set before the element goes to READY.
+   *
+   * Since: 1.8
+   */
+  g_object_class_install_property (gobject_class, PROP_SPSC,
+      g_param_spec_boolean ("spsc", "Single producer, single consumer",
+          "Don't lock the ringbuffer when waiting for free space, the element "
+          "must be the only writer", DEFAULT_SPSC,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAudioBaseSink:stats:
+   *
+   * Various statistics about glitches in the rendered audio. This property
+   * returns a #GstStructure with name application/x-audio-base-sink-stats
+   * with the following fields:
+   *
+   * <variablelist>
+   * <varlistentry>
+   *   <term>dropped</term>
+   *   <listitem><para>#G_TYPE_UINT64, the number of samples that were
+   *   dropped because they arrived too late or overlapped with already
+   *   rendered samples.</para></listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>inserted</term>
+   *   <listitem><para>#G_TYPE_UINT64, the number of silence samples that
+   *   were inserted to fill gaps in the stream.</para></listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>resyncs</term>
+   *   <listitem><para>#G_TYPE_UINT, the number of times the sink had to
+   *   resynchronise to the timestamps or the clock.</para></listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>skew-corrections</term>
+   *   <listitem><para>#G_TYPE_UINT, the number of times the clock slaving
+   *   corrected the skew.</para></listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>skew-correction</term>
+   *   <listitem><para>#G_TYPE_UINT64, the total absolute amount of skew
+   *   correction in nanoseconds.</para></listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>fill-histogram</term>
+   *   <listitem><para>#GST_TYPE_ARRAY of 4 #G_TYPE_UINT, how often the
+   *   ringbuffer was filled to 0-25%, 25-50%, 50-75% and 75-100% when
+   *   new samples were written into it.</para></listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>delay</term>
+   *   <listitem><para>#G_TYPE_UINT, the number of samples queued in the
+   *   device as reported by gst_audio_ring_buffer_delay().</para></listitem>
+   * </varlistentry>
+   * </variablelist>
+   *
+   * Since: 1.8
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics", "Various statistics",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_audio_base_sink_change_state);
   gstelement_class->provide_clock =
@@ -311,6 +395,7 @@ gst_audio_base_sink_init (GstAudioBaseSink * audiobasesink)
   audiobasesink->priv->drift_tolerance = DEFAULT_DRIFT_TOLERANCE;
   audiobasesink->priv->alignment_threshold = DEFAULT_ALIGNMENT_THRESHOLD;
   audiobasesink->priv->discont_wait = DEFAULT_DISCONT_WAIT;
+  audiobasesink->priv->spsc = DEFAULT_SPSC;
   audiobasesink->priv->custom_slaving_callback = NULL;
   audiobasesink->priv->custom_slaving_cb_data = NULL;
   audiobasesink->priv->custom_slaving_cb_notify = NULL;
@@ -818,6 +903,7 @@ gst_audio_base_sink_report_device_failure (GstAudioBaseSink * sink)
   g_return_if_fail (GST_IS_AUDIO_BASE_SINK (sink));
 
   GST_OBJECT_LOCK (sink);
+  sink->priv->stats_resyncs++;
   gst_audio_base_sink_custom_cb_report_discont (sink,
       GST_AUDIO_BASE_SINK_DISCONT_REASON_DEVICE_FAILURE);
   GST_OBJECT_UNLOCK (sink);
@@ -879,12 +965,107 @@ gst_audio_base_sink_set_property (GObject * object, guint prop_id,
     case PROP_DISCONT_WAIT:
       gst_audio_base_sink_set_discont_wait (sink, g_value_get_uint64 (value));
       break;
+    case PROP_SPSC:
+      GST_OBJECT_LOCK (sink);
+      sink->priv->spsc = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (sink);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+static void
+gst_audio_base_sink_count_skew (GstAudioBaseSink * sink,
+    GstClockTime correction, gboolean resync)
+{
+  GstAudioBaseSinkPrivate *priv = sink->priv;
+
+  GST_OBJECT_LOCK (sink);
+  priv->stats_skew_corrections++;
+  priv->stats_skew_correction += correction;
+  if (resync)
+    priv->stats_resyncs++;
+  GST_OBJECT_UNLOCK (sink);
+}
+
+static void
+gst_audio_base_sink_reset_stats (GstAudioBaseSink * sink)
+{
+  GstAudioBaseSinkPrivate *priv = sink->priv;
+
+  GST_OBJECT_LOCK (sink);
+  priv->stats_dropped = 0;
+  priv->stats_inserted = 0;
+  priv->stats_resyncs = 0;
+  priv->stats_skew_corrections = 0;
+  priv->stats_skew_correction = 0;
+  memset (priv->stats_fill, 0, sizeof (priv->stats_fill));
+  GST_OBJECT_UNLOCK (sink);
+}
+
+/* must be called with the object lock */
+static void
+gst_audio_base_sink_update_fill (GstAudioBaseSink * sink, gint64 fill,
+    guint samples)
+{
+  GstAudioBaseSinkPrivate *priv = sink->priv;
+  GstAudioRingBuffer *ringbuf = sink->ringbuffer;
+  gint64 total;
+  guint idx;
+
+  if (fill < 0) {
+    /* the samples are behind the read pointer and will never be heard */
+    priv->stats_dropped += MIN (-fill, samples);
+    return;
+  }
+
+  total = (gint64) ringbuf->spec.segtotal * ringbuf->samples_per_seg;
+  if (total <= 0)
+    return;
+
+  idx = MIN (fill * G_N_ELEMENTS (priv->stats_fill) / total,
+      G_N_ELEMENTS (priv->stats_fill) - 1);
+  priv->stats_fill[idx]++;
+}
+
+static GstStructure *
+gst_audio_base_sink_create_stats (GstAudioBaseSink * sink)
+{
+  GstAudioBaseSinkPrivate *priv = sink->priv;
+  GstStructure *s;
+  GValue fill = G_VALUE_INIT;
+  GValue v = G_VALUE_INIT;
+  guint delay = 0;
+  guint i;
+
+  if (sink->ringbuffer && gst_audio_ring_buffer_is_acquired (sink->ringbuffer))
+    delay = gst_audio_ring_buffer_delay (sink->ringbuffer);
+
+  g_value_init (&fill, GST_TYPE_ARRAY);
+  g_value_init (&v, G_TYPE_UINT);
+
+  GST_OBJECT_LOCK (sink);
+  for (i = 0; i < G_N_ELEMENTS (priv->stats_fill); i++) {
+    g_value_set_uint (&v, priv->stats_fill[i]);
+    gst_value_array_append_value (&fill, &v);
+  }
+  s = gst_structure_new ("application/x-audio-base-sink-stats",
+      "dropped", G_TYPE_UINT64, priv->stats_dropped,
+      "inserted", G_TYPE_UINT64, priv->stats_inserted,
+      "resyncs", G_TYPE_UINT, priv->stats_resyncs,
+      "skew-corrections", G_TYPE_UINT, priv->stats_skew_corrections,
+      "skew-correction", G_TYPE_UINT64, priv->stats_skew_correction,
+      "delay", G_TYPE_UINT, delay, NULL);
+  GST_OBJECT_UNLOCK (sink);
+
+  gst_structure_take_value (s, "fill-histogram", &fill);
+  g_value_unset (&v);
+
+  return s;
+}
+
 static void
 gst_audio_base_sink_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec)
@@ -919,6 +1100,14 @@ gst_audio_base_sink_get_property (GObject * object, guint prop_id,
     case PROP_DISCONT_WAIT:
       g_value_set_uint64 (value, gst_audio_base_sink_get_discont_wait (sink));
       break;
+    case PROP_SPSC:
+      GST_OBJECT_LOCK (sink);
+      g_value_set_boolean (value, sink->priv->spsc);
+      GST_OBJECT_UNLOCK (sink);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, gst_audio_base_sink_create_stats (sink));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1333,6 +1522,9 @@ gst_audio_base_sink_custom_slaving (GstAudioBaseSink * sink,
     if ((last_align < 0) || (last_align > driftsamples))
       sink->next_sample = -1;
 
+    gst_audio_base_sink_count_skew (sink, requested_skew,
+        sink->next_sample == -1);
+
     GST_DEBUG_OBJECT (sink,
         "last_align %" G_GINT64_FORMAT " driftsamples %u, next %"
         G_GUINT64_FORMAT, last_align, driftsamples, sink->next_sample);
@@ -1351,6 +1543,9 @@ gst_audio_base_sink_custom_slaving (GstAudioBaseSink * sink,
     if ((last_align > 0) || (-last_align > driftsamples))
       sink->next_sample = -1;
 
+    gst_audio_base_sink_count_skew (sink, -requested_skew,
+        sink->next_sample == -1);
+
     GST_DEBUG_OBJECT (sink,
         "last_align %" G_GINT64_FORMAT " driftsamples %u, next %"
         G_GUINT64_FORMAT, last_align, driftsamples, sink->next_sample);
@@ -1433,6 +1628,7 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
   GstClockTime cinternal, cexternal, crate_num, crate_denom;
   GstClockTime etime, itime;
   GstClockTimeDiff skew, mdrift, mdrift2;
+  GstClockTime correction;
   gint driftsamples;
   gint64 last_align;
 
@@ -1484,9 +1680,11 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
         GST_STIME_ARGS (sink->priv->avg_skew), GST_STIME_ARGS (mdrift2));
 
     if (sink->priv->avg_skew > (2 * mdrift)) {
+      correction = sink->priv->avg_skew;
       cexternal -= sink->priv->avg_skew;
       sink->priv->avg_skew = 0;
     } else {
+      correction = mdrift;
       cexternal = cexternal > mdrift ? cexternal - mdrift : 0;
       sink->priv->avg_skew -= mdrift;
     }
@@ -1499,6 +1697,9 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
     if (last_align < 0 || last_align > driftsamples)
       sink->next_sample = -1;
 
+    gst_audio_base_sink_count_skew (sink, correction,
+        sink->next_sample == -1);
+
     GST_DEBUG_OBJECT (sink,
         "last_align %" G_GINT64_FORMAT " driftsamples %u, next %"
         G_GUINT64_FORMAT, last_align, driftsamples, sink->next_sample);
@@ -1512,9 +1713,11 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
         GST_STIME_ARGS (sink->priv->avg_skew), GST_STIME_ARGS (mdrift2));
 
     if (sink->priv->avg_skew < (2 * -mdrift)) {
+      correction = -sink->priv->avg_skew;
       cexternal -= sink->priv->avg_skew;
       sink->priv->avg_skew = 0;
     } else {
+      correction = mdrift;
       cexternal += mdrift;
       sink->priv->avg_skew += mdrift;
     }
@@ -1527,6 +1730,9 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
     if (last_align > 0 || -last_align > driftsamples)
       sink->next_sample = -1;
 
+    gst_audio_base_sink_count_skew (sink, correction,
+        sink->next_sample == -1);
+
     GST_DEBUG_OBJECT (sink,
         "last_align %" G_GINT64_FORMAT " driftsamples %u, next %"
         G_GUINT64_FORMAT, last_align, driftsamples, sink->next_sample);
@@ -1807,6 +2013,14 @@ gst_audio_base_sink_get_alignment (GstAudioBaseSink * sink,
         sample_offset > sink->next_sample ? "+" : "-", GST_TIME_ARGS (diff_s));
     align = 0;
 
+    GST_OBJECT_LOCK (sink);
+    sink->priv->stats_resyncs++;
+    if (sample_offset > sink->next_sample)
+      sink->priv->stats_inserted += sample_diff;
+    else
+      sink->priv->stats_dropped += sample_diff;
+    GST_OBJECT_UNLOCK (sink);
+
     gst_audio_base_sink_custom_cb_report_discont (sink,
         GST_AUDIO_BASE_SINK_DISCONT_REASON_ALIGNMENT);
   }
@@ -2154,6 +2368,13 @@ no_align:
   GST_DEBUG_OBJECT (sink, "rendering at %" G_GUINT64_FORMAT " %d/%d",
       sample_offset, samples, out_samples);
 
+  /* keep track of how far ahead of the read pointer we are writing */
+  GST_OBJECT_LOCK (sink);
+  gst_audio_base_sink_update_fill (sink, (gint64) sample_offset -
+      (gint64) (g_atomic_int_get (&ringbuf->segdone) - ringbuf->segbase) *
+      ringbuf->samples_per_seg, samples);
+  GST_OBJECT_UNLOCK (sink);
+
   /* we need to accumulate over different runs for when we get interrupted */
   accum = 0;
   align_next = TRUE;
@@ -2225,6 +2446,9 @@ out_of_segment:
 too_late:
   {
     GST_DEBUG_OBJECT (sink, "dropping late sample");
+    GST_OBJECT_LOCK (sink);
+    sink->priv->stats_dropped += samples;
+    GST_OBJECT_UNLOCK (sink);
     ret = GST_FLOW_OK;
     goto done;
   }
@@ -2417,6 +2641,7 @@ gst_audio_base_sink_change_state (GstElement * element,
   switch (transition) {
     case GST_STATE_CHANGE_NULL_TO_READY:{
       GstAudioRingBuffer *rb;
+      gboolean spsc;
 
       gst_audio_clock_reset (GST_AUDIO_CLOCK (sink->provided_clock), 0);
       rb = gst_audio_base_sink_create_ringbuffer (sink);
@@ -2425,8 +2650,12 @@ gst_audio_base_sink_change_state (GstElement * element,
 
       GST_OBJECT_LOCK (sink);
       sink->ringbuffer = rb;
+      spsc = sink->priv->spsc;
       GST_OBJECT_UNLOCK (sink);
 
+      if (spsc)
+        gst_audio_ring_buffer_set_spsc (rb, TRUE);
+
       if (!gst_audio_ring_buffer_open_device (sink->ringbuffer)) {
         GST_OBJECT_LOCK (sink);
         gst_object_unparent (GST_OBJECT_CAST (sink->ringbuffer));
@@ -2438,6 +2667,7 @@ gst_audio_base_sink_change_state (GstElement * element,
     }
     case GST_STATE_CHANGE_READY_TO_PAUSED:
       gst_audio_base_sink_reset_sync (sink);
+      gst_audio_base_sink_reset_stats (sink);
       gst_audio_ring_buffer_set_flushing (sink->ringbuffer, FALSE);
       gst_audio_ring_buffer_may_start (sink->ringbuffer, FALSE);
 
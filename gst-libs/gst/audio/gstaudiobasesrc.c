@@ -74,6 +74,16 @@ struct _GstAudioBaseSrcPrivate
 {
   /* the clock slaving algorithm in use */
   GstAudioBaseSrcSlaveMethod slave_method;
+
+  /* put the ringbuffer in SPSC mode */
+  gboolean spsc;
+
+  /* statistics, protected by the object lock */
+  guint64 stats_dropped;
+  guint stats_resyncs;
+  guint stats_skew_corrections;
+  GstClockTime stats_skew_correction;
+  guint stats_fill[4];
 };
 
 /* BaseAudioSrc signals and args */
@@ -90,6 +100,7 @@ enum
 #define DEFAULT_ACTUAL_LATENCY_TIME    -1
 #define DEFAULT_PROVIDE_CLOCK   TRUE
 #define DEFAULT_SLAVE_METHOD    GST_AUDIO_BASE_SRC_SLAVE_SKEW
+#define DEFAULT_SPSC            FALSE
 
 enum
 {
@@ -100,6 +111,8 @@ enum
   PROP_ACTUAL_LATENCY_TIME,
   PROP_PROVIDE_CLOCK,
   PROP_SLAVE_METHOD,
+  PROP_SPSC,
+  PROP_STATS,
   PROP_LAST
 };
 
@@ -215,6 +228,70 @@ gst_audio_base_src_class_init (GstAudioBaseSrcClass * klass)
           GST_TYPE_AUDIO_BASE_SRC_SLAVE_METHOD, DEFAULT_SLAVE_METHOD,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioBaseSrc:spsc:
+   *
+   * Put the ringbuffer in single producer, single consumer mode when it is
+   * created, see gst_audio_ring_buffer_set_spsc(). The element must then be
+   * the only reader of the ringbuffer and the device the only writer. Only
+   * has an effect when set before the element goes to READY.
+   *
+   * Since: 1.8
+   */
+  g_object_class_install_property (gobject_class, PROP_SPSC,
+      g_param_spec_boolean ("spsc", "Single producer, single consumer",
+          "Don't lock the ringbuffer when waiting for data, the element "
+          "must be the only reader", DEFAULT_SPSC,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAudioBaseSrc:stats:
+   *
+   * Various statistics about glitches in the captured audio. This property
+   * returns a #GstStructure with name application/x-audio-base-src-stats
+   * with the following fields:
+   *
+   * <variablelist>
+   * <varlistentry>
+   *   <term>dropped</term>
+   *   <listitem><para>#G_TYPE_UINT64, the number of samples that were
+   *   overwritten in the ringbuffer before they could be read.</para>
+   *   </listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>resyncs</term>
+   *   <listitem><para>#G_TYPE_UINT, the number of times the read pointer
+   *   was moved to resynchronise with the clock.</para></listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>skew-corrections</term>
+   *   <listitem><para>#G_TYPE_UINT, the number of times the clock slaving
+   *   corrected the skew.</para></listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>skew-correction</term>
+   *   <listitem><para>#G_TYPE_UINT64, the total absolute amount of skew
+   *   correction in nanoseconds.</para></listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>fill-histogram</term>
+   *   <listitem><para>#GST_TYPE_ARRAY of 4 #G_TYPE_UINT, how often the
+   *   ringbuffer was filled to 0-25%, 25-50%, 50-75% and 75-100% when
+   *   samples were read from it.</para></listitem>
+   * </varlistentry>
+   * <varlistentry>
+   *   <term>delay</term>
+   *   <listitem><para>#G_TYPE_UINT, the number of samples queued in the
+   *   device as reported by gst_audio_ring_buffer_delay().</para></listitem>
+   * </varlistentry>
+   * </variablelist>
+   *
+   * Since: 1.8
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics", "Various statistics",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_audio_base_src_change_state);
   gstelement_class->provide_clock =
@@ -248,6 +325,7 @@ gst_audio_base_src_init (GstAudioBaseSrc * audiobasesrc)
   else
     GST_OBJECT_FLAG_UNSET (audiobasesrc, GST_ELEMENT_FLAG_PROVIDE_CLOCK);
   audiobasesrc->priv->slave_method = DEFAULT_SLAVE_METHOD;
+  audiobasesrc->priv->spsc = DEFAULT_SPSC;
   /* reset blocksize we use latency time to calculate a more useful
    * value based on negotiated format. */
   GST_BASE_SRC (audiobasesrc)->blocksize = 0;
@@ -461,12 +539,88 @@ gst_audio_base_src_set_property (GObject * object, guint prop_id,
     case PROP_SLAVE_METHOD:
       gst_audio_base_src_set_slave_method (src, g_value_get_enum (value));
       break;
+    case PROP_SPSC:
+      GST_OBJECT_LOCK (src);
+      src->priv->spsc = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (src);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+static void
+gst_audio_base_src_reset_stats (GstAudioBaseSrc * src)
+{
+  GstAudioBaseSrcPrivate *priv = src->priv;
+
+  GST_OBJECT_LOCK (src);
+  priv->stats_dropped = 0;
+  priv->stats_resyncs = 0;
+  priv->stats_skew_corrections = 0;
+  priv->stats_skew_correction = 0;
+  memset (priv->stats_fill, 0, sizeof (priv->stats_fill));
+  GST_OBJECT_UNLOCK (src);
+}
+
+/* must be called with the object lock */
+static void
+gst_audio_base_src_update_fill (GstAudioBaseSrc * src, gint64 fill)
+{
+  GstAudioBaseSrcPrivate *priv = src->priv;
+  GstAudioRingBuffer *ringbuf = src->ringbuffer;
+  gint64 total;
+  guint idx;
+
+  total = (gint64) ringbuf->spec.segtotal * ringbuf->samples_per_seg;
+  if (total <= 0)
+    return;
+
+  /* no data available yet means we are waiting for the device */
+  if (fill < 0)
+    fill = 0;
+
+  idx = MIN (fill * G_N_ELEMENTS (priv->stats_fill) / total,
+      G_N_ELEMENTS (priv->stats_fill) - 1);
+  priv->stats_fill[idx]++;
+}
+
+static GstStructure *
+gst_audio_base_src_create_stats (GstAudioBaseSrc * src)
+{
+  GstAudioBaseSrcPrivate *priv = src->priv;
+  GstStructure *s;
+  GValue fill = G_VALUE_INIT;
+  GValue v = G_VALUE_INIT;
+  guint delay = 0;
+  guint i;
+
+  if (src->ringbuffer && gst_audio_ring_buffer_is_acquired (src->ringbuffer))
+    delay = gst_audio_ring_buffer_delay (src->ringbuffer);
+
+  g_value_init (&fill, GST_TYPE_ARRAY);
+  g_value_init (&v, G_TYPE_UINT);
+
+  GST_OBJECT_LOCK (src);
+  for (i = 0; i < G_N_ELEMENTS (priv->stats_fill); i++) {
+    g_value_set_uint (&v, priv->stats_fill[i]);
+    gst_value_array_append_value (&fill, &v);
+  }
+  s = gst_structure_new ("application/x-audio-base-src-stats",
+      "dropped", G_TYPE_UINT64, priv->stats_dropped,
+      "resyncs", G_TYPE_UINT, priv->stats_resyncs,
+      "skew-corrections", G_TYPE_UINT, priv->stats_skew_corrections,
+      "skew-correction", G_TYPE_UINT64, priv->stats_skew_correction,
+      "delay", G_TYPE_UINT, delay, NULL);
+  GST_OBJECT_UNLOCK (src);
+
+  gst_structure_take_value (s, "fill-histogram", &fill);
+  g_value_unset (&v);
+
+  return s;
+}
+
 static void
 gst_audio_base_src_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec)
@@ -504,6 +658,14 @@ gst_audio_base_src_get_property (GObject * object, guint prop_id,
     case PROP_SLAVE_METHOD:
       g_value_set_enum (value, gst_audio_base_src_get_slave_method (src));
       break;
+    case PROP_SPSC:
+      GST_OBJECT_LOCK (src);
+      g_value_set_boolean (value, src->priv->spsc);
+      GST_OBJECT_UNLOCK (src);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, gst_audio_base_src_create_stats (src));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -817,6 +979,13 @@ gst_audio_base_src_create (GstBaseSrc * bsrc, guint64 offset, guint length,
   /* get the number of samples to read */
   total_samples = samples = length / bpf;
 
+  /* keep track of how much data the device had captured for us */
+  GST_OBJECT_LOCK (src);
+  gst_audio_base_src_update_fill (src,
+      (gint64) (g_atomic_int_get (&ringbuffer->segdone) -
+          ringbuffer->segbase) * ringbuffer->samples_per_seg - (gint64) sample);
+  GST_OBJECT_UNLOCK (src);
+
   /* use the basesrc allocation code to use bufferpools or custom allocators */
   ret = GST_BASE_SRC_CLASS (parent_class)->alloc (bsrc, offset, length, &buf);
   if (G_UNLIKELY (ret != GST_FLOW_OK))
@@ -868,6 +1037,12 @@ gst_audio_base_src_create (GstBaseSrc * bsrc, guint64 offset, guint length,
             "downstream can't keep up and is consuming samples too slowly.",
             sample - src->next_sample));
     GST_BUFFER_FLAG_SET (buf, GST_BUFFER_FLAG_DISCONT);
+
+    if (sample > src->next_sample) {
+      GST_OBJECT_LOCK (src);
+      src->priv->stats_dropped += sample - src->next_sample;
+      GST_OBJECT_UNLOCK (src);
+    }
   }
 
   src->next_sample = sample + samples;
@@ -984,6 +1159,16 @@ gst_audio_base_src_create (GstBaseSrc * bsrc, guint64 offset, guint length,
           /* we update the next sample accordingly */
           src->next_sample = new_sample + samples;
 
+          /* catching up with the running time on the first buffer is not a
+           * correction */
+          if (!first_sample && last_read_segment != 0 && segment_diff != 0) {
+            src->priv->stats_resyncs++;
+            src->priv->stats_skew_corrections++;
+            src->priv->stats_skew_correction +=
+                gst_util_uint64_scale_int (ABS (segment_diff) * (guint64) sps,
+                GST_SECOND, rate);
+          }
+
           GST_DEBUG_OBJECT (bsrc,
               "Timeshifted the ringbuffer with %d segments: "
               "Updating the timestamp to %" GST_TIME_FORMAT ", "
@@ -1132,6 +1317,7 @@ gst_audio_base_src_change_state (GstElement * element,
   switch (transition) {
     case GST_STATE_CHANGE_NULL_TO_READY:{
       GstAudioRingBuffer *rb;
+      gboolean spsc;
 
       GST_DEBUG_OBJECT (src, "NULL->READY");
       gst_audio_clock_reset (GST_AUDIO_CLOCK (src->clock), 0);
@@ -1141,8 +1327,12 @@ gst_audio_base_src_change_state (GstElement * element,
 
       GST_OBJECT_LOCK (src);
       src->ringbuffer = rb;
+      spsc = src->priv->spsc;
       GST_OBJECT_UNLOCK (src);
 
+      if (spsc)
+        gst_audio_ring_buffer_set_spsc (rb, TRUE);
+
       if (!gst_audio_ring_buffer_open_device (src->ringbuffer)) {
         GST_OBJECT_LOCK (src);
         gst_object_unparent (GST_OBJECT_CAST (src->ringbuffer));
@@ -1155,6 +1345,7 @@ gst_audio_base_src_change_state (GstElement * element,
     case GST_STATE_CHANGE_READY_TO_PAUSED:
       GST_DEBUG_OBJECT (src, "READY->PAUSED");
       src->next_sample = -1;
+      gst_audio_base_src_reset_stats (src);
       gst_audio_ring_buffer_set_flushing (src->ringbuffer, FALSE);
       gst_audio_ring_buffer_may_start (src->ringbuffer, FALSE);
       /* Only post clock-provide messages if this is the clock that
@@ -171,7 +171,8 @@ enum
   PROP_0,
   PROP_LATENCY,
   PROP_TOLERANCE,
-  PROP_PLC
+  PROP_PLC,
+  PROP_ALLOCATIONS
 };
 
 #define DEFAULT_LATENCY    0
@@ -179,6 +180,7 @@ enum
 #define DEFAULT_PLC        FALSE
 #define DEFAULT_DRAINABLE  TRUE
 #define DEFAULT_NEEDS_FORMAT  FALSE
+#define DEFAULT_BYPASS_ADAPTER  FALSE
 
 typedef struct _GstAudioDecoderContext
 {
@@ -209,6 +211,9 @@ typedef struct _GstAudioDecoderContext
 
   GstAllocator *allocator;
   GstAllocationParams params;
+  /* output buffer pool, configured on first allocation */
+  GstBufferPool *pool;
+  gsize pool_size;
 } GstAudioDecoderContext;
 
 struct _GstAudioDecoderPrivate
@@ -226,6 +231,10 @@ struct _GstAudioDecoderPrivate
   /* tracking input ts for changes */
   GstClockTime prev_ts;
   guint64 prev_distance;
+  /* input ts and distance when bypassing the adapter, as the adapter would
+   * have reported them */
+  GstClockTime in_ts;
+  guint64 in_distance;
   /* frames obtained from input */
   GQueue frames;
   /* collected output data */
@@ -282,12 +291,16 @@ struct _GstAudioDecoderPrivate
   gboolean plc;
   gboolean drainable;
   gboolean needs_format;
+  gboolean bypass_adapter;
 
   /* pending serialized sink events, will be sent from finish_frame() */
   GList *pending_events;
 
   /* flags */
   gboolean use_default_pad_acceptcaps;
+
+  /* buffers allocated outside of a pool while streaming, atomic */
+  gint allocations;
 };
 
 static void gst_audio_decoder_finalize (GObject * object);
@@ -412,6 +425,23 @@ gst_audio_decoder_class_init (GstAudioDecoderClass * klass)
           "Perform packet loss concealment (if supported)",
           DEFAULT_PLC, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioDecoder:allocations:
+   *
+   * The number of buffers the base class had to allocate while streaming
+   * because they could not be taken from a buffer pool or passed through
+   * without copying, plus the number of times the output buffer pool had to
+   * be reconfigured and dropped its buffers. This is reset when the decoder
+   * is started and meant for catching regressions in the steady state
+   * allocation behaviour.
+   *
+   * Since: 1.8
+   */
+  g_object_class_install_property (gobject_class, PROP_ALLOCATIONS,
+      g_param_spec_uint ("allocations", "Allocations",
+          "Number of buffers allocated while streaming", 0, G_MAXUINT, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   audiodecoder_class->sink_event =
       GST_DEBUG_FUNCPTR (gst_audio_decoder_sink_eventfunc);
   audiodecoder_class->src_event =
@@ -479,6 +509,7 @@ gst_audio_decoder_init (GstAudioDecoder * dec, GstAudioDecoderClass * klass)
   dec->priv->plc = DEFAULT_PLC;
   dec->priv->drainable = DEFAULT_DRAINABLE;
   dec->priv->needs_format = DEFAULT_NEEDS_FORMAT;
+  dec->priv->bypass_adapter = DEFAULT_BYPASS_ADAPTER;
 
   /* init state */
   dec->priv->ctx.min_latency = 0;
@@ -500,6 +531,7 @@ gst_audio_decoder_reset (GstAudioDecoder * dec, gboolean full)
     dec->priv->samples_out = 0;
     dec->priv->agg = -1;
     dec->priv->error_count = 0;
+    g_atomic_int_set (&dec->priv->allocations, 0);
     gst_audio_decoder_clear_queues (dec);
 
     if (dec->priv->taglist) {
@@ -523,6 +555,10 @@ gst_audio_decoder_reset (GstAudioDecoder * dec, gboolean full)
 
     if (dec->priv->ctx.allocator)
       gst_object_unref (dec->priv->ctx.allocator);
+    if (dec->priv->ctx.pool) {
+      gst_buffer_pool_set_active (dec->priv->ctx.pool, FALSE);
+      gst_object_unref (dec->priv->ctx.pool);
+    }
 
     gst_caps_replace (&dec->priv->ctx.input_caps, NULL);
 
@@ -542,6 +578,8 @@ gst_audio_decoder_reset (GstAudioDecoder * dec, gboolean full)
   dec->priv->out_dur = 0;
   dec->priv->prev_ts = GST_CLOCK_TIME_NONE;
   dec->priv->prev_distance = 0;
+  dec->priv->in_ts = GST_CLOCK_TIME_NONE;
+  dec->priv->in_distance = 0;
   dec->priv->drained = TRUE;
   dec->priv->base_ts = GST_CLOCK_TIME_NONE;
   dec->priv->samples = 0;
@@ -632,6 +670,8 @@ gst_audio_decoder_negotiate_default (GstAudioDecoder * dec)
   GstQuery *query = NULL;
   GstAllocator *allocator;
   GstAllocationParams params;
+  GstBufferPool *pool = NULL;
+  guint size = 0, min = 0, max = 0;
 
   g_return_val_if_fail (GST_IS_AUDIO_DECODER (dec), FALSE);
   g_return_val_if_fail (GST_AUDIO_INFO_IS_VALID (&dec->priv->ctx.info), FALSE);
@@ -696,11 +736,35 @@ gst_audio_decoder_negotiate_default (GstAudioDecoder * dec)
     gst_allocation_params_init (&params);
   }
 
+  if (gst_query_get_n_allocation_pools (query) > 0)
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+
   if (dec->priv->ctx.allocator)
     gst_object_unref (dec->priv->ctx.allocator);
   dec->priv->ctx.allocator = allocator;
   dec->priv->ctx.params = params;
 
+  /* release the buffers of the old pool, the new one is activated once we
+   * know the frame size */
+  if (dec->priv->ctx.pool) {
+    GST_DEBUG_OBJECT (dec, "unref pool %" GST_PTR_FORMAT, dec->priv->ctx.pool);
+    gst_buffer_pool_set_active (dec->priv->ctx.pool, FALSE);
+    gst_object_unref (dec->priv->ctx.pool);
+  }
+
+  if (pool) {
+    GstStructure *config;
+
+    /* the size is updated once we know the frame size, the caps and the
+     * limits negotiated with downstream are kept */
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_set_params (config, caps, size, min, max);
+    if (!gst_buffer_pool_set_config (pool, config))
+      GST_DEBUG_OBJECT (dec, "pool refused configuration");
+  }
+  dec->priv->ctx.pool = pool;
+  dec->priv->ctx.pool_size = 0;
+
 done:
 
   if (query)
@@ -1037,6 +1101,8 @@ again:
     if (av && assemble) {
       GST_LOG_OBJECT (dec, "assembling fragment");
       inbuf = buf;
+      if ((gsize) av > gst_adapter_available_fast (priv->adapter_out))
+        g_atomic_int_inc (&priv->allocations);
       buf = gst_adapter_take_buffer (priv->adapter_out, av);
       GST_BUFFER_TIMESTAMP (buf) = priv->out_ts;
       GST_BUFFER_DURATION (buf) = priv->out_dur;
@@ -1452,6 +1518,47 @@ gst_audio_decoder_handle_frame (GstAudioDecoder * dec,
   return klass->handle_frame (dec, buffer);
 }
 
+/* hands a single input buffer to the subclass, bypassing the adapter */
+static GstFlowReturn
+gst_audio_decoder_push_frame (GstAudioDecoder * dec, GstBuffer * buffer)
+{
+  GstAudioDecoderClass *klass = GST_AUDIO_DECODER_GET_CLASS (dec);
+  GstAudioDecoderPrivate *priv = dec->priv;
+  GstClockTime ts;
+  guint64 distance;
+
+  g_return_val_if_fail (klass->handle_frame != NULL, GST_FLOW_ERROR);
+
+  GST_LOG_OBJECT (dec, "pushing %" G_GSIZE_FORMAT " bytes without adapter",
+      gst_buffer_get_size (buffer));
+
+  buffer = gst_buffer_make_writable (buffer);
+
+  /* same ts and distance as gst_adapter_prev_pts() would report, i.e. the
+   * last valid upstream ts and the number of bytes since */
+  if (GST_BUFFER_TIMESTAMP_IS_VALID (buffer)) {
+    priv->in_ts = GST_BUFFER_TIMESTAMP (buffer);
+    priv->in_distance = 0;
+  }
+  ts = priv->in_ts;
+  distance = priv->in_distance;
+  priv->in_distance += gst_buffer_get_size (buffer);
+
+  /* track upstream ts, but do not get stuck if nothing new upstream */
+  if (ts != priv->prev_ts || distance <= priv->prev_distance) {
+    priv->prev_ts = ts;
+    priv->prev_distance = distance;
+    GST_BUFFER_TIMESTAMP (buffer) = ts;
+  } else {
+    GST_LOG_OBJECT (dec, "ts == prev_ts; discarding");
+    GST_BUFFER_TIMESTAMP (buffer) = GST_CLOCK_TIME_NONE;
+  }
+  priv->ctx.eos = FALSE;
+  priv->force = FALSE;
+
+  return gst_audio_decoder_handle_frame (dec, klass, buffer);
+}
+
 /* maybe subclass configurable instead, but this allows for a whole lot of
  * raw samples, so at least quite some encoded ... */
 #define GST_AUDIO_DECODER_MAX_SYNC     10 * 8 * 2 * 1024
@@ -1531,6 +1638,10 @@ gst_audio_decoder_push_buffers (GstAudioDecoder * dec, gboolean force)
         GST_LOG_OBJECT (dec, "ts == prev_ts; discarding");
         ts = GST_CLOCK_TIME_NONE;
       }
+      /* frames spanning several input buffers need to be merged */
+      if (G_UNLIKELY ((gsize) len >
+              gst_adapter_available_fast (priv->adapter)))
+        g_atomic_int_inc (&priv->allocations);
       buffer = gst_adapter_take_buffer (priv->adapter, len);
       buffer = gst_buffer_make_writable (buffer);
       GST_BUFFER_TIMESTAMP (buffer) = ts;
@@ -1610,6 +1721,8 @@ drain_failed:
 
   /* discard (unparsed) leftover */
   gst_adapter_clear (dec->priv->adapter);
+  dec->priv->in_ts = GST_CLOCK_TIME_NONE;
+  dec->priv->in_distance = 0;
   return ret;
 }
 
@@ -1654,11 +1767,20 @@ gst_audio_decoder_chain_forward (GstAudioDecoder * dec, GstBuffer * buffer)
     goto exit;
   }
 
+  /* new stuff, so we can push subclass again */
+  dec->priv->drained = FALSE;
+
+  /* subclass handles each input buffer as one frame; when nothing is
+   * pending in the adapter it can be handed to the subclass directly */
+  if (dec->priv->bypass_adapter && !GST_AUDIO_DECODER_GET_CLASS (dec)->parse
+      && gst_adapter_available (dec->priv->adapter) == 0) {
+    ret = gst_audio_decoder_push_frame (dec, buffer);
+    goto exit;
+  }
+
   /* grab buffer */
   gst_adapter_push (dec->priv->adapter, buffer);
   buffer = NULL;
-  /* new stuff, so we can push subclass again */
-  dec->priv->drained = FALSE;
 
   /* hand to subclass */
   ret = gst_audio_decoder_push_buffers (dec, FALSE);
@@ -2478,7 +2600,9 @@ gst_audio_decoder_decide_allocation_default (GstAudioDecoder * dec,
 {
   GstAllocator *allocator = NULL;
   GstAllocationParams params;
-  gboolean update_allocator;
+  GstBufferPool *pool = NULL;
+  guint size, min, max;
+  gboolean update_allocator, update_pool;
 
   /* we got configuration from our peer or the decide_allocation method,
    * parse them */
@@ -2492,6 +2616,22 @@ gst_audio_decoder_decide_allocation_default (GstAudioDecoder * dec,
     update_allocator = FALSE;
   }
 
+  if (gst_query_get_n_allocation_pools (query) > 0) {
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+    update_pool = TRUE;
+  } else {
+    size = min = max = 0;
+    update_pool = FALSE;
+  }
+
+  if (pool == NULL) {
+    /* no pool, we can make our own. The size of the decoded frames is not
+     * known yet, the pool is configured when the first buffer is
+     * allocated */
+    GST_DEBUG_OBJECT (dec, "no pool, making new pool");
+    pool = __gst_audio_frame_pool_new ();
+  }
+
   if (update_allocator)
     gst_query_set_nth_allocation_param (query, 0, allocator, &params);
   else
@@ -2499,6 +2639,12 @@ gst_audio_decoder_decide_allocation_default (GstAudioDecoder * dec,
   if (allocator)
     gst_object_unref (allocator);
 
+  if (update_pool)
+    gst_query_set_nth_allocation_pool (query, 0, pool, size, min, max);
+  else
+    gst_query_add_allocation_pool (query, pool, size, min, max);
+  gst_object_unref (pool);
+
   return TRUE;
 }
 
@@ -2943,6 +3089,10 @@ gst_audio_decoder_get_property (GObject * object, guint prop_id,
     case PROP_PLC:
       g_value_set_boolean (value, dec->priv->plc);
       break;
+    case PROP_ALLOCATIONS:
+      g_value_set_uint (value,
+          (guint) g_atomic_int_get (&dec->priv->allocations));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -3433,6 +3583,57 @@ gst_audio_decoder_get_drainable (GstAudioDecoder * dec)
   return result;
 }
 
+/**
+ * gst_audio_decoder_set_bypass_adapter:
+ * @dec: a #GstAudioDecoder
+ * @enabled: new state
+ *
+ * Configures decoder input handling.  If enabled, and the subclass has no
+ * @parse vfunc, each input buffer is considered a single frame and is
+ * passed to @handle_frame as is, instead of being collected in an adapter
+ * first.  Otherwise, input is always collected in an adapter and handed
+ * to the subclass in whatever chunks are available.
+ *
+ * MT safe.
+ *
+ * Since: 1.8
+ */
+void
+gst_audio_decoder_set_bypass_adapter (GstAudioDecoder * dec, gboolean enabled)
+{
+  g_return_if_fail (GST_IS_AUDIO_DECODER (dec));
+
+  GST_OBJECT_LOCK (dec);
+  dec->priv->bypass_adapter = enabled;
+  GST_OBJECT_UNLOCK (dec);
+}
+
+/**
+ * gst_audio_decoder_get_bypass_adapter:
+ * @dec: a #GstAudioDecoder
+ *
+ * Queries decoder input handling.
+ *
+ * Returns: TRUE if input buffers are passed to the subclass without adapter.
+ *
+ * MT safe.
+ *
+ * Since: 1.8
+ */
+gboolean
+gst_audio_decoder_get_bypass_adapter (GstAudioDecoder * dec)
+{
+  gboolean result;
+
+  g_return_val_if_fail (GST_IS_AUDIO_DECODER (dec), 0);
+
+  GST_OBJECT_LOCK (dec);
+  result = dec->priv->bypass_adapter;
+  GST_OBJECT_UNLOCK (dec);
+
+  return result;
+}
+
 /**
  * gst_audio_decoder_set_needs_format:
  * @dec: a #GstAudioDecoder
@@ -3526,7 +3727,8 @@ gst_audio_decoder_merge_tags (GstAudioDecoder * dec,
  * @size: size of the buffer
  *
  * Helper function that allocates a buffer to hold an audio frame
- * for @dec's current output format.
+ * for @dec's current output format. The buffer is taken from the negotiated
+ * buffer pool when there is one, so that output buffers are recycled.
  *
  * Returns: (transfer full): allocated buffer
  */
@@ -3553,6 +3755,18 @@ gst_audio_decoder_allocate_output_buffer (GstAudioDecoder * dec, gsize size)
     }
   }
 
+  if (G_LIKELY (dec->priv->ctx.pool)) {
+    buffer = __gst_audio_frame_pool_acquire (GST_ELEMENT_CAST (dec),
+        &dec->priv->ctx.pool, &dec->priv->ctx.pool_size,
+        dec->priv->ctx.allocator, &dec->priv->ctx.params, size,
+        &dec->priv->allocations);
+    if (G_LIKELY (buffer)) {
+      GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
+      return buffer;
+    }
+    GST_INFO_OBJECT (dec, "couldn't acquire output buffer from pool");
+  }
+
   buffer =
       gst_buffer_new_allocate (dec->priv->ctx.allocator, size,
       &dec->priv->ctx.params);
@@ -3560,11 +3774,13 @@ gst_audio_decoder_allocate_output_buffer (GstAudioDecoder * dec, gsize size)
     GST_INFO_OBJECT (dec, "couldn't allocate output buffer");
     goto fallback;
   }
+  g_atomic_int_inc (&dec->priv->allocations);
 
   GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
 
   return buffer;
 fallback:
+  g_atomic_int_inc (&dec->priv->allocations);
   buffer = gst_buffer_new_allocate (NULL, size, NULL);
   GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
 
@@ -387,6 +387,11 @@ void              gst_audio_decoder_set_needs_format (GstAudioDecoder * dec,
 
 gboolean          gst_audio_decoder_get_needs_format (GstAudioDecoder * dec);
 
+void              gst_audio_decoder_set_bypass_adapter (GstAudioDecoder * dec,
+                                                        gboolean enabled);
+
+gboolean          gst_audio_decoder_get_bypass_adapter (GstAudioDecoder * dec);
+
 void              gst_audio_decoder_get_allocator (GstAudioDecoder * dec,
                                                    GstAllocator ** allocator,
                                                    GstAllocationParams * params);
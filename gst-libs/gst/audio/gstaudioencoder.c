@@ -174,7 +174,8 @@ enum
   PROP_PERFECT_TS,
   PROP_GRANULE,
   PROP_HARD_RESYNC,
-  PROP_TOLERANCE
+  PROP_TOLERANCE,
+  PROP_ALLOCATIONS
 };
 
 #define DEFAULT_PERFECT_TS   FALSE
@@ -207,6 +208,9 @@ typedef struct _GstAudioEncoderContext
 
   GstAllocator *allocator;
   GstAllocationParams params;
+  /* output buffer pool, configured on first allocation */
+  GstBufferPool *pool;
+  gsize pool_size;
 } GstAudioEncoderContext;
 
 struct _GstAudioEncoderPrivate
@@ -269,6 +273,9 @@ struct _GstAudioEncoderPrivate
 
   /* pending serialized sink events, will be sent from finish_frame() */
   GList *pending_events;
+
+  /* buffers allocated outside of a pool while streaming, atomic */
+  gint allocations;
 };
 
 
@@ -397,6 +404,22 @@ gst_audio_encoder_class_init (GstAudioEncoderClass * klass)
           0, G_MAXINT64, DEFAULT_TOLERANCE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioEncoder:allocations:
+   *
+   * The number of buffers the base class had to allocate while streaming
+   * because they could not be taken from a buffer pool or passed through
+   * without copying, plus the number of times the output buffer pool had to
+   * be reconfigured and dropped its buffers. This is reset when the encoder is started and meant
+   * for catching regressions in the steady state allocation behaviour.
+   *
+   * Since: 1.8
+   */
+  g_object_class_install_property (gobject_class, PROP_ALLOCATIONS,
+      g_param_spec_uint ("allocations", "Allocations",
+          "Number of buffers allocated while streaming", 0, G_MAXUINT, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_audio_encoder_change_state);
 
@@ -480,6 +503,7 @@ gst_audio_encoder_reset (GstAudioEncoder * enc, gboolean full)
     enc->priv->active = FALSE;
     enc->priv->samples_in = 0;
     enc->priv->bytes_out = 0;
+    g_atomic_int_set (&enc->priv->allocations, 0);
 
     g_list_foreach (enc->priv->ctx.headers, (GFunc) gst_buffer_unref, NULL);
     g_list_free (enc->priv->ctx.headers);
@@ -489,6 +513,10 @@ gst_audio_encoder_reset (GstAudioEncoder * enc, gboolean full)
     if (enc->priv->ctx.allocator)
       gst_object_unref (enc->priv->ctx.allocator);
     enc->priv->ctx.allocator = NULL;
+    if (enc->priv->ctx.pool) {
+      gst_buffer_pool_set_active (enc->priv->ctx.pool, FALSE);
+      gst_object_unref (enc->priv->ctx.pool);
+    }
 
     gst_caps_replace (&enc->priv->ctx.input_caps, NULL);
     gst_caps_replace (&enc->priv->ctx.caps, NULL);
@@ -1048,6 +1076,7 @@ gst_audio_encoder_push_buffers (GstAudioEncoder * enc, gboolean force)
   GstAudioEncoderContext *ctx;
   gint av, need;
   GstBuffer *buf;
+  gboolean mapped;
   GstFlowReturn ret = GST_FLOW_OK;
 
   klass = GST_AUDIO_ENCODER_GET_CLASS (enc);
@@ -1098,13 +1127,23 @@ gst_audio_encoder_push_buffers (GstAudioEncoder * enc, gboolean force)
     }
 
     priv->got_data = FALSE;
+    mapped = FALSE;
     if (G_LIKELY (need)) {
       const guint8 *data;
 
-      data = gst_adapter_map (priv->adapter, priv->offset + need);
-      buf =
-          gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY,
-          (gpointer) data, priv->offset + need, priv->offset, need, NULL, NULL);
+      if (priv->offset == 0 &&
+          gst_adapter_available_fast (priv->adapter) == (gsize) need) {
+        /* the frame is exactly the first input buffer, pass it on as is */
+        buf = gst_adapter_get_buffer (priv->adapter, need);
+      } else {
+        data = gst_adapter_map (priv->adapter, priv->offset + need);
+        buf =
+            gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY,
+            (gpointer) data, priv->offset + need, priv->offset, need, NULL,
+            NULL);
+        g_atomic_int_inc (&priv->allocations);
+        mapped = TRUE;
+      }
     } else if (!priv->drainable) {
       GST_DEBUG_OBJECT (enc, "non-drainable and no more data");
       goto finish;
@@ -1129,7 +1168,8 @@ gst_audio_encoder_push_buffers (GstAudioEncoder * enc, gboolean force)
 
     if (G_LIKELY (buf)) {
       gst_buffer_unref (buf);
-      gst_adapter_unmap (priv->adapter);
+      if (mapped)
+        gst_adapter_unmap (priv->adapter);
     }
 
   finish:
@@ -1815,7 +1855,9 @@ gst_audio_encoder_decide_allocation_default (GstAudioEncoder * enc,
 {
   GstAllocator *allocator = NULL;
   GstAllocationParams params;
-  gboolean update_allocator;
+  GstBufferPool *pool = NULL;
+  guint size, min, max;
+  gboolean update_allocator, update_pool;
 
   /* we got configuration from our peer or the decide_allocation method,
    * parse them */
@@ -1829,6 +1871,22 @@ gst_audio_encoder_decide_allocation_default (GstAudioEncoder * enc,
     update_allocator = FALSE;
   }
 
+  if (gst_query_get_n_allocation_pools (query) > 0) {
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+    update_pool = TRUE;
+  } else {
+    size = min = max = 0;
+    update_pool = FALSE;
+  }
+
+  if (pool == NULL) {
+    /* no pool, we can make our own. The size of the encoded frames is not
+     * known yet, the pool is configured when the first buffer is
+     * allocated */
+    GST_DEBUG_OBJECT (enc, "no pool, making new pool");
+    pool = __gst_audio_frame_pool_new ();
+  }
+
   if (update_allocator)
     gst_query_set_nth_allocation_param (query, 0, allocator, &params);
   else
@@ -1836,6 +1894,12 @@ gst_audio_encoder_decide_allocation_default (GstAudioEncoder * enc,
   if (allocator)
     gst_object_unref (allocator);
 
+  if (update_pool)
+    gst_query_set_nth_allocation_pool (query, 0, pool, size, min, max);
+  else
+    gst_query_add_allocation_pool (query, pool, size, min, max);
+  gst_object_unref (pool);
+
   return TRUE;
 }
 
@@ -2094,6 +2158,10 @@ gst_audio_encoder_get_property (GObject * object, guint prop_id,
     case PROP_TOLERANCE:
       g_value_set_int64 (value, enc->priv->tolerance);
       break;
+    case PROP_ALLOCATIONS:
+      g_value_set_uint (value,
+          (guint) g_atomic_int_get (&enc->priv->allocations));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2695,6 +2763,8 @@ gst_audio_encoder_negotiate_default (GstAudioEncoder * enc)
   GstQuery *query = NULL;
   GstAllocator *allocator;
   GstAllocationParams params;
+  GstBufferPool *pool = NULL;
+  guint size = 0, min = 0, max = 0;
   GstCaps *caps, *prevcaps;
 
   g_return_val_if_fail (GST_IS_AUDIO_ENCODER (enc), FALSE);
@@ -2760,11 +2830,35 @@ gst_audio_encoder_negotiate_default (GstAudioEncoder * enc)
     gst_allocation_params_init (&params);
   }
 
+  if (gst_query_get_n_allocation_pools (query) > 0)
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+
   if (enc->priv->ctx.allocator)
     gst_object_unref (enc->priv->ctx.allocator);
   enc->priv->ctx.allocator = allocator;
   enc->priv->ctx.params = params;
 
+  /* release the buffers of the old pool, the new one is activated once we
+   * know the frame size */
+  if (enc->priv->ctx.pool) {
+    GST_DEBUG_OBJECT (enc, "unref pool %" GST_PTR_FORMAT, enc->priv->ctx.pool);
+    gst_buffer_pool_set_active (enc->priv->ctx.pool, FALSE);
+    gst_object_unref (enc->priv->ctx.pool);
+  }
+
+  if (pool) {
+    GstStructure *config;
+
+    /* the size is updated once we know the frame size, the caps and the
+     * limits negotiated with downstream are kept */
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_set_params (config, caps, size, min, max);
+    if (!gst_buffer_pool_set_config (pool, config))
+      GST_DEBUG_OBJECT (enc, "pool refused configuration");
+  }
+  enc->priv->ctx.pool = pool;
+  enc->priv->ctx.pool_size = 0;
+
 done:
   if (query)
     gst_query_unref (query);
@@ -2875,7 +2969,8 @@ refuse_caps:
  * @size: size of the buffer
  *
  * Helper function that allocates a buffer to hold an encoded audio frame
- * for @enc's current output format.
+ * for @enc's current output format. The buffer is taken from the negotiated
+ * buffer pool when there is one, so that output buffers are recycled.
  *
  * Returns: (transfer full): allocated buffer
  */
@@ -2901,6 +2996,18 @@ gst_audio_encoder_allocate_output_buffer (GstAudioEncoder * enc, gsize size)
     }
   }
 
+  if (G_LIKELY (enc->priv->ctx.pool)) {
+    buffer = __gst_audio_frame_pool_acquire (GST_ELEMENT_CAST (enc),
+        &enc->priv->ctx.pool, &enc->priv->ctx.pool_size,
+        enc->priv->ctx.allocator, &enc->priv->ctx.params, size,
+        &enc->priv->allocations);
+    if (G_LIKELY (buffer)) {
+      GST_AUDIO_ENCODER_STREAM_UNLOCK (enc);
+      return buffer;
+    }
+    GST_INFO_OBJECT (enc, "couldn't acquire output buffer from pool");
+  }
+
   buffer =
       gst_buffer_new_allocate (enc->priv->ctx.allocator, size,
       &enc->priv->ctx.params);
@@ -2908,12 +3015,14 @@ gst_audio_encoder_allocate_output_buffer (GstAudioEncoder * enc, gsize size)
     GST_INFO_OBJECT (enc, "couldn't allocate output buffer");
     goto fallback;
   }
+  g_atomic_int_inc (&enc->priv->allocations);
 
   GST_AUDIO_ENCODER_STREAM_UNLOCK (enc);
 
   return buffer;
 
 fallback:
+  g_atomic_int_inc (&enc->priv->allocations);
   buffer = gst_buffer_new_allocate (NULL, size, NULL);
   GST_AUDIO_ENCODER_STREAM_UNLOCK (enc);
 
@@ -45,6 +45,40 @@
 GST_DEBUG_CATEGORY_STATIC (gst_audio_ring_buffer_debug);
 #define GST_CAT_DEFAULT gst_audio_ring_buffer_debug
 
+#define GST_AUDIO_RING_BUFFER_GET_PRIVATE(obj)  \
+   (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GST_TYPE_AUDIO_RING_BUFFER, GstAudioRingBufferPrivate))
+
+#define CACHE_LINE_SIZE 64
+
+/* SPSC mode: set while the reader or writer is blocked until segdone
+ * reaches wait_seg. wait_seg is a free running segment counter like
+ * segdone and can have any value, including 0.
+ *
+ * The device thread reads this on every gst_audio_ring_buffer_advance(), so
+ * it gets a cache line of its own, away from the wait lock that the blocked
+ * side takes. segdone itself is a public field of #GstAudioRingBuffer that
+ * subclasses read and write directly, it can't be moved to its own cache
+ * line and a padded private copy would have to be kept in sync with all of
+ * them. The write (playback) or read (capture) position is local to the
+ * element thread and is not shared. */
+typedef struct
+{
+  guint8 _pad0[CACHE_LINE_SIZE];
+  gint waiting;
+  gint wait_seg;
+  guint8 _pad1[CACHE_LINE_SIZE - 2 * sizeof (gint)];
+} RingBufferWaiter;
+
+struct _GstAudioRingBufferPrivate
+{
+  gboolean spsc;
+
+  RingBufferWaiter waiter;
+
+  GMutex wait_lock;
+  GCond wait_cond;
+};
+
 static void gst_audio_ring_buffer_dispose (GObject * object);
 static void gst_audio_ring_buffer_finalize (GObject * object);
 
@@ -52,6 +86,7 @@ static gboolean gst_audio_ring_buffer_pause_unlocked (GstAudioRingBuffer * buf);
 static void default_clear_all (GstAudioRingBuffer * buf);
 static guint default_commit (GstAudioRingBuffer * buf, guint64 * sample,
     guint8 * data, gint in_samples, gint out_samples, gint * accum);
+static void signal_spsc_waiter (GstAudioRingBuffer * buf);
 
 /* ringbuffer abstract base class */
 G_DEFINE_ABSTRACT_TYPE (GstAudioRingBuffer, gst_audio_ring_buffer,
@@ -69,6 +104,8 @@ gst_audio_ring_buffer_class_init (GstAudioRingBufferClass * klass)
   GST_DEBUG_CATEGORY_INIT (gst_audio_ring_buffer_debug, "ringbuffer", 0,
       "ringbuffer class");
 
+  g_type_class_add_private (klass, sizeof (GstAudioRingBufferPrivate));
+
   gobject_class->dispose = gst_audio_ring_buffer_dispose;
   gobject_class->finalize = gst_audio_ring_buffer_finalize;
 
@@ -79,6 +116,10 @@ gst_audio_ring_buffer_class_init (GstAudioRingBufferClass * klass)
 static void
 gst_audio_ring_buffer_init (GstAudioRingBuffer * ringbuffer)
 {
+  ringbuffer->priv = GST_AUDIO_RING_BUFFER_GET_PRIVATE (ringbuffer);
+  g_mutex_init (&ringbuffer->priv->wait_lock);
+  g_cond_init (&ringbuffer->priv->wait_cond);
+
   ringbuffer->open = FALSE;
   ringbuffer->acquired = FALSE;
   ringbuffer->state = GST_AUDIO_RING_BUFFER_STATE_STOPPED;
@@ -107,6 +148,8 @@ gst_audio_ring_buffer_finalize (GObject * object)
   GstAudioRingBuffer *ringbuffer = GST_AUDIO_RING_BUFFER (object);
 
   g_cond_clear (&ringbuffer->cond);
+  g_mutex_clear (&ringbuffer->priv->wait_lock);
+  g_cond_clear (&ringbuffer->priv->wait_cond);
   g_free (ringbuffer->empty_seg);
 
   G_OBJECT_CLASS (gst_audio_ring_buffer_parent_class)->finalize (G_OBJECT
@@ -692,6 +735,7 @@ gst_audio_ring_buffer_release (GstAudioRingBuffer * buf)
   /* signal any waiters */
   GST_DEBUG_OBJECT (buf, "signal waiter");
   GST_AUDIO_RING_BUFFER_SIGNAL (buf);
+  signal_spsc_waiter (buf);
 
   if (G_UNLIKELY (!res))
     goto release_failed;
@@ -890,6 +934,68 @@ gst_audio_ring_buffer_is_flushing (GstAudioRingBuffer * buf)
   return res;
 }
 
+/**
+ * gst_audio_ring_buffer_set_spsc:
+ * @buf: the #GstAudioRingBuffer to configure
+ * @spsc: the new mode
+ *
+ * Configure @buf for a single producer and a single consumer. Only one
+ * thread may then call gst_audio_ring_buffer_commit() or
+ * gst_audio_ring_buffer_read() and only one thread may call
+ * gst_audio_ring_buffer_advance().
+ *
+ * In this mode the object lock is not taken when waiting for a segment. The
+ * device thread only wakes up the other side when it was blocked on a full
+ * (playback) or empty (capture) ringbuffer. The state that the device
+ * thread checks for this is kept on its own cache line. The segdone counter
+ * is not, it is a public field of #GstAudioRingBuffer.
+ *
+ * This function should be called before @buf is started. #GstAudioBaseSink
+ * and #GstAudioBaseSrc call it from their #GstAudioBaseSink:spsc and
+ * #GstAudioBaseSrc:spsc properties.
+ *
+ * MT safe.
+ *
+ * Since: 1.8
+ */
+void
+gst_audio_ring_buffer_set_spsc (GstAudioRingBuffer * buf, gboolean spsc)
+{
+  g_return_if_fail (GST_IS_AUDIO_RING_BUFFER (buf));
+
+  GST_OBJECT_LOCK (buf);
+  GST_DEBUG_OBJECT (buf, "single producer, single consumer: %d", spsc);
+  g_atomic_int_set (&buf->priv->waiter.waiting, 0);
+  buf->priv->spsc = spsc;
+  GST_OBJECT_UNLOCK (buf);
+}
+
+/**
+ * gst_audio_ring_buffer_is_spsc:
+ * @buf: the #GstAudioRingBuffer
+ *
+ * Check if @buf is in single producer, single consumer mode.
+ *
+ * MT safe.
+ *
+ * Returns: TRUE if @buf is in single producer, single consumer mode.
+ *
+ * Since: 1.8
+ */
+gboolean
+gst_audio_ring_buffer_is_spsc (GstAudioRingBuffer * buf)
+{
+  gboolean res;
+
+  g_return_val_if_fail (GST_IS_AUDIO_RING_BUFFER (buf), FALSE);
+
+  GST_OBJECT_LOCK (buf);
+  res = buf->priv->spsc;
+  GST_OBJECT_UNLOCK (buf);
+
+  return res;
+}
+
 /**
  * gst_audio_ring_buffer_start:
  * @buf: the #GstAudioRingBuffer to start
@@ -1000,6 +1106,7 @@ gst_audio_ring_buffer_pause_unlocked (GstAudioRingBuffer * buf)
   /* signal any waiters */
   GST_DEBUG_OBJECT (buf, "signal waiter");
   GST_AUDIO_RING_BUFFER_SIGNAL (buf);
+  signal_spsc_waiter (buf);
 
   rclass = GST_AUDIO_RING_BUFFER_GET_CLASS (buf);
   if (G_LIKELY (rclass->pause))
@@ -1109,6 +1216,7 @@ gst_audio_ring_buffer_stop (GstAudioRingBuffer * buf)
   /* signal any waiters */
   GST_DEBUG_OBJECT (buf, "signal waiter");
   GST_AUDIO_RING_BUFFER_SIGNAL (buf);
+  signal_spsc_waiter (buf);
 
   rclass = GST_AUDIO_RING_BUFFER_GET_CLASS (buf);
   if (G_LIKELY (rclass->stop))
@@ -1346,6 +1454,66 @@ no_start:
   }
 }
 
+/* SPSC version of wait_segment(), blocks until segdone - segbase reaches
+ * @wait_seg. The object lock is not taken, the device thread only needs the
+ * private lock to wake us up. */
+static gboolean
+wait_segment_spsc (GstAudioRingBuffer * buf, gint wait_seg)
+{
+  GstAudioRingBufferPrivate *priv = buf->priv;
+  gboolean res = TRUE;
+
+  if (G_UNLIKELY (g_atomic_int_get (&buf->state) !=
+          GST_AUDIO_RING_BUFFER_STATE_STARTED)) {
+    if (G_UNLIKELY (!g_atomic_int_get (&buf->may_start))) {
+      GST_DEBUG_OBJECT (buf, "not allowed to start");
+      return FALSE;
+    }
+    GST_DEBUG_OBJECT (buf, "start!");
+    gst_audio_ring_buffer_start (buf);
+  }
+
+  wait_seg += buf->segbase;
+
+  g_mutex_lock (&priv->wait_lock);
+  /* publish what we wait for before checking the position again, the
+   * device thread does the opposite so one of us sees the other */
+  g_atomic_int_set (&priv->waiter.wait_seg, wait_seg);
+  g_atomic_int_set (&priv->waiter.waiting, 1);
+  while (g_atomic_int_get (&buf->segdone) - wait_seg < 0) {
+    if (G_UNLIKELY (g_atomic_int_get (&buf->flushing))) {
+      GST_DEBUG_OBJECT (buf, "flushing");
+      res = FALSE;
+      break;
+    }
+    if (G_UNLIKELY (g_atomic_int_get (&buf->state) !=
+            GST_AUDIO_RING_BUFFER_STATE_STARTED)) {
+      GST_DEBUG_OBJECT (buf, "stopped processing");
+      res = FALSE;
+      break;
+    }
+    GST_DEBUG_OBJECT (buf, "waiting for segment %d", wait_seg);
+    g_cond_wait (&priv->wait_cond, &priv->wait_lock);
+  }
+  g_atomic_int_set (&priv->waiter.waiting, 0);
+  g_mutex_unlock (&priv->wait_lock);
+
+  return res;
+}
+
+static void
+signal_spsc_waiter (GstAudioRingBuffer * buf)
+{
+  GstAudioRingBufferPrivate *priv = buf->priv;
+
+  if (!priv->spsc)
+    return;
+
+  g_mutex_lock (&priv->wait_lock);
+  g_cond_signal (&priv->wait_cond);
+  g_mutex_unlock (&priv->wait_lock);
+}
+
 
 
 #define REORDER_SAMPLE(d, s, l)                 \
@@ -1466,6 +1634,7 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
   gint inr, outr;
   gboolean reverse;
   gboolean need_reorder;
+  gboolean spsc;
 
   g_return_val_if_fail (buf->memory != NULL, -1);
   g_return_val_if_fail (data != NULL, -1);
@@ -1483,6 +1652,7 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
   }
 
   need_reorder = buf->need_reorder;
+  spsc = buf->priv->spsc;
 
   channels = buf->spec.info.channels;
   dest = buf->memory;
@@ -1549,7 +1719,10 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
       }
 
       /* else we need to wait for the segment to become writable. */
-      if (!wait_segment (buf))
+      if (spsc) {
+        if (!wait_segment_spsc (buf, writeseg - segtotal + 1))
+          goto not_started;
+      } else if (!wait_segment (buf))
         goto not_started;
     }
 
@@ -1709,12 +1882,14 @@ gst_audio_ring_buffer_read (GstAudioRingBuffer * buf, guint64 sample,
   guint8 *dest;
   guint to_read;
   gboolean need_reorder;
+  gboolean spsc;
 
   g_return_val_if_fail (GST_IS_AUDIO_RING_BUFFER (buf), -1);
   g_return_val_if_fail (buf->memory != NULL, -1);
   g_return_val_if_fail (data != NULL, -1);
 
   need_reorder = buf->need_reorder;
+  spsc = buf->priv->spsc;
   dest = buf->memory;
   segsize = buf->spec.segsize;
   segtotal = buf->spec.segtotal;
@@ -1765,7 +1940,10 @@ gst_audio_ring_buffer_read (GstAudioRingBuffer * buf, guint64 sample,
         break;
 
       /* else we need to wait for the segment to become readable. */
-      if (!wait_segment (buf))
+      if (spsc) {
+        if (!wait_segment_spsc (buf, readseg + 1))
+          goto not_started;
+      } else if (!wait_segment (buf))
         goto not_started;
     }
 
@@ -1884,6 +2062,25 @@ gst_audio_ring_buffer_advance (GstAudioRingBuffer * buf, guint advance)
 {
   g_return_if_fail (GST_IS_AUDIO_RING_BUFFER (buf));
 
+  if (buf->priv->spsc) {
+    GstAudioRingBufferPrivate *priv = buf->priv;
+    gint segdone;
+
+    segdone = g_atomic_int_add (&buf->segdone, advance) + advance;
+
+    /* only wake up the other side when it was blocked on this segment. The
+     * waiter sets the flag before checking segdone, we check the flag after
+     * updating segdone, so one of us sees the other */
+    if (G_UNLIKELY (g_atomic_int_get (&priv->waiter.waiting) &&
+            segdone - g_atomic_int_get (&priv->waiter.wait_seg) >= 0)) {
+      g_mutex_lock (&priv->wait_lock);
+      GST_LOG_OBJECT (buf, "signal waiter");
+      g_cond_signal (&priv->wait_cond);
+      g_mutex_unlock (&priv->wait_lock);
+    }
+    return;
+  }
+
   /* update counter */
   g_atomic_int_add (&buf->segdone, advance);
 
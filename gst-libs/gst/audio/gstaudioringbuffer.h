@@ -40,6 +40,7 @@ G_BEGIN_DECLS
 typedef struct _GstAudioRingBuffer GstAudioRingBuffer;
 typedef struct _GstAudioRingBufferClass GstAudioRingBufferClass;
 typedef struct _GstAudioRingBufferSpec GstAudioRingBufferSpec;
+typedef struct _GstAudioRingBufferPrivate GstAudioRingBufferPrivate;
 
 /**
  * GstAudioRingBufferCallback:
@@ -206,7 +207,9 @@ struct _GstAudioRingBuffer {
   gboolean                    active;
 
   /*< private >*/
-  gpointer _gst_reserved[GST_PADDING];
+  GstAudioRingBufferPrivate  *priv;
+
+  gpointer _gst_reserved[GST_PADDING - 1];
 };
 
 /**
@@ -295,6 +298,10 @@ gboolean        gst_audio_ring_buffer_is_active       (GstAudioRingBuffer *buf);
 void            gst_audio_ring_buffer_set_flushing    (GstAudioRingBuffer *buf, gboolean flushing);
 gboolean        gst_audio_ring_buffer_is_flushing     (GstAudioRingBuffer *buf);
 
+/* single producer, single consumer mode */
+void            gst_audio_ring_buffer_set_spsc        (GstAudioRingBuffer *buf, gboolean spsc);
+gboolean        gst_audio_ring_buffer_is_spsc         (GstAudioRingBuffer *buf);
+
 /* playback/pause */
 gboolean        gst_audio_ring_buffer_start           (GstAudioRingBuffer *buf);
 gboolean        gst_audio_ring_buffer_pause           (GstAudioRingBuffer *buf);
@@ -142,3 +142,168 @@ done:
 
   return fcaps;
 }
+
+/*
+ * A buffer pool for variable sized audio frames. Buffers handed out are
+ * usually shrunk to the size of the frame, this pool restores the configured
+ * size when they are returned so that they can be recycled.
+ */
+typedef struct
+{
+  GstBufferPool parent;
+
+  guint size;
+} GstAudioFramePool;
+
+typedef GstBufferPoolClass GstAudioFramePoolClass;
+
+static GType __gst_audio_frame_pool_get_type (void);
+
+G_DEFINE_TYPE (GstAudioFramePool, __gst_audio_frame_pool, GST_TYPE_BUFFER_POOL);
+
+static gboolean
+__gst_audio_frame_pool_set_config (GstBufferPool * pool, GstStructure * config)
+{
+  GstAudioFramePool *fpool = (GstAudioFramePool *) pool;
+  guint size;
+
+  if (!gst_buffer_pool_config_get_params (config, NULL, &size, NULL, NULL))
+    return FALSE;
+
+  fpool->size = size;
+
+  return
+      GST_BUFFER_POOL_CLASS (__gst_audio_frame_pool_parent_class)->set_config
+      (pool, config);
+}
+
+static void
+__gst_audio_frame_pool_reset_buffer (GstBufferPool * pool, GstBuffer * buffer)
+{
+  GstAudioFramePool *fpool = (GstAudioFramePool *) pool;
+
+  if (!GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_TAG_MEMORY)) {
+    gsize offset, maxsize;
+
+    gst_buffer_get_sizes (buffer, &offset, &maxsize);
+    if (offset + fpool->size <= maxsize)
+      gst_buffer_set_size (buffer, fpool->size);
+  }
+
+  GST_BUFFER_POOL_CLASS (__gst_audio_frame_pool_parent_class)->reset_buffer
+      (pool, buffer);
+}
+
+static void
+__gst_audio_frame_pool_class_init (GstAudioFramePoolClass * klass)
+{
+  klass->set_config = __gst_audio_frame_pool_set_config;
+  klass->reset_buffer = __gst_audio_frame_pool_reset_buffer;
+}
+
+static void
+__gst_audio_frame_pool_init (GstAudioFramePool * pool)
+{
+}
+
+GstBufferPool *
+__gst_audio_frame_pool_new (void)
+{
+  return g_object_new (__gst_audio_frame_pool_get_type (), NULL);
+}
+
+/* changes the buffer size of @pool, keeping the caps and the limits that were
+ * negotiated with downstream */
+static gboolean
+__gst_audio_frame_pool_configure (GstBufferPool * pool, gsize size,
+    GstAllocator * allocator, const GstAllocationParams * params,
+    GstCaps * caps, guint min, guint max)
+{
+  GstStructure *config;
+
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, size, min, max);
+  gst_buffer_pool_config_set_allocator (config, allocator, params);
+
+  return gst_buffer_pool_set_config (pool, config);
+}
+
+/*
+ * Acquires a buffer of @size bytes from @pool. The frame size is not known
+ * when the pool is negotiated, so the pool is configured on the first
+ * allocation and reconfigured whenever a larger frame is requested. When
+ * the pool refuses the new configuration, because buffers are still in use
+ * downstream, it is replaced by a new pool. Every reconfiguration after the
+ * first one throws away the buffers of the pool and is counted in
+ * @allocations.
+ *
+ * Returns NULL when no buffer could be acquired.
+ */
+GstBuffer *
+__gst_audio_frame_pool_acquire (GstElement * element, GstBufferPool ** pool,
+    gsize * pool_size, GstAllocator * allocator,
+    const GstAllocationParams * params, gsize size, gint * allocations)
+{
+  GstBuffer *buffer = NULL;
+
+  if (G_UNLIKELY (size > *pool_size || !gst_buffer_pool_is_active (*pool))) {
+    gsize new_size = MAX (size, *pool_size);
+    GstStructure *config;
+    GstCaps *caps = NULL;
+    guint min = 0, max = 0;
+
+    GST_DEBUG_OBJECT (element, "configuring pool %" GST_PTR_FORMAT
+        " for frames of %" G_GSIZE_FORMAT " bytes", *pool, new_size);
+
+    if (*pool_size > 0)
+      g_atomic_int_inc (allocations);
+
+    gst_buffer_pool_set_active (*pool, FALSE);
+
+    config = gst_buffer_pool_get_config (*pool);
+    gst_buffer_pool_config_get_params (config, &caps, NULL, &min, &max);
+    if (caps)
+      gst_caps_ref (caps);
+    gst_structure_free (config);
+
+    if (!__gst_audio_frame_pool_configure (*pool, new_size, allocator, params,
+            caps, min, max)) {
+      GST_DEBUG_OBJECT (element, "pool refused configuration, making new pool");
+      gst_object_unref (*pool);
+      *pool = __gst_audio_frame_pool_new ();
+      if (!__gst_audio_frame_pool_configure (*pool, new_size, allocator,
+              params, caps, min, max)) {
+        gst_caps_replace (&caps, NULL);
+        goto config_failed;
+      }
+    }
+    gst_caps_replace (&caps, NULL);
+
+    if (!gst_buffer_pool_set_active (*pool, TRUE))
+      goto activate_failed;
+
+    *pool_size = new_size;
+  }
+
+  if (gst_buffer_pool_acquire_buffer (*pool, &buffer, NULL) != GST_FLOW_OK)
+    return NULL;
+
+  if (size < *pool_size)
+    gst_buffer_set_size (buffer, size);
+
+  return buffer;
+
+  /* ERRORS */
+config_failed:
+  {
+    GST_WARNING_OBJECT (element, "failed to configure pool");
+    *pool_size = 0;
+    return NULL;
+  }
+activate_failed:
+  {
+    GST_WARNING_OBJECT (element, "failed to activate pool");
+    *pool_size = 0;
+    return NULL;
+  }
+}
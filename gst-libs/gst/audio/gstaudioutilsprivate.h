@@ -35,6 +35,19 @@ GstCaps *__gst_audio_element_proxy_getcaps (GstElement * element, GstPad * sinkp
                                             GstPad * srcpad, GstCaps * initial_caps,
                                             GstCaps * filter);
 
+/* Buffer pool utility functions */
+GstBufferPool *__gst_audio_frame_pool_new (void);
+GstBuffer *__gst_audio_frame_pool_acquire (GstElement * element,
+                                           GstBufferPool ** pool,
+                                           gsize * pool_size,
+                                           GstAllocator * allocator,
+                                           const GstAllocationParams * params,
+                                           gsize size,
+                                           gint * allocations);
+
+/* Quantizer test hook */
+void _gst_audio_quantize_set_seed (GstAudioQuantize * quant, guint32 seed);
+
 G_END_DECLS
 
 #endif
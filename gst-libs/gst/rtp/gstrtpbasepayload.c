@@ -61,6 +61,12 @@ struct _GstRTPBasePayloadPrivate
 
   GstCaps *subclass_srccaps;
   GstCaps *sinkcaps;
+
+  GstBufferPool *header_pool;
+  gboolean push_list;
+  GstBufferList *pending_list;
+  /* result of pushing pending_list before an event, returned by chain */
+  GstFlowReturn pending_ret;
 };
 
 /* RTPBasePayload signals and args */
@@ -138,6 +144,14 @@ static GstStateChangeReturn gst_rtp_base_payload_change_state (GstElement *
 
 static gboolean gst_rtp_base_payload_negotiate (GstRTPBasePayload * payload);
 
+static void gst_rtp_base_payload_flush_pending (GstRTPBasePayload * payload,
+    const gchar * before);
+static GstFlowReturn gst_rtp_base_payload_push_pending (GstRTPBasePayload *
+    payload);
+static void gst_rtp_base_payload_clear_pending (GstRTPBasePayload * payload);
+static void gst_rtp_base_payload_free_header_pool (GstRTPBasePayload *
+    payload);
+
 
 static GstElementClass *parent_class = NULL;
 
@@ -406,6 +420,9 @@ gst_rtp_base_payload_finalize (GObject * object)
   gst_caps_replace (&rtpbasepayload->priv->subclass_srccaps, NULL);
   gst_caps_replace (&rtpbasepayload->priv->sinkcaps, NULL);
 
+  gst_rtp_base_payload_clear_pending (rtpbasepayload);
+  gst_rtp_base_payload_free_header_pool (rtpbasepayload);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -435,6 +452,12 @@ gst_rtp_base_payload_sink_event_default (GstRTPBasePayload * rtpbasepayload,
   GstObject *parent = GST_OBJECT_CAST (rtpbasepayload);
   gboolean res = FALSE;
 
+  /* packets that are collected for a list go out before the event */
+  if (GST_EVENT_IS_SERIALIZED (event)
+      && GST_EVENT_TYPE (event) != GST_EVENT_FLUSH_STOP)
+    gst_rtp_base_payload_flush_pending (rtpbasepayload,
+        GST_EVENT_TYPE_NAME (event));
+
   switch (GST_EVENT_TYPE (event)) {
     case GST_EVENT_FLUSH_START:
       res = gst_pad_event_default (rtpbasepayload->sinkpad, parent, event);
@@ -443,6 +466,7 @@ gst_rtp_base_payload_sink_event_default (GstRTPBasePayload * rtpbasepayload,
       res = gst_pad_event_default (rtpbasepayload->sinkpad, parent, event);
       gst_segment_init (&rtpbasepayload->segment, GST_FORMAT_UNDEFINED);
       gst_event_replace (&rtpbasepayload->priv->pending_segment, NULL);
+      gst_rtp_base_payload_clear_pending (rtpbasepayload);
       break;
     case GST_EVENT_CAPS:
     {
@@ -657,8 +681,22 @@ gst_rtp_base_payload_chain (GstPad * pad, GstObject * parent,
   if (gst_pad_check_reconfigure (GST_RTP_BASE_PAYLOAD_SRCPAD (rtpbasepayload)))
     gst_rtp_base_payload_negotiate (rtpbasepayload);
 
+  rtpbasepayload->priv->pending_ret = GST_FLOW_OK;
+
   ret = rtpbasepayload_class->handle_buffer (rtpbasepayload, buffer);
 
+  /* push the packets the subclass made from this buffer in one go */
+  if (rtpbasepayload->priv->pending_list) {
+    GstFlowReturn list_ret;
+
+    list_ret = gst_rtp_base_payload_push_pending (rtpbasepayload);
+    if (ret == GST_FLOW_OK)
+      ret = list_ret;
+  }
+  /* packets pushed before the subclass changed the caps */
+  if (ret == GST_FLOW_OK)
+    ret = rtpbasepayload->priv->pending_ret;
+
   return ret;
 
   /* ERRORS */
@@ -1064,6 +1102,9 @@ gst_rtp_base_payload_negotiate (GstRTPBasePayload * payload)
 
   update_max_ptime (payload);
 
+  /* packets made under the old caps go out before the new caps */
+  gst_rtp_base_payload_flush_pending (payload, "caps");
+
   res = gst_pad_set_caps (GST_RTP_BASE_PAYLOAD_SRCPAD (payload), srccaps);
   gst_caps_unref (srccaps);
   gst_caps_unref (templ);
@@ -1124,20 +1165,25 @@ find_timestamp (GstBuffer ** buffer, guint idx, gpointer user_data)
     return TRUE;
 }
 
+/* the fixed header is in the first memory of the packet, only that memory is
+ * mapped to write the fields, this is called for every packet we push */
 static gboolean
 set_headers (GstBuffer ** buffer, guint idx, gpointer user_data)
 {
   HeaderData *data = user_data;
-  GstRTPBuffer rtp = { NULL, };
+  GstMapInfo map;
 
-  if (!gst_rtp_buffer_map (*buffer, GST_MAP_WRITE, &rtp))
+  if (!gst_buffer_map_range (*buffer, 0, 1, &map, GST_MAP_WRITE))
     goto map_failed;
 
-  gst_rtp_buffer_set_ssrc (&rtp, data->ssrc);
-  gst_rtp_buffer_set_payload_type (&rtp, data->pt);
-  gst_rtp_buffer_set_seq (&rtp, data->seqnum);
-  gst_rtp_buffer_set_timestamp (&rtp, data->rtptime);
-  gst_rtp_buffer_unmap (&rtp);
+  if (G_UNLIKELY (map.size < 12 || (map.data[0] >> 6) != GST_RTP_VERSION))
+    goto invalid_packet;
+
+  map.data[1] = (map.data[1] & 0x80) | (data->pt & 0x7f);
+  GST_WRITE_UINT16_BE (map.data + 2, data->seqnum);
+  GST_WRITE_UINT32_BE (map.data + 4, data->rtptime);
+  GST_WRITE_UINT32_BE (map.data + 8, data->ssrc);
+  gst_buffer_unmap (*buffer, &map);
 
   /* increment the seqnum for each buffer */
   data->seqnum++;
@@ -1149,6 +1195,12 @@ map_failed:
     GST_ERROR ("failed to map buffer %p", *buffer);
     return FALSE;
   }
+invalid_packet:
+  {
+    GST_ERROR ("buffer %p is not a valid RTP packet", *buffer);
+    gst_buffer_unmap (*buffer, &map);
+    return FALSE;
+  }
 }
 
 /* Updates the SSRC, payload type, seqnum and timestamp of the RTP buffer
@@ -1279,6 +1331,89 @@ no_rate:
   }
 }
 
+static void
+gst_rtp_base_payload_push_segment (GstRTPBasePayload * payload)
+{
+  if (G_UNLIKELY (payload->priv->pending_segment)) {
+    gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
+    payload->priv->pending_segment = FALSE;
+    payload->priv->delay_segment = FALSE;
+  }
+}
+
+static gboolean
+add_pending (GstBuffer ** buffer, guint idx, gpointer user_data)
+{
+  gst_buffer_list_add (GST_BUFFER_LIST_CAST (user_data),
+      gst_buffer_ref (*buffer));
+  return TRUE;
+}
+
+/* collect a prepared buffer or list to push it later with the other packets
+ * of the input buffer */
+static void
+gst_rtp_base_payload_add_pending (GstRTPBasePayload * payload, gpointer obj,
+    gboolean is_list)
+{
+  GstRTPBasePayloadPrivate *priv = payload->priv;
+
+  if (is_list) {
+    if (priv->pending_list == NULL) {
+      priv->pending_list = GST_BUFFER_LIST_CAST (obj);
+      return;
+    }
+    gst_buffer_list_foreach (GST_BUFFER_LIST_CAST (obj), add_pending,
+        priv->pending_list);
+    gst_buffer_list_unref (GST_BUFFER_LIST_CAST (obj));
+  } else {
+    if (priv->pending_list == NULL)
+      priv->pending_list = gst_buffer_list_new ();
+    gst_buffer_list_add (priv->pending_list, GST_BUFFER_CAST (obj));
+  }
+}
+
+static GstFlowReturn
+gst_rtp_base_payload_push_pending (GstRTPBasePayload * payload)
+{
+  GstBufferList *list = payload->priv->pending_list;
+
+  if (list == NULL)
+    return GST_FLOW_OK;
+
+  payload->priv->pending_list = NULL;
+  gst_rtp_base_payload_push_segment (payload);
+
+  GST_LOG_OBJECT (payload, "pushing list of %u packets",
+      gst_buffer_list_length (list));
+
+  return gst_pad_push_list (payload->srcpad, list);
+}
+
+/* push the collected packets before an event that goes out on the srcpad.
+ * A failure is returned from the chain function of the current buffer */
+static void
+gst_rtp_base_payload_flush_pending (GstRTPBasePayload * payload,
+    const gchar * before)
+{
+  GstFlowReturn ret;
+
+  ret = gst_rtp_base_payload_push_pending (payload);
+  if (G_UNLIKELY (ret != GST_FLOW_OK)) {
+    GST_DEBUG_OBJECT (payload, "pushing packets before %s returned %s",
+        before, gst_flow_get_name (ret));
+    payload->priv->pending_ret = ret;
+  }
+}
+
+static void
+gst_rtp_base_payload_clear_pending (GstRTPBasePayload * payload)
+{
+  if (payload->priv->pending_list) {
+    gst_buffer_list_unref (payload->priv->pending_list);
+    payload->priv->pending_list = NULL;
+  }
+}
+
 /**
  * gst_rtp_base_payload_push_list:
  * @payload: a #GstRTPBasePayload
@@ -1300,12 +1435,12 @@ gst_rtp_base_payload_push_list (GstRTPBasePayload * payload,
   res = gst_rtp_base_payload_prepare_push (payload, list, TRUE);
 
   if (G_LIKELY (res == GST_FLOW_OK)) {
-    if (G_UNLIKELY (payload->priv->pending_segment)) {
-      gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
-      payload->priv->pending_segment = FALSE;
-      payload->priv->delay_segment = FALSE;
+    if (payload->priv->push_list) {
+      gst_rtp_base_payload_add_pending (payload, list, TRUE);
+    } else {
+      gst_rtp_base_payload_push_segment (payload);
+      res = gst_pad_push_list (payload->srcpad, list);
     }
-    res = gst_pad_push_list (payload->srcpad, list);
   } else {
     gst_buffer_list_unref (list);
   }
@@ -1333,12 +1468,12 @@ gst_rtp_base_payload_push (GstRTPBasePayload * payload, GstBuffer * buffer)
   res = gst_rtp_base_payload_prepare_push (payload, buffer, FALSE);
 
   if (G_LIKELY (res == GST_FLOW_OK)) {
-    if (G_UNLIKELY (payload->priv->pending_segment)) {
-      gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
-      payload->priv->pending_segment = FALSE;
-      payload->priv->delay_segment = FALSE;
+    if (payload->priv->push_list) {
+      gst_rtp_base_payload_add_pending (payload, buffer, FALSE);
+    } else {
+      gst_rtp_base_payload_push_segment (payload);
+      res = gst_pad_push (payload->srcpad, buffer);
     }
-    res = gst_pad_push (payload->srcpad, buffer);
   } else {
     gst_buffer_unref (buffer);
   }
@@ -1346,6 +1481,192 @@ gst_rtp_base_payload_push (GstRTPBasePayload * payload, GstBuffer * buffer)
   return res;
 }
 
+/**
+ * gst_rtp_base_payload_set_push_list:
+ * @payload: a #GstRTPBasePayload
+ * @push_list: whether to push the packets of an input buffer as one list
+ *
+ * When @push_list is %TRUE, the packets that the subclass pushes with
+ * gst_rtp_base_payload_push() and gst_rtp_base_payload_push_list() while
+ * handling an input buffer are collected and pushed downstream as one
+ * #GstBufferList after the handle_buffer function returns. This saves a
+ * push per packet for payloaders that make many packets from one input
+ * buffer.
+ *
+ * The SSRC, payload type, seqnum and timestamp of the packets are still
+ * updated when they are pushed by the subclass, but the result of pushing
+ * them downstream is only returned from the chain function.
+ *
+ * Subclasses typically call this from their instance init function.
+ *
+ * Since: 1.8
+ */
+void
+gst_rtp_base_payload_set_push_list (GstRTPBasePayload * payload,
+    gboolean push_list)
+{
+  g_return_if_fail (GST_IS_RTP_BASE_PAYLOAD (payload));
+
+  payload->priv->push_list = push_list;
+}
+
+/* A pool of RTP packets without payload. Payloaders append their payload to
+ * these as extra memory, it is removed again and the header is reset when a
+ * buffer returns to the pool. */
+typedef GstBufferPool GstRTPHeaderPool;
+typedef GstBufferPoolClass GstRTPHeaderPoolClass;
+
+static GstBufferPoolClass *header_pool_parent_class = NULL;
+
+static void
+gst_rtp_header_pool_init_header (GstBuffer * buffer)
+{
+  GstMapInfo map;
+
+  if (gst_buffer_map (buffer, &map, GST_MAP_WRITE)) {
+    memset (map.data, 0, map.size);
+    map.data[0] = GST_RTP_VERSION << 6;
+    gst_buffer_unmap (buffer, &map);
+  }
+}
+
+static GstFlowReturn
+gst_rtp_header_pool_alloc_buffer (GstBufferPool * pool, GstBuffer ** buffer,
+    GstBufferPoolAcquireParams * params)
+{
+  GstFlowReturn ret;
+
+  ret = header_pool_parent_class->alloc_buffer (pool, buffer, params);
+  if (ret == GST_FLOW_OK)
+    gst_rtp_header_pool_init_header (*buffer);
+
+  return ret;
+}
+
+static void
+gst_rtp_header_pool_reset_buffer (GstBufferPool * pool, GstBuffer * buffer)
+{
+  /* remove the payload */
+  if (gst_buffer_n_memory (buffer) > 1)
+    gst_buffer_remove_memory_range (buffer, 1, -1);
+
+  header_pool_parent_class->reset_buffer (pool, buffer);
+
+  /* the header can be reused when it has its original size and nobody else
+   * uses it anymore, otherwise the memory stays tagged and the buffer is
+   * freed by the pool */
+  if (gst_buffer_n_memory (buffer) == 1
+      && gst_buffer_get_size (buffer) == gst_rtp_buffer_calc_header_len (0)
+      && gst_buffer_is_memory_range_writable (buffer, 0, 1)) {
+    gst_rtp_header_pool_init_header (buffer);
+    GST_BUFFER_FLAG_UNSET (buffer, GST_BUFFER_FLAG_TAG_MEMORY);
+  }
+}
+
+static void
+gst_rtp_header_pool_class_init (GstRTPHeaderPoolClass * klass)
+{
+  header_pool_parent_class = g_type_class_peek_parent (klass);
+
+  klass->alloc_buffer = gst_rtp_header_pool_alloc_buffer;
+  klass->reset_buffer = gst_rtp_header_pool_reset_buffer;
+}
+
+static GType
+gst_rtp_header_pool_get_type (void)
+{
+  static volatile gsize rtp_header_pool_type = 0;
+
+  if (g_once_init_enter ((gsize *) & rtp_header_pool_type)) {
+    GType _type;
+
+    _type = g_type_register_static_simple (GST_TYPE_BUFFER_POOL,
+        "GstRTPHeaderPool", sizeof (GstRTPHeaderPoolClass),
+        (GClassInitFunc) gst_rtp_header_pool_class_init,
+        sizeof (GstRTPHeaderPool), NULL, 0);
+    g_once_init_leave ((gsize *) & rtp_header_pool_type, _type);
+  }
+  return rtp_header_pool_type;
+}
+
+static GstBufferPool *
+gst_rtp_base_payload_get_header_pool (GstRTPBasePayload * payload)
+{
+  GstRTPBasePayloadPrivate *priv = payload->priv;
+
+  if (G_UNLIKELY (priv->header_pool == NULL)) {
+    GstBufferPool *pool;
+    GstStructure *config;
+
+    pool = g_object_new (gst_rtp_header_pool_get_type (), NULL);
+    gst_object_ref_sink (pool);
+
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_set_params (config, NULL,
+        gst_rtp_buffer_calc_header_len (0), 0, 0);
+    if (!gst_buffer_pool_set_config (pool, config)
+        || !gst_buffer_pool_set_active (pool, TRUE)) {
+      GST_WARNING_OBJECT (payload, "could not activate header pool");
+      gst_object_unref (pool);
+      return NULL;
+    }
+    priv->header_pool = pool;
+  }
+  return priv->header_pool;
+}
+
+static void
+gst_rtp_base_payload_free_header_pool (GstRTPBasePayload * payload)
+{
+  if (payload->priv->header_pool) {
+    gst_buffer_pool_set_active (payload->priv->header_pool, FALSE);
+    gst_object_unref (payload->priv->header_pool);
+    payload->priv->header_pool = NULL;
+  }
+}
+
+/**
+ * gst_rtp_base_payload_allocate_output_buffer:
+ * @payload: a #GstRTPBasePayload
+ * @payload_len: the length of the payload
+ * @pad_len: the amount of padding
+ * @csrc_count: the minimum number of CSRC entries
+ *
+ * Allocate a new #GstBuffer with enough data to hold an RTP packet with
+ * @csrc_count CSRCs, a payload length of @payload_len and padding of
+ * @pad_len, like gst_rtp_buffer_new_allocate() does.
+ *
+ * Packets without payload, padding and CSRCs, to which the payloader
+ * appends the payload as extra memory, are taken from a pool and are reused
+ * when they are freed downstream.
+ *
+ * Returns: (transfer full): A newly allocated buffer that can hold an RTP
+ * packet with given parameters.
+ *
+ * Since: 1.8
+ */
+GstBuffer *
+gst_rtp_base_payload_allocate_output_buffer (GstRTPBasePayload * payload,
+    guint payload_len, guint8 pad_len, guint8 csrc_count)
+{
+  GstBuffer *buffer = NULL;
+
+  g_return_val_if_fail (GST_IS_RTP_BASE_PAYLOAD (payload), NULL);
+
+  if (payload_len == 0 && pad_len == 0 && csrc_count == 0) {
+    GstBufferPool *pool = gst_rtp_base_payload_get_header_pool (payload);
+
+    if (pool && gst_buffer_pool_acquire_buffer (pool, &buffer,
+            NULL) != GST_FLOW_OK)
+      buffer = NULL;
+  }
+
+  if (buffer == NULL)
+    buffer = gst_rtp_buffer_new_allocate (payload_len, pad_len, csrc_count);
+
+  return buffer;
+}
+
 static GstStructure *
 gst_rtp_base_payload_create_stats (GstRTPBasePayload * rtpbasepayload)
 {
@@ -1540,6 +1861,8 @@ gst_rtp_base_payload_change_state (GstElement * element,
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_event_replace (&rtpbasepayload->priv->pending_segment, NULL);
+      gst_rtp_base_payload_clear_pending (rtpbasepayload);
+      gst_rtp_base_payload_free_header_pool (rtpbasepayload);
       break;
     default:
       break;
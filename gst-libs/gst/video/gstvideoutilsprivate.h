@@ -35,6 +35,10 @@ GstCaps *__gst_video_element_proxy_getcaps (GstElement * element, GstPad * sinkp
                                             GstPad * srcpad, GstCaps * initial_caps,
                                             GstCaps * filter);
 
+/* Scaler test hook */
+void _gst_video_scaler_set_generic_taps (GstVideoScaler * scale,
+                                         gboolean generic);
+
 G_END_DECLS
 
 #endif
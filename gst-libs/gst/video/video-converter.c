@@ -124,6 +124,7 @@ typedef struct _GstLineCache GstLineCache;
 #define SCALE_F  ((float) (1 << SCALE))
 
 typedef struct _MatrixData MatrixData;
+typedef struct _MatrixTable MatrixTable;
 
 struct _MatrixData
 {
@@ -134,9 +135,10 @@ struct _MatrixData
   guint64 orc_p2;
   guint64 orc_p3;
   guint64 orc_p4;
-  gint64 *t_r;
-  gint64 *t_g;
-  gint64 *t_b;
+  MatrixTable *table;
+  const gint64 *t_r;
+  const gint64 *t_g;
+  const gint64 *t_b;
   gint64 t_c;
   void (*matrix_func) (MatrixData * data, gpointer pixels);
 };
@@ -171,6 +173,39 @@ typedef struct
 typedef void (*FastConvertFunc) (GstVideoConverter * convert,
     const GstVideoFrame * src, GstVideoFrame * dest, gint plane);
 
+typedef enum
+{
+  STAGE_UNPACK,
+  STAGE_UPSAMPLE,
+  STAGE_TO_RGB,
+  STAGE_HSCALE,
+  STAGE_VSCALE,
+  STAGE_CONVERT,
+  STAGE_ALPHA,
+  STAGE_TO_YUV,
+  STAGE_DOWNSAMPLE,
+  STAGE_DITHER,
+  STAGE_PACK,
+  N_STAGES
+} ConverterStage;
+
+static const gchar *stage_names[N_STAGES] = {
+  "unpack", "upsample", "to-rgb", "hscale", "vscale", "convert", "alpha",
+  "to-yuv", "downsample", "dither", "pack"
+};
+
+/* time spent in each stage, in nanoseconds. The stages pull lines from each
+ * other recursively, child_time is used to only count the time spent in the
+ * stage itself. */
+typedef struct
+{
+  gboolean enabled;
+  guint64 frames;
+  guint64 time;
+  guint64 stage_time[N_STAGES];
+  guint64 child_time;
+} ConverterStats;
+
 struct _GstVideoConverter
 {
   gint flags;
@@ -299,6 +334,31 @@ struct _GstVideoConverter
   GstVideoScaler *fh_scaler[4];
   GstVideoScaler *fv_scaler[4];
   FastConvertFunc fconvert[4];
+  gint fband_y[4];
+
+  /* threading, band converters convert lines band_y to
+   * band_y + band_height of the output */
+  gint band_y;
+  gint band_height;
+  gboolean band_shift;
+  guint8 *band_lines;
+  gint band_stride;
+  gint band_n_lines;
+  gint band_idx;
+  /* number of lines that can be allocated with get_dest_line at the same
+   * time */
+  gint dest_n_lines;
+  GstVideoConverter **bands;
+  guint n_bands;
+  gboolean bands_fill_border;
+  GMutex bands_lock;
+  GCond bands_cond;
+  guint bands_pending;
+
+  /* when freed, the converter goes into the converter cache */
+  gboolean cacheable;
+
+  ConverterStats stats;
 };
 
 typedef gpointer (*GstLineCacheAllocLineFunc) (GstLineCache * cache, gint idx,
@@ -326,6 +386,9 @@ struct _GstLineCache
   GstLineCacheAllocLineFunc alloc_line;
   gpointer alloc_line_data;
   GDestroyNotify alloc_line_notify;
+
+  ConverterStage stage;
+  ConverterStats *stats;
 };
 
 static GstLineCache *
@@ -384,6 +447,28 @@ gst_line_cache_set_alloc_line_func (GstLineCache * cache,
 /* keep this much backlog for interlaced video */
 #define BACKLOG 2
 
+static gboolean
+gst_line_cache_need_line_timed (GstLineCache * cache, gint out_line,
+    gint in_line)
+{
+  ConverterStats *stats = cache->stats;
+  GstClockTime start, elapsed;
+  guint64 child_time;
+  gboolean res;
+
+  child_time = stats->child_time;
+  stats->child_time = 0;
+
+  start = gst_util_get_timestamp ();
+  res = cache->need_line (cache, out_line, in_line, cache->need_line_data);
+  elapsed = gst_util_get_timestamp () - start;
+
+  stats->stage_time[cache->stage] += elapsed - stats->child_time;
+  stats->child_time = child_time + elapsed;
+
+  return res;
+}
+
 static gpointer *
 gst_line_cache_get_lines (GstLineCache * cache, gint out_line, gint in_line,
     gint n_lines)
@@ -415,8 +500,12 @@ gst_line_cache_get_lines (GstLineCache * cache, gint out_line, gint in_line,
 
     oline = out_line + cache->first + cache->lines->len - in_line;
 
-    if (!cache->need_line (cache, oline, cache->first + cache->lines->len,
-            cache->need_line_data))
+    if (G_UNLIKELY (cache->stats)) {
+      if (!gst_line_cache_need_line_timed (cache, oline,
+              cache->first + cache->lines->len))
+        break;
+    } else if (!cache->need_line (cache, oline,
+            cache->first + cache->lines->len, cache->need_line_data))
       break;
   }
   GST_DEBUG ("no lines");
@@ -451,6 +540,14 @@ static void video_converter_generic (GstVideoConverter * convert,
 static gboolean video_converter_lookup_fastpath (GstVideoConverter * convert);
 static void video_converter_compute_matrix (GstVideoConverter * convert);
 static void video_converter_compute_resample (GstVideoConverter * convert);
+static void convert_scale_planes (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest);
+static void convert_fill_border (GstVideoConverter * convert,
+    GstVideoFrame * dest);
+static void setup_bands (GstVideoConverter * convert);
+static GstVideoConverter *video_converter_new (GstVideoInfo * in_info,
+    GstVideoInfo * out_info, GstStructure * config);
+static void video_converter_free (GstVideoConverter * convert);
 
 static gpointer get_dest_line (GstLineCache * cache, gint idx,
     gpointer user_data);
@@ -607,6 +704,8 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
 #define DEFAULT_OPT_RESAMPLER_TAPS 0
 #define DEFAULT_OPT_DITHER_METHOD GST_VIDEO_DITHER_BAYER
 #define DEFAULT_OPT_DITHER_QUANTIZATION 1
+#define DEFAULT_OPT_THREADS 1
+#define DEFAULT_OPT_STATS FALSE
 
 #define GET_OPT_FILL_BORDER(c) get_opt_bool(c, \
     GST_VIDEO_CONVERTER_OPT_FILL_BORDER, DEFAULT_OPT_FILL_BORDER)
@@ -637,6 +736,10 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
     DEFAULT_OPT_DITHER_METHOD)
 #define GET_OPT_DITHER_QUANTIZATION(c) get_opt_uint(c, \
     GST_VIDEO_CONVERTER_OPT_DITHER_QUANTIZATION, DEFAULT_OPT_DITHER_QUANTIZATION)
+#define GET_OPT_THREADS(c) get_opt_uint(c, \
+    GST_VIDEO_CONVERTER_OPT_THREADS, DEFAULT_OPT_THREADS)
+#define GET_OPT_STATS(c) get_opt_bool(c, \
+    GST_VIDEO_CONVERTER_OPT_STATS, DEFAULT_OPT_STATS)
 
 #define CHECK_ALPHA_COPY(c) (GET_OPT_ALPHA_MODE(c) == GST_VIDEO_ALPHA_MODE_COPY)
 #define CHECK_ALPHA_SET(c) (GET_OPT_ALPHA_MODE(c) == GST_VIDEO_ALPHA_MODE_SET)
@@ -924,27 +1027,115 @@ color_matrix_RGB_to_XYZ (MatrixData * dst, double Rx, double Ry, double Gx,
   color_matrix_copy (dst, &m);
 }
 
-static void
-videoconvert_convert_init_tables (MatrixData * data)
+/* The 8 bit lookup tables only depend on the 3x3 part of the integer matrix.
+ * They are immutable once made, so converters with the same matrix share
+ * one refcounted copy. */
+struct _MatrixTable
+{
+  gint im[3][3];
+  gint refcount;
+
+  gint64 t_r[256];
+  gint64 t_g[256];
+  gint64 t_b[256];
+};
+
+static GMutex matrix_tables_lock;
+static GHashTable *matrix_tables;
+static guint matrix_tables_live;
+static guint matrix_tables_users;
+
+static guint
+matrix_table_hash (gconstpointer key)
+{
+  const MatrixTable *table = key;
+  guint i, j, hash = 5381;
+
+  for (i = 0; i < 3; i++)
+    for (j = 0; j < 3; j++)
+      hash = hash * 33 + (guint) table->im[i][j];
+
+  return hash;
+}
+
+static gboolean
+matrix_table_equal (gconstpointer a, gconstpointer b)
+{
+  const MatrixTable *ta = a, *tb = b;
+
+  return memcmp (ta->im, tb->im, sizeof (ta->im)) == 0;
+}
+
+static MatrixTable *
+matrix_table_get (const MatrixData * data)
 {
+  MatrixTable key, *table;
   gint i, j;
 
-  data->t_r = g_new (gint64, 256);
-  data->t_g = g_new (gint64, 256);
-  data->t_b = g_new (gint64, 256);
+  for (i = 0; i < 3; i++)
+    for (j = 0; j < 3; j++)
+      key.im[i][j] = data->im[i][j];
 
-  for (i = 0; i < 256; i++) {
-    gint64 r = 0, g = 0, b = 0;
+  g_mutex_lock (&matrix_tables_lock);
+  if (matrix_tables == NULL)
+    matrix_tables = g_hash_table_new (matrix_table_hash, matrix_table_equal);
 
-    for (j = 0; j < 3; j++) {
-      r = (r << 16) + data->im[j][0] * i;
-      g = (g << 16) + data->im[j][1] * i;
-      b = (b << 16) + data->im[j][2] * i;
+  matrix_tables_users++;
+  table = g_hash_table_lookup (matrix_tables, &key);
+  if (table) {
+    table->refcount++;
+    GST_DEBUG ("share 8bit matrix table %p, refcount %d", table,
+        table->refcount);
+  } else {
+    table = g_slice_new (MatrixTable);
+    memcpy (table->im, key.im, sizeof (key.im));
+    table->refcount = 1;
+
+    for (i = 0; i < 256; i++) {
+      gint64 r = 0, g = 0, b = 0;
+
+      for (j = 0; j < 3; j++) {
+        r = (r << 16) + data->im[j][0] * i;
+        g = (g << 16) + data->im[j][1] * i;
+        b = (b << 16) + data->im[j][2] * i;
+      }
+      table->t_r[i] = r;
+      table->t_g[i] = g;
+      table->t_b[i] = b;
     }
-    data->t_r[i] = r;
-    data->t_g[i] = g;
-    data->t_b[i] = b;
+    g_hash_table_add (matrix_tables, table);
+    matrix_tables_live++;
+    GST_DEBUG ("new 8bit matrix table %p, %u live (%" G_GSIZE_FORMAT
+        " bytes)", table, matrix_tables_live,
+        matrix_tables_live * sizeof (MatrixTable));
+  }
+  g_mutex_unlock (&matrix_tables_lock);
+
+  return table;
+}
+
+static void
+matrix_table_unref (MatrixTable * table)
+{
+  g_mutex_lock (&matrix_tables_lock);
+  matrix_tables_users--;
+  if (--table->refcount == 0) {
+    g_hash_table_remove (matrix_tables, table);
+    matrix_tables_live--;
+    GST_DEBUG ("free 8bit matrix table %p, %u live", table,
+        matrix_tables_live);
+    g_slice_free (MatrixTable, table);
   }
+  g_mutex_unlock (&matrix_tables_lock);
+}
+
+static void
+videoconvert_convert_init_tables (MatrixData * data)
+{
+  data->table = matrix_table_get (data);
+  data->t_r = data->table->t_r;
+  data->t_g = data->table->t_g;
+  data->t_b = data->table->t_b;
   data->t_c = ((gint64) data->im[0][3] << 32)
       + ((gint64) data->im[1][3] << 16)
       + ((gint64) data->im[2][3] << 0);
@@ -1873,11 +2064,14 @@ setup_allocators (GstVideoConverter * convert)
   gpointer user_data;
   GDestroyNotify notify;
   gint width, n_lines;
+  gboolean dest_alloc;
 
   width = MAX (convert->in_maxwidth, convert->out_maxwidth);
   width += convert->out_x;
 
   n_lines = 1;
+  dest_alloc = convert->identity_pack;
+  convert->dest_n_lines = 0;
 
   /* start with using dest lines if we can directly write into it */
   if (convert->identity_pack) {
@@ -1907,6 +2101,11 @@ setup_allocators (GstVideoConverter * convert)
     notify = NULL;
 
     if (!cache->pass_alloc) {
+      if (dest_alloc) {
+        /* the caches up to here all use dest lines */
+        convert->dest_n_lines = n_lines + BACKLOG;
+        dest_alloc = FALSE;
+      }
       /* can't pass allocator, make new temp line allocator */
       user_data =
           converter_alloc_new (sizeof (guint16) * width * 4, n_lines + BACKLOG,
@@ -1921,6 +2120,8 @@ setup_allocators (GstVideoConverter * convert)
     if (cache->write_input)
       alloc_writable = TRUE;
   }
+  if (dest_alloc)
+    convert->dest_n_lines = n_lines + BACKLOG;
   /* free leftover allocator */
   if (notify)
     notify (user_data);
@@ -2034,6 +2235,161 @@ convert_get_alpha_mode (GstVideoConverter * convert)
   return ALPHA_MODE_SET;
 }
 
+/* Converters that were freed are kept around in a small LRU cache so that
+ * renegotiating to a format that was seen before does not need to compute
+ * the matrices, resampler, dither and scaler tables again */
+#define CONVERTER_CACHE_SIZE 8
+
+static GMutex converter_cache_lock;
+/* most recently freed converter first */
+static GQueue converter_cache = G_QUEUE_INIT;
+static guint converter_cache_hits;
+static guint converter_cache_misses;
+
+static void
+setup_stats (GstVideoConverter * convert)
+{
+  GstLineCache *caches[N_STAGES] = {
+    convert->unpack_lines, convert->upsample_lines, convert->to_RGB_lines,
+    convert->hscale_lines, convert->vscale_lines, convert->convert_lines,
+    convert->alpha_lines, convert->to_YUV_lines, convert->downsample_lines,
+    convert->dither_lines, NULL
+  };
+  gint i;
+
+  if (!convert->stats.enabled)
+    return;
+
+  for (i = 0; i < N_STAGES; i++) {
+    if (caches[i] == NULL)
+      continue;
+    caches[i]->stage = i;
+    caches[i]->stats = &convert->stats;
+  }
+}
+
+static void
+reset_stats (GstVideoConverter * convert)
+{
+  ConverterStats *stats = &convert->stats;
+  guint i;
+
+  stats->frames = 0;
+  stats->time = 0;
+  memset (stats->stage_time, 0, sizeof (stats->stage_time));
+
+  for (i = 0; i < convert->n_bands; i++)
+    reset_stats (convert->bands[i]);
+}
+
+static GstVideoConverter *
+converter_cache_take (GstVideoInfo * in_info, GstVideoInfo * out_info,
+    GstStructure * config)
+{
+  GstVideoConverter *convert = NULL;
+  GstStructure *key;
+  GList *walk;
+
+  /* compare against the config as gst_video_converter_new() would make it */
+  if (config) {
+    key = gst_structure_copy (config);
+    gst_structure_set_name (key, "GstVideoConverter");
+  } else {
+    key = gst_structure_new_empty ("GstVideoConverter");
+  }
+
+  g_mutex_lock (&converter_cache_lock);
+  for (walk = converter_cache.head; walk; walk = g_list_next (walk)) {
+    GstVideoConverter *cached = walk->data;
+
+    if (gst_video_info_is_equal (&cached->in_info, in_info) &&
+        gst_video_info_is_equal (&cached->out_info, out_info) &&
+        gst_structure_is_equal (cached->config, key)) {
+      g_queue_delete_link (&converter_cache, walk);
+      convert = cached;
+      break;
+    }
+  }
+  if (convert)
+    converter_cache_hits++;
+  else
+    converter_cache_misses++;
+  g_mutex_unlock (&converter_cache_lock);
+
+  gst_structure_free (key);
+
+  if (convert) {
+    GST_DEBUG ("reusing cached converter %p", convert);
+    reset_stats (convert);
+    if (config)
+      gst_structure_free (config);
+  }
+  return convert;
+}
+
+static void
+converter_cache_add (GstVideoConverter * convert)
+{
+  GstVideoConverter *evict = NULL;
+
+  g_mutex_lock (&converter_cache_lock);
+  g_queue_push_head (&converter_cache, convert);
+  if (converter_cache.length > CONVERTER_CACHE_SIZE)
+    evict = g_queue_pop_tail (&converter_cache);
+  g_mutex_unlock (&converter_cache_lock);
+
+  if (evict) {
+    GST_DEBUG ("evicting cached converter %p", evict);
+    video_converter_free (evict);
+  }
+}
+
+/**
+ * gst_video_converter_get_cache_stats:
+ * @hits: (out) (allow-none): number of converters that were reused
+ * @misses: (out) (allow-none): number of converters that were created
+ *
+ * Freed converters are kept in a small cache and reused when a converter
+ * with the same input and output info and configuration is requested
+ * again. This function retrieves the number of gst_video_converter_new()
+ * calls that could reuse a cached converter and that needed to create one.
+ *
+ * Since: 1.8
+ */
+void
+gst_video_converter_get_cache_stats (guint * hits, guint * misses)
+{
+  g_mutex_lock (&converter_cache_lock);
+  if (hits)
+    *hits = converter_cache_hits;
+  if (misses)
+    *misses = converter_cache_misses;
+  g_mutex_unlock (&converter_cache_lock);
+}
+
+/**
+ * gst_video_converter_get_table_stats:
+ * @n_tables: (out) (allow-none): number of 8 bit matrix tables in memory
+ * @n_users: (out) (allow-none): number of matrix stages using them
+ *
+ * Converters that apply the same color matrix to 8 bit samples share one
+ * lookup table for it. This function retrieves the number of tables in
+ * memory and the number of matrix stages, over all converters including
+ * cached ones, that use them.
+ *
+ * Since: 1.8
+ */
+void
+gst_video_converter_get_table_stats (guint * n_tables, guint * n_users)
+{
+  g_mutex_lock (&matrix_tables_lock);
+  if (n_tables)
+    *n_tables = matrix_tables_live;
+  if (n_users)
+    *n_users = matrix_tables_users;
+  g_mutex_unlock (&matrix_tables_lock);
+}
+
 /**
  * gst_video_converter_new: (skip)
  * @in_info: a #GstVideoInfo
@@ -2052,9 +2408,6 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
     GstStructure * config)
 {
   GstVideoConverter *convert;
-  GstLineCache *prev;
-  const GstVideoFormatInfo *fin, *fout, *finfo;
-  gdouble alpha_value;
 
   g_return_val_if_fail (in_info != NULL, NULL);
   g_return_val_if_fail (out_info != NULL, NULL);
@@ -2065,7 +2418,31 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   g_return_val_if_fail (in_info->interlace_mode == out_info->interlace_mode,
       NULL);
 
+  convert = converter_cache_take (in_info, out_info, config);
+  if (convert)
+    return convert;
+
+  convert = video_converter_new (in_info, out_info, config);
+  if (convert)
+    convert->cacheable = TRUE;
+
+  return convert;
+}
+
+/* creates a converter without going through the cache, the result is not
+ * cacheable and is freed right away by gst_video_converter_free() */
+static GstVideoConverter *
+video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
+    GstStructure * config)
+{
+  GstVideoConverter *convert;
+  GstLineCache *prev;
+  const GstVideoFormatInfo *fin, *fout, *finfo;
+  gdouble alpha_value;
+
   convert = g_slice_new0 (GstVideoConverter);
+  g_mutex_init (&convert->bands_lock);
+  g_cond_init (&convert->bands_cond);
 
   fin = in_info->finfo;
   fout = out_info->finfo;
@@ -2116,6 +2493,9 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   convert->out_height =
       MIN (convert->out_height, convert->out_maxheight - convert->out_y);
 
+  convert->band_y = 0;
+  convert->band_height = convert->out_height;
+
   convert->fill_border = GET_OPT_FILL_BORDER (convert);
   convert->border_argb = get_opt_uint (convert,
       GST_VIDEO_CONVERTER_OPT_BORDER_ARGB, DEFAULT_OPT_BORDER_ARGB);
@@ -2124,6 +2504,8 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   convert->alpha_value = 255 * alpha_value;
   convert->alpha_mode = convert_get_alpha_mode (convert);
 
+  convert->stats.enabled = GET_OPT_STATS (convert);
+
   convert->unpack_format = in_info->finfo->unpack_format;
   finfo = gst_video_format_get_info (convert->unpack_format);
   convert->unpack_bits = GST_VIDEO_FORMAT_INFO_DEPTH (finfo, 0);
@@ -2178,8 +2560,11 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   setup_borderline (convert);
   /* now figure out allocators */
   setup_allocators (convert);
+  setup_stats (convert);
 
 done:
+  setup_bands (convert);
+
   return convert;
 
   /* ERRORS */
@@ -2202,9 +2587,8 @@ no_pack_func:
 static void
 clear_matrix_data (MatrixData * data)
 {
-  g_free (data->t_r);
-  g_free (data->t_g);
-  g_free (data->t_b);
+  if (data->table)
+    matrix_table_unref (data->table);
 }
 
 /**
@@ -2218,10 +2602,19 @@ clear_matrix_data (MatrixData * data)
 void
 gst_video_converter_free (GstVideoConverter * convert)
 {
-  gint i;
-
   g_return_if_fail (convert != NULL);
 
+  if (convert->cacheable)
+    converter_cache_add (convert);
+  else
+    video_converter_free (convert);
+}
+
+static void
+video_converter_free (GstVideoConverter * convert)
+{
+  gint i;
+
   if (convert->upsample_p)
     gst_video_chroma_resample_free (convert->upsample_p);
   if (convert->upsample_i)
@@ -2266,6 +2659,13 @@ gst_video_converter_free (GstVideoConverter * convert)
 
   g_free (convert->tmpline);
   g_free (convert->borderline);
+  g_free (convert->band_lines);
+
+  for (i = 0; i < convert->n_bands; i++)
+    video_converter_free (convert->bands[i]);
+  g_free (convert->bands);
+  g_mutex_clear (&convert->bands_lock);
+  g_cond_clear (&convert->bands_cond);
 
   if (convert->config)
     gst_structure_free (convert->config);
@@ -2318,6 +2718,9 @@ gst_video_converter_set_config (GstVideoConverter * convert,
   g_return_val_if_fail (convert != NULL, FALSE);
   g_return_val_if_fail (config != NULL, FALSE);
 
+  /* the converter was made for a different config, don't reuse it */
+  convert->cacheable = FALSE;
+
   gst_structure_foreach (config, copy_config, convert);
   gst_structure_free (config);
 
@@ -2359,7 +2762,309 @@ gst_video_converter_frame (GstVideoConverter * convert,
   g_return_if_fail (src != NULL);
   g_return_if_fail (dest != NULL);
 
+  video_converter_run (convert, src, dest);
+}
+
+/**
+ * gst_video_converter_get_stats:
+ * @convert: a #GstVideoConverter
+ *
+ * Get the time spent in the conversions done by @convert so far. This needs
+ * the #GST_VIDEO_CONVERTER_OPT_STATS option.
+ *
+ * The structure has the number of converted "frames" and the total "time"
+ * as #G_TYPE_UINT64 and a "fastpath" boolean. When no fastpath is used it
+ * also has a #G_TYPE_UINT64 field with the time of each stage: "unpack",
+ * "upsample", "to-rgb", "hscale", "vscale", "convert", "alpha", "to-yuv",
+ * "downsample", "dither" and "pack". Times are in nanoseconds. When more
+ * than one thread is used, the stage times of all threads are added up.
+ *
+ * Returns: (transfer full) (nullable): a new #GstStructure or %NULL when
+ *   statistics are not enabled.
+ *
+ * Since: 1.8
+ */
+GstStructure *
+gst_video_converter_get_stats (GstVideoConverter * convert)
+{
+  GstVideoConverter *first;
+  GstStructure *s;
+  guint64 stage_time[N_STAGES] = { 0, };
+  gboolean fastpath;
+  guint i, j;
+
+  g_return_val_if_fail (convert != NULL, NULL);
+
+  if (!convert->stats.enabled)
+    return NULL;
+
+  if (convert->n_bands > 0) {
+    for (i = 0; i < convert->n_bands; i++)
+      for (j = 0; j < N_STAGES; j++)
+        stage_time[j] += convert->bands[i]->stats.stage_time[j];
+    first = convert->bands[0];
+  } else {
+    for (j = 0; j < N_STAGES; j++)
+      stage_time[j] = convert->stats.stage_time[j];
+    first = convert;
+  }
+  fastpath = first->convert != video_converter_generic;
+
+  s = gst_structure_new ("GstVideoConverterStats",
+      "frames", G_TYPE_UINT64, convert->stats.frames,
+      "time", G_TYPE_UINT64, convert->stats.time,
+      "fastpath", G_TYPE_BOOLEAN, fastpath, NULL);
+
+  if (!fastpath) {
+    for (j = 0; j < N_STAGES; j++)
+      gst_structure_set (s, stage_names[j], G_TYPE_UINT64, stage_time[j],
+          NULL);
+  }
+  return s;
+}
+
+typedef struct
+{
+  GstVideoConverter *convert;
+  GstVideoConverter *band;
+  const GstVideoFrame *src;
+  GstVideoFrame *dest;
+} ConverterBand;
+
+static void
+shift_frame (GstVideoFrame * frame, gint lines)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  gint i;
+
+  for (i = 0; i < GST_VIDEO_FRAME_N_PLANES (frame); i++) {
+    frame->data[i] = (guint8 *) frame->data[i] +
+        GST_VIDEO_FRAME_PLANE_STRIDE (frame, i) *
+        GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (finfo, i, lines);
+  }
+}
+
+static void
+video_converter_run (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  ConverterStats *stats = &convert->stats;
+  GstClockTime start, elapsed;
+
+  if (G_LIKELY (!stats->enabled)) {
+    convert->convert (convert, src, dest);
+    return;
+  }
+
+  stats->child_time = 0;
+  start = gst_util_get_timestamp ();
   convert->convert (convert, src, dest);
+  elapsed = gst_util_get_timestamp () - start;
+
+  /* whatever the line stages did not take was spent packing */
+  if (convert->convert == video_converter_generic)
+    stats->stage_time[STAGE_PACK] += elapsed - stats->child_time;
+  stats->time += elapsed;
+  stats->frames++;
+}
+
+static void
+convert_band (GstVideoConverter * band, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  if (band->band_shift) {
+    GstVideoFrame s = *src, d = *dest;
+
+    /* the fastpath only knows about full frames, make it see the band
+     * as a frame of band_height lines */
+    shift_frame (&s, band->band_y);
+    shift_frame (&d, band->band_y);
+    video_converter_run (band, &s, &d);
+  } else {
+    video_converter_run (band, src, dest);
+  }
+}
+
+static void
+convert_band_func (gpointer data, gpointer user_data)
+{
+  ConverterBand *task = data;
+  GstVideoConverter *convert = task->convert;
+
+  convert_band (task->band, task->src, task->dest);
+
+  g_mutex_lock (&convert->bands_lock);
+  if (--convert->bands_pending == 0)
+    g_cond_signal (&convert->bands_cond);
+  g_mutex_unlock (&convert->bands_lock);
+}
+
+static GThreadPool *
+get_bands_pool (void)
+{
+  static gsize pool_gonce = 0;
+
+  if (g_once_init_enter (&pool_gonce)) {
+    GThreadPool *pool;
+
+    /* shared between all converters, tasks never block so the pool can't
+     * deadlock when more converters are active than there are threads */
+    pool = g_thread_pool_new (convert_band_func, NULL,
+        g_get_num_processors (), FALSE, NULL);
+
+    g_once_init_leave (&pool_gonce, (gsize) pool);
+  }
+  return (GThreadPool *) pool_gonce;
+}
+
+static void
+video_converter_threaded (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  GThreadPool *pool;
+  ConverterBand *tasks;
+  guint i;
+
+  pool = get_bands_pool ();
+  tasks = g_newa (ConverterBand, convert->n_bands);
+
+  convert->bands_pending = convert->n_bands - 1;
+
+  /* the first band is done in this thread */
+  for (i = 1; i < convert->n_bands; i++) {
+    tasks[i].convert = convert;
+    tasks[i].band = convert->bands[i];
+    tasks[i].src = src;
+    tasks[i].dest = dest;
+    g_thread_pool_push (pool, &tasks[i], NULL);
+  }
+  convert_band (convert->bands[0], src, dest);
+
+  g_mutex_lock (&convert->bands_lock);
+  while (convert->bands_pending > 0)
+    g_cond_wait (&convert->bands_cond, &convert->bands_lock);
+  g_mutex_unlock (&convert->bands_lock);
+
+  if (convert->bands_fill_border)
+    convert_fill_border (convert, dest);
+}
+
+static void
+setup_bands (GstVideoConverter * convert)
+{
+  GstStructure *config;
+  const GstVideoFormatInfo *out_finfo;
+  guint n_threads, n_bands, i;
+  gint out_height, band_height, j;
+  gboolean shift;
+
+  n_threads = GET_OPT_THREADS (convert);
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+  if (n_threads < 2)
+    return;
+
+  if (convert->convert == video_converter_generic) {
+    /* error diffusion carries state from one line to the next */
+    if (convert->dither &&
+        GET_OPT_DITHER_METHOD (convert) != GST_VIDEO_DITHER_BAYER)
+      return;
+    shift = FALSE;
+  } else if (convert->convert == convert_scale_planes) {
+    shift = FALSE;
+  } else if (convert->in_height == convert->out_height &&
+      !GST_VIDEO_FORMAT_INFO_IS_TILED (convert->in_info.finfo)) {
+    /* tiled planes can't be shifted by whole lines */
+    shift = TRUE;
+  } else {
+    return;
+  }
+
+  /* make bands a multiple of 8 lines so that subsampled and interlaced
+   * chroma lines never straddle two bands */
+  out_height = convert->out_height;
+  band_height = GST_ROUND_UP_8 ((out_height + n_threads - 1) / n_threads);
+  if (band_height == 0)
+    return;
+  n_bands = (out_height + band_height - 1) / band_height;
+  if (n_bands < 2)
+    return;
+
+  GST_DEBUG ("using %u bands of %d lines", n_bands, band_height);
+
+  config = gst_structure_copy (convert->config);
+  gst_structure_set (config, GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, 1,
+      NULL);
+
+  out_finfo = convert->out_info.finfo;
+
+  convert->bands = g_new0 (GstVideoConverter *, n_bands);
+  for (i = 0; i < n_bands; i++) {
+    GstVideoConverter *band;
+
+    /* bands are owned by the converter, don't count them in the cache
+     * stats */
+    band = video_converter_new (&convert->in_info, &convert->out_info,
+        gst_structure_copy (config));
+    if (band == NULL)
+      goto band_failed;
+
+    convert->bands[convert->n_bands++] = band;
+
+    band->band_y = i * band_height;
+    band->band_height = MIN (band_height, out_height - band->band_y);
+    band->band_shift = shift;
+
+    if (band->convert == video_converter_generic) {
+      gint width;
+
+      /* lines outside of the band go to a scratch area so that we don't
+       * write into the lines of the other bands. It needs as many lines as
+       * the caches can hold from the dest allocator at the same time */
+      width = MAX (band->in_maxwidth, band->out_maxwidth) + band->out_x;
+      band->band_stride = sizeof (guint16) * width * 4;
+      band->band_n_lines = MAX (band->dest_n_lines, 1);
+      band->band_lines = g_malloc0 (band->band_stride * band->band_n_lines);
+    } else {
+      /* borders are done once for the complete frame */
+      band->fill_border = FALSE;
+
+      if (shift) {
+        band->in_height = band->band_height;
+        band->out_height = band->band_height;
+      } else {
+        for (j = 0; j < GST_VIDEO_INFO_N_PLANES (&band->out_info); j++) {
+          gint y1, y2;
+
+          y1 = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (out_finfo, j, band->band_y);
+          y2 = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (out_finfo, j,
+              band->band_y + band->band_height);
+
+          band->fband_y[j] = y1;
+          band->fout_height[j] = y2 - y1;
+        }
+      }
+    }
+  }
+  gst_structure_free (config);
+
+  convert->bands_fill_border = convert->convert != video_converter_generic;
+  convert->convert = video_converter_threaded;
+
+  return;
+
+  /* ERRORS */
+band_failed:
+  {
+    GST_WARNING ("failed to create band converter, not using threads");
+    for (i = 0; i < convert->n_bands; i++)
+      video_converter_free (convert->bands[i]);
+    g_free (convert->bands);
+    convert->bands = NULL;
+    convert->n_bands = 0;
+    gst_structure_free (config);
+    return;
+  }
 }
 
 static void
@@ -2471,6 +3176,19 @@ get_dest_line (GstLineCache * cache, gint idx, gpointer user_data)
   gint out_x = convert->out_x;
   guint cline;
 
+  if (convert->band_lines) {
+    gint y = idx - convert->out_y;
+
+    /* the lines of the other bands go to the scratch area */
+    if (y >= 0 && y < convert->out_height &&
+        (y < convert->band_y || y >= convert->band_y + convert->band_height)) {
+      line = convert->band_lines + convert->band_idx * convert->band_stride;
+      convert->band_idx = (convert->band_idx + 1) % convert->band_n_lines;
+      GST_DEBUG ("get scratch line %d %p", idx, line);
+      return line + out_x * pstride;
+    }
+  }
+
   cline = CLAMP (idx, 0, convert->out_maxheight - 1);
 
   line = FRAME_GET_LINE (convert->dest, cline);
@@ -2520,14 +3238,15 @@ do_upsample_lines (GstLineCache * cache, gint out_line, gint in_line,
 {
   GstVideoConverter *convert = user_data;
   gpointer *lines;
-  gint i, start_line, n_lines;
+  gint i, start_line, n_lines, phase;
 
   n_lines = convert->up_n_lines;
-  start_line = in_line;
-  if (start_line < n_lines + convert->up_offset) {
-    start_line += convert->up_offset;
-    out_line += convert->up_offset;
-  }
+  /* chroma is upsampled in groups of n_lines starting at up_offset */
+  phase = (in_line - convert->up_offset) % n_lines;
+  if (phase < 0)
+    phase += n_lines;
+  start_line = in_line - phase;
+  out_line -= phase;
 
   /* get the lines needed for chroma upsample */
   lines = gst_line_cache_get_lines (cache->prev, out_line, start_line, n_lines);
@@ -2720,12 +3439,14 @@ do_downsample_lines (GstLineCache * cache, gint out_line, gint in_line,
 {
   GstVideoConverter *convert = user_data;
   gpointer *lines;
-  gint i, start_line, n_lines;
+  gint i, start_line, n_lines, phase;
 
   n_lines = convert->down_n_lines;
-  start_line = in_line;
-  if (start_line < n_lines + convert->down_offset)
-    start_line += convert->down_offset;
+  /* chroma is downsampled in groups of n_lines starting at down_offset */
+  phase = (in_line - convert->down_offset) % n_lines;
+  if (phase < 0)
+    phase += n_lines;
+  start_line = in_line - phase;
 
   /* get the lines needed for chroma downsample */
   lines = gst_line_cache_get_lines (cache->prev, out_line, start_line, n_lines);
@@ -2771,8 +3492,11 @@ video_converter_generic (GstVideoConverter * convert, const GstVideoFrame * src,
   gint out_x, out_y, out_height;
   gint pack_lines, pstride;
   gint lb_width;
+  gint band_y, band_end;
 
   out_height = convert->out_height;
+  band_y = convert->band_y;
+  band_end = band_y + convert->band_height;
   out_maxwidth = convert->out_maxwidth;
   out_maxheight = convert->out_maxheight;
 
@@ -2813,13 +3537,22 @@ video_converter_generic (GstVideoConverter * convert, const GstVideoFrame * src,
 
   lb_width = out_x * pstride;
 
-  if (convert->borderline) {
+  if (convert->band_lines) {
+    GstLineCache *cache;
+
+    /* lines of the previous frame can't be reused when we start in the
+     * middle of the frame */
+    for (cache = convert->pack_lines; cache; cache = cache->prev)
+      gst_line_cache_clear (cache);
+  }
+
+  if (convert->borderline && band_y == 0) {
     /* FIXME we should try to avoid PACK_FRAME */
     for (i = 0; i < out_y; i++)
       PACK_FRAME (dest, convert->borderline, i, out_maxwidth);
   }
 
-  for (i = 0; i < out_height; i += pack_lines) {
+  for (i = band_y; i < band_end; i += pack_lines) {
     gpointer *lines;
 
     /* load the lines needed to pack */
@@ -2835,6 +3568,9 @@ video_converter_generic (GstVideoConverter * convert, const GstVideoFrame * src,
     }
   }
 
+  if (band_end < out_height)
+    return;
+
   if (convert->borderline) {
     for (i = out_y + out_height; i < out_maxheight; i++)
       PACK_FRAME (dest, convert->borderline, i, out_maxwidth);
@@ -2845,9 +3581,6 @@ video_converter_generic (GstVideoConverter * convert, const GstVideoFrame * src,
   }
 }
 
-static void convert_fill_border (GstVideoConverter * convert,
-    GstVideoFrame * dest);
-
 /* Fast paths */
 
 #define GET_LINE_OFFSETS(interlaced,line,l1,l2) \
@@ -3046,6 +3779,511 @@ convert_YUY2_Y444 (GstVideoConverter * convert, const GstVideoFrame * src,
 }
 
 
+/* the kernels below do the conversion line by line in one pass without
+ * going through the intermediate AYUV lines of the generic path */
+static void
+interleave_u8 (guint8 * d, const guint8 * s1, const guint8 * s2, gint n)
+{
+  gint i;
+
+  for (i = 0; i < n; i++) {
+    d[2 * i + 0] = s1[i];
+    d[2 * i + 1] = s2[i];
+  }
+}
+
+static void
+deinterleave_u8 (guint8 * d1, guint8 * d2, const guint8 * s, gint n)
+{
+  gint i;
+
+  for (i = 0; i < n; i++) {
+    d1[i] = s[2 * i + 0];
+    d2[i] = s[2 * i + 1];
+  }
+}
+
+static void
+convert_NV12_I420 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  video_orc_memcpy_2d (FRAME_GET_Y_LINE (dest, 0), FRAME_GET_Y_STRIDE (dest),
+      FRAME_GET_Y_LINE (src, 0), FRAME_GET_Y_STRIDE (src), width, height);
+
+  for (i = 0; i < (height + 1) / 2; i++) {
+    deinterleave_u8 (FRAME_GET_U_LINE (dest, i), FRAME_GET_V_LINE (dest, i),
+        FRAME_GET_U_LINE (src, i), (width + 1) / 2);
+  }
+}
+
+static void
+convert_I420_NV12 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  video_orc_memcpy_2d (FRAME_GET_Y_LINE (dest, 0), FRAME_GET_Y_STRIDE (dest),
+      FRAME_GET_Y_LINE (src, 0), FRAME_GET_Y_STRIDE (src), width, height);
+
+  for (i = 0; i < (height + 1) / 2; i++) {
+    interleave_u8 (FRAME_GET_U_LINE (dest, i), FRAME_GET_U_LINE (src, i),
+        FRAME_GET_V_LINE (src, i), (width + 1) / 2);
+  }
+}
+
+/* Copies @height lines of @width bytes out of an indexed tiled plane into
+ * @d1. When @d2 is not NULL, the lines are deinterleaved into @d1 and @d2
+ * instead. We walk the image one complete tile at a time so that the tile
+ * memory is read linearly and every tile index is computed only once. */
+static void
+detile_plane (const GstVideoFormatInfo * finfo, guint8 * d1, gint d1stride,
+    guint8 * d2, gint d2stride, const guint8 * s, gint sstride, gint width,
+    gint height)
+{
+  GstVideoTileMode mode = GST_VIDEO_FORMAT_INFO_TILE_MODE (finfo);
+  gint ws = GST_VIDEO_FORMAT_INFO_TILE_WS (finfo);
+  gint hs = GST_VIDEO_FORMAT_INFO_TILE_HS (finfo);
+  gint tile_width = 1 << ws, tile_height = 1 << hs;
+  gint x_tiles = GST_VIDEO_TILE_X_TILES (sstride);
+  gint y_tiles = GST_VIDEO_TILE_Y_TILES (sstride);
+  gint tx, ty, i;
+
+  for (ty = 0; ty < y_tiles && (ty << hs) < height; ty++) {
+    gint lines = MIN (tile_height, height - (ty << hs));
+
+    for (tx = 0; tx < x_tiles && (tx << ws) < width; tx++) {
+      gint x = tx << ws;
+      gint w = MIN (tile_width, width - x);
+      const guint8 *t;
+
+      t = s + ((gsize) gst_video_tile_get_index (mode, tx, ty, x_tiles,
+              y_tiles) << (ws + hs));
+
+      if (d2 == NULL) {
+        guint8 *d = d1 + (ty << hs) * d1stride + x;
+
+        for (i = 0; i < lines; i++) {
+          memcpy (d, t, w);
+          d += d1stride;
+          t += tile_width;
+        }
+      } else {
+        guint8 *du = d1 + (ty << hs) * d1stride + x / 2;
+        guint8 *dv = d2 + (ty << hs) * d2stride + x / 2;
+
+        for (i = 0; i < lines; i++) {
+          deinterleave_u8 (du, dv, t, w / 2);
+          du += d1stride;
+          dv += d2stride;
+          t += tile_width;
+        }
+      }
+    }
+  }
+}
+
+static void
+convert_NV12_64Z32_NV12 (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  const GstVideoFormatInfo *finfo = src->info.finfo;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  detile_plane (finfo, FRAME_GET_PLANE_LINE (dest, 0, 0),
+      FRAME_GET_PLANE_STRIDE (dest, 0), NULL, 0,
+      FRAME_GET_PLANE_LINE (src, 0, 0), FRAME_GET_PLANE_STRIDE (src, 0),
+      width, height);
+  detile_plane (finfo, FRAME_GET_PLANE_LINE (dest, 1, 0),
+      FRAME_GET_PLANE_STRIDE (dest, 1), NULL, 0,
+      FRAME_GET_PLANE_LINE (src, 1, 0), FRAME_GET_PLANE_STRIDE (src, 1),
+      GST_ROUND_UP_2 (width), (height + 1) / 2);
+}
+
+static void
+convert_NV12_64Z32_I420 (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  const GstVideoFormatInfo *finfo = src->info.finfo;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  detile_plane (finfo, FRAME_GET_Y_LINE (dest, 0), FRAME_GET_Y_STRIDE (dest),
+      NULL, 0, FRAME_GET_PLANE_LINE (src, 0, 0),
+      FRAME_GET_PLANE_STRIDE (src, 0), width, height);
+  detile_plane (finfo, FRAME_GET_U_LINE (dest, 0), FRAME_GET_U_STRIDE (dest),
+      FRAME_GET_V_LINE (dest, 0), FRAME_GET_V_STRIDE (dest),
+      FRAME_GET_PLANE_LINE (src, 1, 0), FRAME_GET_PLANE_STRIDE (src, 1),
+      GST_ROUND_UP_2 (width), (height + 1) / 2);
+}
+
+static void
+convert_YUY2_NV12 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gboolean interlaced = GST_VIDEO_FRAME_IS_INTERLACED (src);
+  guint8 *tu, *tv;
+  gint l1, l2, uv_width;
+
+  uv_width = (width + 1) / 2;
+  tu = (guint8 *) convert->tmpline;
+  tv = tu + GST_ROUND_UP_8 (uv_width);
+
+  for (i = 0; i < GST_ROUND_DOWN_2 (height); i += 2) {
+    GET_LINE_OFFSETS (interlaced, i, l1, l2);
+
+    video_orc_convert_YUY2_I420 (FRAME_GET_Y_LINE (dest, l1),
+        FRAME_GET_Y_LINE (dest, l2), tu, tv,
+        FRAME_GET_LINE (src, l1), FRAME_GET_LINE (src, l2), uv_width);
+    interleave_u8 (FRAME_GET_U_LINE (dest, i >> 1), tu, tv, uv_width);
+  }
+
+  /* now handle last line */
+  if (height & 1) {
+    UNPACK_FRAME (src, convert->tmpline, height - 1, convert->in_x, width);
+    PACK_FRAME (dest, convert->tmpline, height - 1, width);
+  }
+}
+
+/* 10 bits kernels, the planar samples are all little endian */
+#define READ_10LE(s) (GST_READ_UINT16_LE (s) & 0x3ff)
+
+/* unpacks a v210 line straight into planar 10 bits Y, U and V */
+static void
+unpack_v210_planar (guint16 * dy, guint16 * du, guint16 * dv,
+    const guint8 * s, gint width)
+{
+  gint i;
+  guint32 a0, a1, a2, a3;
+
+  for (i = 0; i < width; i += 6) {
+    a0 = GST_READ_UINT32_LE (s + 0);
+    a1 = GST_READ_UINT32_LE (s + 4);
+    a2 = GST_READ_UINT32_LE (s + 8);
+    a3 = GST_READ_UINT32_LE (s + 12);
+    s += 16;
+
+    GST_WRITE_UINT16_LE (du + (i >> 1), a0 & 0x3ff);
+    GST_WRITE_UINT16_LE (dy + i, (a0 >> 10) & 0x3ff);
+    GST_WRITE_UINT16_LE (dv + (i >> 1), (a0 >> 20) & 0x3ff);
+    if (i + 1 < width)
+      GST_WRITE_UINT16_LE (dy + i + 1, a1 & 0x3ff);
+    if (i + 2 < width) {
+      GST_WRITE_UINT16_LE (du + (i >> 1) + 1, (a1 >> 10) & 0x3ff);
+      GST_WRITE_UINT16_LE (dy + i + 2, (a1 >> 20) & 0x3ff);
+      GST_WRITE_UINT16_LE (dv + (i >> 1) + 1, a2 & 0x3ff);
+    }
+    if (i + 3 < width)
+      GST_WRITE_UINT16_LE (dy + i + 3, (a2 >> 10) & 0x3ff);
+    if (i + 4 < width) {
+      GST_WRITE_UINT16_LE (du + (i >> 1) + 2, (a2 >> 20) & 0x3ff);
+      GST_WRITE_UINT16_LE (dy + i + 4, a3 & 0x3ff);
+      GST_WRITE_UINT16_LE (dv + (i >> 1) + 2, (a3 >> 10) & 0x3ff);
+    }
+    if (i + 5 < width)
+      GST_WRITE_UINT16_LE (dy + i + 5, (a3 >> 20) & 0x3ff);
+  }
+}
+
+/* packs planar 10 bits Y, U and V into a v210 line, the last group is
+ * padded by repeating the last pixel like pack_v210 does */
+static void
+pack_planar_v210 (guint8 * d, const guint16 * sy, const guint16 * su,
+    const guint16 * sv, gint width)
+{
+  gint i;
+  guint32 y0, y1, y2, y3, y4, y5;
+  guint32 u0, u1, u2, v0, v1, v2;
+
+  for (i = 0; i < width; i += 6) {
+    y0 = READ_10LE (sy + i);
+    u0 = READ_10LE (su + (i >> 1));
+    v0 = READ_10LE (sv + (i >> 1));
+    y1 = i + 1 < width ? READ_10LE (sy + i + 1) : y0;
+    if (i + 2 < width) {
+      y2 = READ_10LE (sy + i + 2);
+      u1 = READ_10LE (su + (i >> 1) + 1);
+      v1 = READ_10LE (sv + (i >> 1) + 1);
+    } else {
+      y2 = y1;
+      u1 = u0;
+      v1 = v0;
+    }
+    y3 = i + 3 < width ? READ_10LE (sy + i + 3) : y2;
+    if (i + 4 < width) {
+      y4 = READ_10LE (sy + i + 4);
+      u2 = READ_10LE (su + (i >> 1) + 2);
+      v2 = READ_10LE (sv + (i >> 1) + 2);
+    } else {
+      y4 = y3;
+      u2 = u1;
+      v2 = v1;
+    }
+    y5 = i + 5 < width ? READ_10LE (sy + i + 5) : y4;
+
+    GST_WRITE_UINT32_LE (d + 0, u0 | (y0 << 10) | (v0 << 20));
+    GST_WRITE_UINT32_LE (d + 4, y1 | (u1 << 10) | (y2 << 20));
+    GST_WRITE_UINT32_LE (d + 8, v1 | (y3 << 10) | (u2 << 20));
+    GST_WRITE_UINT32_LE (d + 12, y4 | (v2 << 10) | (y5 << 20));
+    d += 16;
+  }
+}
+
+/* rounds a 10 bits sample to 8 bits */
+#define ROUND_10_TO_8(v) MIN (((v) + 2) >> 2, 255)
+
+static void
+convert_v210_I420 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i, j;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gboolean interlaced = GST_VIDEO_FRAME_IS_INTERLACED (src);
+  gint uv_width = (width + 1) / 2;
+  guint16 *ty, *tu1, *tv1, *tu2, *tv2;
+  guint8 *dy, *du, *dv;
+  gint l1, l2;
+
+  ty = convert->tmpline;
+  tu1 = ty + width;
+  tv1 = tu1 + uv_width;
+  tu2 = tv1 + uv_width;
+  tv2 = tu2 + uv_width;
+
+  /* unpack each v210 line once into planar 10 bits, average the chroma of
+   * the two lines at 10 bits and round all samples to 8 bits once, like
+   * the generic path does */
+  for (i = 0; i < GST_ROUND_DOWN_2 (height); i += 2) {
+    GET_LINE_OFFSETS (interlaced, i, l1, l2);
+
+    unpack_v210_planar (ty, tu1, tv1, FRAME_GET_LINE (src, l1), width);
+    dy = FRAME_GET_Y_LINE (dest, l1);
+    for (j = 0; j < width; j++)
+      dy[j] = ROUND_10_TO_8 (READ_10LE (ty + j));
+
+    unpack_v210_planar (ty, tu2, tv2, FRAME_GET_LINE (src, l2), width);
+    dy = FRAME_GET_Y_LINE (dest, l2);
+    for (j = 0; j < width; j++)
+      dy[j] = ROUND_10_TO_8 (READ_10LE (ty + j));
+
+    du = FRAME_GET_U_LINE (dest, i >> 1);
+    dv = FRAME_GET_V_LINE (dest, i >> 1);
+    for (j = 0; j < uv_width; j++) {
+      du[j] = ROUND_10_TO_8 ((READ_10LE (tu1 + j) + READ_10LE (tu2 + j) +
+              1) >> 1);
+      dv[j] = ROUND_10_TO_8 ((READ_10LE (tv1 + j) + READ_10LE (tv2 + j) +
+              1) >> 1);
+    }
+  }
+
+  /* now handle last line */
+  if (height & 1) {
+    unpack_v210_planar (ty, tu1, tv1, FRAME_GET_LINE (src, height - 1),
+        width);
+    dy = FRAME_GET_Y_LINE (dest, height - 1);
+    du = FRAME_GET_U_LINE (dest, (height - 1) >> 1);
+    dv = FRAME_GET_V_LINE (dest, (height - 1) >> 1);
+    for (j = 0; j < width; j++)
+      dy[j] = ROUND_10_TO_8 (READ_10LE (ty + j));
+    for (j = 0; j < uv_width; j++) {
+      du[j] = ROUND_10_TO_8 (READ_10LE (tu1 + j));
+      dv[j] = ROUND_10_TO_8 (READ_10LE (tv1 + j));
+    }
+  }
+}
+
+static void
+convert_v210_I420_10LE (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  int i, j;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gboolean interlaced = GST_VIDEO_FRAME_IS_INTERLACED (src);
+  gint uv_width = (width + 1) / 2;
+  guint16 *tu, *tv, *du, *dv;
+  gint l1, l2;
+
+  tu = convert->tmpline;
+  tv = tu + GST_ROUND_UP_8 (uv_width);
+
+  /* the chroma of the second line is averaged with the first one */
+  for (i = 0; i < GST_ROUND_DOWN_2 (height); i += 2) {
+    GET_LINE_OFFSETS (interlaced, i, l1, l2);
+
+    du = FRAME_GET_U_LINE (dest, i >> 1);
+    dv = FRAME_GET_V_LINE (dest, i >> 1);
+
+    unpack_v210_planar (FRAME_GET_Y_LINE (dest, l1), du, dv,
+        FRAME_GET_LINE (src, l1), width);
+    unpack_v210_planar (FRAME_GET_Y_LINE (dest, l2), tu, tv,
+        FRAME_GET_LINE (src, l2), width);
+
+    for (j = 0; j < uv_width; j++) {
+      GST_WRITE_UINT16_LE (du + j,
+          (READ_10LE (du + j) + READ_10LE (tu + j) + 1) >> 1);
+      GST_WRITE_UINT16_LE (dv + j,
+          (READ_10LE (dv + j) + READ_10LE (tv + j) + 1) >> 1);
+    }
+  }
+
+  /* now handle last line */
+  if (height & 1) {
+    unpack_v210_planar (FRAME_GET_Y_LINE (dest, height - 1),
+        FRAME_GET_U_LINE (dest, (height - 1) >> 1),
+        FRAME_GET_V_LINE (dest, (height - 1) >> 1),
+        FRAME_GET_LINE (src, height - 1), width);
+  }
+}
+
+static void
+convert_I420_10LE_v210 (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gboolean interlaced = GST_VIDEO_FRAME_IS_INTERLACED (src);
+
+  /* every chroma line is used for the two lines it was made from */
+  for (i = 0; i < height; i++) {
+    gint uv = interlaced ? ((i & ~3) >> 1) + (i & 1) : i >> 1;
+
+    pack_planar_v210 (FRAME_GET_LINE (dest, i), FRAME_GET_Y_LINE (src, i),
+        FRAME_GET_U_LINE (src, uv), FRAME_GET_V_LINE (src, uv), width);
+  }
+}
+
+static void
+convert_I420_10LE_P010_10LE (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  int i, j;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  for (i = 0; i < height; i++) {
+    const guint16 *sy = FRAME_GET_Y_LINE (src, i);
+    guint16 *dy = FRAME_GET_Y_LINE (dest, i);
+
+    for (j = 0; j < width; j++)
+      GST_WRITE_UINT16_LE (dy + j, READ_10LE (sy + j) << 6);
+  }
+  for (i = 0; i < (height + 1) / 2; i++) {
+    const guint16 *su = FRAME_GET_U_LINE (src, i);
+    const guint16 *sv = FRAME_GET_V_LINE (src, i);
+    guint16 *duv = FRAME_GET_PLANE_LINE (dest, 1, i);
+
+    for (j = 0; j < (width + 1) / 2; j++) {
+      GST_WRITE_UINT16_LE (duv + 2 * j, READ_10LE (su + j) << 6);
+      GST_WRITE_UINT16_LE (duv + 2 * j + 1, READ_10LE (sv + j) << 6);
+    }
+  }
+}
+
+static void
+convert_P010_10LE_I420_10LE (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  int i, j;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  for (i = 0; i < height; i++) {
+    const guint16 *sy = FRAME_GET_Y_LINE (src, i);
+    guint16 *dy = FRAME_GET_Y_LINE (dest, i);
+
+    for (j = 0; j < width; j++)
+      GST_WRITE_UINT16_LE (dy + j, GST_READ_UINT16_LE (sy + j) >> 6);
+  }
+  for (i = 0; i < (height + 1) / 2; i++) {
+    const guint16 *suv = FRAME_GET_PLANE_LINE (src, 1, i);
+    guint16 *du = FRAME_GET_U_LINE (dest, i);
+    guint16 *dv = FRAME_GET_V_LINE (dest, i);
+
+    for (j = 0; j < (width + 1) / 2; j++) {
+      GST_WRITE_UINT16_LE (du + j, GST_READ_UINT16_LE (suv + 2 * j) >> 6);
+      GST_WRITE_UINT16_LE (dv + j, GST_READ_UINT16_LE (suv + 2 * j + 1) >> 6);
+    }
+  }
+}
+
+/* ordered dither thresholds for dropping 2 bits, this is the 2x2 Bayer
+ * matrix. Error diffusion methods don't use these fastpaths. */
+static const guint8 dither_10_8[3][2] = {
+  {0, 2}, {3, 1}, {0, 0}
+};
+
+#define DITHER_10_8(dither,line) dither_10_8[(dither) ? ((line) & 1) : 2]
+
+/* reduces @n samples with the 10 bits at @shift to 8 bits, @cstep is the
+ * number of interleaved components so that they all get the same threshold */
+static void
+dither_line_10_8 (guint8 * d, const guint16 * s, gint n, gint shift,
+    gint cstep, const guint8 * dither)
+{
+  gint i;
+
+  for (i = 0; i < n; i++) {
+    guint v = (GST_READ_UINT16_LE (s + i) >> shift) & 0x3ff;
+
+    v = (v + dither[(i / cstep) & 1]) >> 2;
+    d[i] = MIN (v, 255);
+  }
+}
+
+static void
+convert_I420_10LE_I420 (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gboolean dither = GET_OPT_DITHER_METHOD (convert) != GST_VIDEO_DITHER_NONE;
+
+  for (i = 0; i < height; i++) {
+    dither_line_10_8 (FRAME_GET_Y_LINE (dest, i), FRAME_GET_Y_LINE (src, i),
+        width, 0, 1, DITHER_10_8 (dither, i));
+  }
+  for (i = 0; i < (height + 1) / 2; i++) {
+    dither_line_10_8 (FRAME_GET_U_LINE (dest, i), FRAME_GET_U_LINE (src, i),
+        (width + 1) / 2, 0, 1, DITHER_10_8 (dither, i));
+    dither_line_10_8 (FRAME_GET_V_LINE (dest, i), FRAME_GET_V_LINE (src, i),
+        (width + 1) / 2, 0, 1, DITHER_10_8 (dither, i));
+  }
+}
+
+static void
+convert_P010_10LE_NV12 (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gboolean dither = GET_OPT_DITHER_METHOD (convert) != GST_VIDEO_DITHER_NONE;
+
+  for (i = 0; i < height; i++) {
+    dither_line_10_8 (FRAME_GET_PLANE_LINE (dest, 0, i),
+        FRAME_GET_PLANE_LINE (src, 0, i), width, 6, 1,
+        DITHER_10_8 (dither, i));
+  }
+  for (i = 0; i < (height + 1) / 2; i++) {
+    dither_line_10_8 (FRAME_GET_PLANE_LINE (dest, 1, i),
+        FRAME_GET_PLANE_LINE (src, 1, i), GST_ROUND_UP_2 (width), 6, 2,
+        DITHER_10_8 (dither, i));
+  }
+}
+
 static void
 convert_UYVY_I420 (GstVideoConverter * convert, const GstVideoFrame * src,
     GstVideoFrame * dest)
@@ -3573,6 +4811,228 @@ convert_I420_BGRA (GstVideoConverter * convert, const GstVideoFrame * src,
   }
   convert_fill_border (convert, dest);
 }
+
+/* scales the AYUV line @tmp of the cropped input width to the output width
+ * when the fastpath has a horizontal scaler, returns the scaled line */
+static guint8 *
+hscale_AYUV_line (GstVideoConverter * convert, guint8 * tmp)
+{
+  guint8 *d;
+
+  if (convert->h_scaler == NULL)
+    return tmp;
+
+  d = tmp + GST_ROUND_UP_16 (convert->in_width * 4);
+  gst_video_scaler_horizontal (convert->h_scaler, GST_VIDEO_FORMAT_AYUV,
+      tmp, d, 0, convert->out_width);
+
+  return d;
+}
+
+static void
+convert_I420_RGBA (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gint out_width = convert->out_width;
+  MatrixData *data = &convert->convert_matrix;
+  guint8 *tmp = convert->tmpline;
+
+  /* upsample, scale and convert one line at a time, the AYUV lines stay in
+   * cache */
+  for (i = 0; i < height; i++) {
+    guint8 *sy, *su, *sv, *d, *l;
+
+    d = FRAME_GET_LINE (dest, i + convert->out_y);
+    d += (convert->out_x * 4);
+    sy = FRAME_GET_Y_LINE (src, i + convert->in_y);
+    sy += convert->in_x;
+    su = FRAME_GET_U_LINE (src, (i + convert->in_y) >> 1);
+    su += (convert->in_x >> 1);
+    sv = FRAME_GET_V_LINE (src, (i + convert->in_y) >> 1);
+    sv += (convert->in_x >> 1);
+
+    video_orc_unpack_I420 (tmp, sy, su, sv, width);
+    l = hscale_AYUV_line (convert, tmp);
+    video_orc_convert_AYUV_RGBA (d, 0, l, 0,
+        data->im[0][0], data->im[0][2],
+        data->im[2][1], data->im[1][1], data->im[1][2], out_width, 1);
+  }
+  convert_fill_border (convert, dest);
+}
+
+static void
+unpack_NV12_line (guint8 * d, const guint8 * sy, const guint8 * suv,
+    gint width)
+{
+  video_orc_unpack_NV12 (d, sy, suv, width / 2);
+  if (width & 1) {
+    d += (width - 1) * 4;
+    d[0] = 0xff;
+    d[1] = sy[width - 1];
+    d[2] = suv[width - 1];
+    d[3] = suv[width];
+  }
+}
+
+static void
+convert_NV12_BGRA (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gint out_width = convert->out_width;
+  MatrixData *data = &convert->convert_matrix;
+  guint8 *tmp = convert->tmpline;
+
+  for (i = 0; i < height; i++) {
+    guint8 *sy, *suv, *d, *l;
+
+    d = FRAME_GET_LINE (dest, i + convert->out_y);
+    d += (convert->out_x * 4);
+    sy = FRAME_GET_Y_LINE (src, i + convert->in_y);
+    sy += convert->in_x;
+    /* the UV plane interleaves the chroma, start on a U sample */
+    suv = FRAME_GET_U_LINE (src, (i + convert->in_y) >> 1);
+    suv += GST_ROUND_DOWN_2 (convert->in_x);
+
+    unpack_NV12_line (tmp, sy, suv, width);
+    l = hscale_AYUV_line (convert, tmp);
+    video_orc_convert_AYUV_BGRA (d, 0, l, 0,
+        data->im[0][0], data->im[0][2],
+        data->im[2][1], data->im[1][1], data->im[1][2], out_width, 1);
+  }
+  convert_fill_border (convert, dest);
+}
+
+static void
+convert_NV12_RGBA (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gint out_width = convert->out_width;
+  MatrixData *data = &convert->convert_matrix;
+  guint8 *tmp = convert->tmpline;
+
+  for (i = 0; i < height; i++) {
+    guint8 *sy, *suv, *d, *l;
+
+    d = FRAME_GET_LINE (dest, i + convert->out_y);
+    d += (convert->out_x * 4);
+    sy = FRAME_GET_Y_LINE (src, i + convert->in_y);
+    sy += convert->in_x;
+    /* the UV plane interleaves the chroma, start on a U sample */
+    suv = FRAME_GET_U_LINE (src, (i + convert->in_y) >> 1);
+    suv += GST_ROUND_DOWN_2 (convert->in_x);
+
+    unpack_NV12_line (tmp, sy, suv, width);
+    l = hscale_AYUV_line (convert, tmp);
+    video_orc_convert_AYUV_RGBA (d, 0, l, 0,
+        data->im[0][0], data->im[0][2],
+        data->im[2][1], data->im[1][1], data->im[1][2], out_width, 1);
+  }
+  convert_fill_border (convert, dest);
+}
+
+/* gathers line @y of an indexed tiled plane into @d */
+static void
+detile_line (const GstVideoFormatInfo * finfo, guint8 * d, const guint8 * s,
+    gint sstride, gint y, gint width)
+{
+  GstVideoTileMode mode = GST_VIDEO_FORMAT_INFO_TILE_MODE (finfo);
+  gint ws = GST_VIDEO_FORMAT_INFO_TILE_WS (finfo);
+  gint hs = GST_VIDEO_FORMAT_INFO_TILE_HS (finfo);
+  gint tile_width = 1 << ws;
+  gint x_tiles = GST_VIDEO_TILE_X_TILES (sstride);
+  gint y_tiles = GST_VIDEO_TILE_Y_TILES (sstride);
+  gint tx, ty;
+
+  ty = y >> hs;
+  s += (y & ((1 << hs) - 1)) << ws;
+
+  for (tx = 0; tx < x_tiles && (tx << ws) < width; tx++) {
+    gint x = tx << ws;
+
+    memcpy (d + x, s + ((gsize) gst_video_tile_get_index (mode, tx, ty,
+                x_tiles, y_tiles) << (ws + hs)), MIN (tile_width, width - x));
+  }
+}
+
+static void
+convert_NV12_64Z32_BGRA (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  const GstVideoFormatInfo *finfo = src->info.finfo;
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  MatrixData *data = &convert->convert_matrix;
+  guint8 *tmp = convert->tmpline;
+  guint8 *sy, *suv;
+
+  sy = tmp + 4 * GST_ROUND_UP_8 (width);
+  suv = sy + GST_ROUND_UP_8 (width);
+
+  for (i = 0; i < height; i++) {
+    guint8 *d;
+
+    d = FRAME_GET_LINE (dest, i + convert->out_y);
+    d += (convert->out_x * 4);
+
+    detile_line (finfo, sy, FRAME_GET_PLANE_LINE (src, 0, 0),
+        FRAME_GET_PLANE_STRIDE (src, 0), i, width);
+    /* chroma lines are shared by two luma lines */
+    if ((i & 1) == 0)
+      detile_line (finfo, suv, FRAME_GET_PLANE_LINE (src, 1, 0),
+          FRAME_GET_PLANE_STRIDE (src, 1), i >> 1, GST_ROUND_UP_2 (width));
+
+    unpack_NV12_line (tmp, sy, suv, width);
+    video_orc_convert_AYUV_BGRA (d, 0, tmp, 0,
+        data->im[0][0], data->im[0][2],
+        data->im[2][1], data->im[1][1], data->im[1][2], width, 1);
+  }
+  convert_fill_border (convert, dest);
+}
+
+static void
+convert_NV12_64Z32_RGBA (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  const GstVideoFormatInfo *finfo = src->info.finfo;
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  MatrixData *data = &convert->convert_matrix;
+  guint8 *tmp = convert->tmpline;
+  guint8 *sy, *suv;
+
+  sy = tmp + 4 * GST_ROUND_UP_8 (width);
+  suv = sy + GST_ROUND_UP_8 (width);
+
+  for (i = 0; i < height; i++) {
+    guint8 *d;
+
+    d = FRAME_GET_LINE (dest, i + convert->out_y);
+    d += (convert->out_x * 4);
+
+    detile_line (finfo, sy, FRAME_GET_PLANE_LINE (src, 0, 0),
+        FRAME_GET_PLANE_STRIDE (src, 0), i, width);
+    if ((i & 1) == 0)
+      detile_line (finfo, suv, FRAME_GET_PLANE_LINE (src, 1, 0),
+          FRAME_GET_PLANE_STRIDE (src, 1), i >> 1, GST_ROUND_UP_2 (width));
+
+    unpack_NV12_line (tmp, sy, suv, width);
+    video_orc_convert_AYUV_RGBA (d, 0, tmp, 0,
+        data->im[0][0], data->im[0][2],
+        data->im[2][1], data->im[1][1], data->im[1][2], width, 1);
+  }
+  convert_fill_border (convert, dest);
+}
 #endif
 
 static void
@@ -3729,7 +5189,8 @@ convert_plane_fill (GstVideoConverter * convert,
 
   s = FRAME_GET_PLANE_LINE (src, splane, convert->fin_y[splane]);
   s += convert->fin_x[splane];
-  d = FRAME_GET_PLANE_LINE (dest, plane, convert->fout_y[plane]);
+  d = FRAME_GET_PLANE_LINE (dest, plane,
+      convert->fout_y[plane] + convert->fband_y[plane]);
   d += convert->fout_x[plane];
 
   video_orc_memset_2d (d, FRAME_GET_PLANE_STRIDE (dest, plane),
@@ -3743,10 +5204,14 @@ convert_plane_h_double (GstVideoConverter * convert,
 {
   guint8 *s, *d;
   gint splane = convert->fsplane[plane];
+  gint in_y, out_y;
 
-  s = FRAME_GET_PLANE_LINE (src, splane, convert->fin_y[splane]);
+  in_y = convert->fin_y[splane] + convert->fband_y[plane];
+  out_y = convert->fout_y[plane] + convert->fband_y[plane];
+
+  s = FRAME_GET_PLANE_LINE (src, splane, in_y);
   s += convert->fin_x[splane];
-  d = FRAME_GET_PLANE_LINE (dest, plane, convert->fout_y[plane]);
+  d = FRAME_GET_PLANE_LINE (dest, plane, out_y);
   d += convert->fout_x[plane];
 
   video_orc_planar_chroma_422_444 (d,
@@ -3761,10 +5226,14 @@ convert_plane_h_halve (GstVideoConverter * convert,
 {
   guint8 *s, *d;
   gint splane = convert->fsplane[plane];
+  gint in_y, out_y;
 
-  s = FRAME_GET_PLANE_LINE (src, splane, convert->fin_y[splane]);
+  in_y = convert->fin_y[splane] + convert->fband_y[plane];
+  out_y = convert->fout_y[plane] + convert->fband_y[plane];
+
+  s = FRAME_GET_PLANE_LINE (src, splane, in_y);
   s += convert->fin_x[splane];
-  d = FRAME_GET_PLANE_LINE (dest, plane, convert->fout_y[plane]);
+  d = FRAME_GET_PLANE_LINE (dest, plane, out_y);
   d += convert->fout_x[plane];
 
   video_orc_planar_chroma_444_422 (d,
@@ -3779,12 +5248,16 @@ convert_plane_v_double (GstVideoConverter * convert,
 {
   guint8 *s, *d1, *d2;
   gint ds, splane = convert->fsplane[plane];
+  gint in_y, out_y;
 
-  s = FRAME_GET_PLANE_LINE (src, splane, convert->fin_y[splane]);
+  in_y = convert->fin_y[splane] + convert->fband_y[plane] / 2;
+  out_y = convert->fout_y[plane] + convert->fband_y[plane];
+
+  s = FRAME_GET_PLANE_LINE (src, splane, in_y);
   s += convert->fin_x[splane];
-  d1 = FRAME_GET_PLANE_LINE (dest, plane, convert->fout_y[plane]);
+  d1 = FRAME_GET_PLANE_LINE (dest, plane, out_y);
   d1 += convert->fout_x[plane];
-  d2 = FRAME_GET_PLANE_LINE (dest, plane, convert->fout_y[plane] + 1);
+  d2 = FRAME_GET_PLANE_LINE (dest, plane, out_y + 1);
   d2 += convert->fout_x[plane];
   ds = FRAME_GET_PLANE_STRIDE (dest, plane);
 
@@ -3799,12 +5272,16 @@ convert_plane_v_halve (GstVideoConverter * convert,
 {
   guint8 *s1, *s2, *d;
   gint ss, ds, splane = convert->fsplane[plane];
+  gint in_y, out_y;
 
-  s1 = FRAME_GET_PLANE_LINE (src, splane, convert->fin_y[splane]);
+  in_y = convert->fin_y[splane] + convert->fband_y[plane] * 2;
+  out_y = convert->fout_y[plane] + convert->fband_y[plane];
+
+  s1 = FRAME_GET_PLANE_LINE (src, splane, in_y);
   s1 += convert->fin_x[splane];
-  s2 = FRAME_GET_PLANE_LINE (src, splane, convert->fin_y[splane] + 1);
+  s2 = FRAME_GET_PLANE_LINE (src, splane, in_y + 1);
   s2 += convert->fin_x[splane];
-  d = FRAME_GET_PLANE_LINE (dest, plane, convert->fout_y[plane]);
+  d = FRAME_GET_PLANE_LINE (dest, plane, out_y);
   d += convert->fout_x[plane];
 
   ss = FRAME_GET_PLANE_STRIDE (src, splane);
@@ -3820,12 +5297,16 @@ convert_plane_hv_double (GstVideoConverter * convert,
 {
   guint8 *s, *d1, *d2;
   gint ss, ds, splane = convert->fsplane[plane];
+  gint in_y, out_y;
 
-  s = FRAME_GET_PLANE_LINE (src, splane, convert->fin_y[splane]);
+  in_y = convert->fin_y[splane] + convert->fband_y[plane] / 2;
+  out_y = convert->fout_y[plane] + convert->fband_y[plane];
+
+  s = FRAME_GET_PLANE_LINE (src, splane, in_y);
   s += convert->fin_x[splane];
-  d1 = FRAME_GET_PLANE_LINE (dest, plane, convert->fout_y[plane]);
+  d1 = FRAME_GET_PLANE_LINE (dest, plane, out_y);
   d1 += convert->fout_x[plane];
-  d2 = FRAME_GET_PLANE_LINE (dest, plane, convert->fout_y[plane] + 1);
+  d2 = FRAME_GET_PLANE_LINE (dest, plane, out_y + 1);
   d2 += convert->fout_x[plane];
   ss = FRAME_GET_PLANE_STRIDE (src, splane);
   ds = FRAME_GET_PLANE_STRIDE (dest, plane);
@@ -3840,12 +5321,16 @@ convert_plane_hv_halve (GstVideoConverter * convert,
 {
   guint8 *s1, *s2, *d;
   gint ss, ds, splane = convert->fsplane[plane];
+  gint in_y, out_y;
+
+  in_y = convert->fin_y[splane] + convert->fband_y[plane] * 2;
+  out_y = convert->fout_y[plane] + convert->fband_y[plane];
 
-  s1 = FRAME_GET_PLANE_LINE (src, splane, convert->fin_y[splane]);
+  s1 = FRAME_GET_PLANE_LINE (src, splane, in_y);
   s1 += convert->fin_x[splane];
-  s2 = FRAME_GET_PLANE_LINE (src, splane, convert->fin_y[splane] + 1);
+  s2 = FRAME_GET_PLANE_LINE (src, splane, in_y + 1);
   s2 += convert->fin_x[splane];
-  d = FRAME_GET_PLANE_LINE (dest, plane, convert->fout_y[plane]);
+  d = FRAME_GET_PLANE_LINE (dest, plane, out_y);
   d += convert->fout_x[plane];
   ss = FRAME_GET_PLANE_STRIDE (src, splane);
   ds = FRAME_GET_PLANE_STRIDE (dest, plane);
@@ -3882,7 +5367,8 @@ convert_plane_hv (GstVideoConverter * convert,
 
   gst_video_scaler_2d (h_scaler, v_scaler, format,
       s, FRAME_GET_PLANE_STRIDE (src, splane),
-      d, FRAME_GET_PLANE_STRIDE (dest, plane), 0, 0, out_width, out_height);
+      d, FRAME_GET_PLANE_STRIDE (dest, plane), 0, convert->fband_y[plane],
+      out_width, out_height);
 }
 
 static void
@@ -3976,6 +5462,8 @@ get_scale_format (GstVideoFormat format, gint plane)
     case GST_VIDEO_FORMAT_A422_10LE:
     case GST_VIDEO_FORMAT_A444_10BE:
     case GST_VIDEO_FORMAT_A444_10LE:
+    case GST_VIDEO_FORMAT_P010_10BE:
+    case GST_VIDEO_FORMAT_P010_10LE:
       res = format;
       g_assert_not_reached ();
       break;
@@ -4259,8 +5747,37 @@ setup_scale (GstVideoConverter * convert)
   return TRUE;
 }
 
+/* horizontal scaler for the AYUV lines of the single pass kernels, the
+ * scaled line follows the unpacked line in tmpline */
+static void
+setup_hscale_line (GstVideoConverter * convert)
+{
+  gint method;
+  guint taps;
+
+  method = GET_OPT_RESAMPLER_METHOD (convert);
+  taps = GET_OPT_RESAMPLER_TAPS (convert);
+
+  convert->h_scaler =
+      gst_video_scaler_new (method, GST_VIDEO_SCALER_FLAG_NONE, taps,
+      convert->in_width, convert->out_width, convert->config);
+
+  GST_DEBUG ("fastpath hscale %d->%d, method %d", convert->in_width,
+      convert->out_width, method);
+}
+
 /* Fast paths */
 
+typedef enum
+{
+  TRANSFORM_FLAG_NONE = 0,
+  /* converts the cropped input in a single pass, keeps_size compares the
+   * cropped input size with the output size */
+  TRANSFORM_FLAG_SINGLE_PASS = (1 << 0),
+  /* scales horizontally in the same pass, only the height must match */
+  TRANSFORM_FLAG_SCALE_WIDTH = (1 << 1)
+} VideoTransformFlags;
+
 typedef struct
 {
   GstVideoFormat in_format;
@@ -4276,6 +5793,7 @@ typedef struct
   gint width_align, height_align;
   void (*convert) (GstVideoConverter * convert, const GstVideoFrame * src,
       GstVideoFrame * dest);
+  VideoTransformFlags flags;
 } VideoTransform;
 
 static const VideoTransform transforms[] = {
@@ -4337,6 +5855,54 @@ static const VideoTransform transforms[] = {
       FALSE, FALSE, FALSE, FALSE, 0, 0, convert_YUY2_I420},
   {GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_Y42B, TRUE, FALSE, TRUE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_YUY2_Y42B},
+  {GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_YUY2_NV12,
+      TRANSFORM_FLAG_SINGLE_PASS},
+  {GST_VIDEO_FORMAT_v210, GST_VIDEO_FORMAT_I420, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_v210_I420,
+      TRANSFORM_FLAG_SINGLE_PASS},
+  {GST_VIDEO_FORMAT_v210, GST_VIDEO_FORMAT_YV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_v210_I420,
+      TRANSFORM_FLAG_SINGLE_PASS},
+
+  /* 10 bits */
+  {GST_VIDEO_FORMAT_v210, GST_VIDEO_FORMAT_I420_10LE, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_v210_I420_10LE},
+  {GST_VIDEO_FORMAT_I420_10LE, GST_VIDEO_FORMAT_v210, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_10LE_v210},
+  {GST_VIDEO_FORMAT_I420_10LE, GST_VIDEO_FORMAT_P010_10LE, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_10LE_P010_10LE},
+  {GST_VIDEO_FORMAT_P010_10LE, GST_VIDEO_FORMAT_I420_10LE, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_P010_10LE_I420_10LE},
+  {GST_VIDEO_FORMAT_I420_10LE, GST_VIDEO_FORMAT_I420, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_10LE_I420},
+  {GST_VIDEO_FORMAT_I420_10LE, GST_VIDEO_FORMAT_YV12, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_10LE_I420},
+  {GST_VIDEO_FORMAT_P010_10LE, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_P010_10LE_NV12},
+
+  /* semi-planar <-> planar */
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_I420, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_I420,
+      TRANSFORM_FLAG_SINGLE_PASS},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_YV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_I420,
+      TRANSFORM_FLAG_SINGLE_PASS},
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_NV12,
+      TRANSFORM_FLAG_SINGLE_PASS},
+  {GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_NV12,
+      TRANSFORM_FLAG_SINGLE_PASS},
+
+  /* tiled -> linear */
+  {GST_VIDEO_FORMAT_NV12_64Z32, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_64Z32_NV12},
+  {GST_VIDEO_FORMAT_NV12_64Z32, GST_VIDEO_FORMAT_I420, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_64Z32_I420},
+  {GST_VIDEO_FORMAT_NV12_64Z32, GST_VIDEO_FORMAT_YV12, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_64Z32_I420},
+
   {GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_Y444, TRUE, FALSE, TRUE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_YUY2_Y444},
 
@@ -4584,6 +6150,39 @@ static const VideoTransform transforms[] = {
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_BGRA},
   {GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_BGRx, FALSE, TRUE, TRUE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_BGRA},
+
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_RGBA, FALSE, TRUE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_RGBA,
+      TRANSFORM_FLAG_SINGLE_PASS | TRANSFORM_FLAG_SCALE_WIDTH},
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_RGBx, FALSE, TRUE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_RGBA,
+      TRANSFORM_FLAG_SINGLE_PASS | TRANSFORM_FLAG_SCALE_WIDTH},
+  {GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_RGBA, FALSE, TRUE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_RGBA,
+      TRANSFORM_FLAG_SINGLE_PASS | TRANSFORM_FLAG_SCALE_WIDTH},
+  {GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_RGBx, FALSE, TRUE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_RGBA,
+      TRANSFORM_FLAG_SINGLE_PASS | TRANSFORM_FLAG_SCALE_WIDTH},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_BGRA, FALSE, TRUE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_BGRA,
+      TRANSFORM_FLAG_SINGLE_PASS | TRANSFORM_FLAG_SCALE_WIDTH},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_BGRx, FALSE, TRUE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_BGRA,
+      TRANSFORM_FLAG_SINGLE_PASS | TRANSFORM_FLAG_SCALE_WIDTH},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_RGBA, FALSE, TRUE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_RGBA,
+      TRANSFORM_FLAG_SINGLE_PASS | TRANSFORM_FLAG_SCALE_WIDTH},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_RGBx, FALSE, TRUE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_RGBA,
+      TRANSFORM_FLAG_SINGLE_PASS | TRANSFORM_FLAG_SCALE_WIDTH},
+  {GST_VIDEO_FORMAT_NV12_64Z32, GST_VIDEO_FORMAT_BGRA, FALSE, TRUE, TRUE,
+      FALSE, TRUE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_64Z32_BGRA},
+  {GST_VIDEO_FORMAT_NV12_64Z32, GST_VIDEO_FORMAT_BGRx, FALSE, TRUE, TRUE,
+      FALSE, TRUE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_64Z32_BGRA},
+  {GST_VIDEO_FORMAT_NV12_64Z32, GST_VIDEO_FORMAT_RGBA, FALSE, TRUE, TRUE,
+      FALSE, TRUE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_64Z32_RGBA},
+  {GST_VIDEO_FORMAT_NV12_64Z32, GST_VIDEO_FORMAT_RGBx, FALSE, TRUE, TRUE,
+      FALSE, TRUE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_64Z32_RGBA},
 #endif
 
   /* scalers */
@@ -4637,6 +6236,25 @@ static const VideoTransform transforms[] = {
       TRUE, TRUE, FALSE, FALSE, FALSE, 0, 0, convert_scale_planes},
 };
 
+static gboolean
+transform_size_matches (const VideoTransform * transform,
+    GstVideoConverter * convert, gboolean same_size)
+{
+  if (!transform->keeps_size)
+    return TRUE;
+
+  if (!(transform->flags & TRANSFORM_FLAG_SINGLE_PASS))
+    return same_size;
+
+  /* the single pass kernels crop but never scale vertically, for them the
+   * cropped input must match the output */
+  if (convert->in_height != convert->out_height)
+    return FALSE;
+
+  return (transform->flags & TRANSFORM_FLAG_SCALE_WIDTH) ||
+      convert->in_width == convert->out_width;
+}
+
 static gboolean
 video_converter_lookup_fastpath (GstVideoConverter * convert)
 {
@@ -4691,6 +6309,15 @@ video_converter_lookup_fastpath (GstVideoConverter * convert)
     same_primaries = in_primaries == out_primaries;
   }
 
+  /* fastpaths that reduce the depth only do ordered dithering */
+  if (GST_VIDEO_FORMAT_INFO_DEPTH (convert->in_info.finfo, 0) >
+      GST_VIDEO_FORMAT_INFO_DEPTH (convert->out_info.finfo, 0)) {
+    GstVideoDitherMethod method = GET_OPT_DITHER_METHOD (convert);
+
+    if (method != GST_VIDEO_DITHER_NONE && method != GST_VIDEO_DITHER_BAYER)
+      return FALSE;
+  }
+
   interlaced = GST_VIDEO_INFO_IS_INTERLACED (&convert->in_info);
   interlaced |= GST_VIDEO_INFO_IS_INTERLACED (&convert->out_info);
 
@@ -4706,7 +6333,7 @@ video_converter_lookup_fastpath (GstVideoConverter * convert)
         transforms[i].out_format == out_format &&
         (transforms[i].keeps_interlaced || !interlaced) &&
         (transforms[i].needs_color_matrix || (same_matrix && same_primaries))
-        && (!transforms[i].keeps_size || same_size)
+        && transform_size_matches (&transforms[i], convert, same_size)
         && (transforms[i].width_align & width) == 0
         && (transforms[i].height_align & height) == 0
         && (transforms[i].do_crop || !crop)
@@ -4718,7 +6345,11 @@ video_converter_lookup_fastpath (GstVideoConverter * convert)
       if (transforms[i].needs_color_matrix)
         video_converter_compute_matrix (convert);
       convert->convert = transforms[i].convert;
-      convert->tmpline = g_malloc0 (sizeof (guint16) * (width + 8) * 4);
+      convert->tmpline = g_malloc0 (sizeof (guint16) *
+          (MAX (width, convert->out_width) + 8) * 4);
+      if ((transforms[i].flags & TRANSFORM_FLAG_SCALE_WIDTH) &&
+          convert->in_width != convert->out_width)
+        setup_hscale_line (convert);
       if (!transforms[i].keeps_size)
         if (!setup_scale (convert))
           return FALSE;
@@ -265,6 +265,30 @@ typedef enum {
  */
 #define GST_VIDEO_CONVERTER_OPT_PRIMARIES_MODE   "GstVideoConverter.primaries-mode"
 
+/**
+ * GST_VIDEO_CONVERTER_OPT_THREADS:
+ *
+ * #G_TYPE_UINT, maximum number of threads to use for the conversion. The
+ * destination is split in horizontal bands that are converted in parallel.
+ * 0 means the number of available processors. Conversions that carry state
+ * from one line to the next (error diffusion dithering) always use 1 thread.
+ * Default 1
+ *
+ * Since: 1.8
+ */
+#define GST_VIDEO_CONVERTER_OPT_THREADS   "GstVideoConverter.threads"
+
+/**
+ * GST_VIDEO_CONVERTER_OPT_STATS:
+ *
+ * #G_TYPE_BOOLEAN, measure the time spent in every stage of the conversion.
+ * The result is available with gst_video_converter_get_stats().
+ * Default %FALSE
+ *
+ * Since: 1.8
+ */
+#define GST_VIDEO_CONVERTER_OPT_STATS   "GstVideoConverter.stats"
+
 typedef struct _GstVideoConverter GstVideoConverter;
 
 GstVideoConverter *  gst_video_converter_new            (GstVideoInfo *in_info,
@@ -278,6 +302,12 @@ const GstStructure * gst_video_converter_get_config     (GstVideoConverter * con
 void                 gst_video_converter_frame          (GstVideoConverter * convert,
                                                          const GstVideoFrame *src, GstVideoFrame *dest);
 
+GstStructure *       gst_video_converter_get_stats      (GstVideoConverter * convert);
+
+void                 gst_video_converter_get_cache_stats (guint *hits, guint *misses);
+
+void                 gst_video_converter_get_table_stats (guint *n_tables, guint *n_users);
+
 
 G_END_DECLS
 
@@ -30,6 +30,8 @@
  * that can be applied to lines of video pixels to quantize and dither them.
  *
  */
+typedef struct _BayerTable BayerTable;
+
 struct _GstVideoDither
 {
   GstVideoDitherMethod method;
@@ -48,6 +50,8 @@ struct _GstVideoDither
   guint32 orc_mask32;
 
   gpointer errors;
+  /* when set, errors points to the shared bayer pattern */
+  BayerTable *bayer;
 };
 
 static void
@@ -287,29 +291,53 @@ alloc_errors (GstVideoDither * dither, guint lines)
   dither->errors = g_malloc0 (sizeof (guint16) * (width + 8) * n_comp * lines);
 }
 
+/* The ordered dither pattern is never written to after it has been made,
+ * dithers with the same parameters share one refcounted copy of it. */
+struct _BayerTable
+{
+  guint width;
+  guint n_comp;
+  guint errdepth;
+  guint8 shift[4];
+
+  gint refcount;
+  gpointer errors;
+};
+
+static GMutex bayer_tables_lock;
+static GHashTable *bayer_tables;
+static guint bayer_tables_live;
+static guint bayer_tables_users;
+
+static guint
+bayer_table_hash (gconstpointer key)
+{
+  const BayerTable *table = key;
+
+  return (table->width << 8) ^ (table->n_comp << 4) ^ table->errdepth ^
+      GST_READ_UINT32_LE (table->shift);
+}
+
+static gboolean
+bayer_table_equal (gconstpointer a, gconstpointer b)
+{
+  const BayerTable *ta = a, *tb = b;
+
+  return ta->width == tb->width && ta->n_comp == tb->n_comp &&
+      ta->errdepth == tb->errdepth &&
+      memcmp (ta->shift, tb->shift, sizeof (ta->shift)) == 0;
+}
+
 static void
-setup_bayer (GstVideoDither * dither)
+fill_bayer (GstVideoDither * dither, guint errdepth)
 {
-  guint i, j, k, width, n_comp, errdepth;
+  guint i, j, k, width, n_comp;
   guint8 *shift;
 
   width = dither->width;
   shift = dither->shift;
   n_comp = dither->n_comp;
 
-  if (dither->depth == 8) {
-    if (dither->flags & GST_VIDEO_DITHER_FLAG_QUANTIZE) {
-      dither->func = dither_ordered_u8_mask;
-      errdepth = 16;
-    } else {
-      dither->func = dither_ordered_u8;
-      errdepth = 8;
-    }
-  } else {
-    dither->func = dither_ordered_u16_mask;
-    errdepth = 16;
-  }
-
   alloc_errors (dither, 16);
 
   if (errdepth == 8) {
@@ -339,6 +367,72 @@ setup_bayer (GstVideoDither * dither)
   }
 }
 
+static void
+setup_bayer (GstVideoDither * dither)
+{
+  BayerTable key, *table;
+  guint errdepth;
+
+  if (dither->depth == 8) {
+    if (dither->flags & GST_VIDEO_DITHER_FLAG_QUANTIZE) {
+      dither->func = dither_ordered_u8_mask;
+      errdepth = 16;
+    } else {
+      dither->func = dither_ordered_u8;
+      errdepth = 8;
+    }
+  } else {
+    dither->func = dither_ordered_u16_mask;
+    errdepth = 16;
+  }
+
+  key.width = dither->width;
+  key.n_comp = dither->n_comp;
+  key.errdepth = errdepth;
+  memcpy (key.shift, dither->shift, sizeof (key.shift));
+
+  g_mutex_lock (&bayer_tables_lock);
+  if (bayer_tables == NULL)
+    bayer_tables = g_hash_table_new (bayer_table_hash, bayer_table_equal);
+
+  bayer_tables_users++;
+  table = g_hash_table_lookup (bayer_tables, &key);
+  if (table) {
+    table->refcount++;
+    GST_DEBUG ("share bayer table %p, refcount %d", table, table->refcount);
+  } else {
+    fill_bayer (dither, errdepth);
+
+    table = g_slice_new (BayerTable);
+    *table = key;
+    table->refcount = 1;
+    table->errors = dither->errors;
+    g_hash_table_add (bayer_tables, table);
+    bayer_tables_live++;
+    GST_DEBUG ("new bayer table %p for width %u, %u live", table,
+        table->width, bayer_tables_live);
+  }
+  g_mutex_unlock (&bayer_tables_lock);
+
+  dither->bayer = table;
+  dither->errors = table->errors;
+}
+
+static void
+bayer_table_unref (BayerTable * table)
+{
+  g_mutex_lock (&bayer_tables_lock);
+  bayer_tables_users--;
+  if (--table->refcount == 0) {
+    g_hash_table_remove (bayer_tables, table);
+    bayer_tables_live--;
+    GST_DEBUG ("free bayer table %p, %u live", table, bayer_tables_live);
+    g_free (table->errors);
+    g_slice_free (BayerTable, table);
+  }
+  g_mutex_unlock (&bayer_tables_lock);
+}
+
 static gint
 count_power (guint v)
 {
@@ -465,10 +559,35 @@ gst_video_dither_free (GstVideoDither * dither)
 {
   g_return_if_fail (dither != NULL);
 
-  g_free (dither->errors);
+  if (dither->bayer)
+    bayer_table_unref (dither->bayer);
+  else
+    g_free (dither->errors);
   g_slice_free (GstVideoDither, dither);
 }
 
+/**
+ * gst_video_dither_get_table_stats:
+ * @n_tables: (out) (allow-none): number of ordered dither patterns in memory
+ * @n_users: (out) (allow-none): number of dithers using them
+ *
+ * Ordered dithers with the same width, format and quantizers share one
+ * dither pattern. This function retrieves the number of patterns in memory
+ * and the number of #GstVideoDither objects that use them.
+ *
+ * Since: 1.8
+ */
+void
+gst_video_dither_get_table_stats (guint * n_tables, guint * n_users)
+{
+  g_mutex_lock (&bayer_tables_lock);
+  if (n_tables)
+    *n_tables = bayer_tables_live;
+  if (n_users)
+    *n_users = bayer_tables_users;
+  g_mutex_unlock (&bayer_tables_lock);
+}
+
 /**
  * gst_video_dither_line:
  * @dither: a #GstVideoDither
@@ -72,6 +72,8 @@ void                gst_video_dither_free     (GstVideoDither *dither);
 void                gst_video_dither_line     (GstVideoDither *dither,
                                                gpointer line, guint x, guint y, guint width);
 
+void                gst_video_dither_get_table_stats (guint *n_tables, guint *n_users);
+
 G_END_DECLS
 
 #endif /* __GST_VIDEO_DITHER_H__ */
@@ -42,6 +42,7 @@
 
 #include "video-orc.h"
 #include "video-scaler.h"
+#include "gstvideoutilsprivate.h"
 
 #ifndef GST_DISABLE_GST_DEBUG
 #define GST_CAT_DEFAULT ensure_debug_category()
@@ -98,6 +99,8 @@ struct _GstVideoScaler
   guint32 *offset_n;
   /* for ORC */
   gint inc;
+  /* use the generic ntap functions instead of the fixed tap kernels */
+  gboolean generic_taps;
 
   gint tmpwidth;
   gpointer tmpline1;
@@ -251,6 +254,16 @@ gst_video_scaler_new (GstVideoResamplerMethod method, GstVideoScalerFlags flags,
   return scale;
 }
 
+/* test hook: makes @scale use the generic ntap functions instead of the
+ * functions for a fixed number of taps so that both can be compared */
+void
+_gst_video_scaler_set_generic_taps (GstVideoScaler * scale, gboolean generic)
+{
+  g_return_if_fail (scale != NULL);
+
+  scale->generic_taps = generic;
+}
+
 /**
  * gst_video_scaler_free:
  * @scale: a #GstVideoScaler
@@ -1060,6 +1073,65 @@ video_scale_v_ntap_u8 (GstVideoScaler * scale,
 #endif
 }
 
+/* 6 and 8 taps in a single pass, the generic ntap function needs a pass over
+ * the temp line for every 4 taps */
+static void
+video_scale_v_6tap_u8 (GstVideoScaler * scale,
+    gpointer srcs[], gpointer dest, guint dest_offset, guint width,
+    guint n_elems)
+{
+#ifdef LQ
+  guint8 **s = (guint8 **) srcs;
+  gint src_inc;
+  gint16 *taps;
+
+  if (scale->taps_s16 == NULL)
+    make_s16_taps (scale, n_elems, SCALE_U8_LQ);
+
+  taps = scale->taps_s16 + scale->resampler.phase[dest_offset] * 6;
+
+  if (scale->flags & GST_VIDEO_SCALER_FLAG_INTERLACED)
+    src_inc = 2;
+  else
+    src_inc = 1;
+
+  video_orc_resample_v_6tap_u8_lq (dest, s[0], s[1 * src_inc],
+      s[2 * src_inc], s[3 * src_inc], s[4 * src_inc], s[5 * src_inc],
+      taps[0], taps[1], taps[2], taps[3], taps[4], taps[5], width * n_elems);
+#else
+  video_scale_v_ntap_u8 (scale, srcs, dest, dest_offset, width, n_elems);
+#endif
+}
+
+static void
+video_scale_v_8tap_u8 (GstVideoScaler * scale,
+    gpointer srcs[], gpointer dest, guint dest_offset, guint width,
+    guint n_elems)
+{
+#ifdef LQ
+  guint8 **s = (guint8 **) srcs;
+  gint src_inc;
+  gint16 *taps;
+
+  if (scale->taps_s16 == NULL)
+    make_s16_taps (scale, n_elems, SCALE_U8_LQ);
+
+  taps = scale->taps_s16 + scale->resampler.phase[dest_offset] * 8;
+
+  if (scale->flags & GST_VIDEO_SCALER_FLAG_INTERLACED)
+    src_inc = 2;
+  else
+    src_inc = 1;
+
+  video_orc_resample_v_8tap_u8_lq (dest, s[0], s[1 * src_inc],
+      s[2 * src_inc], s[3 * src_inc], s[4 * src_inc], s[5 * src_inc],
+      s[6 * src_inc], s[7 * src_inc], taps[0], taps[1], taps[2], taps[3],
+      taps[4], taps[5], taps[6], taps[7], width * n_elems);
+#else
+  video_scale_v_ntap_u8 (scale, srcs, dest, dest_offset, width, n_elems);
+#endif
+}
+
 static void
 video_scale_v_ntap_u16 (GstVideoScaler * scale,
     gpointer srcs[], gpointer dest, guint dest_offset, guint width,
@@ -1094,6 +1166,141 @@ video_scale_v_ntap_u16 (GstVideoScaler * scale,
   video_orc_resample_scaletaps_u16 (d, temp, count);
 }
 
+/* Single pass n-tap kernels for horizontal and vertical u16 scaling. They
+ * compute each output sample directly from the source with the per-pixel
+ * coefficients instead of first collecting the pixels in tmpline1 and making
+ * a pass over the temp line for each tap. The rounding is the same as the
+ * ORC ntap functions.
+ *
+ * These are portable C, not ORC, and there is no runtime CPU dispatch. The
+ * number of taps is a constant in each function so that the compiler can
+ * unroll the tap loop and vectorize it for the instruction set the library
+ * is built for. Vertical u8 scaling uses the ORC functions above. */
+static inline void
+scale_h_taps_u8 (GstVideoScaler * scale, const guint8 * s, guint8 * d,
+    guint dest_offset, guint width, guint n_elems, const gint n_taps)
+{
+  const guint32 *offset = scale->resampler.offset + dest_offset;
+  const guint32 *phase = scale->resampler.phase + dest_offset;
+  gint i, j, k;
+
+  if (scale->taps_s16 == NULL)
+#ifdef LQ
+    make_s16_taps (scale, n_elems, SCALE_U8_LQ);
+#else
+    make_s16_taps (scale, n_elems, SCALE_U8);
+#endif
+
+  d += dest_offset * n_elems;
+
+  for (i = 0; i < width; i++) {
+    const gint16 *t = scale->taps_s16 + phase[i] * n_taps;
+    const guint8 *p = s + offset[i] * n_elems;
+
+    for (j = 0; j < n_elems; j++) {
+      gint sum = 0;
+
+      for (k = 0; k < n_taps; k++)
+        sum += p[k * n_elems + j] * t[k];
+#ifdef LQ
+      sum = (gint16) ((gint16) sum + SCALE_U8_LQ_ROUND) >> SCALE_U8_LQ;
+#else
+      sum = (sum + SCALE_U8_ROUND) >> SCALE_U8;
+#endif
+      d[i * n_elems + j] = CLAMP (sum, 0, 255);
+    }
+  }
+}
+
+static inline void
+scale_h_taps_u16 (GstVideoScaler * scale, const guint16 * s, guint16 * d,
+    guint dest_offset, guint width, guint n_elems, const gint n_taps)
+{
+  const guint32 *offset = scale->resampler.offset + dest_offset;
+  const guint32 *phase = scale->resampler.phase + dest_offset;
+  gint i, j, k;
+
+  if (scale->taps_s16 == NULL)
+    make_s16_taps (scale, n_elems, SCALE_U16);
+
+  d += dest_offset * n_elems;
+
+  for (i = 0; i < width; i++) {
+    const gint16 *t = scale->taps_s16 + phase[i] * n_taps;
+    const guint16 *p = s + offset[i] * n_elems;
+
+    for (j = 0; j < n_elems; j++) {
+      gint32 sum = 0;
+
+      for (k = 0; k < n_taps; k++)
+        sum += p[k * n_elems + j] * t[k];
+      sum = (sum + 4095) >> SCALE_U16;
+      d[i * n_elems + j] = CLAMP (sum, 0, 65535);
+    }
+  }
+}
+
+static inline void
+scale_v_taps_u16 (GstVideoScaler * scale, guint16 ** srcs, guint16 * d,
+    guint dest_offset, guint width, guint n_elems, const gint n_taps)
+{
+  const gint16 *t;
+  gint i, k, count, src_inc;
+
+  if (scale->taps_s16 == NULL)
+    make_s16_taps (scale, n_elems, SCALE_U16);
+
+  t = scale->taps_s16 + scale->resampler.phase[dest_offset] * n_taps;
+
+  if (scale->flags & GST_VIDEO_SCALER_FLAG_INTERLACED)
+    src_inc = 2;
+  else
+    src_inc = 1;
+
+  count = width * n_elems;
+  for (i = 0; i < count; i++) {
+    gint32 sum = 0;
+
+    for (k = 0; k < n_taps; k++)
+      sum += srcs[k * src_inc][i] * t[k];
+    sum = (sum + 4095) >> SCALE_U16;
+    d[i] = CLAMP (sum, 0, 65535);
+  }
+}
+
+#define MAKE_H_TAPS_FUNCS(n)                                                    \
+static void                                                                     \
+video_scale_h_##n##tap_u8 (GstVideoScaler * scale,                              \
+    gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems) \
+{                                                                               \
+  scale_h_taps_u8 (scale, src, dest, dest_offset, width, n_elems, n);           \
+}                                                                               \
+static void                                                                     \
+video_scale_h_##n##tap_u16 (GstVideoScaler * scale,                             \
+    gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems) \
+{                                                                               \
+  scale_h_taps_u16 (scale, src, dest, dest_offset, width, n_elems, n);          \
+}
+
+#define MAKE_V_TAPS_FUNC(n)                                                     \
+static void                                                                     \
+video_scale_v_##n##tap_u16 (GstVideoScaler * scale,                             \
+    gpointer srcs[], gpointer dest, guint dest_offset, guint width,             \
+    guint n_elems)                                                              \
+{                                                                               \
+  scale_v_taps_u16 (scale, (guint16 **) srcs, dest, dest_offset, width,         \
+      n_elems, n);                                                              \
+}
+
+MAKE_H_TAPS_FUNCS (4)
+MAKE_H_TAPS_FUNCS (6)
+MAKE_H_TAPS_FUNCS (8)
+MAKE_H_TAPS_FUNCS (12)
+MAKE_V_TAPS_FUNC (4)
+MAKE_V_TAPS_FUNC (6)
+MAKE_V_TAPS_FUNC (8)
+MAKE_V_TAPS_FUNC (12)
+
 static gint
 get_y_offset (GstVideoFormat format)
 {
@@ -1187,6 +1394,46 @@ gst_video_scaler_combine_packed_YUV (GstVideoScaler * y_scale,
   return scale;
 }
 
+static GstVideoScalerHFunc
+get_h_taps_func (GstVideoScaler * scale, gint bits)
+{
+  if (scale->generic_taps)
+    return bits == 8 ? video_scale_h_ntap_u8 : video_scale_h_ntap_u16;
+
+  switch (scale->resampler.max_taps) {
+    case 4:
+      return bits == 8 ? video_scale_h_4tap_u8 : video_scale_h_4tap_u16;
+    case 6:
+      return bits == 8 ? video_scale_h_6tap_u8 : video_scale_h_6tap_u16;
+    case 8:
+      return bits == 8 ? video_scale_h_8tap_u8 : video_scale_h_8tap_u16;
+    case 12:
+      return bits == 8 ? video_scale_h_12tap_u8 : video_scale_h_12tap_u16;
+    default:
+      return bits == 8 ? video_scale_h_ntap_u8 : video_scale_h_ntap_u16;
+  }
+}
+
+static GstVideoScalerVFunc
+get_v_taps_func (GstVideoScaler * scale, gint bits)
+{
+  if (scale->generic_taps)
+    return bits == 8 ? video_scale_v_ntap_u8 : video_scale_v_ntap_u16;
+
+  switch (scale->resampler.max_taps) {
+    case 4:
+      return bits == 8 ? video_scale_v_4tap_u8 : video_scale_v_4tap_u16;
+    case 6:
+      return bits == 8 ? video_scale_v_6tap_u8 : video_scale_v_6tap_u16;
+    case 8:
+      return bits == 8 ? video_scale_v_8tap_u8 : video_scale_v_8tap_u16;
+    case 12:
+      return bits == 8 ? video_scale_v_ntap_u8 : video_scale_v_12tap_u16;
+    default:
+      return bits == 8 ? video_scale_v_ntap_u8 : video_scale_v_ntap_u16;
+  }
+}
+
 static gboolean
 get_functions (GstVideoScaler * hscale, GstVideoScaler * vscale,
     GstVideoFormat format,
@@ -1271,6 +1518,15 @@ get_functions (GstVideoScaler * hscale, GstVideoScaler * vscale,
         else
           *hfunc = video_scale_h_ntap_u8;
         break;
+      case 4:
+      case 6:
+      case 8:
+      case 12:
+        if (!hscale->merged)
+          *hfunc = get_h_taps_func (hscale, bits);
+        else
+          *hfunc = video_scale_h_ntap_u8;
+        break;
       default:
         *hfunc = video_scale_h_ntap_u8;
         break;
@@ -1287,6 +1543,11 @@ get_functions (GstVideoScaler * hscale, GstVideoScaler * vscale,
       case 4:
         *vfunc = video_scale_v_4tap_u8;
         break;
+      case 6:
+      case 8:
+      case 12:
+        *vfunc = get_v_taps_func (vscale, bits);
+        break;
       default:
         *vfunc = video_scale_v_ntap_u8;
         break;
@@ -1301,6 +1562,12 @@ get_functions (GstVideoScaler * hscale, GstVideoScaler * vscale,
         else
           *hfunc = video_scale_h_near_u64;
         break;
+      case 4:
+      case 6:
+      case 8:
+      case 12:
+        *hfunc = get_h_taps_func (hscale, bits);
+        break;
       default:
         *hfunc = video_scale_h_ntap_u16;
         break;
@@ -1314,6 +1581,12 @@ get_functions (GstVideoScaler * hscale, GstVideoScaler * vscale,
       case 2:
         *vfunc = video_scale_v_2tap_u16;
         break;
+      case 4:
+      case 6:
+      case 8:
+      case 12:
+        *vfunc = get_v_taps_func (vscale, bits);
+        break;
       default:
         *vfunc = video_scale_v_ntap_u16;
         break;
@@ -1461,7 +1734,7 @@ gst_video_scaler_2d (GstVideoScaler * hscale, GstVideoScaler * vscale,
       d = LINE (dest, dest_stride, y) + xo;
 
       /* no scaling, do memcpy */
-      for (i = y; i < height; i++) {
+      for (i = y; i < y + height; i++) {
         memcpy (d, s, xw);
         d += dest_stride;
         s += src_stride;
@@ -1471,7 +1744,7 @@ gst_video_scaler_2d (GstVideoScaler * hscale, GstVideoScaler * vscale,
         realloc_tmplines (hscale, n_elems, width);
 
       /* only horizontal scaling */
-      for (i = y; i < height; i++) {
+      for (i = y; i < y + height; i++) {
         hfunc (hscale, LINE (src, src_stride, i), LINE (dest, dest_stride, i),
             x, width, n_elems);
       }
@@ -1488,7 +1761,7 @@ gst_video_scaler_2d (GstVideoScaler * hscale, GstVideoScaler * vscale,
 
     if (hscale == NULL) {
       /* only vertical scaling */
-      for (i = y; i < height; i++) {
+      for (i = y; i < y + height; i++) {
         guint in, j;
 
         in = vscale->resampler.offset[i];
@@ -1498,17 +1771,19 @@ gst_video_scaler_2d (GstVideoScaler * hscale, GstVideoScaler * vscale,
         vfunc (vscale, lines, LINE (dest, dest_stride, i), i, width, n_elems);
       }
     } else {
-      gint tmp_in = y;
+      gint tmp_in = vscale->resampler.offset[y];
       gint s1, s2;
 
       if (hscale->tmpwidth < width)
         realloc_tmplines (hscale, n_elems, width);
 
-      s1 = width * vscale->resampler.offset[height - 1];
-      s2 = width * height;
+      /* decide on the complete output so that all bands of an image are
+       * scaled in the same order */
+      s1 = width * vscale->resampler.offset[vscale->resampler.out_size - 1];
+      s2 = width * vscale->resampler.out_size;
 
       if (s1 <= s2) {
-        for (i = y; i < height; i++) {
+        for (i = y; i < y + height; i++) {
           guint in, j;
 
           in = vscale->resampler.offset[i];
@@ -1553,7 +1828,7 @@ gst_video_scaler_2d (GstVideoScaler * hscale, GstVideoScaler * vscale,
         if (vscale->tmpwidth < vw)
           realloc_tmplines (vscale, n_elems, vw);
 
-        for (i = y; i < height; i++) {
+        for (i = y; i < y + height; i++) {
           guint in, j;
 
           in = vscale->resampler.offset[i];
@@ -29,6 +29,13 @@
  * The adder currently mixes all data received on the sinkpads as soon as
  * possible without trying to synchronize the streams.
  *
+ * For every sink pad a mix-minus src pad with the same index can be
+ * requested, e.g. src_3 for sink_3. It outputs the mix of all other sink pads,
+ * which is what a conference participant should hear. All mix-minus outputs
+ * are computed from the total mix in the same pass, so the cost only grows
+ * linearly with the number of participants. Mix-minus pads output the format
+ * negotiated on the always src pad.
+ *
  * Check out the audiomixer element in gst-plugins-bad for a better-behaving
  * audio mixing element: It will sync input streams correctly and also handle
  * live inputs properly.
@@ -38,6 +45,9 @@
  * |[
  * gst-launch-1.0 audiotestsrc freq=100 ! adder name=mix ! audioconvert ! autoaudiosink audiotestsrc freq=500 ! mix.
  * ]| This pipeline produces two sine waves mixed together.
+ * |[
+ * gst-launch-1.0 adder name=mix ! fakesink audiotestsrc freq=100 ! mix.sink_0 audiotestsrc freq=500 ! mix.sink_1 mix.src_0 ! audioconvert ! autoaudiosink
+ * ]| This pipeline plays the 500Hz sine wave, the mix without sink_0.
  * </refsect2>
  */
 /* Element-Checklist-Version: 5 */
@@ -48,7 +58,8 @@
 
 #include "gstadder.h"
 #include <gst/audio/audio.h>
-#include <string.h>             /* strcmp */
+#include <stdio.h>              /* sscanf */
+#include <string.h>             /* strcmp, memcpy, memset */
 #include "gstadderorc.h"
 
 #define GST_CAT_DEFAULT gst_adder_debug
@@ -70,6 +81,27 @@ GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
 #define VOLUME_UNITY_INT32           134217728  /* internal int for unity 2^(32-5) */
 #define VOLUME_UNITY_INT32_BIT_SHIFT 27
 
+/* an input of the mix with a snapshot of its pad volume */
+typedef struct
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+  gdouble volume;
+  /* volume as integer of the sample size */
+  gint volume_i;
+  /* output for the mix without this input or NULL */
+  gpointer minus;
+} GstAdderInput;
+
+/* a mix-minus output of a collect cycle */
+typedef struct
+{
+  GstPad *pad;
+  /* NULL when the pad was not part of the mix */
+  GstBuffer *buffer;
+  GstMapInfo map;
+} GstAdderMinusOutput;
+
 enum
 {
   PROP_PAD_0,
@@ -181,6 +213,13 @@ GST_STATIC_PAD_TEMPLATE ("sink_%u",
     GST_STATIC_CAPS (CAPS)
     );
 
+static GstStaticPadTemplate gst_adder_minus_src_template =
+GST_STATIC_PAD_TEMPLATE ("src_%u",
+    GST_PAD_SRC,
+    GST_PAD_REQUEST,
+    GST_STATIC_CAPS (CAPS)
+    );
+
 static void gst_adder_child_proxy_init (gpointer g_iface, gpointer iface_data);
 
 #define gst_adder_parent_class parent_class
@@ -531,6 +570,28 @@ gst_adder_src_query (GstPad * pad, GstObject * parent, GstQuery * query)
 
 /* event handling */
 
+/* pushes @event on the src pad and on all mix-minus pads, takes ownership of
+ * the event
+ *
+ * Returns: the result of pushing on the src pad.
+ */
+static gboolean
+gst_adder_push_event (GstAdder * adder, GstEvent * event)
+{
+  GList *pads, *l;
+
+  GST_OBJECT_LOCK (adder);
+  pads = g_list_copy_deep (adder->minus_pads, (GCopyFunc) gst_object_ref,
+      NULL);
+  GST_OBJECT_UNLOCK (adder);
+
+  for (l = pads; l; l = l->next)
+    gst_pad_push_event (GST_PAD_CAST (l->data), gst_event_ref (event));
+  g_list_free_full (pads, gst_object_unref);
+
+  return gst_pad_push_event (adder->srcpad, event);
+}
+
 typedef struct
 {
   GstEvent *event;
@@ -679,7 +740,7 @@ gst_adder_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
          * We send a flush-start before, to ensure no streaming is done
          * as we need to take the stream lock.
          */
-        gst_pad_push_event (adder->srcpad, gst_event_new_flush_start ());
+        gst_adder_push_event (adder, gst_event_new_flush_start ());
         gst_collect_pads_set_flushing (adder->collect, TRUE);
 
         /* We can't send FLUSH_STOP here since upstream could start pushing data
@@ -728,7 +789,7 @@ gst_adder_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
       if (g_atomic_int_compare_and_exchange (&adder->flush_stop_pending,
               TRUE, FALSE)) {
         GST_DEBUG_OBJECT (adder, "pending flush stop");
-        if (!gst_pad_push_event (adder->srcpad,
+        if (!gst_adder_push_event (adder,
                 gst_event_new_flush_stop (TRUE))) {
           GST_WARNING_OBJECT (adder, "Sending flush stop event failed");
         }
@@ -860,6 +921,8 @@ gst_adder_class_init (GstAdderClass * klass)
       gst_static_pad_template_get (&gst_adder_src_template));
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&gst_adder_sink_template));
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_adder_minus_src_template));
   gst_element_class_set_static_metadata (gstelement_class, "Adder",
       "Generic/Audio",
       "Add N audio channels together",
@@ -893,6 +956,10 @@ gst_adder_init (GstAdder * adder)
 
   adder->filter_caps = NULL;
 
+  adder->inputs = g_array_new (FALSE, FALSE, sizeof (GstAdderInput));
+  adder->minus_outputs =
+      g_array_new (FALSE, FALSE, sizeof (GstAdderMinusOutput));
+
   /* keep track of the sinkpads requested */
   adder->collect = gst_collect_pads_new ();
   gst_collect_pads_set_function (adder->collect,
@@ -923,6 +990,17 @@ gst_adder_dispose (GObject * object)
     adder->pending_events = NULL;
   }
 
+  if (adder->inputs) {
+    g_array_free (adder->inputs, TRUE);
+    adder->inputs = NULL;
+  }
+  if (adder->minus_outputs) {
+    g_array_free (adder->minus_outputs, TRUE);
+    adder->minus_outputs = NULL;
+  }
+  g_list_free (adder->minus_pads);
+  adder->minus_pads = NULL;
+
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
@@ -979,20 +1057,139 @@ gst_adder_get_property (GObject * object, guint prop_id, GValue * value,
 }
 
 
+static gboolean
+copy_sticky_event (GstPad * pad, GstEvent ** event, gpointer user_data)
+{
+  GstPad *minus_pad = GST_PAD_CAST (user_data);
+
+  gst_pad_store_sticky_event (minus_pad, *event);
+
+  return TRUE;
+}
+
+/* a mix-minus src pad outputs the mix of all sink pads except the sink pad
+ * with the same index */
+static GstPad *
+gst_adder_request_minus_pad (GstAdder * adder, GstPadTemplate * templ,
+    const gchar * name)
+{
+  GstAdderPad *sinkpad;
+  GstPad *newpad;
+  gchar *sinkname;
+  guint index;
+
+  if (name == NULL || sscanf (name, "src_%u", &index) != 1)
+    goto no_index;
+
+  sinkname = g_strdup_printf ("sink_%u", index);
+  sinkpad = (GstAdderPad *) gst_element_get_static_pad (GST_ELEMENT (adder),
+      sinkname);
+  g_free (sinkname);
+  if (sinkpad == NULL)
+    goto no_sinkpad;
+
+  newpad = gst_pad_new_from_template (templ, name);
+  gst_pad_set_query_function (newpad, GST_DEBUG_FUNCPTR (gst_adder_src_query));
+  gst_pad_set_event_function (newpad, GST_DEBUG_FUNCPTR (gst_adder_src_event));
+  /* the sink pad outlives its mix-minus pad, no ref needed */
+  gst_pad_set_element_private (newpad, sinkpad);
+
+  GST_OBJECT_LOCK (sinkpad);
+  if (sinkpad->minus_pad != NULL) {
+    GST_OBJECT_UNLOCK (sinkpad);
+    gst_object_unref (newpad);
+    goto in_use;
+  }
+  GST_OBJECT_UNLOCK (sinkpad);
+
+  /* takes ownership of the pad, fails for a concurrent request of the same
+   * name */
+  if (!gst_element_add_pad (GST_ELEMENT (adder), newpad))
+    goto could_not_add;
+
+  /* give the new pad the same events as the src pad before the collect
+   * function can see it, it then only outputs after them */
+  GST_COLLECT_PADS_STREAM_LOCK (adder->collect);
+  gst_pad_sticky_events_foreach (adder->srcpad, copy_sticky_event, newpad);
+  GST_OBJECT_LOCK (sinkpad);
+  sinkpad->minus_pad = newpad;
+  GST_OBJECT_UNLOCK (sinkpad);
+  GST_OBJECT_LOCK (adder);
+  adder->minus_pads = g_list_prepend (adder->minus_pads, newpad);
+  GST_OBJECT_UNLOCK (adder);
+  GST_COLLECT_PADS_STREAM_UNLOCK (adder->collect);
+
+  GST_DEBUG_OBJECT (adder, "request new mix-minus pad %s", name);
+  gst_object_unref (sinkpad);
+
+  return newpad;
+
+  /* errors */
+no_index:
+  {
+    GST_WARNING_OBJECT (adder, "mix-minus pads need a name like src_%%u");
+    return NULL;
+  }
+no_sinkpad:
+  {
+    GST_WARNING_OBJECT (adder, "no sink pad for mix-minus pad %s", name);
+    return NULL;
+  }
+in_use:
+  {
+    GST_WARNING_OBJECT (adder, "sink pad %s:%s already has a mix-minus pad",
+        GST_DEBUG_PAD_NAME (sinkpad));
+    gst_object_unref (sinkpad);
+    return NULL;
+  }
+could_not_add:
+  {
+    GST_DEBUG_OBJECT (adder, "could not add pad");
+    gst_object_unref (sinkpad);
+    return NULL;
+  }
+}
+
+static void
+gst_adder_release_minus_pad (GstAdder * adder, GstAdderPad * sinkpad)
+{
+  GstPad *minus_pad;
+
+  GST_OBJECT_LOCK (sinkpad);
+  minus_pad = sinkpad->minus_pad;
+  sinkpad->minus_pad = NULL;
+  GST_OBJECT_UNLOCK (sinkpad);
+
+  if (minus_pad == NULL)
+    return;
+
+  GST_DEBUG_OBJECT (adder, "release mix-minus pad %s:%s",
+      GST_DEBUG_PAD_NAME (minus_pad));
+
+  GST_OBJECT_LOCK (adder);
+  adder->minus_pads = g_list_remove (adder->minus_pads, minus_pad);
+  GST_OBJECT_UNLOCK (adder);
+
+  gst_element_remove_pad (GST_ELEMENT (adder), minus_pad);
+}
+
 static GstPad *
 gst_adder_request_new_pad (GstElement * element, GstPadTemplate * templ,
-    const gchar * unused, const GstCaps * caps)
+    const gchar * req_name, const GstCaps * caps)
 {
   gchar *name;
   GstAdder *adder;
   GstPad *newpad;
   gint padcount;
 
+  adder = GST_ADDER (element);
+
+  if (templ->direction == GST_PAD_SRC)
+    return gst_adder_request_minus_pad (adder, templ, req_name);
+
   if (templ->direction != GST_PAD_SINK)
     goto not_sink;
 
-  adder = GST_ADDER (element);
-
   /* increment pad counter */
   padcount = g_atomic_int_add (&adder->padcount, 1);
 
@@ -1036,8 +1233,17 @@ gst_adder_release_pad (GstElement * element, GstPad * pad)
 
   adder = GST_ADDER (element);
 
+  if (GST_PAD_IS_SRC (pad)) {
+    gst_adder_release_minus_pad (adder,
+        (GstAdderPad *) gst_pad_get_element_private (pad));
+    return;
+  }
+
   GST_DEBUG_OBJECT (adder, "release pad %s:%s", GST_DEBUG_PAD_NAME (pad));
 
+  /* the mix-minus pad can't exist without its sink pad */
+  gst_adder_release_minus_pad (adder, GST_ADDER_PAD (pad));
+
   gst_child_proxy_child_removed (GST_CHILD_PROXY (adder), G_OBJECT (pad),
       GST_OBJECT_NAME (pad));
   if (adder->collect)
@@ -1061,6 +1267,181 @@ gst_adder_do_clip (GstCollectPads * pads, GstCollectData * data,
   return GST_FLOW_OK;
 }
 
+/* the samples of all inputs are mixed in blocks of this size, the
+ * accumulators of a block stay in the cache */
+#define MIX_BLOCK_SAMPLES 256
+
+/* Mix all inputs in a single pass: every input is read once, accumulated
+ * with its volume into a wider integer and the saturated result is written
+ * once. Inputs with a mix-minus output get the total minus their own
+ * contribution. Unsigned samples are mixed around their midpoint, like the
+ * volume functions do. The output may be the memory of one of the inputs but
+ * the mix-minus outputs may not. The accumulate, mix-minus and saturating
+ * pack steps are orc kernels that shift by the VOLUME_UNITY_*_BIT_SHIFT
+ * values. */
+#define MAKE_MIX_FUNC_INT(name,type,acctype)                            \
+static void                                                             \
+adder_mix_##name (type * out, const GstAdderInput * inputs,             \
+    guint n_inputs, guint n_samples)                                    \
+{                                                                       \
+  acctype acc[MIX_BLOCK_SAMPLES];                                       \
+  guint off, len, i;                                                    \
+                                                                        \
+  for (off = 0; off < n_samples; off += len) {                          \
+    len = MIN (MIX_BLOCK_SAMPLES, n_samples - off);                     \
+                                                                        \
+    memset (acc, 0, len * sizeof (acctype));                            \
+    for (i = 0; i < n_inputs; i++) {                                    \
+      const type *in = (const type *) inputs[i].map.data + off;         \
+                                                                        \
+      adder_orc_acc_volume_##name (acc, in, inputs[i].volume_i, len);   \
+    }                                                                   \
+                                                                        \
+    for (i = 0; i < n_inputs; i++) {                                    \
+      const type *in = (const type *) inputs[i].map.data + off;         \
+      type *minus = inputs[i].minus;                                    \
+                                                                        \
+      if (minus == NULL)                                                \
+        continue;                                                       \
+                                                                        \
+      adder_orc_minus_volume_##name (minus + off, acc, in,              \
+          inputs[i].volume_i, len);                                     \
+    }                                                                   \
+                                                                        \
+    adder_orc_pack_##name (out + off, acc, len);                        \
+  }                                                                     \
+}
+
+/* floats are accumulated in their own precision and not clipped, a mix-minus
+ * output is the total plus the input with its volume negated */
+#define MAKE_MIX_FUNC_FLOAT(name,type)                                  \
+static void                                                             \
+adder_mix_##name (type * out, const GstAdderInput * inputs,             \
+    guint n_inputs, guint n_samples)                                    \
+{                                                                       \
+  type acc[MIX_BLOCK_SAMPLES];                                          \
+  guint off, len, i;                                                    \
+                                                                        \
+  for (off = 0; off < n_samples; off += len) {                          \
+    len = MIN (MIX_BLOCK_SAMPLES, n_samples - off);                     \
+                                                                        \
+    memset (acc, 0, len * sizeof (type));                               \
+    for (i = 0; i < n_inputs; i++) {                                    \
+      const type *in = (const type *) inputs[i].map.data + off;         \
+                                                                        \
+      if (inputs[i].volume == 1.0)                                      \
+        adder_orc_add_##name (acc, in, len);                            \
+      else                                                              \
+        adder_orc_add_volume_##name (acc, in, inputs[i].volume, len);   \
+    }                                                                   \
+                                                                        \
+    for (i = 0; i < n_inputs; i++) {                                    \
+      const type *in = (const type *) inputs[i].map.data + off;         \
+      type *minus = inputs[i].minus;                                    \
+                                                                        \
+      if (minus == NULL)                                                \
+        continue;                                                       \
+                                                                        \
+      minus += off;                                                     \
+      memcpy (minus, acc, len * sizeof (type));                         \
+      adder_orc_add_volume_##name (minus, in, -inputs[i].volume, len);  \
+    }                                                                   \
+                                                                        \
+    memcpy (out + off, acc, len * sizeof (type));                       \
+  }                                                                     \
+}
+
+MAKE_MIX_FUNC_INT (u8, guint8, gint32);
+MAKE_MIX_FUNC_INT (s8, gint8, gint32);
+MAKE_MIX_FUNC_INT (u16, guint16, gint32);
+MAKE_MIX_FUNC_INT (s16, gint16, gint32);
+MAKE_MIX_FUNC_INT (u32, guint32, gint64);
+MAKE_MIX_FUNC_INT (s32, gint32, gint64);
+MAKE_MIX_FUNC_FLOAT (f32, gfloat);
+MAKE_MIX_FUNC_FLOAT (f64, gdouble);
+
+static void
+gst_adder_mix_inputs (GstAdder * adder, gpointer out, guint n_samples)
+{
+  const GstAdderInput *inputs = (const GstAdderInput *) adder->inputs->data;
+  guint n_inputs = adder->inputs->len;
+
+  switch (adder->info.finfo->format) {
+    case GST_AUDIO_FORMAT_U8:
+      adder_mix_u8 (out, inputs, n_inputs, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_S8:
+      adder_mix_s8 (out, inputs, n_inputs, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_U16:
+      adder_mix_u16 (out, inputs, n_inputs, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_S16:
+      adder_mix_s16 (out, inputs, n_inputs, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_U32:
+      adder_mix_u32 (out, inputs, n_inputs, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_S32:
+      adder_mix_s32 (out, inputs, n_inputs, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_F32:
+      adder_mix_f32 (out, inputs, n_inputs, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_F64:
+      adder_mix_f64 (out, inputs, n_inputs, n_samples);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+static void
+gst_adder_clear_minus_outputs (GstAdder * adder)
+{
+  guint i;
+
+  for (i = 0; i < adder->minus_outputs->len; i++) {
+    GstAdderMinusOutput *output =
+        &g_array_index (adder->minus_outputs, GstAdderMinusOutput, i);
+
+    if (output->buffer)
+      gst_buffer_unref (output->buffer);
+    gst_object_unref (output->pad);
+  }
+  g_array_set_size (adder->minus_outputs, 0);
+}
+
+/* pushes the mix-minus outputs and combines their result with @ret. A
+ * participant that is not linked, flushing or EOS does not stop the mix,
+ * only errors are returned. */
+static GstFlowReturn
+gst_adder_push_minus_outputs (GstAdder * adder, GstFlowReturn ret)
+{
+  guint i;
+
+  for (i = 0; i < adder->minus_outputs->len; i++) {
+    GstAdderMinusOutput *output =
+        &g_array_index (adder->minus_outputs, GstAdderMinusOutput, i);
+    GstFlowReturn minus_ret;
+
+    minus_ret = gst_pad_push (output->pad, output->buffer);
+    output->buffer = NULL;
+
+    GST_LOG_OBJECT (output->pad, "pushed mix-minus buffer, result = %s",
+        gst_flow_get_name (minus_ret));
+
+    if (minus_ret == GST_FLOW_OK && ret == GST_FLOW_NOT_LINKED)
+      ret = GST_FLOW_OK;
+    else if (minus_ret < GST_FLOW_EOS && minus_ret < ret)
+      ret = minus_ret;
+  }
+  gst_adder_clear_minus_outputs (adder);
+
+  return ret;
+}
+
 static GstFlowReturn
 gst_adder_collected (GstCollectPads * pads, gpointer user_data)
 {
@@ -1070,8 +1451,10 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
    * - this function is called when all pads have a buffer
    * - get available bytes on all pads.
    * - repeat for each input pad :
-   *   - read available bytes, copy or add to target buffer
+   *   - take available bytes, the first becomes the target buffer
    *   - if there's an EOS event, remove the input channel
+   * - add all taken buffers with their volume into the target buffer in
+   *   one pass
    * - push out the output buffer
    *
    * todo:
@@ -1100,7 +1483,7 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
 
   if (adder->flush_stop_pending) {
     GST_INFO_OBJECT (adder->srcpad, "send pending flush stop event");
-    if (!gst_pad_push_event (adder->srcpad, gst_event_new_flush_stop (TRUE))) {
+    if (!gst_adder_push_event (adder, gst_event_new_flush_stop (TRUE))) {
       GST_WARNING_OBJECT (adder->srcpad, "Sending flush stop event failed");
     }
 
@@ -1119,7 +1502,7 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
     event = gst_event_new_stream_start (s_id);
     gst_event_set_group_id (event, gst_util_group_id_next ());
 
-    if (!gst_pad_push_event (adder->srcpad, event)) {
+    if (!gst_adder_push_event (adder, event)) {
       GST_WARNING_OBJECT (adder->srcpad, "Sending stream start event failed");
     }
     adder->send_stream_start = FALSE;
@@ -1131,7 +1514,7 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
     caps_event = gst_event_new_caps (adder->current_caps);
     GST_INFO_OBJECT (adder->srcpad, "send pending caps event %" GST_PTR_FORMAT,
         caps_event);
-    if (!gst_pad_push_event (adder->srcpad, caps_event)) {
+    if (!gst_adder_push_event (adder, caps_event)) {
       GST_WARNING_OBJECT (adder->srcpad, "Sending caps event failed");
     }
     adder->send_caps = FALSE;
@@ -1162,7 +1545,7 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
     GST_INFO_OBJECT (adder->srcpad, "sending pending new segment event %"
         GST_SEGMENT_FORMAT, &adder->segment);
     if (event) {
-      if (!gst_pad_push_event (adder->srcpad, event)) {
+      if (!gst_adder_push_event (adder, event)) {
         GST_WARNING_OBJECT (adder->srcpad, "Sending new segment event failed");
       }
     } else {
@@ -1185,6 +1568,8 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
     GstBuffer *inbuf;
     gboolean is_gap;
     GstAdderPad *pad;
+    GstAdderInput input;
+    gint minus_index = -1;
     GstClockTime timestamp, stream_time;
 
     /* take next to see if this is the last collectdata */
@@ -1193,6 +1578,18 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
     collect_data = (GstCollectData *) collected->data;
     pad = GST_ADDER_PAD (collect_data->pad);
 
+    /* every mix-minus pad gets an output, the complete mix when its sink pad
+     * has nothing to contribute */
+    GST_OBJECT_LOCK (pad);
+    if (pad->minus_pad) {
+      GstAdderMinusOutput output = { NULL, };
+
+      output.pad = gst_object_ref (pad->minus_pad);
+      minus_index = adder->minus_outputs->len;
+      g_array_append_val (adder->minus_outputs, output);
+    }
+    GST_OBJECT_UNLOCK (pad);
+
     /* get a buffer of size bytes, if we get a buffer, it is at least outsize
      * bytes big. */
     inbuf = gst_collect_pads_take_buffer (pads, collect_data, outsize);
@@ -1250,151 +1647,82 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
 
       /* make data and metadata writable, can simply return the inbuf when we
        * are the only one referencing this buffer. If this is the last (and
-       * only) GAP buffer, it will automatically copy the GAP flag. */
+       * only) GAP buffer, it will automatically copy the GAP flag. The
+       * output buffer is the first input of the mix. */
       outbuf = gst_buffer_make_writable (inbuf);
       gst_buffer_map (outbuf, &outmap, GST_MAP_READWRITE);
 
-      if (pad->volume != 1.0) {
-        switch (adder->info.finfo->format) {
-          case GST_AUDIO_FORMAT_U8:
-            adder_orc_volume_u8 ((gpointer) outmap.data, pad->volume_i8,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_S8:
-            adder_orc_volume_s8 ((gpointer) outmap.data, pad->volume_i8,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_U16:
-            adder_orc_volume_u16 ((gpointer) outmap.data, pad->volume_i16,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_S16:
-            adder_orc_volume_s16 ((gpointer) outmap.data, pad->volume_i16,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_U32:
-            adder_orc_volume_u32 ((gpointer) outmap.data, pad->volume_i32,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_S32:
-            adder_orc_volume_s32 ((gpointer) outmap.data, pad->volume_i32,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_F32:
-            adder_orc_volume_f32 ((gpointer) outmap.data, pad->volume,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_F64:
-            adder_orc_volume_f64 ((gpointer) outmap.data, pad->volume,
-                outmap.size / bps);
-            break;
-          default:
-            g_assert_not_reached ();
-            break;
-        }
-      }
+      input.buffer = NULL;
+      input.map = outmap;
     } else {
-      if (!is_gap) {
-        /* we had a previous output buffer, mix this non-GAP buffer */
-        GstMapInfo inmap;
-
-        gst_buffer_map (inbuf, &inmap, GST_MAP_READ);
-
-        /* all buffers should have outsize, there are no short buffers because we
-         * asked for the max size above */
-        g_assert (inmap.size == outmap.size);
-
-        GST_LOG_OBJECT (adder, "channel %p: mixing %" G_GSIZE_FORMAT " bytes"
-            " from data %p", collect_data, inmap.size, inmap.data);
-
-        /* further buffers, need to add them */
-        if (pad->volume == 1.0) {
-          switch (adder->info.finfo->format) {
-            case GST_AUDIO_FORMAT_U8:
-              adder_orc_add_u8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S8:
-              adder_orc_add_s8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U16:
-              adder_orc_add_u16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S16:
-              adder_orc_add_s16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U32:
-              adder_orc_add_u32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S32:
-              adder_orc_add_s32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F32:
-              adder_orc_add_f32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F64:
-              adder_orc_add_f64 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            default:
-              g_assert_not_reached ();
-              break;
-          }
-        } else {
-          switch (adder->info.finfo->format) {
-            case GST_AUDIO_FORMAT_U8:
-              adder_orc_add_volume_u8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i8, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S8:
-              adder_orc_add_volume_s8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i8, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U16:
-              adder_orc_add_volume_u16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i16, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S16:
-              adder_orc_add_volume_s16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i16, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U32:
-              adder_orc_add_volume_u32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i32, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S32:
-              adder_orc_add_volume_s32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i32, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F32:
-              adder_orc_add_volume_f32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F64:
-              adder_orc_add_volume_f64 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume, inmap.size / bps);
-              break;
-            default:
-              g_assert_not_reached ();
-              break;
-          }
-        }
-        gst_buffer_unmap (inbuf, &inmap);
-      } else {
+      if (is_gap) {
         /* skip gap buffer */
         GST_LOG_OBJECT (adder, "channel %p: skipping GAP buffer", collect_data);
+        gst_buffer_unref (inbuf);
+        GST_OBJECT_UNLOCK (pad);
+        continue;
       }
-      gst_buffer_unref (inbuf);
+
+      input.buffer = inbuf;
+      gst_buffer_map (inbuf, &input.map, GST_MAP_READ);
+
+      /* all buffers should have outsize, there are no short buffers because we
+       * asked for the max size above */
+      g_assert (input.map.size == outmap.size);
+
+      GST_LOG_OBJECT (adder, "channel %p: mixing %" G_GSIZE_FORMAT " bytes"
+          " from data %p", collect_data, input.map.size, input.map.data);
+    }
+
+    input.minus = NULL;
+    if (minus_index >= 0) {
+      GstAdderMinusOutput *output = &g_array_index (adder->minus_outputs,
+          GstAdderMinusOutput, minus_index);
+
+      output->buffer = gst_buffer_new_allocate (NULL, outmap.size, NULL);
+      gst_buffer_map (output->buffer, &output->map, GST_MAP_WRITE);
+      input.minus = output->map.data;
     }
+
+    input.volume = pad->volume;
+    switch (bps) {
+      case 1:
+        input.volume_i = pad->volume_i8;
+        break;
+      case 2:
+        input.volume_i = pad->volume_i16;
+        break;
+      default:
+        input.volume_i = pad->volume_i32;
+        break;
+    }
+    g_array_append_val (adder->inputs, input);
     GST_OBJECT_UNLOCK (pad);
   }
 
+  if (outbuf) {
+    guint i;
+
+    GST_LOG_OBJECT (adder, "mixing %u inputs", adder->inputs->len);
+    gst_adder_mix_inputs (adder, outmap.data, outmap.size / bps);
+
+    /* the first input is the output buffer itself */
+    for (i = 1; i < adder->inputs->len; i++) {
+      GstAdderInput *in = &g_array_index (adder->inputs, GstAdderInput, i);
+
+      gst_buffer_unmap (in->buffer, &in->map);
+      gst_buffer_unref (in->buffer);
+    }
+    for (i = 0; i < adder->minus_outputs->len; i++) {
+      GstAdderMinusOutput *output =
+          &g_array_index (adder->minus_outputs, GstAdderMinusOutput, i);
+
+      if (output->buffer)
+        gst_buffer_unmap (output->buffer, &output->map);
+    }
+  }
+  g_array_set_size (adder->inputs, 0);
+
   if (outbuf)
     gst_buffer_unmap (outbuf, &outmap);
 
@@ -1430,7 +1758,7 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
     while (tmp) {
       GstEvent *ev = (GstEvent *) tmp->data;
 
-      gst_pad_push_event (adder->srcpad, ev);
+      gst_adder_push_event (adder, ev);
       tmp = g_list_next (tmp);
     }
     g_list_free (adder->pending_events);
@@ -1464,6 +1792,21 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
   adder->offset = next_offset;
   adder->segment.position = next_timestamp;
 
+  if (adder->minus_outputs->len > 0) {
+    guint i;
+
+    for (i = 0; i < adder->minus_outputs->len; i++) {
+      GstAdderMinusOutput *output =
+          &g_array_index (adder->minus_outputs, GstAdderMinusOutput, i);
+
+      if (output->buffer)
+        gst_buffer_copy_into (output->buffer, outbuf,
+            GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+      else
+        output->buffer = gst_buffer_ref (outbuf);
+    }
+  }
+
   /* send it out */
   GST_LOG_OBJECT (adder, "pushing outbuf %p, timestamp %" GST_TIME_FORMAT
       " offset %" G_GINT64_FORMAT, outbuf,
@@ -1473,6 +1816,9 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
 
   GST_LOG_OBJECT (adder, "pushed outbuf, result = %s", gst_flow_get_name (ret));
 
+  if (adder->minus_outputs->len > 0)
+    ret = gst_adder_push_minus_outputs (adder, ret);
+
   return ret;
 
   /* ERRORS */
@@ -1485,7 +1831,8 @@ not_negotiated:
 eos:
   {
     GST_DEBUG_OBJECT (adder, "no data available, must be EOS");
-    gst_pad_push_event (adder->srcpad, gst_event_new_eos ());
+    gst_adder_clear_minus_outputs (adder);
+    gst_adder_push_event (adder, gst_event_new_eos ());
     return GST_FLOW_EOS;
   }
 }
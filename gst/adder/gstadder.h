@@ -76,6 +76,14 @@ struct _GstAdder {
   
   gboolean send_stream_start;
   gboolean send_caps;
+
+  /* the inputs of the current collect cycle, mixed in a single pass */
+  GArray *inputs;
+
+  /* requested mix-minus src pads, protected with the object lock */
+  GList *minus_pads;
+  /* the mix-minus outputs of the current collect cycle */
+  GArray *minus_outputs;
 };
 
 struct _GstAdderClass {
@@ -99,6 +107,9 @@ struct _GstAdderPad {
   gint volume_i16;
   gint volume_i8;
   gboolean mute;
+
+  /* the mix-minus src pad of this pad, protected with the object lock */
+  GstPad *minus_pad;
 };
 
 struct _GstAdderPadClass {
@@ -135,6 +135,48 @@ void adder_orc_add_volume_f32 (float *ORC_RESTRICT d1,
     const float *ORC_RESTRICT s1, float p1, int n);
 void adder_orc_add_volume_f64 (double *ORC_RESTRICT d1,
     const double *ORC_RESTRICT s1, double p1, int n);
+void adder_orc_acc_volume_u8 (gint32 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, int p1, int n);
+void adder_orc_acc_volume_s8 (gint32 * ORC_RESTRICT d1,
+    const gint8 * ORC_RESTRICT s1, int p1, int n);
+void adder_orc_acc_volume_u16 (gint32 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, int p1, int n);
+void adder_orc_acc_volume_s16 (gint32 * ORC_RESTRICT d1,
+    const gint16 * ORC_RESTRICT s1, int p1, int n);
+void adder_orc_acc_volume_u32 (gint64 * ORC_RESTRICT d1,
+    const guint32 * ORC_RESTRICT s1, int p1, int n);
+void adder_orc_acc_volume_s32 (gint64 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, int p1, int n);
+void adder_orc_pack_u8 (guint8 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, int n);
+void adder_orc_pack_s8 (gint8 * ORC_RESTRICT d1, const gint32 * ORC_RESTRICT s1,
+    int n);
+void adder_orc_pack_u16 (guint16 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, int n);
+void adder_orc_pack_s16 (gint16 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, int n);
+void adder_orc_pack_u32 (guint32 * ORC_RESTRICT d1,
+    const gint64 * ORC_RESTRICT s1, int n);
+void adder_orc_pack_s32 (gint32 * ORC_RESTRICT d1,
+    const gint64 * ORC_RESTRICT s1, int n);
+void adder_orc_minus_volume_u8 (guint8 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int p1,
+    int n);
+void adder_orc_minus_volume_s8 (gint8 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint8 * ORC_RESTRICT s2, int p1,
+    int n);
+void adder_orc_minus_volume_u16 (guint16 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2, int p1,
+    int n);
+void adder_orc_minus_volume_s16 (gint16 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2, int p1,
+    int n);
+void adder_orc_minus_volume_u32 (guint32 * ORC_RESTRICT d1,
+    const gint64 * ORC_RESTRICT s1, const guint32 * ORC_RESTRICT s2, int p1,
+    int n);
+void adder_orc_minus_volume_s32 (gint32 * ORC_RESTRICT d1,
+    const gint64 * ORC_RESTRICT s1, const gint32 * ORC_RESTRICT s2, int p1,
+    int n);
 
 
 /* begin Orc C target preamble */
@@ -3532,3 +3574,2726 @@ adder_orc_add_volume_f64 (double *ORC_RESTRICT d1,
   func (ex);
 }
 #endif
+
+
+/* adder_orc_acc_volume_u8 */
+#ifdef DISABLE_ORC
+void
+adder_orc_acc_volume_u8 (gint32 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, int p1, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  orc_int8 var35;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_int8 var36;
+#else
+  orc_int8 var36;
+#endif
+  orc_int8 var37;
+  orc_union32 var38;
+  orc_union32 var39;
+  orc_int8 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union32 var43;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_int8 *) s1;
+
+  /* 1: loadpb */
+  var36 = (int) 0x00000080;     /* 128 or 6.32404e-322f */
+  /* 3: loadpb */
+  var37 = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var35 = ptr4[i];
+    /* 2: xorb */
+    var40 = var35 ^ var36;
+    /* 4: mulsbw */
+    var41.i = var40 * var37;
+    /* 5: shrsw */
+    var42.i = var41.i >> 3;
+    /* 6: convswl */
+    var43.i = var42.i;
+    /* 7: loadl */
+    var38 = ptr0[i];
+    /* 8: addl */
+    var39.i = ((orc_uint32) var38.i) + ((orc_uint32) var43.i);
+    /* 9: storel */
+    ptr0[i] = var39;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_acc_volume_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  orc_int8 var35;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_int8 var36;
+#else
+  orc_int8 var36;
+#endif
+  orc_int8 var37;
+  orc_union32 var38;
+  orc_union32 var39;
+  orc_int8 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union32 var43;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+
+  /* 1: loadpb */
+  var36 = (int) 0x00000080;     /* 128 or 6.32404e-322f */
+  /* 3: loadpb */
+  var37 = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var35 = ptr4[i];
+    /* 2: xorb */
+    var40 = var35 ^ var36;
+    /* 4: mulsbw */
+    var41.i = var40 * var37;
+    /* 5: shrsw */
+    var42.i = var41.i >> 3;
+    /* 6: convswl */
+    var43.i = var42.i;
+    /* 7: loadl */
+    var38 = ptr0[i];
+    /* 8: addl */
+    var39.i = ((orc_uint32) var38.i) + ((orc_uint32) var43.i);
+    /* 9: storel */
+    ptr0[i] = var39;
+  }
+
+}
+
+void
+adder_orc_acc_volume_u8 (gint32 * ORC_RESTRICT d1,
+    const guint8 * ORC_RESTRICT s1, int p1, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 23, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 97, 99, 99,
+        95, 118, 111, 108, 117, 109, 101, 95, 117, 56, 11, 4, 4, 12, 1, 1,
+        14, 1, 128, 0, 0, 0, 14, 2, 3, 0, 0, 0, 16, 1, 20, 1,
+        20, 2, 20, 4, 68, 32, 4, 16, 174, 33, 32, 24, 94, 33, 33, 17,
+        153, 34, 33, 103, 0, 0, 34, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_acc_volume_u8");
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_u8);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_constant (p, 1, 0x00000080, "c1");
+      orc_program_add_constant (p, 2, 0x00000003, "c2");
+      orc_program_add_parameter (p, 1, "p1");
+      orc_program_add_temporary (p, 1, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+
+      orc_program_append_2 (p, "xorb", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulsbw", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convswl", 0, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_D1, ORC_VAR_D1, ORC_VAR_T3,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_acc_volume_s8 */
+#ifdef DISABLE_ORC
+void
+adder_orc_acc_volume_s8 (gint32 * ORC_RESTRICT d1,
+    const gint8 * ORC_RESTRICT s1, int p1, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  orc_int8 var34;
+  orc_int8 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+  orc_union16 var38;
+  orc_union16 var39;
+  orc_union32 var40;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_int8 *) s1;
+
+  /* 1: loadpb */
+  var35 = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var34 = ptr4[i];
+    /* 2: mulsbw */
+    var38.i = var34 * var35;
+    /* 3: shrsw */
+    var39.i = var38.i >> 3;
+    /* 4: convswl */
+    var40.i = var39.i;
+    /* 5: loadl */
+    var36 = ptr0[i];
+    /* 6: addl */
+    var37.i = ((orc_uint32) var36.i) + ((orc_uint32) var40.i);
+    /* 7: storel */
+    ptr0[i] = var37;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_acc_volume_s8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_int8 *ORC_RESTRICT ptr4;
+  orc_int8 var34;
+  orc_int8 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+  orc_union16 var38;
+  orc_union16 var39;
+  orc_union32 var40;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_int8 *) ex->arrays[4];
+
+  /* 1: loadpb */
+  var35 = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var34 = ptr4[i];
+    /* 2: mulsbw */
+    var38.i = var34 * var35;
+    /* 3: shrsw */
+    var39.i = var38.i >> 3;
+    /* 4: convswl */
+    var40.i = var39.i;
+    /* 5: loadl */
+    var36 = ptr0[i];
+    /* 6: addl */
+    var37.i = ((orc_uint32) var36.i) + ((orc_uint32) var40.i);
+    /* 7: storel */
+    ptr0[i] = var37;
+  }
+
+}
+
+void
+adder_orc_acc_volume_s8 (gint32 * ORC_RESTRICT d1,
+    const gint8 * ORC_RESTRICT s1, int p1, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 23, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 97, 99, 99,
+        95, 118, 111, 108, 117, 109, 101, 95, 115, 56, 11, 4, 4, 12, 1, 1,
+        14, 2, 3, 0, 0, 0, 16, 1, 20, 2, 20, 4, 174, 32, 4, 24,
+        94, 32, 32, 16, 153, 33, 32, 103, 0, 0, 33, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_s8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_acc_volume_s8");
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_s8);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 1, "s1");
+      orc_program_add_constant (p, 2, 0x00000003, "c1");
+      orc_program_add_parameter (p, 1, "p1");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+
+      orc_program_append_2 (p, "mulsbw", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convswl", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_D1, ORC_VAR_D1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_acc_volume_u16 */
+#ifdef DISABLE_ORC
+void
+adder_orc_acc_volume_u16 (gint32 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, int p1, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  orc_union16 var34;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var35;
+#else
+  orc_union16 var35;
+#endif
+  orc_union16 var36;
+  orc_union32 var37;
+  orc_union32 var38;
+  orc_union16 var39;
+  orc_union32 var40;
+  orc_union32 var41;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_union16 *) s1;
+
+  /* 1: loadpw */
+  var35.i = (int) 0x00008000;   /* 32768 or 1.61895e-319f */
+  /* 3: loadpw */
+  var36.i = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr4[i];
+    /* 2: xorw */
+    var39.i = var34.i ^ var35.i;
+    /* 4: mulswl */
+    var40.i = var39.i * var36.i;
+    /* 5: shrsl */
+    var41.i = var40.i >> 11;
+    /* 6: loadl */
+    var37 = ptr0[i];
+    /* 7: addl */
+    var38.i = ((orc_uint32) var37.i) + ((orc_uint32) var41.i);
+    /* 8: storel */
+    ptr0[i] = var38;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_acc_volume_u16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  orc_union16 var34;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var35;
+#else
+  orc_union16 var35;
+#endif
+  orc_union16 var36;
+  orc_union32 var37;
+  orc_union32 var38;
+  orc_union16 var39;
+  orc_union32 var40;
+  orc_union32 var41;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_union16 *) ex->arrays[4];
+
+  /* 1: loadpw */
+  var35.i = (int) 0x00008000;   /* 32768 or 1.61895e-319f */
+  /* 3: loadpw */
+  var36.i = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr4[i];
+    /* 2: xorw */
+    var39.i = var34.i ^ var35.i;
+    /* 4: mulswl */
+    var40.i = var39.i * var36.i;
+    /* 5: shrsl */
+    var41.i = var40.i >> 11;
+    /* 6: loadl */
+    var37 = ptr0[i];
+    /* 7: addl */
+    var38.i = ((orc_uint32) var37.i) + ((orc_uint32) var41.i);
+    /* 8: storel */
+    ptr0[i] = var38;
+  }
+
+}
+
+void
+adder_orc_acc_volume_u16 (gint32 * ORC_RESTRICT d1,
+    const guint16 * ORC_RESTRICT s1, int p1, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 24, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 97, 99, 99,
+        95, 118, 111, 108, 117, 109, 101, 95, 117, 49, 54, 11, 4, 4, 12, 2,
+        2, 14, 2, 0, 128, 0, 0, 14, 4, 11, 0, 0, 0, 16, 2, 20,
+        2, 20, 4, 101, 32, 4, 16, 176, 33, 32, 24, 125, 33, 33, 17, 103,
+        0, 0, 33, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_u16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_acc_volume_u16");
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_u16);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 2, "s1");
+      orc_program_add_constant (p, 2, 0x00008000, "c1");
+      orc_program_add_constant (p, 4, 0x0000000b, "c2");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+
+      orc_program_append_2 (p, "xorw", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsl", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_D1, ORC_VAR_D1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_acc_volume_s16 */
+#ifdef DISABLE_ORC
+void
+adder_orc_acc_volume_s16 (gint32 * ORC_RESTRICT d1,
+    const gint16 * ORC_RESTRICT s1, int p1, int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  orc_union16 var33;
+  orc_union16 var34;
+  orc_union32 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+  orc_union32 var38;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_union16 *) s1;
+
+  /* 1: loadpw */
+  var34.i = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var33 = ptr4[i];
+    /* 2: mulswl */
+    var37.i = var33.i * var34.i;
+    /* 3: shrsl */
+    var38.i = var37.i >> 11;
+    /* 4: loadl */
+    var35 = ptr0[i];
+    /* 5: addl */
+    var36.i = ((orc_uint32) var35.i) + ((orc_uint32) var38.i);
+    /* 6: storel */
+    ptr0[i] = var36;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_acc_volume_s16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union16 *ORC_RESTRICT ptr4;
+  orc_union16 var33;
+  orc_union16 var34;
+  orc_union32 var35;
+  orc_union32 var36;
+  orc_union32 var37;
+  orc_union32 var38;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_union16 *) ex->arrays[4];
+
+  /* 1: loadpw */
+  var34.i = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var33 = ptr4[i];
+    /* 2: mulswl */
+    var37.i = var33.i * var34.i;
+    /* 3: shrsl */
+    var38.i = var37.i >> 11;
+    /* 4: loadl */
+    var35 = ptr0[i];
+    /* 5: addl */
+    var36.i = ((orc_uint32) var35.i) + ((orc_uint32) var38.i);
+    /* 6: storel */
+    ptr0[i] = var36;
+  }
+
+}
+
+void
+adder_orc_acc_volume_s16 (gint32 * ORC_RESTRICT d1,
+    const gint16 * ORC_RESTRICT s1, int p1, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 24, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 97, 99, 99,
+        95, 118, 111, 108, 117, 109, 101, 95, 115, 49, 54, 11, 4, 4, 12, 2,
+        2, 14, 4, 11, 0, 0, 0, 16, 2, 20, 4, 176, 32, 4, 24, 125,
+        32, 32, 16, 103, 0, 0, 32, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_s16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_acc_volume_s16");
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_s16);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 2, "s1");
+      orc_program_add_constant (p, 4, 0x0000000b, "c1");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_temporary (p, 4, "t1");
+
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addl", 0, ORC_VAR_D1, ORC_VAR_D1, ORC_VAR_T1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_acc_volume_u32 */
+#ifdef DISABLE_ORC
+void
+adder_orc_acc_volume_u32 (gint64 * ORC_RESTRICT d1,
+    const guint32 * ORC_RESTRICT s1, int p1, int n)
+{
+  int i;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var34;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var35;
+#else
+  orc_union32 var35;
+#endif
+  orc_union32 var36;
+  orc_union64 var37;
+  orc_union64 var38;
+  orc_union32 var39;
+  orc_union64 var40;
+  orc_union64 var41;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr4 = (orc_union32 *) s1;
+
+  /* 1: loadpl */
+  var35.i = (int) 0x80000000;   /* -2147483648 or 1.061e-314f */
+  /* 3: loadpl */
+  var36.i = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var34 = ptr4[i];
+    /* 2: xorl */
+    var39.i = var34.i ^ var35.i;
+    /* 4: mulslq */
+    var40.i = ((orc_int64) var39.i) * ((orc_int64) var36.i);
+    /* 5: shrsq */
+    var41.i = var40.i >> 27;
+    /* 6: loadq */
+    var37 = ptr0[i];
+    /* 7: addq */
+    var38.i = var37.i + var41.i;
+    /* 8: storeq */
+    ptr0[i] = var38;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_acc_volume_u32 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var34;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var35;
+#else
+  orc_union32 var35;
+#endif
+  orc_union32 var36;
+  orc_union64 var37;
+  orc_union64 var38;
+  orc_union32 var39;
+  orc_union64 var40;
+  orc_union64 var41;
+
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+
+  /* 1: loadpl */
+  var35.i = (int) 0x80000000;   /* -2147483648 or 1.061e-314f */
+  /* 3: loadpl */
+  var36.i = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var34 = ptr4[i];
+    /* 2: xorl */
+    var39.i = var34.i ^ var35.i;
+    /* 4: mulslq */
+    var40.i = ((orc_int64) var39.i) * ((orc_int64) var36.i);
+    /* 5: shrsq */
+    var41.i = var40.i >> 27;
+    /* 6: loadq */
+    var37 = ptr0[i];
+    /* 7: addq */
+    var38.i = var37.i + var41.i;
+    /* 8: storeq */
+    ptr0[i] = var38;
+  }
+
+}
+
+void
+adder_orc_acc_volume_u32 (gint64 * ORC_RESTRICT d1,
+    const guint32 * ORC_RESTRICT s1, int p1, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 24, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 97, 99, 99,
+        95, 118, 111, 108, 117, 109, 101, 95, 117, 51, 50, 11, 8, 8, 12, 4,
+        4, 14, 4, 0, 0, 0, 128, 15, 8, 27, 0, 0, 0, 0, 0, 0,
+        0, 16, 4, 20, 4, 20, 8, 132, 32, 4, 16, 178, 33, 32, 24, 147,
+        33, 33, 17, 144, 0, 0, 33, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_u32);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_acc_volume_u32");
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_u32);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_constant (p, 4, 0x80000000, "c1");
+      orc_program_add_constant_int64 (p, 8, 0x000000000000001bULL, "c2");
+      orc_program_add_parameter (p, 4, "p1");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 8, "t2");
+
+      orc_program_append_2 (p, "xorl", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulslq", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsq", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addq", 0, ORC_VAR_D1, ORC_VAR_D1, ORC_VAR_T2,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_acc_volume_s32 */
+#ifdef DISABLE_ORC
+void
+adder_orc_acc_volume_s32 (gint64 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, int p1, int n)
+{
+  int i;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union64 var35;
+  orc_union64 var36;
+  orc_union64 var37;
+  orc_union64 var38;
+
+  ptr0 = (orc_union64 *) d1;
+  ptr4 = (orc_union32 *) s1;
+
+  /* 1: loadpl */
+  var34.i = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var33 = ptr4[i];
+    /* 2: mulslq */
+    var37.i = ((orc_int64) var33.i) * ((orc_int64) var34.i);
+    /* 3: shrsq */
+    var38.i = var37.i >> 27;
+    /* 4: loadq */
+    var35 = ptr0[i];
+    /* 5: addq */
+    var36.i = var35.i + var38.i;
+    /* 6: storeq */
+    ptr0[i] = var36;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_acc_volume_s32 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union64 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union64 var35;
+  orc_union64 var36;
+  orc_union64 var37;
+  orc_union64 var38;
+
+  ptr0 = (orc_union64 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+
+  /* 1: loadpl */
+  var34.i = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var33 = ptr4[i];
+    /* 2: mulslq */
+    var37.i = ((orc_int64) var33.i) * ((orc_int64) var34.i);
+    /* 3: shrsq */
+    var38.i = var37.i >> 27;
+    /* 4: loadq */
+    var35 = ptr0[i];
+    /* 5: addq */
+    var36.i = var35.i + var38.i;
+    /* 6: storeq */
+    ptr0[i] = var36;
+  }
+
+}
+
+void
+adder_orc_acc_volume_s32 (gint64 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, int p1, int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 24, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 97, 99, 99,
+        95, 118, 111, 108, 117, 109, 101, 95, 115, 51, 50, 11, 8, 8, 12, 4,
+        4, 15, 8, 27, 0, 0, 0, 0, 0, 0, 0, 16, 4, 20, 8, 178,
+        32, 4, 24, 147, 32, 32, 16, 144, 0, 0, 32, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_s32);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_acc_volume_s32");
+      orc_program_set_backup_function (p, _backup_adder_orc_acc_volume_s32);
+      orc_program_add_destination (p, 8, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_constant_int64 (p, 8, 0x000000000000001bULL, "c1");
+      orc_program_add_parameter (p, 4, "p1");
+      orc_program_add_temporary (p, 8, "t1");
+
+      orc_program_append_2 (p, "mulslq", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsq", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "addq", 0, ORC_VAR_D1, ORC_VAR_D1, ORC_VAR_T1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_pack_u8 */
+#ifdef DISABLE_ORC
+void
+adder_orc_pack_u8 (guint8 * ORC_RESTRICT d1, const gint32 * ORC_RESTRICT s1,
+    int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var34;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_int8 var35;
+#else
+  orc_int8 var35;
+#endif
+  orc_int8 var36;
+  orc_union16 var37;
+  orc_int8 var38;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_union32 *) s1;
+
+  /* 3: loadpb */
+  var35 = (int) 0x00000080;     /* 128 or 6.32404e-322f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var34 = ptr4[i];
+    /* 1: convssslw */
+    var37.i = ORC_CLAMP_SW (var34.i);
+    /* 2: convssswb */
+    var38 = ORC_CLAMP_SB (var37.i);
+    /* 4: xorb */
+    var36 = var38 ^ var35;
+    /* 5: storeb */
+    ptr0[i] = var36;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_pack_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var34;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_int8 var35;
+#else
+  orc_int8 var35;
+#endif
+  orc_int8 var36;
+  orc_union16 var37;
+  orc_int8 var38;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+
+  /* 3: loadpb */
+  var35 = (int) 0x00000080;     /* 128 or 6.32404e-322f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var34 = ptr4[i];
+    /* 1: convssslw */
+    var37.i = ORC_CLAMP_SW (var34.i);
+    /* 2: convssswb */
+    var38 = ORC_CLAMP_SB (var37.i);
+    /* 4: xorb */
+    var36 = var38 ^ var35;
+    /* 5: storeb */
+    ptr0[i] = var36;
+  }
+
+}
+
+void
+adder_orc_pack_u8 (guint8 * ORC_RESTRICT d1, const gint32 * ORC_RESTRICT s1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 17, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 112, 97, 99,
+        107, 95, 117, 56, 11, 1, 1, 12, 4, 4, 14, 1, 128, 0, 0, 0,
+        20, 2, 20, 1, 165, 32, 4, 159, 33, 32, 68, 0, 33, 16, 2, 0,
+
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_pack_u8");
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_u8);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_constant (p, 1, 0x00000080, "c1");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 1, "t2");
+
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convssswb", 0, ORC_VAR_T2, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "xorb", 0, ORC_VAR_D1, ORC_VAR_T2, ORC_VAR_C1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_pack_s8 */
+#ifdef DISABLE_ORC
+void
+adder_orc_pack_s8 (gint8 * ORC_RESTRICT d1, const gint32 * ORC_RESTRICT s1,
+    int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var33;
+  orc_int8 var34;
+  orc_union16 var35;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_union32 *) s1;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var33 = ptr4[i];
+    /* 1: convssslw */
+    var35.i = ORC_CLAMP_SW (var33.i);
+    /* 2: convssswb */
+    var34 = ORC_CLAMP_SB (var35.i);
+    /* 3: storeb */
+    ptr0[i] = var34;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_pack_s8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var33;
+  orc_int8 var34;
+  orc_union16 var35;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var33 = ptr4[i];
+    /* 1: convssslw */
+    var35.i = ORC_CLAMP_SW (var33.i);
+    /* 2: convssswb */
+    var34 = ORC_CLAMP_SB (var35.i);
+    /* 3: storeb */
+    ptr0[i] = var34;
+  }
+
+}
+
+void
+adder_orc_pack_s8 (gint8 * ORC_RESTRICT d1, const gint32 * ORC_RESTRICT s1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 17, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 112, 97, 99,
+        107, 95, 115, 56, 11, 1, 1, 12, 4, 4, 20, 2, 165, 32, 4, 159,
+        0, 32, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_s8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_pack_s8");
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_s8);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_temporary (p, 2, "t1");
+
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convssswb", 0, ORC_VAR_D1, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_pack_u16 */
+#ifdef DISABLE_ORC
+void
+adder_orc_pack_u16 (guint16 * ORC_RESTRICT d1, const gint32 * ORC_RESTRICT s1,
+    int n)
+{
+  int i;
+  orc_union16 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var33;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var34;
+#else
+  orc_union16 var34;
+#endif
+  orc_union16 var35;
+  orc_union16 var36;
+
+  ptr0 = (orc_union16 *) d1;
+  ptr4 = (orc_union32 *) s1;
+
+  /* 2: loadpw */
+  var34.i = (int) 0x00008000;   /* 32768 or 1.61895e-319f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var33 = ptr4[i];
+    /* 1: convssslw */
+    var36.i = ORC_CLAMP_SW (var33.i);
+    /* 3: xorw */
+    var35.i = var36.i ^ var34.i;
+    /* 4: storew */
+    ptr0[i] = var35;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_pack_u16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union16 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var33;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var34;
+#else
+  orc_union16 var34;
+#endif
+  orc_union16 var35;
+  orc_union16 var36;
+
+  ptr0 = (orc_union16 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+
+  /* 2: loadpw */
+  var34.i = (int) 0x00008000;   /* 32768 or 1.61895e-319f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var33 = ptr4[i];
+    /* 1: convssslw */
+    var36.i = ORC_CLAMP_SW (var33.i);
+    /* 3: xorw */
+    var35.i = var36.i ^ var34.i;
+    /* 4: storew */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+adder_orc_pack_u16 (guint16 * ORC_RESTRICT d1, const gint32 * ORC_RESTRICT s1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 18, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 112, 97, 99,
+        107, 95, 117, 49, 54, 11, 2, 2, 12, 4, 4, 14, 2, 0, 128, 0,
+        0, 20, 2, 165, 32, 4, 101, 0, 32, 16, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_u16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_pack_u16");
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_u16);
+      orc_program_add_destination (p, 2, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_constant (p, 2, 0x00008000, "c1");
+      orc_program_add_temporary (p, 2, "t1");
+
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "xorw", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_pack_s16 */
+#ifdef DISABLE_ORC
+void
+adder_orc_pack_s16 (gint16 * ORC_RESTRICT d1, const gint32 * ORC_RESTRICT s1,
+    int n)
+{
+  int i;
+  orc_union16 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union16 var33;
+
+  ptr0 = (orc_union16 *) d1;
+  ptr4 = (orc_union32 *) s1;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: convssslw */
+    var33.i = ORC_CLAMP_SW (var32.i);
+    /* 2: storew */
+    ptr0[i] = var33;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_pack_s16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union16 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  orc_union32 var32;
+  orc_union16 var33;
+
+  ptr0 = (orc_union16 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var32 = ptr4[i];
+    /* 1: convssslw */
+    var33.i = ORC_CLAMP_SW (var32.i);
+    /* 2: storew */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+adder_orc_pack_s16 (gint16 * ORC_RESTRICT d1, const gint32 * ORC_RESTRICT s1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 18, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 112, 97, 99,
+        107, 95, 115, 49, 54, 11, 2, 2, 12, 4, 4, 165, 0, 4, 2, 0,
+
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_s16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_pack_s16");
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_s16);
+      orc_program_add_destination (p, 2, "d1");
+      orc_program_add_source (p, 4, "s1");
+
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_D1, ORC_VAR_S1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_pack_u32 */
+#ifdef DISABLE_ORC
+void
+adder_orc_pack_u32 (guint32 * ORC_RESTRICT d1, const gint64 * ORC_RESTRICT s1,
+    int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  orc_union64 var33;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var34;
+#else
+  orc_union32 var34;
+#endif
+  orc_union32 var35;
+  orc_union32 var36;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_union64 *) s1;
+
+  /* 2: loadpl */
+  var34.i = (int) 0x80000000;   /* -2147483648 or 1.061e-314f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var33 = ptr4[i];
+    /* 1: convsssql */
+    var36.i = ORC_CLAMP_SL (var33.i);
+    /* 3: xorl */
+    var35.i = var36.i ^ var34.i;
+    /* 4: storel */
+    ptr0[i] = var35;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_pack_u32 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  orc_union64 var33;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var34;
+#else
+  orc_union32 var34;
+#endif
+  orc_union32 var35;
+  orc_union32 var36;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+
+  /* 2: loadpl */
+  var34.i = (int) 0x80000000;   /* -2147483648 or 1.061e-314f */
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var33 = ptr4[i];
+    /* 1: convsssql */
+    var36.i = ORC_CLAMP_SL (var33.i);
+    /* 3: xorl */
+    var35.i = var36.i ^ var34.i;
+    /* 4: storel */
+    ptr0[i] = var35;
+  }
+
+}
+
+void
+adder_orc_pack_u32 (guint32 * ORC_RESTRICT d1, const gint64 * ORC_RESTRICT s1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 18, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 112, 97, 99,
+        107, 95, 117, 51, 50, 11, 4, 4, 12, 8, 8, 14, 4, 0, 0, 0,
+        128, 20, 4, 170, 32, 4, 132, 0, 32, 16, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_u32);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_pack_u32");
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_u32);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_constant (p, 4, 0x80000000, "c1");
+      orc_program_add_temporary (p, 4, "t1");
+
+      orc_program_append_2 (p, "convsssql", 0, ORC_VAR_T1, ORC_VAR_S1,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "xorl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_pack_s32 */
+#ifdef DISABLE_ORC
+void
+adder_orc_pack_s32 (gint32 * ORC_RESTRICT d1, const gint64 * ORC_RESTRICT s1,
+    int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  orc_union64 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_union64 *) s1;
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: convsssql */
+    var33.i = ORC_CLAMP_SL (var32.i);
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_pack_s32 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  orc_union64 var32;
+  orc_union32 var33;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadq */
+    var32 = ptr4[i];
+    /* 1: convsssql */
+    var33.i = ORC_CLAMP_SL (var32.i);
+    /* 2: storel */
+    ptr0[i] = var33;
+  }
+
+}
+
+void
+adder_orc_pack_s32 (gint32 * ORC_RESTRICT d1, const gint64 * ORC_RESTRICT s1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 18, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 112, 97, 99,
+        107, 95, 115, 51, 50, 11, 4, 4, 12, 8, 8, 170, 0, 4, 2, 0,
+
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_s32);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_pack_s32");
+      orc_program_set_backup_function (p, _backup_adder_orc_pack_s32);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 8, "s1");
+
+      orc_program_append_2 (p, "convsssql", 0, ORC_VAR_D1, ORC_VAR_S1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_minus_volume_u8 */
+#ifdef DISABLE_ORC
+void
+adder_orc_minus_volume_u8 (guint8 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  orc_int8 var35;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_int8 var36;
+#else
+  orc_int8 var36;
+#endif
+  orc_int8 var37;
+  orc_union32 var38;
+  orc_int8 var39;
+  orc_int8 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union16 var45;
+  orc_int8 var46;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_int8 *) s2;
+
+  /* 1: loadpb */
+  var36 = (int) 0x00000080;     /* 128 or 6.32404e-322f */
+  /* 3: loadpb */
+  var37 = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var35 = ptr5[i];
+    /* 2: xorb */
+    var40 = var35 ^ var36;
+    /* 4: mulsbw */
+    var41.i = var40 * var37;
+    /* 5: shrsw */
+    var42.i = var41.i >> 3;
+    /* 6: convswl */
+    var43.i = var42.i;
+    /* 7: loadl */
+    var38 = ptr4[i];
+    /* 8: subl */
+    var44.i = ((orc_uint32) var38.i) - ((orc_uint32) var43.i);
+    /* 9: convssslw */
+    var45.i = ORC_CLAMP_SW (var44.i);
+    /* 10: convssswb */
+    var46 = ORC_CLAMP_SB (var45.i);
+    /* 11: xorb */
+    var39 = var46 ^ var36;
+    /* 12: storeb */
+    ptr0[i] = var39;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_minus_volume_u8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  orc_int8 var35;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_int8 var36;
+#else
+  orc_int8 var36;
+#endif
+  orc_int8 var37;
+  orc_union32 var38;
+  orc_int8 var39;
+  orc_int8 var40;
+  orc_union16 var41;
+  orc_union16 var42;
+  orc_union32 var43;
+  orc_union32 var44;
+  orc_union16 var45;
+  orc_int8 var46;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+
+  /* 1: loadpb */
+  var36 = (int) 0x00000080;     /* 128 or 6.32404e-322f */
+  /* 3: loadpb */
+  var37 = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var35 = ptr5[i];
+    /* 2: xorb */
+    var40 = var35 ^ var36;
+    /* 4: mulsbw */
+    var41.i = var40 * var37;
+    /* 5: shrsw */
+    var42.i = var41.i >> 3;
+    /* 6: convswl */
+    var43.i = var42.i;
+    /* 7: loadl */
+    var38 = ptr4[i];
+    /* 8: subl */
+    var44.i = ((orc_uint32) var38.i) - ((orc_uint32) var43.i);
+    /* 9: convssslw */
+    var45.i = ORC_CLAMP_SW (var44.i);
+    /* 10: convssswb */
+    var46 = ORC_CLAMP_SB (var45.i);
+    /* 11: xorb */
+    var39 = var46 ^ var36;
+    /* 12: storeb */
+    ptr0[i] = var39;
+  }
+
+}
+
+void
+adder_orc_minus_volume_u8 (guint8 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const guint8 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 25, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 109, 105, 110,
+        117, 115, 95, 118, 111, 108, 117, 109, 101, 95, 117, 56, 11, 1, 1, 12,
+        4, 4, 12, 1, 1, 14, 1, 128, 0, 0, 0, 14, 2, 3, 0, 0,
+        0, 16, 1, 20, 1, 20, 2, 20, 4, 68, 32, 5, 16, 174, 33, 32,
+        24, 94, 33, 33, 17, 153, 34, 33, 129, 34, 4, 34, 165, 33, 34, 159,
+        32, 33, 68, 0, 32, 16, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_u8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_minus_volume_u8");
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_u8);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_constant (p, 1, 0x00000080, "c1");
+      orc_program_add_constant (p, 2, 0x00000003, "c2");
+      orc_program_add_parameter (p, 1, "p1");
+      orc_program_add_temporary (p, 1, "t1");
+      orc_program_add_temporary (p, 2, "t2");
+      orc_program_add_temporary (p, 4, "t3");
+
+      orc_program_append_2 (p, "xorb", 0, ORC_VAR_T1, ORC_VAR_S2, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulsbw", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsw", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convswl", 0, ORC_VAR_T3, ORC_VAR_T2, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subl", 0, ORC_VAR_T3, ORC_VAR_S1, ORC_VAR_T3,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_T2, ORC_VAR_T3,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convssswb", 0, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "xorb", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_minus_volume_s8 */
+#ifdef DISABLE_ORC
+void
+adder_orc_minus_volume_s8 (gint8 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint8 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  int i;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  orc_int8 var34;
+  orc_int8 var35;
+  orc_union32 var36;
+  orc_int8 var37;
+  orc_union16 var38;
+  orc_union16 var39;
+  orc_union32 var40;
+  orc_union32 var41;
+  orc_union16 var42;
+
+  ptr0 = (orc_int8 *) d1;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_int8 *) s2;
+
+  /* 1: loadpb */
+  var35 = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var34 = ptr5[i];
+    /* 2: mulsbw */
+    var38.i = var34 * var35;
+    /* 3: shrsw */
+    var39.i = var38.i >> 3;
+    /* 4: convswl */
+    var40.i = var39.i;
+    /* 5: loadl */
+    var36 = ptr4[i];
+    /* 6: subl */
+    var41.i = ((orc_uint32) var36.i) - ((orc_uint32) var40.i);
+    /* 7: convssslw */
+    var42.i = ORC_CLAMP_SW (var41.i);
+    /* 8: convssswb */
+    var37 = ORC_CLAMP_SB (var42.i);
+    /* 9: storeb */
+    ptr0[i] = var37;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_minus_volume_s8 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_int8 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_int8 *ORC_RESTRICT ptr5;
+  orc_int8 var34;
+  orc_int8 var35;
+  orc_union32 var36;
+  orc_int8 var37;
+  orc_union16 var38;
+  orc_union16 var39;
+  orc_union32 var40;
+  orc_union32 var41;
+  orc_union16 var42;
+
+  ptr0 = (orc_int8 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_int8 *) ex->arrays[5];
+
+  /* 1: loadpb */
+  var35 = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadb */
+    var34 = ptr5[i];
+    /* 2: mulsbw */
+    var38.i = var34 * var35;
+    /* 3: shrsw */
+    var39.i = var38.i >> 3;
+    /* 4: convswl */
+    var40.i = var39.i;
+    /* 5: loadl */
+    var36 = ptr4[i];
+    /* 6: subl */
+    var41.i = ((orc_uint32) var36.i) - ((orc_uint32) var40.i);
+    /* 7: convssslw */
+    var42.i = ORC_CLAMP_SW (var41.i);
+    /* 8: convssswb */
+    var37 = ORC_CLAMP_SB (var42.i);
+    /* 9: storeb */
+    ptr0[i] = var37;
+  }
+
+}
+
+void
+adder_orc_minus_volume_s8 (gint8 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint8 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 25, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 109, 105, 110,
+        117, 115, 95, 118, 111, 108, 117, 109, 101, 95, 115, 56, 11, 1, 1, 12,
+        4, 4, 12, 1, 1, 14, 2, 3, 0, 0, 0, 16, 1, 20, 2, 20,
+        4, 174, 32, 5, 24, 94, 32, 32, 16, 153, 33, 32, 129, 33, 4, 33,
+        165, 32, 33, 159, 0, 32, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_s8);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_minus_volume_s8");
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_s8);
+      orc_program_add_destination (p, 1, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 1, "s2");
+      orc_program_add_constant (p, 2, 0x00000003, "c1");
+      orc_program_add_parameter (p, 1, "p1");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+
+      orc_program_append_2 (p, "mulsbw", 0, ORC_VAR_T1, ORC_VAR_S2, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsw", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convswl", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_D1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subl", 0, ORC_VAR_T2, ORC_VAR_S1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "convssswb", 0, ORC_VAR_D1, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_minus_volume_u16 */
+#ifdef DISABLE_ORC
+void
+adder_orc_minus_volume_u16 (guint16 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  int i;
+  orc_union16 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  orc_union16 var34;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var35;
+#else
+  orc_union16 var35;
+#endif
+  orc_union16 var36;
+  orc_union32 var37;
+  orc_union16 var38;
+  orc_union16 var39;
+  orc_union32 var40;
+  orc_union32 var41;
+  orc_union32 var42;
+  orc_union16 var43;
+
+  ptr0 = (orc_union16 *) d1;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_union16 *) s2;
+
+  /* 1: loadpw */
+  var35.i = (int) 0x00008000;   /* 32768 or 1.61895e-319f */
+  /* 3: loadpw */
+  var36.i = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr5[i];
+    /* 2: xorw */
+    var39.i = var34.i ^ var35.i;
+    /* 4: mulswl */
+    var40.i = var39.i * var36.i;
+    /* 5: shrsl */
+    var41.i = var40.i >> 11;
+    /* 6: loadl */
+    var37 = ptr4[i];
+    /* 7: subl */
+    var42.i = ((orc_uint32) var37.i) - ((orc_uint32) var41.i);
+    /* 8: convssslw */
+    var43.i = ORC_CLAMP_SW (var42.i);
+    /* 9: xorw */
+    var38.i = var43.i ^ var35.i;
+    /* 10: storew */
+    ptr0[i] = var38;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_minus_volume_u16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union16 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  orc_union16 var34;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union16 var35;
+#else
+  orc_union16 var35;
+#endif
+  orc_union16 var36;
+  orc_union32 var37;
+  orc_union16 var38;
+  orc_union16 var39;
+  orc_union32 var40;
+  orc_union32 var41;
+  orc_union32 var42;
+  orc_union16 var43;
+
+  ptr0 = (orc_union16 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_union16 *) ex->arrays[5];
+
+  /* 1: loadpw */
+  var35.i = (int) 0x00008000;   /* 32768 or 1.61895e-319f */
+  /* 3: loadpw */
+  var36.i = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var34 = ptr5[i];
+    /* 2: xorw */
+    var39.i = var34.i ^ var35.i;
+    /* 4: mulswl */
+    var40.i = var39.i * var36.i;
+    /* 5: shrsl */
+    var41.i = var40.i >> 11;
+    /* 6: loadl */
+    var37 = ptr4[i];
+    /* 7: subl */
+    var42.i = ((orc_uint32) var37.i) - ((orc_uint32) var41.i);
+    /* 8: convssslw */
+    var43.i = ORC_CLAMP_SW (var42.i);
+    /* 9: xorw */
+    var38.i = var43.i ^ var35.i;
+    /* 10: storew */
+    ptr0[i] = var38;
+  }
+
+}
+
+void
+adder_orc_minus_volume_u16 (guint16 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const guint16 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 26, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 109, 105, 110,
+        117, 115, 95, 118, 111, 108, 117, 109, 101, 95, 117, 49, 54, 11, 2, 2,
+        12, 4, 4, 12, 2, 2, 14, 2, 0, 128, 0, 0, 14, 4, 11, 0,
+        0, 0, 16, 2, 20, 2, 20, 4, 101, 32, 5, 16, 176, 33, 32, 24,
+        125, 33, 33, 17, 129, 33, 4, 33, 165, 32, 33, 101, 0, 32, 16, 2,
+        0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_u16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_minus_volume_u16");
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_u16);
+      orc_program_add_destination (p, 2, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 2, "s2");
+      orc_program_add_constant (p, 2, 0x00008000, "c1");
+      orc_program_add_constant (p, 4, 0x0000000b, "c2");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_temporary (p, 2, "t1");
+      orc_program_add_temporary (p, 4, "t2");
+
+      orc_program_append_2 (p, "xorw", 0, ORC_VAR_T1, ORC_VAR_S2, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsl", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subl", 0, ORC_VAR_T2, ORC_VAR_S1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "xorw", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_minus_volume_s16 */
+#ifdef DISABLE_ORC
+void
+adder_orc_minus_volume_s16 (gint16 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  int i;
+  orc_union16 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  orc_union16 var33;
+  orc_union16 var34;
+  orc_union32 var35;
+  orc_union16 var36;
+  orc_union32 var37;
+  orc_union32 var38;
+  orc_union32 var39;
+
+  ptr0 = (orc_union16 *) d1;
+  ptr4 = (orc_union32 *) s1;
+  ptr5 = (orc_union16 *) s2;
+
+  /* 1: loadpw */
+  var34.i = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var33 = ptr5[i];
+    /* 2: mulswl */
+    var37.i = var33.i * var34.i;
+    /* 3: shrsl */
+    var38.i = var37.i >> 11;
+    /* 4: loadl */
+    var35 = ptr4[i];
+    /* 5: subl */
+    var39.i = ((orc_uint32) var35.i) - ((orc_uint32) var38.i);
+    /* 6: convssslw */
+    var36.i = ORC_CLAMP_SW (var39.i);
+    /* 7: storew */
+    ptr0[i] = var36;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_minus_volume_s16 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union16 *ORC_RESTRICT ptr0;
+  const orc_union32 *ORC_RESTRICT ptr4;
+  const orc_union16 *ORC_RESTRICT ptr5;
+  orc_union16 var33;
+  orc_union16 var34;
+  orc_union32 var35;
+  orc_union16 var36;
+  orc_union32 var37;
+  orc_union32 var38;
+  orc_union32 var39;
+
+  ptr0 = (orc_union16 *) ex->arrays[0];
+  ptr4 = (orc_union32 *) ex->arrays[4];
+  ptr5 = (orc_union16 *) ex->arrays[5];
+
+  /* 1: loadpw */
+  var34.i = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadw */
+    var33 = ptr5[i];
+    /* 2: mulswl */
+    var37.i = var33.i * var34.i;
+    /* 3: shrsl */
+    var38.i = var37.i >> 11;
+    /* 4: loadl */
+    var35 = ptr4[i];
+    /* 5: subl */
+    var39.i = ((orc_uint32) var35.i) - ((orc_uint32) var38.i);
+    /* 6: convssslw */
+    var36.i = ORC_CLAMP_SW (var39.i);
+    /* 7: storew */
+    ptr0[i] = var36;
+  }
+
+}
+
+void
+adder_orc_minus_volume_s16 (gint16 * ORC_RESTRICT d1,
+    const gint32 * ORC_RESTRICT s1, const gint16 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 26, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 109, 105, 110,
+        117, 115, 95, 118, 111, 108, 117, 109, 101, 95, 115, 49, 54, 11, 2, 2,
+        12, 4, 4, 12, 2, 2, 14, 4, 11, 0, 0, 0, 16, 2, 20, 4,
+        176, 32, 5, 24, 125, 32, 32, 16, 129, 32, 4, 32, 165, 0, 32, 2,
+        0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_s16);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_minus_volume_s16");
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_s16);
+      orc_program_add_destination (p, 2, "d1");
+      orc_program_add_source (p, 4, "s1");
+      orc_program_add_source (p, 2, "s2");
+      orc_program_add_constant (p, 4, 0x0000000b, "c1");
+      orc_program_add_parameter (p, 2, "p1");
+      orc_program_add_temporary (p, 4, "t1");
+
+      orc_program_append_2 (p, "mulswl", 0, ORC_VAR_T1, ORC_VAR_S2, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsl", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subl", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convssslw", 0, ORC_VAR_D1, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_minus_volume_u32 */
+#ifdef DISABLE_ORC
+void
+adder_orc_minus_volume_u32 (guint32 * ORC_RESTRICT d1,
+    const gint64 * ORC_RESTRICT s1, const guint32 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  orc_union32 var34;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var35;
+#else
+  orc_union32 var35;
+#endif
+  orc_union32 var36;
+  orc_union64 var37;
+  orc_union32 var38;
+  orc_union32 var39;
+  orc_union64 var40;
+  orc_union64 var41;
+  orc_union64 var42;
+  orc_union32 var43;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union32 *) s2;
+
+  /* 1: loadpl */
+  var35.i = (int) 0x80000000;   /* -2147483648 or 1.061e-314f */
+  /* 3: loadpl */
+  var36.i = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var34 = ptr5[i];
+    /* 2: xorl */
+    var39.i = var34.i ^ var35.i;
+    /* 4: mulslq */
+    var40.i = ((orc_int64) var39.i) * ((orc_int64) var36.i);
+    /* 5: shrsq */
+    var41.i = var40.i >> 27;
+    /* 6: loadq */
+    var37 = ptr4[i];
+    /* 7: subq */
+    var42.i = var37.i - var41.i;
+    /* 8: convsssql */
+    var43.i = ORC_CLAMP_SL (var42.i);
+    /* 9: xorl */
+    var38.i = var43.i ^ var35.i;
+    /* 10: storel */
+    ptr0[i] = var38;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_minus_volume_u32 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  orc_union32 var34;
+#if defined(__APPLE__) && __GNUC__ == 4 && __GNUC_MINOR__ == 2 && defined (__i386__)
+  volatile orc_union32 var35;
+#else
+  orc_union32 var35;
+#endif
+  orc_union32 var36;
+  orc_union64 var37;
+  orc_union32 var38;
+  orc_union32 var39;
+  orc_union64 var40;
+  orc_union64 var41;
+  orc_union64 var42;
+  orc_union32 var43;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union32 *) ex->arrays[5];
+
+  /* 1: loadpl */
+  var35.i = (int) 0x80000000;   /* -2147483648 or 1.061e-314f */
+  /* 3: loadpl */
+  var36.i = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var34 = ptr5[i];
+    /* 2: xorl */
+    var39.i = var34.i ^ var35.i;
+    /* 4: mulslq */
+    var40.i = ((orc_int64) var39.i) * ((orc_int64) var36.i);
+    /* 5: shrsq */
+    var41.i = var40.i >> 27;
+    /* 6: loadq */
+    var37 = ptr4[i];
+    /* 7: subq */
+    var42.i = var37.i - var41.i;
+    /* 8: convsssql */
+    var43.i = ORC_CLAMP_SL (var42.i);
+    /* 9: xorl */
+    var38.i = var43.i ^ var35.i;
+    /* 10: storel */
+    ptr0[i] = var38;
+  }
+
+}
+
+void
+adder_orc_minus_volume_u32 (guint32 * ORC_RESTRICT d1,
+    const gint64 * ORC_RESTRICT s1, const guint32 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 26, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 109, 105, 110,
+        117, 115, 95, 118, 111, 108, 117, 109, 101, 95, 117, 51, 50, 11, 4, 4,
+        12, 8, 8, 12, 4, 4, 14, 4, 0, 0, 0, 128, 15, 8, 27, 0,
+        0, 0, 0, 0, 0, 0, 16, 4, 20, 4, 20, 8, 132, 32, 5, 16,
+        178, 33, 32, 24, 147, 33, 33, 17, 145, 33, 4, 33, 170, 32, 33, 132,
+        0, 32, 16, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_u32);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_minus_volume_u32");
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_u32);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 4, "s2");
+      orc_program_add_constant (p, 4, 0x80000000, "c1");
+      orc_program_add_constant_int64 (p, 8, 0x000000000000001bULL, "c2");
+      orc_program_add_parameter (p, 4, "p1");
+      orc_program_add_temporary (p, 4, "t1");
+      orc_program_add_temporary (p, 8, "t2");
+
+      orc_program_append_2 (p, "xorl", 0, ORC_VAR_T1, ORC_VAR_S2, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "mulslq", 0, ORC_VAR_T2, ORC_VAR_T1, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsq", 0, ORC_VAR_T2, ORC_VAR_T2, ORC_VAR_C2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subq", 0, ORC_VAR_T2, ORC_VAR_S1, ORC_VAR_T2,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsssql", 0, ORC_VAR_T1, ORC_VAR_T2,
+          ORC_VAR_D1, ORC_VAR_D1);
+      orc_program_append_2 (p, "xorl", 0, ORC_VAR_D1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
+
+
+/* adder_orc_minus_volume_s32 */
+#ifdef DISABLE_ORC
+void
+adder_orc_minus_volume_s32 (gint32 * ORC_RESTRICT d1,
+    const gint64 * ORC_RESTRICT s1, const gint32 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  int i;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union64 var35;
+  orc_union32 var36;
+  orc_union64 var37;
+  orc_union64 var38;
+  orc_union64 var39;
+
+  ptr0 = (orc_union32 *) d1;
+  ptr4 = (orc_union64 *) s1;
+  ptr5 = (orc_union32 *) s2;
+
+  /* 1: loadpl */
+  var34.i = p1;
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var33 = ptr5[i];
+    /* 2: mulslq */
+    var37.i = ((orc_int64) var33.i) * ((orc_int64) var34.i);
+    /* 3: shrsq */
+    var38.i = var37.i >> 27;
+    /* 4: loadq */
+    var35 = ptr4[i];
+    /* 5: subq */
+    var39.i = var35.i - var38.i;
+    /* 6: convsssql */
+    var36.i = ORC_CLAMP_SL (var39.i);
+    /* 7: storel */
+    ptr0[i] = var36;
+  }
+
+}
+
+#else
+static void
+_backup_adder_orc_minus_volume_s32 (OrcExecutor * ORC_RESTRICT ex)
+{
+  int i;
+  int n = ex->n;
+  orc_union32 *ORC_RESTRICT ptr0;
+  const orc_union64 *ORC_RESTRICT ptr4;
+  const orc_union32 *ORC_RESTRICT ptr5;
+  orc_union32 var33;
+  orc_union32 var34;
+  orc_union64 var35;
+  orc_union32 var36;
+  orc_union64 var37;
+  orc_union64 var38;
+  orc_union64 var39;
+
+  ptr0 = (orc_union32 *) ex->arrays[0];
+  ptr4 = (orc_union64 *) ex->arrays[4];
+  ptr5 = (orc_union32 *) ex->arrays[5];
+
+  /* 1: loadpl */
+  var34.i = ex->params[24];
+
+  for (i = 0; i < n; i++) {
+    /* 0: loadl */
+    var33 = ptr5[i];
+    /* 2: mulslq */
+    var37.i = ((orc_int64) var33.i) * ((orc_int64) var34.i);
+    /* 3: shrsq */
+    var38.i = var37.i >> 27;
+    /* 4: loadq */
+    var35 = ptr4[i];
+    /* 5: subq */
+    var39.i = var35.i - var38.i;
+    /* 6: convsssql */
+    var36.i = ORC_CLAMP_SL (var39.i);
+    /* 7: storel */
+    ptr0[i] = var36;
+  }
+
+}
+
+void
+adder_orc_minus_volume_s32 (gint32 * ORC_RESTRICT d1,
+    const gint64 * ORC_RESTRICT s1, const gint32 * ORC_RESTRICT s2, int p1,
+    int n)
+{
+  OrcExecutor _ex, *ex = &_ex;
+  static volatile int p_inited = 0;
+  static OrcCode *c = 0;
+  void (*func) (OrcExecutor *);
+
+  if (!p_inited) {
+    orc_once_mutex_lock ();
+    if (!p_inited) {
+      OrcProgram *p;
+
+#if 1
+      static const orc_uint8 bc[] = {
+        1, 9, 26, 97, 100, 100, 101, 114, 95, 111, 114, 99, 95, 109, 105, 110,
+        117, 115, 95, 118, 111, 108, 117, 109, 101, 95, 115, 51, 50, 11, 4, 4,
+        12, 8, 8, 12, 4, 4, 15, 8, 27, 0, 0, 0, 0, 0, 0, 0,
+        16, 4, 20, 8, 178, 32, 5, 24, 147, 32, 32, 16, 145, 32, 4, 32,
+        170, 0, 32, 2, 0,
+      };
+      p = orc_program_new_from_static_bytecode (bc);
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_s32);
+#else
+      p = orc_program_new ();
+      orc_program_set_name (p, "adder_orc_minus_volume_s32");
+      orc_program_set_backup_function (p, _backup_adder_orc_minus_volume_s32);
+      orc_program_add_destination (p, 4, "d1");
+      orc_program_add_source (p, 8, "s1");
+      orc_program_add_source (p, 4, "s2");
+      orc_program_add_constant_int64 (p, 8, 0x000000000000001bULL, "c1");
+      orc_program_add_parameter (p, 4, "p1");
+      orc_program_add_temporary (p, 8, "t1");
+
+      orc_program_append_2 (p, "mulslq", 0, ORC_VAR_T1, ORC_VAR_S2, ORC_VAR_P1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "shrsq", 0, ORC_VAR_T1, ORC_VAR_T1, ORC_VAR_C1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "subq", 0, ORC_VAR_T1, ORC_VAR_S1, ORC_VAR_T1,
+          ORC_VAR_D1);
+      orc_program_append_2 (p, "convsssql", 0, ORC_VAR_D1, ORC_VAR_T1,
+          ORC_VAR_D1, ORC_VAR_D1);
+#endif
+
+      orc_program_compile (p);
+      c = orc_program_take_code (p);
+      orc_program_free (p);
+    }
+    p_inited = TRUE;
+    orc_once_mutex_unlock ();
+  }
+  ex->arrays[ORC_VAR_A2] = c;
+  ex->program = 0;
+
+  ex->n = n;
+  ex->arrays[ORC_VAR_D1] = d1;
+  ex->arrays[ORC_VAR_S1] = (void *) s1;
+  ex->arrays[ORC_VAR_S2] = (void *) s2;
+  ex->params[ORC_VAR_P1] = p1;
+
+  func = c->exec;
+  func (ex);
+}
+#endif
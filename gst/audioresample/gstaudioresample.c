@@ -71,6 +71,8 @@ GST_DEBUG_CATEGORY (audio_resample_debug);
 GST_DEBUG_CATEGORY_STATIC (GST_CAT_PERFORMANCE);
 #endif
 
+#define DEFAULT_N_THREADS 1
+
 #define GST_TYPE_SPEEX_RESAMPLER_SINC_FILTER_MODE (speex_resampler_sinc_filter_mode_get_type ())
 
 enum
@@ -78,7 +80,8 @@ enum
   PROP_0,
   PROP_QUALITY,
   PROP_SINC_FILTER_MODE,
-  PROP_SINC_FILTER_AUTO_THRESHOLD
+  PROP_SINC_FILTER_AUTO_THRESHOLD,
+  PROP_N_THREADS
 };
 
 #if G_BYTE_ORDER == G_LITTLE_ENDIAN
@@ -117,6 +120,8 @@ static void gst_audio_resample_set_property (GObject * object,
 static void gst_audio_resample_get_property (GObject * object,
     guint prop_id, GValue * value, GParamSpec * pspec);
 
+static void gst_audio_resample_finalize (GObject * object);
+
 static GType speex_resampler_sinc_filter_mode_get_type (void);
 
 /* vmethods */
@@ -155,6 +160,7 @@ gst_audio_resample_class_init (GstAudioResampleClass * klass)
 
   gobject_class->set_property = gst_audio_resample_set_property;
   gobject_class->get_property = gst_audio_resample_get_property;
+  gobject_class->finalize = gst_audio_resample_finalize;
 
   g_object_class_install_property (gobject_class, PROP_QUALITY,
       g_param_spec_int ("quality", "Quality", "Resample quality with 0 being "
@@ -178,6 +184,12 @@ gst_audio_resample_class_init (GstAudioResampleClass * klass)
           0, G_MAXUINT, SPEEX_RESAMPLER_SINC_FILTER_AUTO_THRESHOLD_DEFAULT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = number of processors)",
+          0, G_MAXUINT, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&gst_audio_resample_src_template));
   gst_element_class_add_pad_template (gstelement_class,
@@ -222,11 +234,26 @@ gst_audio_resample_init (GstAudioResample * resample)
   resample->sinc_filter_mode = SPEEX_RESAMPLER_SINC_FILTER_DEFAULT;
   resample->sinc_filter_auto_threshold =
       SPEEX_RESAMPLER_SINC_FILTER_AUTO_THRESHOLD_DEFAULT;
+  resample->n_threads = DEFAULT_N_THREADS;
+
+  g_mutex_init (&resample->groups_lock);
+  g_cond_init (&resample->groups_cond);
 
   gst_base_transform_set_gap_aware (trans, TRUE);
   gst_pad_set_query_function (trans->srcpad, gst_audio_resample_query);
 }
 
+static void
+gst_audio_resample_finalize (GObject * object)
+{
+  GstAudioResample *resample = GST_AUDIO_RESAMPLE (object);
+
+  g_mutex_clear (&resample->groups_lock);
+  g_cond_clear (&resample->groups_cond);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 /* vmethods */
 static gboolean
 gst_audio_resample_start (GstBaseTransform * base)
@@ -1010,6 +1037,121 @@ gst_audio_resample_check_discont (GstAudioResample * resample, GstBuffer * buf)
   return TRUE;
 }
 
+typedef struct
+{
+  GstAudioResample *resample;
+  guint32 first;
+  guint32 n_channels;
+  const guint8 *in;
+  guint32 in_len;
+  guint8 *out;
+  guint32 out_len;
+  gint err;
+} ResampleGroup;
+
+static void
+resample_group (ResampleGroup * group)
+{
+  GstAudioResample *resample = group->resample;
+
+  group->err = resample->funcs->process_channels (resample->state,
+      group->first, group->n_channels, group->in, &group->in_len, group->out,
+      &group->out_len);
+}
+
+static void
+resample_group_func (gpointer data, gpointer user_data)
+{
+  ResampleGroup *group = data;
+  GstAudioResample *resample = group->resample;
+
+  resample_group (group);
+
+  g_mutex_lock (&resample->groups_lock);
+  if (--resample->groups_pending == 0)
+    g_cond_signal (&resample->groups_cond);
+  g_mutex_unlock (&resample->groups_lock);
+}
+
+static GThreadPool *
+get_groups_pool (void)
+{
+  static gsize pool_gonce = 0;
+
+  if (g_once_init_enter (&pool_gonce)) {
+    GThreadPool *pool;
+
+    /* shared between all instances, tasks never block so the pool can't
+     * deadlock when more resamplers are active than there are threads */
+    pool = g_thread_pool_new (resample_group_func, NULL,
+        g_get_num_processors (), FALSE, NULL);
+
+    g_once_init_leave (&pool_gonce, (gsize) pool);
+  }
+  return (GThreadPool *) pool_gonce;
+}
+
+/* channels are filtered independently, so split them in groups and run
+ * each group in the shared pool. The first group is done in this thread. */
+static gint
+gst_audio_resample_process_channels (GstAudioResample * resample,
+    const guint8 * in, guint32 * in_len, guint8 * out, guint32 * out_len)
+{
+  GThreadPool *pool;
+  ResampleGroup *groups;
+  guint n_threads, per_group, n_groups, i;
+  gint err;
+
+  n_threads = resample->n_threads;
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+  n_threads = MIN (n_threads, resample->channels);
+
+  if (n_threads < 2)
+    return resample->funcs->process (resample->state, in, in_len, out,
+        out_len);
+
+  per_group = (resample->channels + n_threads - 1) / n_threads;
+  n_groups = (resample->channels + per_group - 1) / per_group;
+
+  pool = get_groups_pool ();
+  groups = g_newa (ResampleGroup, n_groups);
+
+  for (i = 0; i < n_groups; i++) {
+    groups[i].resample = resample;
+    groups[i].first = i * per_group;
+    groups[i].n_channels = MIN (per_group, resample->channels - i * per_group);
+    groups[i].in = in;
+    groups[i].in_len = *in_len;
+    groups[i].out = out;
+    groups[i].out_len = *out_len;
+  }
+
+  /* the groups only read the state that is shared between the channels */
+  resample->funcs->prepare_channels (resample->state);
+
+  resample->groups_pending = n_groups - 1;
+  for (i = 1; i < n_groups; i++)
+    g_thread_pool_push (pool, &groups[i], NULL);
+  resample_group (&groups[0]);
+
+  g_mutex_lock (&resample->groups_lock);
+  while (resample->groups_pending > 0)
+    g_cond_wait (&resample->groups_cond, &resample->groups_lock);
+  g_mutex_unlock (&resample->groups_lock);
+
+  /* all channels consume and produce the same amount of samples */
+  err = RESAMPLER_ERR_SUCCESS;
+  for (i = 0; i < n_groups; i++)
+    if (groups[i].err != RESAMPLER_ERR_SUCCESS)
+      err = groups[i].err;
+
+  *in_len = groups[0].in_len;
+  *out_len = groups[0].out_len;
+
+  return err;
+}
+
 static GstFlowReturn
 gst_audio_resample_process (GstAudioResample * resample, GstBuffer * inbuf,
     GstBuffer * outbuf)
@@ -1099,7 +1241,7 @@ gst_audio_resample_process (GstAudioResample * resample, GstBuffer * inbuf,
           resample->tmp_in, in_len, FALSE);
 
       /* process */
-      err = resample->funcs->process (resample->state,
+      err = gst_audio_resample_process_channels (resample,
           resample->tmp_in, &in_processed, resample->tmp_out, &out_processed);
 
       /* convert output */
@@ -1107,7 +1249,7 @@ gst_audio_resample_process (GstAudioResample * resample, GstBuffer * inbuf,
           out_map.data, out_processed, TRUE);
     } else {
       /* no format conversion required;  process */
-      err = resample->funcs->process (resample->state,
+      err = gst_audio_resample_process_channels (resample,
           in_map.data, &in_processed, out_map.data, &out_processed);
     }
 
@@ -1397,6 +1539,9 @@ gst_audio_resample_set_property (GObject * object, guint prop_id,
 
       break;
     }
+    case PROP_N_THREADS:
+      resample->n_threads = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1421,6 +1566,9 @@ gst_audio_resample_get_property (GObject * object, guint prop_id,
     case PROP_SINC_FILTER_AUTO_THRESHOLD:
       g_value_set_uint (value, resample->sinc_filter_auto_threshold);
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, resample->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -66,6 +66,7 @@ struct _GstAudioResample {
 
   /* properties */
   gint quality;
+  guint n_threads;
 
   /* state */
   gboolean fp;
@@ -85,6 +86,11 @@ struct _GstAudioResample {
 
   SpeexResamplerState *state;
   const SpeexResampleFuncs *funcs;
+
+  /* channel groups processed in the shared pool */
+  GMutex groups_lock;
+  GCond groups_cond;
+  guint groups_pending;
 };
 
 struct _GstAudioResampleClass {
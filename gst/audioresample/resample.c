@@ -94,6 +94,16 @@
 #endif
 #endif
 
+/* the AVX2 functions are compiled with a target attribute and selected at
+ * runtime, so they don't need -mavx2 */
+#ifdef _USE_AVX2
+#if !defined(HAVE_IMMINTRIN_H) || !(defined(__x86_64__) || defined(__i386__)) \
+    || !(defined(__clang__) || __GNUC__ > 4 || \
+        (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#undef _USE_AVX2
+#endif
+#endif
+
 static inline void *
 speex_alloc (int size)
 {
@@ -144,6 +154,10 @@ speex_free (void *ptr)
 #include "resample_neon.h"
 #endif
 
+#ifdef _USE_AVX2
+#include "resample_avx.h"
+#endif
+
 /* Numer of elements to allocate on the stack */
 #ifdef VAR_ARRAYS
 #define FIXED_STACK_ALLOC 8192
@@ -172,6 +186,16 @@ speex_free (void *ptr)
 #define SSE2_FALLBACK(macro)
 #endif
 
+#ifdef _USE_AVX2
+#define AVX2_FALLBACK(macro) \
+  if (st->use_avx2) goto avx2_##macro##_avx2; {
+#define AVX2_IMPLEMENTATION(macro) \
+  goto avx2_##macro##_end; } avx2_##macro##_avx2: {
+#define AVX2_END(macro) avx2_##macro##_end:; }
+#else
+#define AVX2_FALLBACK(macro)
+#endif
+
 #ifdef _USE_NEON
 #define NEON_FALLBACK(macro) \
   if (st->use_neon) goto neon_##macro##_neon; {
@@ -222,6 +246,7 @@ struct SpeexResamplerState_
   int use_sse:1;
   int use_sse2:1;
   int use_neon:1;
+  int use_avx2:1;
 };
 
 static const double kaiser12_table[68] = {
@@ -477,6 +502,7 @@ resampler_basic_direct_single (SpeexResamplerState * st,
     const spx_word16_t *sinc = &sinc_table[samp_frac_num * N];
     const spx_word16_t *iptr = &in[last_sample];
 
+    AVX2_FALLBACK (INNER_PRODUCT_SINGLE)
     SSE_FALLBACK (INNER_PRODUCT_SINGLE)
         NEON_FALLBACK (INNER_PRODUCT_SINGLE)
         sum = 0;
@@ -503,6 +529,11 @@ resampler_basic_direct_single (SpeexResamplerState * st,
     SSE_IMPLEMENTATION (INNER_PRODUCT_SINGLE)
         sum = inner_product_single (sinc, iptr, N);
     SSE_END (INNER_PRODUCT_SINGLE)
+#endif
+#if defined(OVERRIDE_INNER_PRODUCT_SINGLE_AVX2) && defined(_USE_AVX2)
+    AVX2_IMPLEMENTATION (INNER_PRODUCT_SINGLE)
+        sum = inner_product_single_avx2 (sinc, iptr, N);
+    AVX2_END (INNER_PRODUCT_SINGLE)
 #endif
         out[out_stride * out_sample++] = SATURATE32PSHR (sum, 15, 32767);
     last_sample += int_advance;
@@ -544,6 +575,7 @@ resampler_basic_direct_double (SpeexResamplerState * st,
     const spx_word16_t *sinc = &sinc_table[samp_frac_num * N];
     const spx_word16_t *iptr = &in[last_sample];
 
+    AVX2_FALLBACK (INNER_PRODUCT_DOUBLE)
     SSE2_FALLBACK (INNER_PRODUCT_DOUBLE)
     double accum[4] = { 0, 0, 0, 0 };
 
@@ -558,6 +590,11 @@ resampler_basic_direct_double (SpeexResamplerState * st,
     SSE2_IMPLEMENTATION (INNER_PRODUCT_DOUBLE)
         sum = inner_product_double (sinc, iptr, N);
     SSE2_END (INNER_PRODUCT_DOUBLE)
+#endif
+#if defined(OVERRIDE_INNER_PRODUCT_DOUBLE_AVX2) && defined(_USE_AVX2)
+    AVX2_IMPLEMENTATION (INNER_PRODUCT_DOUBLE)
+        sum = inner_product_double_avx2 (sinc, iptr, N);
+    AVX2_END (INNER_PRODUCT_DOUBLE)
 #endif
         out[out_stride * out_sample++] = PSHR32 (sum, 15);
     last_sample += int_advance;
@@ -608,6 +645,7 @@ resampler_basic_interpolate_single (SpeexResamplerState * st,
     spx_word16_t interp[4];
 
 
+    AVX2_FALLBACK (INTERPOLATE_PRODUCT_SINGLE)
     SSE_FALLBACK (INTERPOLATE_PRODUCT_SINGLE)
     spx_word32_t accum[4] = { 0, 0, 0, 0 };
 
@@ -641,6 +679,15 @@ resampler_basic_interpolate_single (SpeexResamplerState * st,
         st->sinc_table + st->oversample + 4 - offset - 2, N, st->oversample,
         interp);
     SSE_END (INTERPOLATE_PRODUCT_SINGLE)
+#endif
+#if defined(OVERRIDE_INTERPOLATE_PRODUCT_SINGLE_AVX2) && defined(_USE_AVX2)
+    AVX2_IMPLEMENTATION (INTERPOLATE_PRODUCT_SINGLE)
+        cubic_coef (frac, interp);
+    sum =
+        interpolate_product_single_avx2 (iptr,
+        st->sinc_table + st->oversample + 4 - offset - 2, N, st->oversample,
+        interp);
+    AVX2_END (INTERPOLATE_PRODUCT_SINGLE)
 #endif
         out[out_stride * out_sample++] = SATURATE32PSHR (sum, 14, 32767);
     last_sample += int_advance;
@@ -699,6 +746,7 @@ resampler_basic_interpolate_double (SpeexResamplerState * st,
     spx_word16_t interp[4];
 
 
+    AVX2_FALLBACK (INTERPOLATE_PRODUCT_DOUBLE)
     SSE2_FALLBACK (INTERPOLATE_PRODUCT_DOUBLE)
     double accum[4] = { 0, 0, 0, 0 };
 
@@ -731,6 +779,15 @@ resampler_basic_interpolate_double (SpeexResamplerState * st,
         st->sinc_table + st->oversample + 4 - offset - 2, N, st->oversample,
         interp);
     SSE2_END (INTERPOLATE_PRODUCT_DOUBLE)
+#endif
+#if defined(OVERRIDE_INTERPOLATE_PRODUCT_DOUBLE_AVX2) && defined(_USE_AVX2)
+    AVX2_IMPLEMENTATION (INTERPOLATE_PRODUCT_DOUBLE)
+        cubic_coef (frac, interp);
+    sum =
+        interpolate_product_double_avx2 (iptr,
+        st->sinc_table + st->oversample + 4 - offset - 2, N, st->oversample,
+        interp);
+    AVX2_END (INTERPOLATE_PRODUCT_DOUBLE)
 #endif
         out[out_stride * out_sample++] = PSHR32 (sum, 15);
     last_sample += int_advance;
@@ -1038,6 +1095,7 @@ speex_resampler_init_frac (spx_uint32_t nb_channels, spx_uint32_t ratio_num,
 
   st->use_sse = st->use_sse2 = 0;
   st->use_neon = 0;
+  st->use_avx2 = 0;
 #if defined HAVE_ORC && !defined DISABLE_ORC
   orc_init ();
   {
@@ -1053,6 +1111,14 @@ speex_resampler_init_frac (spx_uint32_t nb_channels, spx_uint32_t ratio_num,
     }
   }
 #endif
+#ifdef _USE_AVX2
+  /* orc doesn't know about AVX2, ask the compiler runtime. The environment
+   * variable selects the SSE code instead, to compare both implementations */
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma")
+      && !g_getenv ("GST_AUDIORESAMPLE_NO_AVX2"))
+    st->use_avx2 = 1;
+#endif
 
   /* Per channel data */
   st->last_sample = (spx_int32_t *) speex_alloc (nb_channels * sizeof (int));
@@ -1112,7 +1178,10 @@ speex_resampler_process_native (SpeexResamplerState * st,
   spx_word16_t *mem = st->mem + channel_index * st->mem_alloc_size;
   spx_uint32_t ilen;
 
-  st->started = 1;
+  /* only written when not prepared for processing ranges of channels from
+   * several threads */
+  if (!st->started)
+    st->started = 1;
 
   /* Call the right resampler through the function ptr */
   out_sample = st->resampler_ptr (st, channel_index, mem, in_len, out, out_len);
@@ -1292,6 +1361,13 @@ speex_resampler_process_int (SpeexResamplerState * st,
   return RESAMPLER_ERR_SUCCESS;
 }
 
+EXPORT void
+speex_resampler_prepare_interleaved (SpeexResamplerState * st)
+{
+  st->in_stride = st->out_stride = st->nb_channels;
+  st->started = 1;
+}
+
 #ifdef DOUBLE_PRECISION
 EXPORT int
 speex_resampler_process_interleaved_float (SpeexResamplerState * st,
@@ -1303,21 +1379,40 @@ speex_resampler_process_interleaved_float (SpeexResamplerState * st,
     const float *in, spx_uint32_t * in_len, float *out, spx_uint32_t * out_len)
 #endif
 {
-  spx_uint32_t i;
   int istride_save, ostride_save;
-  spx_uint32_t bak_len = *out_len;
   istride_save = st->in_stride;
   ostride_save = st->out_stride;
-  st->in_stride = st->out_stride = st->nb_channels;
-  for (i = 0; i < st->nb_channels; i++) {
+  speex_resampler_prepare_interleaved (st);
+  speex_resampler_process_interleaved_float_channels (st, 0, st->nb_channels,
+      in, in_len, out, out_len);
+  st->in_stride = istride_save;
+  st->out_stride = ostride_save;
+  return RESAMPLER_ERR_SUCCESS;
+}
+
+#ifdef DOUBLE_PRECISION
+EXPORT int
+speex_resampler_process_interleaved_float_channels (SpeexResamplerState * st,
+    spx_uint32_t first, spx_uint32_t n_channels, const double *in,
+    spx_uint32_t * in_len, double *out, spx_uint32_t * out_len)
+#else
+EXPORT int
+speex_resampler_process_interleaved_float_channels (SpeexResamplerState * st,
+    spx_uint32_t first, spx_uint32_t n_channels, const float *in,
+    spx_uint32_t * in_len, float *out, spx_uint32_t * out_len)
+#endif
+{
+  spx_uint32_t i;
+  spx_uint32_t bak_len = *out_len;
+  /* the strides were set up by speex_resampler_prepare_interleaved(), the
+   * state is only read here so that ranges can run in parallel */
+  for (i = first; i < first + n_channels; i++) {
     *out_len = bak_len;
     if (in != NULL)
       speex_resampler_process_float (st, i, in + i, in_len, out + i, out_len);
     else
       speex_resampler_process_float (st, i, NULL, in_len, out + i, out_len);
   }
-  st->in_stride = istride_save;
-  st->out_stride = ostride_save;
   return RESAMPLER_ERR_SUCCESS;
 }
 
@@ -1326,21 +1421,33 @@ speex_resampler_process_interleaved_int (SpeexResamplerState * st,
     const spx_int16_t * in, spx_uint32_t * in_len, spx_int16_t * out,
     spx_uint32_t * out_len)
 {
-  spx_uint32_t i;
   int istride_save, ostride_save;
-  spx_uint32_t bak_len = *out_len;
   istride_save = st->in_stride;
   ostride_save = st->out_stride;
-  st->in_stride = st->out_stride = st->nb_channels;
-  for (i = 0; i < st->nb_channels; i++) {
+  speex_resampler_prepare_interleaved (st);
+  speex_resampler_process_interleaved_int_channels (st, 0, st->nb_channels,
+      in, in_len, out, out_len);
+  st->in_stride = istride_save;
+  st->out_stride = ostride_save;
+  return RESAMPLER_ERR_SUCCESS;
+}
+
+EXPORT int
+speex_resampler_process_interleaved_int_channels (SpeexResamplerState * st,
+    spx_uint32_t first, spx_uint32_t n_channels, const spx_int16_t * in,
+    spx_uint32_t * in_len, spx_int16_t * out, spx_uint32_t * out_len)
+{
+  spx_uint32_t i;
+  spx_uint32_t bak_len = *out_len;
+  /* the strides were set up by speex_resampler_prepare_interleaved(), the
+   * state is only read here so that ranges can run in parallel */
+  for (i = first; i < first + n_channels; i++) {
     *out_len = bak_len;
     if (in != NULL)
       speex_resampler_process_int (st, i, in + i, in_len, out + i, out_len);
     else
       speex_resampler_process_int (st, i, NULL, in_len, out + i, out_len);
   }
-  st->in_stride = istride_save;
-  st->out_stride = ostride_save;
   return RESAMPLER_ERR_SUCCESS;
 }
 
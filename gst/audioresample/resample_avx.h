@@ -0,0 +1,216 @@
+/**
+   @file resample_avx.h
+   @brief Resampler functions (AVX2/FMA version)
+*/
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   - Neither the name of the Xiph.org Foundation nor the names of its
+   contributors may be used to endorse or promote products derived from
+   this software without specific prior written permission.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE FOUNDATION OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* These functions are compiled for AVX2 and FMA even when the rest of the
+ * file is not, they must only be called when st->use_avx2 is set */
+
+#include <immintrin.h>
+
+#define AVX2_TARGET __attribute__ ((target ("avx2,fma")))
+
+AVX2_TARGET static inline float
+hsum_ps_avx2 (__m256 v)
+{
+  __m128 s = _mm_add_ps (_mm256_castps256_ps128 (v),
+      _mm256_extractf128_ps (v, 1));
+
+  s = _mm_add_ps (s, _mm_movehl_ps (s, s));
+  s = _mm_add_ss (s, _mm_shuffle_ps (s, s, 0x55));
+
+  return _mm_cvtss_f32 (s);
+}
+
+AVX2_TARGET static inline double
+hsum_pd_avx2 (__m256d v)
+{
+  __m128d s = _mm_add_pd (_mm256_castpd256_pd128 (v),
+      _mm256_extractf128_pd (v, 1));
+
+  s = _mm_add_sd (s, _mm_unpackhi_pd (s, s));
+
+  return _mm_cvtsd_f64 (s);
+}
+
+#ifndef DOUBLE_PRECISION
+#define OVERRIDE_INNER_PRODUCT_SINGLE_AVX2
+AVX2_TARGET static float
+inner_product_single_avx2 (const float *a, const float *b, unsigned int len)
+{
+  unsigned int i = 0;
+  float ret;
+  __m256 sum1 = _mm256_setzero_ps ();
+  __m256 sum2 = _mm256_setzero_ps ();
+
+  for (; i + 16 <= len; i += 16) {
+    sum1 = _mm256_fmadd_ps (_mm256_loadu_ps (a + i), _mm256_loadu_ps (b + i),
+        sum1);
+    sum2 = _mm256_fmadd_ps (_mm256_loadu_ps (a + i + 8),
+        _mm256_loadu_ps (b + i + 8), sum2);
+  }
+  ret = hsum_ps_avx2 (_mm256_add_ps (sum1, sum2));
+
+  for (; i < len; i++)
+    ret += a[i] * b[i];
+
+  return ret;
+}
+
+#define OVERRIDE_INTERPOLATE_PRODUCT_SINGLE_AVX2
+AVX2_TARGET static float
+interpolate_product_single_avx2 (const float *a, const float *b,
+    unsigned int len, const spx_uint32_t oversample, float *frac)
+{
+  unsigned int i = 0;
+  float ret;
+  __m256 sum = _mm256_setzero_ps ();
+  __m128 s;
+
+  /* two taps per register, the four interpolation points of one tap in
+   * each half */
+  for (; i + 2 <= len; i += 2) {
+    __m256 t = _mm256_insertf128_ps (_mm256_castps128_ps256 (_mm_loadu_ps (b +
+                i * oversample)), _mm_loadu_ps (b + (i + 1) * oversample), 1);
+    __m256 x = _mm256_insertf128_ps (_mm256_castps128_ps256 (_mm_set1_ps (a
+                [i])), _mm_set1_ps (a[i + 1]), 1);
+
+    sum = _mm256_fmadd_ps (x, t, sum);
+  }
+  s = _mm_add_ps (_mm256_castps256_ps128 (sum), _mm256_extractf128_ps (sum,
+          1));
+  s = _mm_mul_ps (s, _mm_loadu_ps (frac));
+  s = _mm_add_ps (s, _mm_movehl_ps (s, s));
+  s = _mm_add_ss (s, _mm_shuffle_ps (s, s, 0x55));
+  ret = _mm_cvtss_f32 (s);
+
+  if (i < len)
+    ret += a[i] * (frac[0] * b[i * oversample] +
+        frac[1] * b[i * oversample + 1] + frac[2] * b[i * oversample + 2] +
+        frac[3] * b[i * oversample + 3]);
+
+  return ret;
+}
+#endif
+
+#define OVERRIDE_INNER_PRODUCT_DOUBLE_AVX2
+#ifdef DOUBLE_PRECISION
+AVX2_TARGET static double
+inner_product_double_avx2 (const double *a, const double *b, unsigned int len)
+{
+  unsigned int i = 0;
+  double ret;
+  __m256d sum1 = _mm256_setzero_pd ();
+  __m256d sum2 = _mm256_setzero_pd ();
+
+  for (; i + 8 <= len; i += 8) {
+    sum1 = _mm256_fmadd_pd (_mm256_loadu_pd (a + i), _mm256_loadu_pd (b + i),
+        sum1);
+    sum2 = _mm256_fmadd_pd (_mm256_loadu_pd (a + i + 4),
+        _mm256_loadu_pd (b + i + 4), sum2);
+  }
+  ret = hsum_pd_avx2 (_mm256_add_pd (sum1, sum2));
+
+  for (; i < len; i++)
+    ret += a[i] * b[i];
+
+  return ret;
+}
+#else
+AVX2_TARGET static double
+inner_product_double_avx2 (const float *a, const float *b, unsigned int len)
+{
+  unsigned int i = 0;
+  double ret;
+  __m256d sum1 = _mm256_setzero_pd ();
+  __m256d sum2 = _mm256_setzero_pd ();
+
+  for (; i + 8 <= len; i += 8) {
+    sum1 = _mm256_fmadd_pd (_mm256_cvtps_pd (_mm_loadu_ps (a + i)),
+        _mm256_cvtps_pd (_mm_loadu_ps (b + i)), sum1);
+    sum2 = _mm256_fmadd_pd (_mm256_cvtps_pd (_mm_loadu_ps (a + i + 4)),
+        _mm256_cvtps_pd (_mm_loadu_ps (b + i + 4)), sum2);
+  }
+  ret = hsum_pd_avx2 (_mm256_add_pd (sum1, sum2));
+
+  for (; i < len; i++)
+    ret += (double) a[i] * b[i];
+
+  return ret;
+}
+#endif
+
+#define OVERRIDE_INTERPOLATE_PRODUCT_DOUBLE_AVX2
+#ifdef DOUBLE_PRECISION
+AVX2_TARGET static double
+interpolate_product_double_avx2 (const double *a, const double *b,
+    unsigned int len, const spx_uint32_t oversample, double *frac)
+{
+  unsigned int i = 0;
+  __m256d sum1 = _mm256_setzero_pd ();
+  __m256d sum2 = _mm256_setzero_pd ();
+
+  for (; i + 2 <= len; i += 2) {
+    sum1 = _mm256_fmadd_pd (_mm256_broadcast_sd (a + i),
+        _mm256_loadu_pd (b + i * oversample), sum1);
+    sum2 = _mm256_fmadd_pd (_mm256_broadcast_sd (a + i + 1),
+        _mm256_loadu_pd (b + (i + 1) * oversample), sum2);
+  }
+  if (i < len)
+    sum1 = _mm256_fmadd_pd (_mm256_broadcast_sd (a + i),
+        _mm256_loadu_pd (b + i * oversample), sum1);
+
+  return hsum_pd_avx2 (_mm256_mul_pd (_mm256_add_pd (sum1, sum2),
+          _mm256_loadu_pd (frac)));
+}
+#else
+AVX2_TARGET static double
+interpolate_product_double_avx2 (const float *a, const float *b,
+    unsigned int len, const spx_uint32_t oversample, float *frac)
+{
+  unsigned int i = 0;
+  __m256d sum1 = _mm256_setzero_pd ();
+  __m256d sum2 = _mm256_setzero_pd ();
+
+  for (; i + 2 <= len; i += 2) {
+    sum1 = _mm256_fmadd_pd (_mm256_set1_pd (a[i]),
+        _mm256_cvtps_pd (_mm_loadu_ps (b + i * oversample)), sum1);
+    sum2 = _mm256_fmadd_pd (_mm256_set1_pd (a[i + 1]),
+        _mm256_cvtps_pd (_mm_loadu_ps (b + (i + 1) * oversample)), sum2);
+  }
+  if (i < len)
+    sum1 = _mm256_fmadd_pd (_mm256_set1_pd (a[i]),
+        _mm256_cvtps_pd (_mm_loadu_ps (b + i * oversample)), sum1);
+
+  return hsum_pd_avx2 (_mm256_mul_pd (_mm256_add_pd (sum1, sum2),
+          _mm256_cvtps_pd (_mm_loadu_ps (frac))));
+}
+#endif
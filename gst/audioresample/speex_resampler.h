@@ -61,6 +61,9 @@
 #define speex_resampler_process_int CAT_PREFIX(RANDOM_PREFIX,_resampler_process_int)
 #define speex_resampler_process_interleaved_float CAT_PREFIX(RANDOM_PREFIX,_resampler_process_interleaved_float)
 #define speex_resampler_process_interleaved_int CAT_PREFIX(RANDOM_PREFIX,_resampler_process_interleaved_int)
+#define speex_resampler_prepare_interleaved CAT_PREFIX(RANDOM_PREFIX,_resampler_prepare_interleaved)
+#define speex_resampler_process_interleaved_float_channels CAT_PREFIX(RANDOM_PREFIX,_resampler_process_interleaved_float_channels)
+#define speex_resampler_process_interleaved_int_channels CAT_PREFIX(RANDOM_PREFIX,_resampler_process_interleaved_int_channels)
 #define speex_resampler_set_rate CAT_PREFIX(RANDOM_PREFIX,_resampler_set_rate)
 #define speex_resampler_get_rate CAT_PREFIX(RANDOM_PREFIX,_resampler_get_rate)
 #define speex_resampler_set_rate_frac CAT_PREFIX(RANDOM_PREFIX,_resampler_set_rate_frac)
@@ -268,6 +271,67 @@ int speex_resampler_process_interleaved_int(SpeexResamplerState *st,
                                              spx_int16_t *out, 
                                              spx_uint32_t *out_len);
 
+/** Set up the state for processing interleaved ranges of channels. The
+ * strides are set to the number of channels. Call this once before
+ * processing ranges of channels from different threads, the range functions
+ * don't modify the state shared between the channels.
+ * @param st Resampler state
+ */
+void speex_resampler_prepare_interleaved(SpeexResamplerState *st);
+
+/** Resample the channels first to first + n_channels - 1 of an interleaved
+ * float array. speex_resampler_prepare_interleaved() must have been called
+ * before so that different ranges of channels can be processed at the same
+ * time from different threads. The input and output buffers must *not*
+ * overlap.
+ * @param st Resampler state
+ * @param first First channel to process
+ * @param n_channels Number of channels to process
+ * @param in Input buffer, pointing to the first channel of the first frame
+ * @param in_len Number of input samples in the input buffer. Returns the number
+ * of samples processed. This is all per-channel.
+ * @param out Output buffer, pointing to the first channel of the first frame
+ * @param out_len Size of the output buffer. Returns the number of samples written.
+ * This is all per-channel.
+ */
+#ifdef DOUBLE_PRECISION
+int speex_resampler_process_interleaved_float_channels(SpeexResamplerState *st,
+                                                        spx_uint32_t first,
+                                                        spx_uint32_t n_channels,
+                                                        const double *in,
+                                                        spx_uint32_t *in_len,
+                                                        double *out,
+                                                        spx_uint32_t *out_len);
+#else
+int speex_resampler_process_interleaved_float_channels(SpeexResamplerState *st,
+                                                        spx_uint32_t first,
+                                                        spx_uint32_t n_channels,
+                                                        const float *in,
+                                                        spx_uint32_t *in_len,
+                                                        float *out,
+                                                        spx_uint32_t *out_len);
+#endif
+
+/** Resample the channels first to first + n_channels - 1 of an interleaved
+ * int array, see speex_resampler_process_interleaved_float_channels().
+ * @param st Resampler state
+ * @param first First channel to process
+ * @param n_channels Number of channels to process
+ * @param in Input buffer, pointing to the first channel of the first frame
+ * @param in_len Number of input samples in the input buffer. Returns the number
+ * of samples processed. This is all per-channel.
+ * @param out Output buffer, pointing to the first channel of the first frame
+ * @param out_len Size of the output buffer. Returns the number of samples written.
+ * This is all per-channel.
+ */
+int speex_resampler_process_interleaved_int_channels(SpeexResamplerState *st,
+                                                      spx_uint32_t first,
+                                                      spx_uint32_t n_channels,
+                                                      const spx_int16_t *in,
+                                                      spx_uint32_t *in_len,
+                                                      spx_int16_t *out,
+                                                      spx_uint32_t *out_len);
+
 /** Set (change) the input/output sampling rates (integer value).
  * @param st Resampler state
  * @param in_rate Input sampling rate (integer number of Hz).
@@ -18,6 +18,7 @@
  */
 
 #define _USE_SSE2
+#define _USE_AVX2
 #define FLOATING_POINT
 #define DOUBLE_PRECISION
 #define OUTSIDE_SPEEX
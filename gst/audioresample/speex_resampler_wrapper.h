@@ -56,6 +56,10 @@ typedef struct {
   void (*destroy) (SpeexResamplerState * st);
   int (*process) (SpeexResamplerState *
     st, const guint8 * in, guint32 * in_len, guint8 * out, guint32 * out_len);
+  int (*process_channels) (SpeexResamplerState * st, guint32 first,
+    guint32 n_channels, const guint8 * in, guint32 * in_len, guint8 * out,
+    guint32 * out_len);
+  void (*prepare_channels) (SpeexResamplerState * st);
   int (*set_rate) (SpeexResamplerState * st,
     guint32 in_rate, guint32 out_rate);
   void (*get_rate) (SpeexResamplerState * st,
@@ -79,6 +83,10 @@ SpeexResamplerState *resample_float_resampler_init (guint32 nb_channels,
 void resample_float_resampler_destroy (SpeexResamplerState * st);
 int resample_float_resampler_process_interleaved_float (SpeexResamplerState *
     st, const guint8 * in, guint32 * in_len, guint8 * out, guint32 * out_len);
+int resample_float_resampler_process_interleaved_float_channels (
+    SpeexResamplerState * st, guint32 first, guint32 n_channels,
+    const guint8 * in, guint32 * in_len, guint8 * out, guint32 * out_len);
+void resample_float_resampler_prepare_interleaved (SpeexResamplerState * st);
 int resample_float_resampler_set_rate (SpeexResamplerState * st,
     guint32 in_rate, guint32 out_rate);
 void resample_float_resampler_get_rate (SpeexResamplerState * st,
@@ -98,6 +106,8 @@ static const SpeexResampleFuncs float_funcs =
   resample_float_resampler_init,
   resample_float_resampler_destroy,
   resample_float_resampler_process_interleaved_float,
+  resample_float_resampler_process_interleaved_float_channels,
+  resample_float_resampler_prepare_interleaved,
   resample_float_resampler_set_rate,
   resample_float_resampler_get_rate,
   resample_float_resampler_get_ratio,
@@ -118,6 +128,10 @@ SpeexResamplerState *resample_double_resampler_init (guint32 nb_channels,
 void resample_double_resampler_destroy (SpeexResamplerState * st);
 int resample_double_resampler_process_interleaved_float (SpeexResamplerState *
     st, const guint8 * in, guint32 * in_len, guint8 * out, guint32 * out_len);
+int resample_double_resampler_process_interleaved_float_channels (
+    SpeexResamplerState * st, guint32 first, guint32 n_channels,
+    const guint8 * in, guint32 * in_len, guint8 * out, guint32 * out_len);
+void resample_double_resampler_prepare_interleaved (SpeexResamplerState * st);
 int resample_double_resampler_set_rate (SpeexResamplerState * st,
     guint32 in_rate, guint32 out_rate);
 void resample_double_resampler_get_rate (SpeexResamplerState * st,
@@ -137,6 +151,8 @@ static const SpeexResampleFuncs double_funcs =
   resample_double_resampler_init,
   resample_double_resampler_destroy,
   resample_double_resampler_process_interleaved_float,
+  resample_double_resampler_process_interleaved_float_channels,
+  resample_double_resampler_prepare_interleaved,
   resample_double_resampler_set_rate,
   resample_double_resampler_get_rate,
   resample_double_resampler_get_ratio,
@@ -157,6 +173,10 @@ SpeexResamplerState *resample_int_resampler_init (guint32 nb_channels,
 void resample_int_resampler_destroy (SpeexResamplerState * st);
 int resample_int_resampler_process_interleaved_int (SpeexResamplerState *
     st, const guint8 * in, guint32 * in_len, guint8 * out, guint32 * out_len);
+int resample_int_resampler_process_interleaved_int_channels (
+    SpeexResamplerState * st, guint32 first, guint32 n_channels,
+    const guint8 * in, guint32 * in_len, guint8 * out, guint32 * out_len);
+void resample_int_resampler_prepare_interleaved (SpeexResamplerState * st);
 int resample_int_resampler_set_rate (SpeexResamplerState * st,
     guint32 in_rate, guint32 out_rate);
 void resample_int_resampler_get_rate (SpeexResamplerState * st,
@@ -176,6 +196,8 @@ static const SpeexResampleFuncs int_funcs =
   resample_int_resampler_init,
   resample_int_resampler_destroy,
   resample_int_resampler_process_interleaved_int,
+  resample_int_resampler_process_interleaved_int_channels,
+  resample_int_resampler_prepare_interleaved,
   resample_int_resampler_set_rate,
   resample_int_resampler_get_rate,
   resample_int_resampler_get_ratio,
@@ -112,10 +112,12 @@
 #endif
 
 #include <string.h>
+#include <limits.h>
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 
 #ifdef HAVE_FIONREAD_IN_SYS_FILIO
@@ -159,7 +161,8 @@ enum
 static void gst_multi_fd_sink_stop_pre (GstMultiHandleSink * mhsink);
 static void gst_multi_fd_sink_stop_post (GstMultiHandleSink * mhsink);
 static gboolean gst_multi_fd_sink_start_pre (GstMultiHandleSink * mhsink);
-static gpointer gst_multi_fd_sink_thread (GstMultiHandleSink * mhsink);
+static gpointer gst_multi_fd_sink_thread (GstMultiHandleSink * mhsink,
+    GstMultiHandleShard * shard);
 
 static void gst_multi_fd_sink_add (GstMultiFdSink * sink, int fd);
 static void gst_multi_fd_sink_add_full (GstMultiFdSink * sink, int fd,
@@ -195,6 +198,9 @@ static void gst_multi_fd_sink_set_property (GObject * object, guint prop_id,
 static void gst_multi_fd_sink_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 
+/* the poll of the I/O thread serving the client */
+#define CLIENT_FDSET(sink,mhclient) ((sink)->fdsets[(mhclient)->shard->index])
+
 #define gst_multi_fd_sink_parent_class parent_class
 G_DEFINE_TYPE (GstMultiFdSink, gst_multi_fd_sink, GST_TYPE_MULTI_HANDLE_SINK);
 
@@ -509,7 +515,7 @@ gst_multi_fd_sink_new_client (GstMultiHandleSink * mhsink,
   gst_poll_fd_init (&client->gfd);
   client->gfd.fd = mhclient->handle.fd;
 
-  gst_multi_handle_sink_client_init (mhclient, sync_method);
+  gst_multi_handle_sink_client_init (mhsink, mhclient, sync_method);
   mhsinkclass->handle_debug (handle, mhclient->debug);
 
   /* set the socket to non blocking */
@@ -519,7 +525,7 @@ gst_multi_fd_sink_new_client (GstMultiHandleSink * mhsink,
   }
 
   /* we always read from a client */
-  gst_poll_add_fd (sink->fdset, &client->gfd);
+  gst_poll_add_fd (CLIENT_FDSET (sink, mhclient), &client->gfd);
 
   /* we don't try to read from write only fds */
   if (sink->handle_read) {
@@ -527,7 +533,7 @@ gst_multi_fd_sink_new_client (GstMultiHandleSink * mhsink,
 
     flags = fcntl (handle.fd, F_GETFL, 0);
     if ((flags & O_ACCMODE) != O_WRONLY) {
-      gst_poll_fd_ctl_read (sink->fdset, &client->gfd, TRUE);
+      gst_poll_fd_ctl_read (CLIENT_FDSET (sink, mhclient), &client->gfd, TRUE);
     }
   }
   /* figure out the mode, can't use send() for non sockets */
@@ -563,8 +569,10 @@ static void
 gst_multi_fd_sink_hash_changed (GstMultiHandleSink * mhsink)
 {
   GstMultiFdSink *sink = GST_MULTI_FD_SINK (mhsink);
+  guint i;
 
-  gst_poll_restart (sink->fdset);
+  for (i = 0; i < mhsink->n_shards; i++)
+    gst_poll_restart (sink->fdsets[i]);
 }
 
 /* handle a read on a client fd,
@@ -642,6 +650,187 @@ ioctl_failed:
   }
 }
 
+/* the maximum number of buffers and bytes that are gathered in one write */
+#if defined (IOV_MAX) && IOV_MAX < 64
+#define MAX_WRITE_BUFFERS IOV_MAX
+#else
+#define MAX_WRITE_BUFFERS 64
+#endif
+#define MAX_WRITE_BYTES (128 * 1024)
+
+/* take the next buffer from the queue and add it to the sending queue of
+ * the client */
+static void
+gst_multi_fd_sink_client_pick_buffer (GstMultiFdSink * sink,
+    GstTCPClient * client)
+{
+  GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
+  GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
+  GstMultiHandleSinkClass *mhsinkclass =
+      GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
+  GstBuffer *buf;
+
+  buf = gst_multi_handle_sink_client_take_buffer (mhsink, mhclient);
+
+  /* queueing a buffer will ref it */
+  mhsinkclass->client_queue_buffer (mhsink, mhclient, buf);
+}
+
+/* Collect the buffers for one write, starting with the buffer the client is
+ * working on. A client that is behind gets more buffers from the queue so
+ * that it can catch up with fewer calls. Those are only peeked at, they are
+ * taken from the queue once they are written, see
+ * gst_multi_handle_sink_client_commit_peeked(). @n_sending is set to the
+ * number of buffers from the sending queue, the others were peeked. Buffers
+ * with fd backed memory are written on their own so that the memory can be
+ * sent without copying. The buffers are reffed, they need to stay alive
+ * while we write without the lock. @bytes is set to the number of bytes to
+ * write. */
+static guint
+gst_multi_fd_sink_client_gather (GstMultiFdSink * sink,
+    GstTCPClient * client, GstBuffer ** buffers, guint * n_sending,
+    gsize * bytes)
+{
+  GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
+  GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
+  GSList *walk;
+  guint n_buffers, idx, n_copy;
+  gsize offset, skip;
+
+  walk = mhclient->sending;
+  n_buffers = 0;
+  *n_sending = 0;
+  *bytes = 0;
+
+  while (n_buffers < MAX_WRITE_BUFFERS && *bytes < MAX_WRITE_BYTES) {
+    GstBuffer *buf;
+    gsize size;
+
+    if (walk != NULL) {
+      buf = GST_BUFFER_CAST (walk->data);
+    } else {
+      /* nothing left in the sending queue, see if there are more buffers
+       * for the client in the queue */
+      buf = gst_multi_handle_sink_client_peek_buffer (mhsink, mhclient,
+          n_buffers - *n_sending);
+      if (buf == NULL)
+        break;
+    }
+
+    size = gst_buffer_get_size (buf);
+    offset = n_buffers == 0 ? mhclient->bufoffset : 0;
+
+    if (n_buffers == 0)
+      size -= offset;
+    else if (size == 0)
+      break;
+
+    if (gst_multi_handle_sink_find_zerocopy_memory (buf, offset, &skip,
+            &idx, &n_copy) != NULL || n_copy != G_MAXUINT) {
+      /* fd backed memory is written on its own */
+      if (n_buffers == 0) {
+        buffers[n_buffers++] = gst_buffer_ref (buf);
+        *n_sending = 1;
+        *bytes += size;
+      }
+      break;
+    }
+
+    buffers[n_buffers++] = gst_buffer_ref (buf);
+    *bytes += size;
+
+    if (walk != NULL) {
+      walk = walk->next;
+      *n_sending = n_buffers;
+    }
+  }
+
+  return n_buffers;
+}
+
+/* writes @buffers with one call, starting at @bufoffset in the first
+ * buffer. When the data starts with fd backed memory, only that memory is
+ * written, without copying it, and @zerocopy is set to TRUE. @maxsize is
+ * updated when less than the complete buffers is written. */
+static ssize_t
+gst_multi_fd_sink_write (GstTCPClient * client, int fd, GstBuffer ** buffers,
+    guint n_buffers, gsize bufoffset, gsize * maxsize, gboolean * zerocopy)
+{
+  struct iovec iov[MAX_WRITE_BUFFERS];
+  GstMapInfo maps[MAX_WRITE_BUFFERS];
+  ssize_t wrote;
+  gint write_errno;
+  guint i, n_mapped, idx, n_copy;
+  gsize skip;
+  GstMemory *mem;
+
+  *zerocopy = FALSE;
+  n_mapped = 0;
+
+  mem = gst_multi_handle_sink_find_zerocopy_memory (buffers[0], bufoffset,
+      &skip, &idx, &n_copy);
+  if (mem != NULL) {
+    wrote = gst_multi_handle_sink_send_memory (fd, mem, skip);
+    if (wrote >= 0 || (errno != EINVAL && errno != ENOSYS)) {
+      *maxsize = mem->size - skip;
+      *zerocopy = wrote >= 0;
+      return wrote;
+    }
+    GST_LOG ("copying memory %p, can't send it directly: %s", mem,
+        g_strerror (errno));
+  } else if (n_copy != G_MAXUINT) {
+    /* copy up to the next memory that can be sent directly */
+    if (!gst_buffer_map_range (buffers[0], idx, n_copy, &maps[0],
+            GST_MAP_READ))
+      g_return_val_if_reached (-1);
+
+    iov[0].iov_base = maps[0].data + skip;
+    iov[0].iov_len = maps[0].size - skip;
+    *maxsize = iov[0].iov_len;
+    n_mapped = 1;
+  }
+
+  if (n_mapped == 0) {
+    for (; n_mapped < n_buffers; n_mapped++) {
+      GstMapInfo *map = &maps[n_mapped];
+
+      if (!gst_buffer_map (buffers[n_mapped], map, GST_MAP_READ))
+        break;
+
+      iov[n_mapped].iov_base = map->data;
+      iov[n_mapped].iov_len = map->size;
+    }
+    if (n_mapped == 0)
+      g_return_val_if_reached (-1);
+
+    iov[0].iov_base = maps[0].data + bufoffset;
+    iov[0].iov_len = maps[0].size - bufoffset;
+  }
+
+  /* FIXME: specific */
+#ifdef MSG_NOSIGNAL
+#define FLAGS MSG_NOSIGNAL
+#else
+#define FLAGS 0
+#endif
+  if (client->is_socket) {
+    struct msghdr msg = { 0 };
+
+    msg.msg_iov = iov;
+    msg.msg_iovlen = n_mapped;
+    wrote = sendmsg (fd, &msg, FLAGS);
+  } else {
+    wrote = writev (fd, iov, n_mapped);
+  }
+  write_errno = errno;
+
+  for (i = 0; i < n_mapped; i++)
+    gst_buffer_unmap (buffers[i], &maps[i]);
+  errno = write_errno;
+
+  return wrote;
+}
+
 /* Handle a write on a client,
  * which indicates a read request from a client.
  *
@@ -662,7 +851,13 @@ ioctl_failed:
  * When the sending returns a partial buffer we stop sending more data as
  * the next send operation could block.
  *
- * This functions returns FALSE if some error occured.
+ * Called with the shard lock and the clients lock, they are released while
+ * writing so that the other I/O threads and the streaming thread are not
+ * blocked by the write calls.
+ *
+ * This functions returns FALSE if some error occured. When the client was
+ * removed while writing, TRUE is returned and the client must not be used
+ * anymore.
  */
 static gboolean
 gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
@@ -673,8 +868,6 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
   GstClockTime now;
   GTimeVal nowtv;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
-  GstMultiHandleSinkClass *mhsinkclass =
-      GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
   GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
   int fd = mhclient->handle.fd;
 
@@ -682,18 +875,17 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
 
   more = TRUE;
   do {
-    gint maxsize;
-
     g_get_current_time (&nowtv);
     now = GST_TIMEVAL_TO_TIME (nowtv);
 
     if (!mhclient->sending) {
       /* client is not working on a buffer */
-      if (mhclient->bufpos == -1) {
+      if (CLIENT_BUFPOS (mhsink, mhclient) == -1) {
         /* client is too fast, remove from write queue until new buffer is
          * available */
         /* FIXME: specific */
-        gst_poll_fd_ctl_write (sink->fdset, &client->gfd, FALSE);
+        gst_poll_fd_ctl_write (CLIENT_FDSET (sink, mhclient), &client->gfd,
+            FALSE);
 
         /* if we flushed out all of the client buffers, we can stop */
         if (mhclient->flushcount == 0)
@@ -702,8 +894,6 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
         return TRUE;
       } else {
         /* client can pick a buffer from the global queue */
-        GstBuffer *buf;
-        GstClockTime timestamp;
 
         /* for new connections, we need to find a good spot in the
          * bufqueue to start streaming from */
@@ -714,11 +904,12 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
           if (position >= 0) {
             /* we got a valid spot in the queue */
             mhclient->new_connection = FALSE;
-            mhclient->bufpos = position;
+            CLIENT_SET_BUFPOS (mhsink, mhclient, position);
           } else {
             /* cannot send data to this client yet */
             /* FIXME: specific */
-            gst_poll_fd_ctl_write (sink->fdset, &client->gfd, FALSE);
+            gst_poll_fd_ctl_write (CLIENT_FDSET (sink, mhclient),
+                &client->gfd, FALSE);
             return TRUE;
           }
         }
@@ -727,26 +918,7 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
         if (mhclient->flushcount == 0)
           goto flushed;
 
-        /* grab buffer */
-        buf = g_array_index (mhsink->bufqueue, GstBuffer *, mhclient->bufpos);
-        mhclient->bufpos--;
-
-        /* update stats */
-        timestamp = GST_BUFFER_TIMESTAMP (buf);
-        if (mhclient->first_buffer_ts == GST_CLOCK_TIME_NONE)
-          mhclient->first_buffer_ts = timestamp;
-        if (timestamp != -1)
-          mhclient->last_buffer_ts = timestamp;
-
-        /* decrease flushcount */
-        if (mhclient->flushcount != -1)
-          mhclient->flushcount--;
-
-        GST_LOG_OBJECT (sink, "%s client %p at position %d",
-            mhclient->debug, client, mhclient->bufpos);
-
-        /* queueing a buffer will ref it */
-        mhsinkclass->client_queue_buffer (mhsink, mhclient, buf);
+        gst_multi_fd_sink_client_pick_buffer (sink, client);
 
         /* need to start from the first byte for this new buffer */
         mhclient->bufoffset = 0;
@@ -756,35 +928,41 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
     /* see if we need to send something */
     if (mhclient->sending) {
       ssize_t wrote;
-      GstBuffer *head;
-      GstMapInfo info;
-      guint8 *data;
-
-      /* pick first buffer from list */
-      head = GST_BUFFER (mhclient->sending->data);
-
-      if (!gst_buffer_map (head, &info, GST_MAP_READ))
-        g_return_val_if_reached (FALSE);
-
-      data = info.data;
-      maxsize = info.size - mhclient->bufoffset;
-
-      /* FIXME: specific */
-      /* try to write the complete buffer */
-#ifdef MSG_NOSIGNAL
-#define FLAGS MSG_NOSIGNAL
-#else
-#define FLAGS 0
-#endif
-      if (client->is_socket) {
-        wrote = send (fd, data + mhclient->bufoffset, maxsize, FLAGS);
-      } else {
-        wrote = write (fd, data + mhclient->bufoffset, maxsize);
+      gint write_errno;
+      gsize bufoffset, maxsize;
+      GstBuffer *buffers[MAX_WRITE_BUFFERS];
+      guint n_buffers, n_sending, i;
+      gboolean zerocopy;
+
+      /* pick the first buffer from the list and the ones that can be
+       * written along with it */
+      n_buffers = gst_multi_fd_sink_client_gather (sink, client, buffers,
+          &n_sending, &maxsize);
+      bufoffset = mhclient->bufoffset;
+
+      /* try to write the complete buffers */
+      gst_multi_handle_sink_client_io_begin (mhsink, mhclient);
+      wrote = gst_multi_fd_sink_write (client, fd, buffers, n_buffers,
+          bufoffset, &maxsize, &zerocopy);
+      write_errno = errno;
+
+      if (!gst_multi_handle_sink_client_io_end (mhsink, mhclient)) {
+        GST_LOG_OBJECT (sink, "client %p was removed while writing", client);
+        for (i = 0; i < n_buffers; i++)
+          gst_buffer_unref (buffers[i]);
+        return TRUE;
       }
-      gst_buffer_unmap (head, &info);
+
+      /* the peeked buffers that were written are taken from the queue */
+      if (wrote > 0)
+        gst_multi_handle_sink_client_commit_peeked (mhsink, mhclient,
+            buffers + n_sending, n_buffers - n_sending, wrote);
+      for (i = 0; i < n_buffers; i++)
+        gst_buffer_unref (buffers[i]);
 
       if (wrote < 0) {
         /* hmm error.. */
+        errno = write_errno;
         if (errno == EAGAIN) {
           /* nothing serious, resource was unavailable, try again later */
           more = FALSE;
@@ -794,15 +972,28 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
           goto write_error;
         }
       } else {
-        if (wrote < maxsize) {
+        gsize left = wrote;
+
+        if ((gsize) wrote < maxsize) {
           /* partial write means that the client cannot read more and we should
            * stop sending more */
           GST_LOG_OBJECT (sink,
               "partial write on %s of %" G_GSSIZE_FORMAT " bytes",
               mhclient->debug, wrote);
-          mhclient->bufoffset += wrote;
           more = FALSE;
-        } else {
+        }
+
+        /* drop the buffers that were written completely */
+        while (mhclient->sending) {
+          GstBuffer *head = GST_BUFFER (mhclient->sending->data);
+          gsize size = gst_buffer_get_size (head) - mhclient->bufoffset;
+
+          if (left < size) {
+            mhclient->bufoffset += left;
+            break;
+          }
+          left -= size;
+
           /* complete buffer was written, we can proceed to the next one */
           mhclient->sending = g_slist_remove (mhclient->sending, head);
           gst_buffer_unref (head);
@@ -813,6 +1004,10 @@ gst_multi_fd_sink_handle_client_write (GstMultiFdSink * sink,
         mhclient->bytes_sent += wrote;
         mhclient->last_activity_time = now;
         mhsink->bytes_served += wrote;
+        if (zerocopy) {
+          mhclient->bytes_sent_zerocopy += wrote;
+          mhsink->bytes_served_zerocopy += wrote;
+        }
       }
     }
   } while (more);
@@ -850,7 +1045,7 @@ gst_multi_fd_sink_hash_adding (GstMultiHandleSink * mhsink,
   GstMultiFdSink *sink = GST_MULTI_FD_SINK (mhsink);
   GstTCPClient *client = (GstTCPClient *) mhclient;
 
-  gst_poll_fd_ctl_write (sink->fdset, &client->gfd, TRUE);
+  gst_poll_fd_ctl_write (CLIENT_FDSET (sink, mhclient), &client->gfd, TRUE);
 }
 
 static void
@@ -860,12 +1055,12 @@ gst_multi_fd_sink_hash_removing (GstMultiHandleSink * mhsink,
   GstMultiFdSink *sink = GST_MULTI_FD_SINK (mhsink);
   GstTCPClient *client = (GstTCPClient *) mhclient;
 
-  gst_poll_remove_fd (sink->fdset, &client->gfd);
+  gst_poll_remove_fd (CLIENT_FDSET (sink, mhclient), &client->gfd);
 }
 
 
-/* Handle the clients. Basically does a blocking select for one
- * of the client fds to become read or writable. We also have a
+/* Handle the clients of a shard. Basically does a blocking select for one
+ * of the client fds of the shard to become read or writable. We also have a
  * filedescriptor to receive commands on that we need to check.
  *
  * After going out of the select call, we read and write to all
@@ -873,7 +1068,8 @@ gst_multi_fd_sink_hash_removing (GstMultiHandleSink * mhsink,
  * garbage list and removed.
  */
 static void
-gst_multi_fd_sink_handle_clients (GstMultiFdSink * sink)
+gst_multi_fd_sink_handle_clients (GstMultiFdSink * sink,
+    GstMultiHandleShard * shard)
 {
   int result;
   GList *clients, *next;
@@ -881,6 +1077,7 @@ gst_multi_fd_sink_handle_clients (GstMultiFdSink * sink)
   GstMultiFdSinkClass *fclass;
   guint cookie;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
+  GstPoll *fdset = sink->fdsets[shard->index];
   int fd;
 
 
@@ -896,7 +1093,7 @@ gst_multi_fd_sink_handle_clients (GstMultiFdSink * sink)
     GST_LOG_OBJECT (sink, "waiting on action on fdset");
 
     result =
-        gst_poll_wait (sink->fdset,
+        gst_poll_wait (fdset,
         mhsink->timeout != 0 ? mhsink->timeout : GST_CLOCK_TIME_NONE);
 
     /* Handle the special case in which the sink is not receiving more buffers
@@ -908,8 +1105,8 @@ gst_multi_fd_sink_handle_clients (GstMultiFdSink * sink)
       g_get_current_time (&nowtv);
       now = GST_TIMEVAL_TO_TIME (nowtv);
 
-      CLIENTS_LOCK (mhsink);
-      for (clients = mhsink->clients; clients; clients = next) {
+      SHARD_LOCK (shard);
+      for (clients = shard->clients; clients; clients = next) {
         GstTCPClient *client;
         GstMultiHandleClient *mhclient;
 
@@ -922,7 +1119,7 @@ gst_multi_fd_sink_handle_clients (GstMultiFdSink * sink)
           gst_multi_handle_sink_remove_client_link (mhsink, clients);
         }
       }
-      CLIENTS_UNLOCK (mhsink);
+      SHARD_UNLOCK (shard);
       return;
     } else if (result < 0) {
       GST_WARNING_OBJECT (sink, "wait failed: %s (%d)", g_strerror (errno),
@@ -930,16 +1127,16 @@ gst_multi_fd_sink_handle_clients (GstMultiFdSink * sink)
       if (errno == EBADF) {
         /* ok, so one or more of the fds is invalid. We loop over them to find
          * the ones that give an error to the F_GETFL fcntl. */
-        CLIENTS_LOCK (mhsink);
+        SHARD_LOCK (shard);
       restart:
-        cookie = mhsink->clients_cookie;
-        for (clients = mhsink->clients; clients; clients = next) {
+        cookie = shard->clients_cookie;
+        for (clients = shard->clients; clients; clients = next) {
           GstTCPClient *client;
           GstMultiHandleClient *mhclient;
           long flags;
           int res;
 
-          if (cookie != mhsink->clients_cookie) {
+          if (cookie != shard->clients_cookie) {
             GST_DEBUG_OBJECT (sink, "Cookie changed finding bad fd");
             goto restart;
           }
@@ -956,12 +1153,12 @@ gst_multi_fd_sink_handle_clients (GstMultiFdSink * sink)
                 fd, g_strerror (errno), errno);
             if (errno == EBADF) {
               mhclient->status = GST_CLIENT_STATUS_ERROR;
-              /* releases the CLIENTS lock */
+              /* releases the shard lock */
               gst_multi_handle_sink_remove_client_link (mhsink, clients);
             }
           }
         }
-        CLIENTS_UNLOCK (mhsink);
+        SHARD_UNLOCK (shard);
         /* after this, go back in the select loop as the read/writefds
          * are not valid */
         try_again = TRUE;
@@ -982,20 +1179,21 @@ gst_multi_fd_sink_handle_clients (GstMultiFdSink * sink)
     }
   } while (try_again);
 
-  /* subclasses can check fdset with this virtual function */
-  if (fclass->wait)
-    fclass->wait (sink, sink->fdset);
+  /* subclasses can check the fdset of the first thread with this virtual
+   * function */
+  if (fclass->wait && shard->index == 0)
+    fclass->wait (sink, fdset);
 
   /* Check the clients */
-  CLIENTS_LOCK (mhsink);
+  SHARD_LOCK (shard);
 
 restart2:
-  cookie = mhsink->clients_cookie;
-  for (clients = mhsink->clients; clients; clients = next) {
+  cookie = shard->clients_cookie;
+  for (clients = shard->clients; clients; clients = next) {
     GstTCPClient *client;
     GstMultiHandleClient *mhclient;
 
-    if (mhsink->clients_cookie != cookie) {
+    if (shard->clients_cookie != cookie) {
       GST_DEBUG_OBJECT (sink, "Restarting loop, cookie out of date");
       goto restart2;
     }
@@ -1010,44 +1208,50 @@ restart2:
       continue;
     }
 
-    if (gst_poll_fd_has_closed (sink->fdset, &client->gfd)) {
+    if (gst_poll_fd_has_closed (fdset, &client->gfd)) {
       mhclient->status = GST_CLIENT_STATUS_CLOSED;
       gst_multi_handle_sink_remove_client_link (mhsink, clients);
       continue;
     }
-    if (gst_poll_fd_has_error (sink->fdset, &client->gfd)) {
+    if (gst_poll_fd_has_error (fdset, &client->gfd)) {
       GST_WARNING_OBJECT (sink, "gst_poll_fd_has_error for %d", client->gfd.fd);
       mhclient->status = GST_CLIENT_STATUS_ERROR;
       gst_multi_handle_sink_remove_client_link (mhsink, clients);
       continue;
     }
-    if (gst_poll_fd_can_read (sink->fdset, &client->gfd)) {
+    if (gst_poll_fd_can_read (fdset, &client->gfd)) {
       /* handle client read */
       if (!gst_multi_fd_sink_handle_client_read (sink, client)) {
         gst_multi_handle_sink_remove_client_link (mhsink, clients);
         continue;
       }
     }
-    if (gst_poll_fd_can_write (sink->fdset, &client->gfd)) {
-      /* handle client write */
-      if (!gst_multi_fd_sink_handle_client_write (sink, client)) {
+    if (gst_poll_fd_can_write (fdset, &client->gfd)) {
+      gboolean ok;
+
+      /* handle client write, it needs the queue */
+      CLIENTS_LOCK (mhsink);
+      ok = gst_multi_fd_sink_handle_client_write (sink, client);
+      CLIENTS_UNLOCK (mhsink);
+      if (!ok) {
         gst_multi_handle_sink_remove_client_link (mhsink, clients);
         continue;
       }
     }
   }
-  CLIENTS_UNLOCK (mhsink);
+  SHARD_UNLOCK (shard);
 }
 
-/* we handle the client communication in another thread so that we do not block
+/* we handle the client communication in other threads so that we do not block
  * the gstreamer thread while we select() on the client fds */
 static gpointer
-gst_multi_fd_sink_thread (GstMultiHandleSink * mhsink)
+gst_multi_fd_sink_thread (GstMultiHandleSink * mhsink,
+    GstMultiHandleShard * shard)
 {
   GstMultiFdSink *sink = GST_MULTI_FD_SINK (mhsink);
 
   while (mhsink->running) {
-    gst_multi_fd_sink_handle_clients (sink);
+    gst_multi_fd_sink_handle_clients (sink, shard);
   }
   return NULL;
 }
@@ -1090,14 +1294,37 @@ gst_multi_fd_sink_get_property (GObject * object, guint prop_id, GValue * value,
   }
 }
 
+static void
+gst_multi_fd_sink_free_fdsets (GstMultiFdSink * mfsink)
+{
+  GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (mfsink);
+  guint i;
+
+  if (mfsink->fdsets == NULL)
+    return;
+
+  for (i = 0; i < mhsink->n_shards; i++) {
+    if (mfsink->fdsets[i])
+      gst_poll_free (mfsink->fdsets[i]);
+  }
+  g_free (mfsink->fdsets);
+  mfsink->fdsets = NULL;
+  mfsink->fdset = NULL;
+}
+
 static gboolean
 gst_multi_fd_sink_start_pre (GstMultiHandleSink * mhsink)
 {
   GstMultiFdSink *mfsink = GST_MULTI_FD_SINK (mhsink);
+  guint i;
 
   GST_INFO_OBJECT (mfsink, "starting");
-  if ((mfsink->fdset = gst_poll_new (TRUE)) == NULL)
-    goto socket_pair;
+  mfsink->fdsets = g_new0 (GstPoll *, mhsink->n_shards);
+  for (i = 0; i < mhsink->n_shards; i++) {
+    if ((mfsink->fdsets[i] = gst_poll_new (TRUE)) == NULL)
+      goto socket_pair;
+  }
+  mfsink->fdset = mfsink->fdsets[0];
 
   return TRUE;
 
@@ -1106,6 +1333,7 @@ socket_pair:
   {
     GST_ELEMENT_ERROR (mfsink, RESOURCE, OPEN_READ_WRITE, (NULL),
         GST_ERROR_SYSTEM);
+    gst_multi_fd_sink_free_fdsets (mfsink);
     return FALSE;
   }
 }
@@ -1120,8 +1348,10 @@ static void
 gst_multi_fd_sink_stop_pre (GstMultiHandleSink * mhsink)
 {
   GstMultiFdSink *mfsink = GST_MULTI_FD_SINK (mhsink);
+  guint i;
 
-  gst_poll_set_flushing (mfsink->fdset, TRUE);
+  for (i = 0; i < mhsink->n_shards; i++)
+    gst_poll_set_flushing (mfsink->fdsets[i], TRUE);
 }
 
 static void
@@ -1129,10 +1359,7 @@ gst_multi_fd_sink_stop_post (GstMultiHandleSink * mhsink)
 {
   GstMultiFdSink *mfsink = GST_MULTI_FD_SINK (mhsink);
 
-  if (mfsink->fdset) {
-    gst_poll_free (mfsink->fdset);
-    mfsink->fdset = NULL;
-  }
+  gst_multi_fd_sink_free_fdsets (mfsink);
   g_hash_table_foreach_remove (mhsink->handle_hash, multifdsink_hash_remove,
       mfsink);
 }
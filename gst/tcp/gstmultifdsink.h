@@ -66,7 +66,8 @@ struct _GstMultiFdSink {
   GstMultiHandleSink element;
 
   /*< private >*/
-  GstPoll *fdset;
+  GstPoll **fdsets;     /* one poll for each I/O thread */
+  GstPoll *fdset;       /* the poll of the first I/O thread */
 
   gboolean handle_read;
 };
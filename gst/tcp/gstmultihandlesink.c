@@ -103,6 +103,8 @@
 #endif
 
 #include <gst/gst-i18n-plugin.h>
+#include <gst/allocators/gstfdmemory.h>
+#include <gst/allocators/gstdmabuf.h>
 
 #include "gstmultihandlesink.h"
 
@@ -110,6 +112,13 @@
 #include <sys/socket.h>
 #endif
 
+#ifdef HAVE_SYS_SENDFILE_H
+#include <sys/sendfile.h>
+#include <signal.h>
+#endif
+
+#include <errno.h>
+
 #ifndef G_OS_WIN32
 #include <netinet/in.h>
 #endif
@@ -163,6 +172,8 @@ enum
 
 #define DEFAULT_RESEND_STREAMHEADER      TRUE
 
+#define DEFAULT_N_THREADS               1
+
 enum
 {
   PROP_0,
@@ -186,6 +197,7 @@ enum
   PROP_SYNC_METHOD,
   PROP_BYTES_TO_SERVE,
   PROP_BYTES_SERVED,
+  PROP_BYTES_SERVED_ZEROCOPY,
 
   PROP_BURST_FORMAT,
   PROP_BURST_VALUE,
@@ -194,7 +206,9 @@ enum
 
   PROP_RESEND_STREAMHEADER,
 
-  PROP_NUM_HANDLES
+  PROP_NUM_HANDLES,
+
+  PROP_N_THREADS
 };
 
 GType
@@ -407,6 +421,18 @@ gst_multi_handle_sink_class_init (GstMultiHandleSinkClass * klass)
       g_param_spec_uint64 ("bytes-served", "Bytes served",
           "Total number of bytes send to all clients", 0, G_MAXUINT64, 0,
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstMultiHandleSink::bytes-served-zerocopy:
+   *
+   * The part of #GstMultiHandleSink:bytes-served that was sent straight from
+   * fd backed memory without copying it, the remaining bytes were copied.
+   *
+   * Since: 1.8
+   */
+  g_object_class_install_property (gobject_class, PROP_BYTES_SERVED_ZEROCOPY,
+      g_param_spec_uint64 ("bytes-served-zerocopy", "Bytes served zerocopy",
+          "Number of bytes send to all clients without copying them", 0,
+          G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
   g_object_class_install_property (gobject_class, PROP_BURST_FORMAT,
       g_param_spec_enum ("burst-format", "Burst format",
@@ -440,6 +466,19 @@ gst_multi_handle_sink_class_init (GstMultiHandleSinkClass * klass)
           "The current number of client handles",
           0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstMultiHandleSink::n-threads
+   *
+   * The number of threads doing the client I/O. Each thread serves its own
+   * share of the clients, all of them send from the same buffer queue. The
+   * value is used when the element is started.
+   */
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Number of I/O threads serving the clients (0 = number of processors)",
+          0, G_MAXUINT, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstMultiHandleSink::clear:
    * @gstmultihandlesink: the multihandlesink element to emit this signal on
@@ -490,9 +529,11 @@ gst_multi_handle_sink_init (GstMultiHandleSink * this)
   GST_OBJECT_FLAG_UNSET (this, GST_MULTI_HANDLE_SINK_OPEN);
 
   CLIENTS_LOCK_INIT (this);
-  this->clients = NULL;
 
-  this->bufqueue = g_array_new (FALSE, TRUE, sizeof (GstBuffer *));
+  this->bufqueue = NULL;
+  this->bufqueue_size = 0;
+  this->bufqueue_len = 0;
+  this->bufqueue_seq = 0;
   this->unit_format = DEFAULT_UNIT_FORMAT;
   this->units_max = DEFAULT_UNITS_MAX;
   this->units_soft_max = DEFAULT_UNITS_SOFT_MAX;
@@ -510,6 +551,8 @@ gst_multi_handle_sink_init (GstMultiHandleSink * this)
   this->qos_dscp = DEFAULT_QOS_DSCP;
 
   this->resend_streamheader = DEFAULT_RESEND_STREAMHEADER;
+
+  this->n_threads = DEFAULT_N_THREADS;
 }
 
 static void
@@ -520,7 +563,7 @@ gst_multi_handle_sink_finalize (GObject * object)
   this = GST_MULTI_HANDLE_SINK (object);
 
   CLIENTS_LOCK_CLEAR (this);
-  g_array_free (this->bufqueue, TRUE);
+  g_free (this->bufqueue);
   g_hash_table_destroy (this->handle_hash);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
@@ -593,18 +636,35 @@ gst_multi_handle_sink_setup_dscp_client (GstMultiHandleSink * sink,
 #endif
 }
 
+/* pick the shard with the least clients, called with the clients lock */
+static GstMultiHandleShard *
+gst_multi_handle_sink_pick_shard (GstMultiHandleSink * sink)
+{
+  GstMultiHandleShard *shard;
+  guint i;
+
+  shard = &sink->shards[0];
+  for (i = 1; i < sink->n_shards; i++) {
+    if (sink->shards[i].n_clients < shard->n_clients)
+      shard = &sink->shards[i];
+  }
+  shard->n_clients++;
+
+  return shard;
+}
+
 void
-gst_multi_handle_sink_client_init (GstMultiHandleClient * client,
-    GstSyncMethod sync_method)
+gst_multi_handle_sink_client_init (GstMultiHandleSink * sink,
+    GstMultiHandleClient * client, GstSyncMethod sync_method)
 {
   GTimeVal now;
 
   client->status = GST_CLIENT_STATUS_OK;
-  client->bufpos = -1;
   client->flushcount = -1;
   client->bufoffset = 0;
   client->sending = NULL;
   client->bytes_sent = 0;
+  client->bytes_sent_zerocopy = 0;
   client->dropped_buffers = 0;
   client->avg_queue_size = 0;
   client->first_buffer_ts = GST_CLOCK_TIME_NONE;
@@ -612,6 +672,12 @@ gst_multi_handle_sink_client_init (GstMultiHandleClient * client,
   client->new_connection = TRUE;
   client->sync_method = sync_method;
   client->currently_removing = FALSE;
+  /* gst_multi_handle_sink_add_full() picked the shard and holds its lock */
+  client->shard = sink->adding_shard;
+  g_assert (client->shard != NULL);
+  client->link = NULL;
+  client->io_unlocked = FALSE;
+  client->free_pending = FALSE;
 
   /* update start time */
   g_get_current_time (&now);
@@ -621,20 +687,318 @@ gst_multi_handle_sink_client_init (GstMultiHandleClient * client,
   client->last_activity_time = client->connect_time;
 }
 
+static void
+gst_multi_handle_sink_client_release (GstMultiHandleSink * sink,
+    GstMultiHandleClient * client)
+{
+  GstMultiHandleSinkClass *mhsinkclass = GST_MULTI_HANDLE_SINK_GET_CLASS (sink);
+
+  /* sub-class must implement this to emit the client-$handle-removed signal */
+  g_assert (mhsinkclass->client_free != NULL);
+
+  /* and the handle is really gone now */
+  mhsinkclass->client_free (sink, client);
+
+  g_free (client);
+}
+
+static void gst_multi_handle_sink_client_finish_removal (GstMultiHandleSink *
+    sink, GstMultiHandleClient * client);
+
+/* Release the shard lock and the clients lock so that the I/O thread of
+ * @client can write to it while the other threads keep working on the queue
+ * and their clients. The client and its handle stay valid until
+ * gst_multi_handle_sink_client_io_end() but the caller has to keep its own
+ * references to the buffers it sends. */
+void
+gst_multi_handle_sink_client_io_begin (GstMultiHandleSink * sink,
+    GstMultiHandleClient * client)
+{
+  client->io_unlocked = TRUE;
+  CLIENTS_UNLOCK (sink);
+  SHARD_UNLOCK (client->shard);
+}
+
+/* Take the locks again after unlocked I/O on @client. Returns FALSE when the
+ * client was removed in the meantime, the client must not be used anymore in
+ * that case. */
+gboolean
+gst_multi_handle_sink_client_io_end (GstMultiHandleSink * sink,
+    GstMultiHandleClient * client)
+{
+  SHARD_LOCK (client->shard);
+  client->io_unlocked = FALSE;
+
+  if (G_UNLIKELY (client->free_pending)) {
+    GST_DEBUG_OBJECT (sink, "%s removed during I/O, finishing removal",
+        client->debug);
+    gst_multi_handle_sink_client_finish_removal (sink, client);
+    CLIENTS_LOCK (sink);
+    return FALSE;
+  }
+  CLIENTS_LOCK (sink);
+  return !client->currently_removing;
+}
+
+/* Take the next buffer of @client from the queue, advancing its position and
+ * updating the stats. The buffer is not reffed. Called with the shard lock
+ * and the clients lock when the client has a buffer to take. */
+GstBuffer *
+gst_multi_handle_sink_client_take_buffer (GstMultiHandleSink * sink,
+    GstMultiHandleClient * client)
+{
+  GstBuffer *buf;
+  GstClockTime timestamp;
+  gint pos;
+
+  /* the streaming thread trims the queue after checking the shards one by
+   * one, a position this thread picked in the meantime can be beyond the
+   * tail. The buffers are gone, so they count as dropped */
+  pos = CLIENT_BUFPOS (sink, client);
+  if (G_UNLIKELY (pos >= sink->bufqueue_len)) {
+    GST_INFO_OBJECT (sink, "%s client %p position %d trimmed to %d",
+        client->debug, client, pos, sink->bufqueue_len - 1);
+    client->dropped_buffers += pos - sink->bufqueue_len + 1;
+    pos = sink->bufqueue_len - 1;
+    CLIENT_SET_BUFPOS (sink, client, pos);
+    client->discont = TRUE;
+  }
+
+  /* grab buffer */
+  buf = BUFQUEUE_BUFFER (sink, pos);
+  client->bufseq++;
+
+  /* update stats */
+  timestamp = GST_BUFFER_TIMESTAMP (buf);
+  if (client->first_buffer_ts == GST_CLOCK_TIME_NONE)
+    client->first_buffer_ts = timestamp;
+  if (timestamp != -1)
+    client->last_buffer_ts = timestamp;
+
+  /* decrease flushcount */
+  if (client->flushcount != -1)
+    client->flushcount--;
+
+  GST_LOG_OBJECT (sink, "%s client %p at position %d",
+      client->debug, client, CLIENT_BUFPOS (sink, client));
+
+  return buf;
+}
+
+/* Look at the buffer that comes @n buffers after the next buffer of @client
+ * in the queue, without taking it. The client keeps its position until the
+ * buffer is written, see gst_multi_handle_sink_client_commit_peeked().
+ * Returns NULL when the client can't send that buffer without picking the
+ * buffers before it first. Called with the shard lock and the clients
+ * lock. */
+GstBuffer *
+gst_multi_handle_sink_client_peek_buffer (GstMultiHandleSink * sink,
+    GstMultiHandleClient * client, gint n)
+{
+  GstCaps *caps;
+  gboolean same_caps;
+  gint pos;
+
+  if (client->new_connection || (client->flushcount != -1
+          && client->flushcount <= n))
+    return NULL;
+
+  pos = CLIENT_BUFPOS (sink, client) - n;
+  if (pos < 0 || pos >= sink->bufqueue_len)
+    return NULL;
+
+  /* picking the buffer would queue new streamheaders in front of it */
+  caps = gst_pad_get_current_caps (GST_BASE_SINK_PAD (sink));
+  same_caps = caps != NULL && caps == client->caps;
+  if (caps)
+    gst_caps_unref (caps);
+  if (!same_caps)
+    return NULL;
+
+  return BUFQUEUE_BUFFER (sink, pos);
+}
+
+/* After writing the buffers in the sending queue of @client followed by the
+ * @n_peeked buffers from gst_multi_handle_sink_client_peek_buffer(), take
+ * the peeked buffers that were written completely or partially and add
+ * them to the sending queue. @wrote is the number of bytes written,
+ * starting at the bufoffset of the client. Called with the shard lock and
+ * the clients lock. */
+void
+gst_multi_handle_sink_client_commit_peeked (GstMultiHandleSink * sink,
+    GstMultiHandleClient * client, GstBuffer ** peeked, guint n_peeked,
+    gsize wrote)
+{
+  GSList *walk;
+  gsize offset;
+  guint i;
+
+  /* skip what was written from the sending queue */
+  offset = client->bufoffset;
+  for (walk = client->sending; walk && wrote > 0; walk = walk->next) {
+    gsize size = gst_buffer_get_size (GST_BUFFER_CAST (walk->data)) - offset;
+
+    wrote -= MIN (wrote, size);
+    offset = 0;
+  }
+
+  for (i = 0; i < n_peeked && wrote > 0; i++) {
+    GstBuffer *buf = peeked[i];
+    gint pos = CLIENT_BUFPOS (sink, client);
+
+    /* the position of the client only changes when it was moved while we
+     * were writing, in that case we only finish sending the buffer */
+    if (pos >= 0 && pos < sink->bufqueue_len
+        && BUFQUEUE_BUFFER (sink, pos) == buf)
+      gst_multi_handle_sink_client_take_buffer (sink, client);
+
+    client->sending = g_slist_append (client->sending, gst_buffer_ref (buf));
+    wrote -= MIN (wrote, gst_buffer_get_size (buf));
+  }
+}
+
+static gboolean
+gst_multi_handle_sink_memory_is_zerocopy (GstMemory * mem)
+{
+#ifdef HAVE_SYS_SENDFILE_H
+  /* dmabufs can't be read with sendfile. Writes to a private mapping don't
+   * end up in the file, sendfile would send the old file contents */
+  return gst_is_fd_memory (mem) && !gst_is_dmabuf_memory (mem) &&
+      !(gst_fd_memory_get_flags (mem) & GST_FD_MEMORY_FLAG_MAP_PRIVATE);
+#else
+  return FALSE;
+#endif
+}
+
+/* Find out how the data of @buf starting at @offset can be sent. When it
+ * starts with a memory that can be sent without copying, that memory is
+ * returned, with the offset of the first byte in it in @skip. Otherwise NULL
+ * is returned, @n_copy is set to the number of memories from @idx that must
+ * be copied before the next memory that can be sent without copying, or to
+ * G_MAXUINT when there is none. */
+GstMemory *
+gst_multi_handle_sink_find_zerocopy_memory (GstBuffer * buf, gsize offset,
+    gsize * skip, guint * idx, guint * n_copy)
+{
+  guint mem_len, i;
+
+  *n_copy = G_MAXUINT;
+
+  if (!gst_buffer_find_memory (buf, offset, gst_buffer_get_size (buf) - offset,
+          idx, &mem_len, skip))
+    return NULL;
+
+  for (i = 0; i < mem_len; i++) {
+    GstMemory *mem = gst_buffer_peek_memory (buf, *idx + i);
+
+    if (gst_multi_handle_sink_memory_is_zerocopy (mem)) {
+      if (i == 0)
+        return mem;
+
+      *n_copy = i;
+      break;
+    }
+  }
+  return NULL;
+}
+
+/* Send the data of the fd backed memory @mem, starting at @skip, to @fd
+ * without mapping and copying it. Returns the number of bytes written or -1
+ * with errno set. errno is EINVAL or ENOSYS when the memory can't be sent
+ * like this and needs to be copied instead. */
+gssize
+gst_multi_handle_sink_send_memory (int fd, GstMemory * mem, gsize skip)
+{
+#ifdef HAVE_SYS_SENDFILE_H
+  sigset_t sigpipe, pending, oldmask;
+  gboolean was_pending;
+  off_t offset;
+  gssize wrote;
+  gint write_errno;
+
+  /* there is no MSG_NOSIGNAL for sendfile, block SIGPIPE in this thread and
+   * discard it again when we raised it */
+  sigemptyset (&sigpipe);
+  sigaddset (&sigpipe, SIGPIPE);
+  sigpending (&pending);
+  was_pending = sigismember (&pending, SIGPIPE);
+  pthread_sigmask (SIG_BLOCK, &sigpipe, &oldmask);
+
+  offset = mem->offset + skip;
+  do {
+    wrote = sendfile (fd, gst_fd_memory_get_fd (mem), &offset,
+        mem->size - skip);
+  } while (wrote < 0 && errno == EINTR);
+  write_errno = errno;
+
+  if (wrote < 0 && write_errno == EPIPE && !was_pending) {
+    struct timespec timeout = { 0, 0 };
+    gint res;
+
+    do {
+      res = sigtimedwait (&sigpipe, NULL, &timeout);
+    } while (res < 0 && errno == EINTR);
+  }
+  pthread_sigmask (SIG_SETMASK, &oldmask, NULL);
+  errno = write_errno;
+
+  return wrote;
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
 static void
 gst_multi_handle_sink_setup_dscp (GstMultiHandleSink * mhsink)
 {
   GList *clients;
+  guint i;
 
-  CLIENTS_LOCK (mhsink);
-  for (clients = mhsink->clients; clients; clients = clients->next) {
-    GstMultiHandleClient *client;
+  for (i = 0; i < mhsink->n_shards; i++) {
+    GstMultiHandleShard *shard = &mhsink->shards[i];
+
+    SHARD_LOCK (shard);
+    for (clients = shard->clients; clients; clients = clients->next) {
+      GstMultiHandleClient *client;
 
-    client = clients->data;
+      client = clients->data;
 
-    gst_multi_handle_sink_setup_dscp_client (mhsink, client);
+      gst_multi_handle_sink_setup_dscp_client (mhsink, client);
+    }
+    SHARD_UNLOCK (shard);
   }
-  CLIENTS_UNLOCK (mhsink);
+}
+
+/* Find the client of @handle and take the lock of its shard, which keeps the
+ * client in place until the caller releases the lock with SHARD_UNLOCK().
+ * Returns NULL without taking a lock when there is no such client. */
+GstMultiHandleClient *
+gst_multi_handle_sink_lock_client (GstMultiHandleSink * sink,
+    GstMultiSinkHandle handle)
+{
+  GstMultiHandleClient *mhclient;
+  GstMultiHandleShard *shard;
+  GstMultiHandleSinkClass *mhsinkclass = GST_MULTI_HANDLE_SINK_GET_CLASS (sink);
+  gpointer key = mhsinkclass->handle_hash_key (handle);
+
+  CLIENTS_LOCK (sink);
+  while ((mhclient = g_hash_table_lookup (sink->handle_hash, key))) {
+    /* the shard lock goes before the clients lock, look again when we have
+     * both, the client could have been removed in the meantime */
+    shard = mhclient->shard;
+    CLIENTS_UNLOCK (sink);
+    SHARD_LOCK (shard);
+    CLIENTS_LOCK (sink);
+
+    mhclient = g_hash_table_lookup (sink->handle_hash, key);
+    if (mhclient != NULL && mhclient->shard == shard)
+      break;
+    SHARD_UNLOCK (shard);
+  }
+  CLIENTS_UNLOCK (sink);
+
+  return mhclient;
 }
 
 void
@@ -643,7 +1007,7 @@ gst_multi_handle_sink_add_full (GstMultiHandleSink * sink,
     guint64 min_value, GstFormat max_format, guint64 max_value)
 {
   GstMultiHandleClient *mhclient;
-  GList *clink;
+  GstMultiHandleShard *shard;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
   gchar debug[30];
   GstMultiHandleSinkClass *mhsinkclass =
@@ -667,26 +1031,39 @@ gst_multi_handle_sink_add_full (GstMultiHandleSink * sink,
       goto wrong_limits;
   }
 
+  /* take a place in the least loaded shard, the client is set up with the
+   * lock of that shard */
+  CLIENTS_LOCK (sink);
+  shard = gst_multi_handle_sink_pick_shard (sink);
+  CLIENTS_UNLOCK (sink);
+
+  SHARD_LOCK (shard);
   CLIENTS_LOCK (sink);
 
   /* check the hash to find a duplicate handle */
-  clink = g_hash_table_lookup (mhsink->handle_hash,
-      mhsinkclass->handle_hash_key (handle));
-  if (clink != NULL)
+  if (g_hash_table_lookup (mhsink->handle_hash,
+          mhsinkclass->handle_hash_key (handle)) != NULL)
     goto duplicate;
 
   /* We do not take ownership of @handle in this function, but we can't take a
    * reference directly as we don't know the concrete type of the handle.
    * GstMultiHandleSink relies on the derived class to take a reference for us
    * in new_client: */
+  mhsink->adding_shard = shard;
   mhclient = mhsinkclass->new_client (mhsink, handle, sync_method);
+  mhsink->adding_shard = NULL;
+
+  /* the client waits for the next buffer */
+  CLIENT_SET_BUFPOS (mhsink, mhclient, -1);
 
   /* we can add the handle now */
-  clink = mhsink->clients = g_list_prepend (mhsink->clients, mhclient);
   g_hash_table_insert (mhsink->handle_hash,
-      mhsinkclass->handle_hash_key (mhclient->handle), clink);
-  mhsink->clients_cookie++;
+      mhsinkclass->handle_hash_key (mhclient->handle), mhclient);
+  CLIENTS_UNLOCK (sink);
 
+  shard->clients = g_list_prepend (shard->clients, mhclient);
+  mhclient->link = shard->clients;
+  shard->clients_cookie++;
 
   mhclient->burst_min_format = min_format;
   mhclient->burst_min_value = min_value;
@@ -696,7 +1073,7 @@ gst_multi_handle_sink_add_full (GstMultiHandleSink * sink,
   if (mhsinkclass->hash_changed)
     mhsinkclass->hash_changed (mhsink);
 
-  CLIENTS_UNLOCK (sink);
+  SHARD_UNLOCK (shard);
 
   mhsinkclass->emit_client_added (mhsink, handle);
 
@@ -713,7 +1090,9 @@ wrong_limits:
   }
 duplicate:
   {
+    shard->n_clients--;
     CLIENTS_UNLOCK (sink);
+    SHARD_UNLOCK (shard);
     GST_WARNING_OBJECT (sink, "%s duplicate client found, refusing", debug);
     mhsinkclass->emit_client_removed (mhsink, handle,
         GST_CLIENT_STATUS_DUPLICATE);
@@ -735,7 +1114,7 @@ void
 gst_multi_handle_sink_remove (GstMultiHandleSink * sink,
     GstMultiSinkHandle handle)
 {
-  GList *clink;
+  GstMultiHandleClient *mhclient;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
   GstMultiHandleSinkClass *mhsinkclass =
       GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
@@ -745,11 +1124,9 @@ gst_multi_handle_sink_remove (GstMultiHandleSink * sink,
 
   GST_DEBUG_OBJECT (sink, "%s removing client", debug);
 
-  CLIENTS_LOCK (sink);
-  clink = g_hash_table_lookup (mhsink->handle_hash,
-      mhsinkclass->handle_hash_key (handle));
-  if (clink != NULL) {
-    GstMultiHandleClient *mhclient = (GstMultiHandleClient *) clink->data;
+  mhclient = gst_multi_handle_sink_lock_client (mhsink, handle);
+  if (mhclient != NULL) {
+    GstMultiHandleShard *shard = mhclient->shard;
 
     if (mhclient->status != GST_CLIENT_STATUS_OK) {
       GST_INFO_OBJECT (sink,
@@ -760,15 +1137,15 @@ gst_multi_handle_sink_remove (GstMultiHandleSink * sink,
 
     mhclient->status = GST_CLIENT_STATUS_REMOVED;
     gst_multi_handle_sink_remove_client_link (GST_MULTI_HANDLE_SINK (sink),
-        clink);
+        mhclient->link);
     if (mhsinkclass->hash_changed)
       mhsinkclass->hash_changed (mhsink);
+
+  done:
+    SHARD_UNLOCK (shard);
   } else {
     GST_WARNING_OBJECT (sink, "%s no client with this handle found!", debug);
   }
-
-done:
-  CLIENTS_UNLOCK (sink);
 }
 
 /* "remove-flush" signal implementation */
@@ -776,7 +1153,7 @@ void
 gst_multi_handle_sink_remove_flush (GstMultiHandleSink * sink,
     GstMultiSinkHandle handle)
 {
-  GList *clink;
+  GstMultiHandleClient *mhclient;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
   GstMultiHandleSinkClass *mhsinkclass =
       GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
@@ -786,11 +1163,9 @@ gst_multi_handle_sink_remove_flush (GstMultiHandleSink * sink,
 
   GST_DEBUG_OBJECT (sink, "%s flushing client", debug);
 
-  CLIENTS_LOCK (sink);
-  clink = g_hash_table_lookup (mhsink->handle_hash,
-      mhsinkclass->handle_hash_key (handle));
-  if (clink != NULL) {
-    GstMultiHandleClient *mhclient = (GstMultiHandleClient *) clink->data;
+  mhclient = gst_multi_handle_sink_lock_client (mhsink, handle);
+  if (mhclient != NULL) {
+    GstMultiHandleShard *shard = mhclient->shard;
 
     if (mhclient->status != GST_CLIENT_STATUS_OK) {
       GST_INFO_OBJECT (sink,
@@ -802,15 +1177,18 @@ gst_multi_handle_sink_remove_flush (GstMultiHandleSink * sink,
     /* take the position of the client as the number of buffers left to flush.
      * If the client was at position -1, we flush 0 buffers, 0 == flush 1
      * buffer, etc... */
-    mhclient->flushcount = mhclient->bufpos + 1;
+    CLIENTS_LOCK (sink);
+    mhclient->flushcount = CLIENT_BUFPOS (mhsink, mhclient) + 1;
+    CLIENTS_UNLOCK (sink);
     /* mark client as flushing. We can not remove the client right away because
      * it might have some buffers to flush in the ->sending queue. */
     mhclient->status = GST_CLIENT_STATUS_FLUSHING;
+
+  done:
+    SHARD_UNLOCK (shard);
   } else {
     GST_WARNING_OBJECT (sink, "%s no client with this handle found!", debug);
   }
-done:
-  CLIENTS_UNLOCK (sink);
 }
 
 /* can be called both through the signal (i.e. from any thread) or when 
@@ -820,34 +1198,38 @@ gst_multi_handle_sink_clear (GstMultiHandleSink * mhsink)
 {
   GList *clients, *next;
   guint32 cookie;
+  guint i;
   GstMultiHandleSinkClass *mhsinkclass =
       GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
 
   GST_DEBUG_OBJECT (mhsink, "clearing all clients");
 
-  CLIENTS_LOCK (mhsink);
-restart:
-  cookie = mhsink->clients_cookie;
-  for (clients = mhsink->clients; clients; clients = next) {
-    GstMultiHandleClient *mhclient;
-
-    if (cookie != mhsink->clients_cookie) {
-      GST_DEBUG_OBJECT (mhsink, "cookie changed while removing all clients");
-      goto restart;
-    }
+  for (i = 0; i < mhsink->n_shards; i++) {
+    GstMultiHandleShard *shard = &mhsink->shards[i];
 
-    mhclient = (GstMultiHandleClient *) clients->data;
-    next = g_list_next (clients);
+    SHARD_LOCK (shard);
+  restart:
+    cookie = shard->clients_cookie;
+    for (clients = shard->clients; clients; clients = next) {
+      GstMultiHandleClient *mhclient;
 
-    mhclient->status = GST_CLIENT_STATUS_REMOVED;
-    /* the next call changes the list, which is why we iterate
-     * with a temporary next pointer */
-    gst_multi_handle_sink_remove_client_link (mhsink, clients);
+      if (cookie != shard->clients_cookie) {
+        GST_DEBUG_OBJECT (mhsink, "cookie changed while removing all clients");
+        goto restart;
+      }
+
+      mhclient = (GstMultiHandleClient *) clients->data;
+      next = g_list_next (clients);
+
+      mhclient->status = GST_CLIENT_STATUS_REMOVED;
+      /* the next call changes the list, which is why we iterate
+       * with a temporary next pointer */
+      gst_multi_handle_sink_remove_client_link (mhsink, clients);
+    }
+    SHARD_UNLOCK (shard);
   }
   if (mhsinkclass->hash_changed)
     mhsinkclass->hash_changed (mhsink);
-
-  CLIENTS_UNLOCK (mhsink);
 }
 
 
@@ -859,7 +1241,6 @@ gst_multi_handle_sink_get_stats (GstMultiHandleSink * sink,
 {
   GstMultiHandleClient *client;
   GstStructure *result = NULL;
-  GList *clink;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
   GstMultiHandleSinkClass *mhsinkclass =
       GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
@@ -867,13 +1248,7 @@ gst_multi_handle_sink_get_stats (GstMultiHandleSink * sink,
 
   mhsinkclass->handle_debug (handle, debug);
 
-  CLIENTS_LOCK (sink);
-  clink = g_hash_table_lookup (mhsink->handle_hash,
-      mhsinkclass->handle_hash_key (handle));
-  if (clink == NULL)
-    goto noclient;
-
-  client = clink->data;
+  client = gst_multi_handle_sink_lock_client (mhsink, handle);
   if (client != NULL) {
     GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
     guint64 interval;
@@ -892,6 +1267,7 @@ gst_multi_handle_sink_get_stats (GstMultiHandleSink * sink,
 
     gst_structure_set (result,
         "bytes-sent", G_TYPE_UINT64, mhclient->bytes_sent,
+        "bytes-sent-zerocopy", G_TYPE_UINT64, mhclient->bytes_sent_zerocopy,
         "connect-time", G_TYPE_UINT64, mhclient->connect_time,
         "disconnect-time", G_TYPE_UINT64, mhclient->disconnect_time,
         "connect-duration", G_TYPE_UINT64, interval,
@@ -899,10 +1275,9 @@ gst_multi_handle_sink_get_stats (GstMultiHandleSink * sink,
         "buffers-dropped", G_TYPE_UINT64, mhclient->dropped_buffers,
         "first-buffer-ts", G_TYPE_UINT64, mhclient->first_buffer_ts,
         "last-buffer-ts", G_TYPE_UINT64, mhclient->last_buffer_ts, NULL);
-  }
 
-noclient:
-  CLIENTS_UNLOCK (sink);
+    SHARD_UNLOCK (mhclient->shard);
+  }
 
   /* python doesn't like a NULL pointer yet */
   if (result == NULL) {
@@ -913,7 +1288,8 @@ noclient:
   return result;
 }
 
-/* should be called with the clientslock held.
+/* should be called with the lock of the shard of the client held and
+ * without the clientslock.
  * Note that we don't close the fd as we didn't open it in the first
  * place. An application should connect to the client-fd-removed signal and
  * close the fd itself.
@@ -924,6 +1300,7 @@ gst_multi_handle_sink_remove_client_link (GstMultiHandleSink * sink,
 {
   GTimeVal now;
   GstMultiHandleClient *mhclient = (GstMultiHandleClient *) link->data;
+  GstMultiHandleShard *shard = mhclient->shard;
   GstMultiHandleSinkClass *mhsinkclass = GST_MULTI_HANDLE_SINK_GET_CLASS (sink);
 
   if (mhclient->currently_removing) {
@@ -980,44 +1357,64 @@ gst_multi_handle_sink_remove_client_link (GstMultiHandleSink * sink,
     gst_caps_unref (mhclient->caps);
   mhclient->caps = NULL;
 
+  /* take the client out of the list of its shard right away, the walkers of
+   * the list see the cookie change */
+  shard->clients = g_list_delete_link (shard->clients, mhclient->link);
+  mhclient->link = NULL;
+  shard->clients_cookie++;
+
+  /* the I/O thread of the client is still writing to its handle. Don't tell
+   * the app about the removal yet, it would close the handle and the number
+   * could be reused for a new client while we are writing to it. The I/O
+   * thread finishes the removal when it takes the lock again. */
+  if (mhclient->io_unlocked) {
+    GST_DEBUG_OBJECT (sink, "%s client is doing I/O, deferring removal",
+        mhclient->debug);
+    mhclient->free_pending = TRUE;
+    return;
+  }
+
+  gst_multi_handle_sink_client_finish_removal (sink, mhclient);
+}
+
+/* second half of the removal, signals the app and frees the client. Called
+ * with the shard lock of the client held when nobody is doing I/O on the
+ * client anymore */
+static void
+gst_multi_handle_sink_client_finish_removal (GstMultiHandleSink * sink,
+    GstMultiHandleClient * mhclient)
+{
+  GstMultiHandleShard *shard = mhclient->shard;
+  GstMultiHandleSinkClass *mhsinkclass = GST_MULTI_HANDLE_SINK_GET_CLASS (sink);
+
   /* unlock the mutex before signaling because the signal handler
    * might query some properties */
-  CLIENTS_UNLOCK (sink);
+  SHARD_UNLOCK (shard);
 
   mhsinkclass->emit_client_removed (sink, mhclient->handle, mhclient->status);
 
   /* lock again before we remove the client completely */
-  CLIENTS_LOCK (sink);
+  SHARD_LOCK (shard);
 
   /* handle cannot be reused in the above signal callback so we can safely
    * remove it from the hashtable here */
+  CLIENTS_LOCK (sink);
   if (!g_hash_table_remove (sink->handle_hash,
           mhsinkclass->handle_hash_key (mhclient->handle))) {
     GST_WARNING_OBJECT (sink,
         "%s error removing client %p from hash", mhclient->debug, mhclient);
   }
-  /* after releasing the lock above, the link could be invalid, more
-   * precisely, the next and prev pointers could point to invalid list
-   * links. One optimisation could be to add a cookie to the linked list
-   * and take a shortcut when it did not change between unlocking and locking
-   * our mutex. For now we just walk the list again. */
-  sink->clients = g_list_remove (sink->clients, mhclient);
-  sink->clients_cookie++;
+  shard->n_clients--;
+  CLIENTS_UNLOCK (sink);
 
   if (mhsinkclass->removed)
     mhsinkclass->removed (sink, mhclient->handle);
 
-  CLIENTS_UNLOCK (sink);
-
-  /* sub-class must implement this to emit the client-$handle-removed signal */
-  g_assert (mhsinkclass->client_free != NULL);
-
-  /* and the handle is really gone now */
-  mhsinkclass->client_free (sink, mhclient);
+  SHARD_UNLOCK (shard);
 
-  g_free (mhclient);
+  gst_multi_handle_sink_client_release (sink, mhclient);
 
-  CLIENTS_LOCK (sink);
+  SHARD_LOCK (shard);
 }
 
 static gboolean
@@ -1160,7 +1557,7 @@ find_syncframe (GstMultiHandleSink * sink, gint idx, gint direction)
   gint i, len, result;
 
   /* take length of queued buffers */
-  len = sink->bufqueue->len;
+  len = sink->bufqueue_len;
 
   /* assume we don't find a keyframe */
   result = -1;
@@ -1169,7 +1566,7 @@ find_syncframe (GstMultiHandleSink * sink, gint idx, gint direction)
   for (i = idx; i >= 0 && i < len; i += direction) {
     GstBuffer *buf;
 
-    buf = g_array_index (sink->bufqueue, GstBuffer *, i);
+    buf = BUFQUEUE_BUFFER (sink, i);
     if (is_sync_frame (sink, buf)) {
       GST_LOG_OBJECT (sink, "found keyframe at %d from %d, direction %d",
           i, idx, direction);
@@ -1198,10 +1595,10 @@ get_buffers_max (GstMultiHandleSink * sink, gint64 max)
       gint64 diff;
       GstClockTime first = GST_CLOCK_TIME_NONE;
 
-      len = sink->bufqueue->len;
+      len = sink->bufqueue_len;
 
       for (i = 0; i < len; i++) {
-        buf = g_array_index (sink->bufqueue, GstBuffer *, i);
+        buf = BUFQUEUE_BUFFER (sink, i);
         if (GST_BUFFER_TIMESTAMP_IS_VALID (buf)) {
           if (first == -1)
             first = GST_BUFFER_TIMESTAMP (buf);
@@ -1221,10 +1618,10 @@ get_buffers_max (GstMultiHandleSink * sink, gint64 max)
       int len;
       gint acc = 0;
 
-      len = sink->bufqueue->len;
+      len = sink->bufqueue_len;
 
       for (i = 0; i < len; i++) {
-        buf = g_array_index (sink->bufqueue, GstBuffer *, i);
+        buf = BUFQUEUE_BUFFER (sink, i);
         acc += gst_buffer_get_size (buf);
 
         if (acc > max)
@@ -1259,7 +1656,7 @@ find_limits (GstMultiHandleSink * sink,
   gboolean result, max_hit;
 
   /* take length of queue */
-  len = sink->bufqueue->len;
+  len = sink->bufqueue_len;
 
   /* this must hold */
   g_assert (len > 0);
@@ -1306,7 +1703,7 @@ find_limits (GstMultiHandleSink * sink,
       result = *min_idx != -1;
       break;
     }
-    buf = g_array_index (sink->bufqueue, GstBuffer *, i);
+    buf = BUFQUEUE_BUFFER (sink, i);
 
     bytes += gst_buffer_get_size (buf);
 
@@ -1422,23 +1819,23 @@ gst_multi_handle_sink_new_client_position (GstMultiHandleSink * sink,
   GST_DEBUG_OBJECT (sink,
       "%s new client, deciding where to start in queue", client->debug);
   GST_DEBUG_OBJECT (sink, "queue is currently %d buffers long",
-      sink->bufqueue->len);
+      sink->bufqueue_len);
   switch (client->sync_method) {
     case GST_SYNC_METHOD_LATEST:
       /* no syncing, we are happy with whatever the client is going to get */
-      result = client->bufpos;
+      result = CLIENT_BUFPOS (sink, client);
       GST_DEBUG_OBJECT (sink,
           "%s SYNC_METHOD_LATEST, position %d", client->debug, result);
       break;
     case GST_SYNC_METHOD_NEXT_KEYFRAME:
     {
-      /* if one of the new buffers (between client->bufpos and 0) in the queue
+      /* if one of the new buffers (between the client position and 0) in the queue
        * is a sync point, we can proceed, otherwise we need to keep waiting */
       GST_LOG_OBJECT (sink,
           "%s new client, bufpos %d, waiting for keyframe",
-          client->debug, client->bufpos);
+          client->debug, CLIENT_BUFPOS (sink, client));
 
-      result = find_prev_syncframe (sink, client->bufpos);
+      result = find_prev_syncframe (sink, CLIENT_BUFPOS (sink, client));
       if (result != -1) {
         GST_DEBUG_OBJECT (sink,
             "%s SYNC_METHOD_NEXT_KEYFRAME: result %d", client->debug, result);
@@ -1450,7 +1847,7 @@ gst_multi_handle_sink_new_client_position (GstMultiHandleSink * sink,
       GST_LOG_OBJECT (sink,
           "%s new client, skipping buffer(s), no syncpoint found",
           client->debug);
-      client->bufpos = -1;
+      CLIENT_SET_BUFPOS (sink, client, -1);
       break;
     }
     case GST_SYNC_METHOD_LATEST_KEYFRAME:
@@ -1473,7 +1870,7 @@ gst_multi_handle_sink_new_client_position (GstMultiHandleSink * sink,
           "%s SYNC_METHOD_LATEST_KEYFRAME: no keyframe found, "
           "switching to SYNC_METHOD_NEXT_KEYFRAME", client->debug);
       /* throw client to the waiting state */
-      client->bufpos = -1;
+      CLIENT_SET_BUFPOS (sink, client, -1);
       /* and make client sync to next keyframe */
       client->sync_method = GST_SYNC_METHOD_NEXT_KEYFRAME;
       break;
@@ -1548,7 +1945,7 @@ gst_multi_handle_sink_new_client_position (GstMultiHandleSink * sink,
           "no prev keyframe found in BURST_KEYFRAME sync mode, waiting for next");
 
       /* throw client to the waiting state */
-      client->bufpos = -1;
+      CLIENT_SET_BUFPOS (sink, client, -1);
       /* and make client sync to next keyframe */
       client->sync_method = GST_SYNC_METHOD_NEXT_KEYFRAME;
       result = -1;
@@ -1595,7 +1992,7 @@ gst_multi_handle_sink_new_client_position (GstMultiHandleSink * sink,
     }
     default:
       g_warning ("unknown sync method %d", client->sync_method);
-      result = client->bufpos;
+      result = CLIENT_BUFPOS (sink, client);
       break;
   }
   return result;
@@ -1613,13 +2010,14 @@ gst_multi_handle_sink_recover_client (GstMultiHandleSink * sink,
 
   GST_WARNING_OBJECT (sink,
       "%s client %p is lagging at %d, recover using policy %d",
-      client->debug, client, client->bufpos, sink->recover_policy);
+      client->debug, client, CLIENT_BUFPOS (sink, client),
+      sink->recover_policy);
 
   switch (sink->recover_policy) {
     case GST_RECOVER_POLICY_NONE:
       /* do nothing, client will catch up or get kicked out when it reaches
        * the hard max */
-      newbufpos = client->bufpos;
+      newbufpos = CLIENT_BUFPOS (sink, client);
       break;
     case GST_RECOVER_POLICY_RESYNC_LATEST:
       /* move to beginning of queue */
@@ -1632,13 +2030,13 @@ gst_multi_handle_sink_recover_client (GstMultiHandleSink * sink,
     case GST_RECOVER_POLICY_RESYNC_KEYFRAME:
       /* find keyframe in buffers, we search backwards to find the
        * closest keyframe relative to what this client already received. */
-      newbufpos = MIN (sink->bufqueue->len - 1,
+      newbufpos = MIN (sink->bufqueue_len - 1,
           get_buffers_max (sink, sink->units_soft_max) - 1);
 
       while (newbufpos >= 0) {
         GstBuffer *buf;
 
-        buf = g_array_index (sink->bufqueue, GstBuffer *, newbufpos);
+        buf = BUFQUEUE_BUFFER (sink, newbufpos);
         if (is_sync_frame (sink, buf)) {
           /* found a buffer that is not a delta unit */
           break;
@@ -1654,18 +2052,43 @@ gst_multi_handle_sink_recover_client (GstMultiHandleSink * sink,
   return newbufpos;
 }
 
+/* double the size of the ring of queued buffers */
+static void
+gst_multi_handle_sink_grow_bufqueue (GstMultiHandleSink * mhsink)
+{
+  GstBuffer **bufqueue;
+  guint i, size;
+  gint64 seq;
+
+  size = MAX (mhsink->bufqueue_size * 2, 16);
+  bufqueue = g_new (GstBuffer *, size);
+
+  /* the slot of a buffer depends on the size of the ring */
+  for (i = 0; i < mhsink->bufqueue_len; i++) {
+    seq = mhsink->bufqueue_seq - 1 - i;
+    bufqueue[seq & (size - 1)] = BUFQUEUE_BUFFER (mhsink, i);
+  }
+  g_free (mhsink->bufqueue);
+  mhsink->bufqueue = bufqueue;
+  mhsink->bufqueue_size = size;
+
+  GST_DEBUG_OBJECT (mhsink, "grew queue to %u buffers", size);
+}
+
 /* Queue a buffer on the global queue.
  *
- * This function adds the buffer to the front of a GArray. It removes the
- * tail buffer if the max queue size is exceeded, unreffing the queued buffer.
+ * This function adds the buffer to the front of the ring of queued buffers.
+ * It removes the tail buffers if the max queue size is exceeded, unreffing
+ * the queued buffers.
  * Note that unreffing the buffer is not a problem as clients who
  * started writing out this buffer will still have a reference to it in the
  * mhclient->sending queue.
  *
- * After adding the buffer, we update all client positions in the queue. If
- * a client moves over the soft max, we start the recovery procedure for this
- * slow client. If it goes over the hard max, it is put into the slow list
- * and removed.
+ * Clients refer to buffers by sequence number so their position in the queue
+ * moves along with the new buffer without touching them. We then check all
+ * client positions. If a client moves over the soft max, we start the
+ * recovery procedure for this slow client. If it goes over the hard max, it
+ * is put into the slow list and removed.
  *
  * Special care is taken of clients that were waiting for a new buffer (they
  * had a position of -1) because they can proceed after adding this new buffer.
@@ -1677,22 +2100,30 @@ gst_multi_handle_sink_queue_buffer (GstMultiHandleSink * mhsink,
     GstBuffer * buffer)
 {
   GList *clients, *next;
-  gint queuelen;
+  gint queuelen, bufpos;
   gboolean hash_changed = FALSE;
   gint max_buffer_usage;
   gint i;
   GTimeVal nowtv;
   GstClockTime now;
   gint max_buffers, soft_max_buffers;
-  guint cookie;
+  guint cookie, n;
   GstMultiHandleSink *sink = GST_MULTI_HANDLE_SINK (mhsink);
   GstMultiHandleSinkClass *mhsinkclass =
       GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
 
   CLIENTS_LOCK (mhsink);
   /* add buffer to queue */
-  g_array_prepend_val (mhsink->bufqueue, buffer);
-  queuelen = mhsink->bufqueue->len;
+  if (mhsink->bufqueue_len == mhsink->bufqueue_size)
+    gst_multi_handle_sink_grow_bufqueue (mhsink);
+  mhsink->bufqueue[mhsink->bufqueue_seq & (mhsink->bufqueue_size - 1)] =
+      buffer;
+  mhsink->bufqueue_seq++;
+  queuelen = ++mhsink->bufqueue_len;
+  CLIENTS_UNLOCK (mhsink);
+
+  /* this is the only thread that changes the queue, it reads it without the
+   * clients lock from here on until the tail is removed */
 
   if (mhsink->units_max > 0)
     max_buffers = get_buffers_max (mhsink, mhsink->units_max);
@@ -1706,68 +2137,76 @@ gst_multi_handle_sink_queue_buffer (GstMultiHandleSink * mhsink,
   GST_LOG_OBJECT (sink, "Using max %d, softmax %d", max_buffers,
       soft_max_buffers);
 
-  /* then loop over the clients and update the positions */
+  /* then loop over the clients and check their positions, one shard at a
+   * time so that the I/O threads of the other shards keep on sending */
   max_buffer_usage = 0;
 
-restart:
-  cookie = mhsink->clients_cookie;
-  for (clients = mhsink->clients; clients; clients = next) {
-    GstMultiHandleClient *mhclient = clients->data;
+  for (n = 0; n < mhsink->n_shards; n++) {
+    GstMultiHandleShard *shard = &mhsink->shards[n];
 
-    g_get_current_time (&nowtv);
-    now = GST_TIMEVAL_TO_TIME (nowtv);
+    SHARD_LOCK (shard);
+  restart:
+    cookie = shard->clients_cookie;
+    for (clients = shard->clients; clients; clients = next) {
+      GstMultiHandleClient *mhclient = clients->data;
 
-    if (cookie != mhsink->clients_cookie) {
-      GST_DEBUG_OBJECT (sink, "Clients cookie outdated, restarting");
-      goto restart;
-    }
+      g_get_current_time (&nowtv);
+      now = GST_TIMEVAL_TO_TIME (nowtv);
 
-    next = g_list_next (clients);
-
-    mhclient->bufpos++;
-    GST_LOG_OBJECT (sink, "%s client %p at position %d",
-        mhclient->debug, mhclient, mhclient->bufpos);
-    /* check soft max if needed, recover client */
-    if (soft_max_buffers > 0 && mhclient->bufpos >= soft_max_buffers) {
-      gint newpos;
-
-      newpos = gst_multi_handle_sink_recover_client (mhsink, mhclient);
-      if (newpos != mhclient->bufpos) {
-        mhclient->dropped_buffers += mhclient->bufpos - newpos;
-        mhclient->bufpos = newpos;
-        mhclient->discont = TRUE;
-        GST_INFO_OBJECT (sink, "%s client %p position reset to %d",
-            mhclient->debug, mhclient, mhclient->bufpos);
-      } else {
-        GST_INFO_OBJECT (sink,
-            "%s client %p not recovering position", mhclient->debug, mhclient);
+      if (cookie != shard->clients_cookie) {
+        GST_DEBUG_OBJECT (sink, "Clients cookie outdated, restarting");
+        goto restart;
+      }
+
+      next = g_list_next (clients);
+
+      bufpos = CLIENT_BUFPOS (mhsink, mhclient);
+      GST_LOG_OBJECT (sink, "%s client %p at position %d",
+          mhclient->debug, mhclient, bufpos);
+      /* check soft max if needed, recover client */
+      if (soft_max_buffers > 0 && bufpos >= soft_max_buffers) {
+        gint newpos;
+
+        newpos = gst_multi_handle_sink_recover_client (mhsink, mhclient);
+        if (newpos != bufpos) {
+          mhclient->dropped_buffers += bufpos - newpos;
+          bufpos = newpos;
+          CLIENT_SET_BUFPOS (mhsink, mhclient, bufpos);
+          mhclient->discont = TRUE;
+          GST_INFO_OBJECT (sink, "%s client %p position reset to %d",
+              mhclient->debug, mhclient, bufpos);
+        } else {
+          GST_INFO_OBJECT (sink, "%s client %p not recovering position",
+              mhclient->debug, mhclient);
+        }
+      }
+      /* check hard max and timeout, remove client */
+      if ((max_buffers > 0 && bufpos >= max_buffers) ||
+          (mhsink->timeout > 0
+              && now - mhclient->last_activity_time > mhsink->timeout)) {
+        /* remove client */
+        GST_WARNING_OBJECT (sink, "%s client %p is too slow, removing",
+            mhclient->debug, mhclient);
+        /* remove the client, the handle set will be cleared and the select
+         * thread will be signaled */
+        mhclient->status = GST_CLIENT_STATUS_SLOW;
+        /* set client to invalid position while being removed */
+        CLIENT_SET_BUFPOS (mhsink, mhclient, -1);
+        gst_multi_handle_sink_remove_client_link (mhsink, clients);
+        hash_changed = TRUE;
+        continue;
+      } else if (bufpos == 0 || mhclient->new_connection) {
+        /* can send data to this client now. need to signal the select thread
+         * that the handle_set changed */
+        mhsinkclass->hash_adding (mhsink, mhclient);
+        hash_changed = TRUE;
+      }
+      /* keep track of maximum buffer usage */
+      if (bufpos > max_buffer_usage) {
+        max_buffer_usage = bufpos;
       }
     }
-    /* check hard max and timeout, remove client */
-    if ((max_buffers > 0 && mhclient->bufpos >= max_buffers) ||
-        (mhsink->timeout > 0
-            && now - mhclient->last_activity_time > mhsink->timeout)) {
-      /* remove client */
-      GST_WARNING_OBJECT (sink, "%s client %p is too slow, removing",
-          mhclient->debug, mhclient);
-      /* remove the client, the handle set will be cleared and the select thread
-       * will be signaled */
-      mhclient->status = GST_CLIENT_STATUS_SLOW;
-      /* set client to invalid position while being removed */
-      mhclient->bufpos = -1;
-      gst_multi_handle_sink_remove_client_link (mhsink, clients);
-      hash_changed = TRUE;
-      continue;
-    } else if (mhclient->bufpos == 0 || mhclient->new_connection) {
-      /* can send data to this client now. need to signal the select thread that
-       * the handle_set changed */
-      mhsinkclass->hash_adding (mhsink, mhclient);
-      hash_changed = TRUE;
-    }
-    /* keep track of maximum buffer usage */
-    if (mhclient->bufpos > max_buffer_usage) {
-      max_buffer_usage = mhclient->bufpos;
-    }
+    SHARD_UNLOCK (shard);
   }
 
   /* make sure we respect bytes-min, buffers-min and time-min when they are set */
@@ -1807,7 +2246,7 @@ restart:
         "extending queue to include sync point, now at %d, limit is %d",
         max_buffer_usage, limit);
     for (i = 0; i < limit; i++) {
-      buf = g_array_index (mhsink->bufqueue, GstBuffer *, i);
+      buf = BUFQUEUE_BUFFER (mhsink, i);
       if (is_sync_frame (mhsink, buf)) {
         /* found a sync frame, now extend the buffer usage to
          * include at least this frame. */
@@ -1821,19 +2260,14 @@ restart:
   GST_LOG_OBJECT (sink, "len %d, usage %d", queuelen, max_buffer_usage);
 
   /* nobody is referencing units after max_buffer_usage so we can
-   * remove them from the queue. We remove them in reverse order as
-   * this is the most optimal for GArray. */
+   * remove them from the tail of the queue. */
+  CLIENTS_LOCK (mhsink);
   for (i = queuelen - 1; i > max_buffer_usage; i--) {
-    GstBuffer *old;
-
-    /* queue exceeded max size */
+    /* queue exceeded max size, unref tail buffer */
+    gst_buffer_unref (BUFQUEUE_BUFFER (mhsink, i));
     queuelen--;
-    old = g_array_index (mhsink->bufqueue, GstBuffer *, i);
-    mhsink->bufqueue = g_array_remove_index (mhsink->bufqueue, i);
-
-    /* unref tail buffer */
-    gst_buffer_unref (old);
   }
+  mhsink->bufqueue_len = queuelen;
   /* save for stats */
   mhsink->buffers_queued = max_buffer_usage;
   CLIENTS_UNLOCK (sink);
@@ -2007,6 +2441,9 @@ gst_multi_handle_sink_set_property (GObject * object, guint prop_id,
     case PROP_RESEND_STREAMHEADER:
       multihandlesink->resend_streamheader = g_value_get_boolean (value);
       break;
+    case PROP_N_THREADS:
+      multihandlesink->n_threads = g_value_get_uint (value);
+      break;
 
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -2071,6 +2508,9 @@ gst_multi_handle_sink_get_property (GObject * object, guint prop_id,
     case PROP_BYTES_SERVED:
       g_value_set_uint64 (value, multihandlesink->bytes_served);
       break;
+    case PROP_BYTES_SERVED_ZEROCOPY:
+      g_value_set_uint64 (value, multihandlesink->bytes_served_zerocopy);
+      break;
     case PROP_BURST_FORMAT:
       g_value_set_enum (value, multihandlesink->def_burst_format);
       break;
@@ -2087,18 +2527,43 @@ gst_multi_handle_sink_get_property (GObject * object, guint prop_id,
       g_value_set_uint (value,
           g_hash_table_size (multihandlesink->handle_hash));
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, multihandlesink->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+static gpointer
+gst_multi_handle_sink_shard_thread (GstMultiHandleShard * shard)
+{
+  GstMultiHandleSinkClass *mhsclass =
+      GST_MULTI_HANDLE_SINK_GET_CLASS (shard->sink);
+
+  return mhsclass->thread (shard->sink, shard);
+}
+
+static void
+gst_multi_handle_sink_free_shards (GstMultiHandleSink * mhsink)
+{
+  guint i;
+
+  for (i = 0; i < mhsink->n_shards; i++)
+    SHARD_LOCK_CLEAR (&mhsink->shards[i]);
+  g_free (mhsink->shards);
+  mhsink->shards = NULL;
+  mhsink->n_shards = 0;
+}
+
 /* create a socket for sending to remote machine */
 static gboolean
 gst_multi_handle_sink_start (GstBaseSink * bsink)
 {
   GstMultiHandleSinkClass *mhsclass;
   GstMultiHandleSink *mhsink;
+  guint i;
 
   if (GST_OBJECT_FLAG_IS_SET (bsink, GST_MULTI_HANDLE_SINK_OPEN))
     return TRUE;
@@ -2106,12 +2571,27 @@ gst_multi_handle_sink_start (GstBaseSink * bsink)
   mhsink = GST_MULTI_HANDLE_SINK (bsink);
   mhsclass = GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
 
-  if (!mhsclass->start_pre (mhsink))
+  /* the subclass sets up the I/O of each shard in start_pre */
+  mhsink->n_shards = mhsink->n_threads;
+  if (mhsink->n_shards == 0)
+    mhsink->n_shards = g_get_num_processors ();
+  mhsink->shards = g_new0 (GstMultiHandleShard, mhsink->n_shards);
+  for (i = 0; i < mhsink->n_shards; i++) {
+    mhsink->shards[i].sink = mhsink;
+    mhsink->shards[i].index = i;
+    SHARD_LOCK_INIT (&mhsink->shards[i]);
+  }
+  GST_DEBUG_OBJECT (mhsink, "using %u I/O threads", mhsink->n_shards);
+
+  if (!mhsclass->start_pre (mhsink)) {
+    gst_multi_handle_sink_free_shards (mhsink);
     return FALSE;
+  }
 
   mhsink->streamheader = NULL;
   mhsink->bytes_to_serve = 0;
   mhsink->bytes_served = 0;
+  mhsink->bytes_served_zerocopy = 0;
 
   if (mhsclass->init) {
     mhsclass->init (mhsink);
@@ -2119,8 +2599,10 @@ gst_multi_handle_sink_start (GstBaseSink * bsink)
 
   mhsink->running = TRUE;
 
-  mhsink->thread = g_thread_new ("multihandlesink",
-      (GThreadFunc) mhsclass->thread, mhsink);
+  for (i = 0; i < mhsink->n_shards; i++) {
+    mhsink->shards[i].thread = g_thread_new ("multihandlesink",
+        (GThreadFunc) gst_multi_handle_sink_shard_thread, &mhsink->shards[i]);
+  }
 
   GST_OBJECT_FLAG_SET (bsink, GST_MULTI_HANDLE_SINK_OPEN);
 
@@ -2133,6 +2615,7 @@ gst_multi_handle_sink_stop (GstBaseSink * bsink)
   GstMultiHandleSinkClass *mhclass;
   GstBuffer *buf;
   gint i;
+  guint n;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (bsink);
 
   mhclass = GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
@@ -2144,11 +2627,15 @@ gst_multi_handle_sink_stop (GstBaseSink * bsink)
 
   mhclass->stop_pre (mhsink);
 
-  if (mhsink->thread) {
-    GST_DEBUG_OBJECT (mhsink, "joining thread");
-    g_thread_join (mhsink->thread);
-    GST_DEBUG_OBJECT (mhsink, "joined thread");
-    mhsink->thread = NULL;
+  for (n = 0; n < mhsink->n_shards; n++) {
+    GstMultiHandleShard *shard = &mhsink->shards[n];
+
+    if (shard->thread) {
+      GST_DEBUG_OBJECT (mhsink, "joining thread %u", n);
+      g_thread_join (shard->thread);
+      GST_DEBUG_OBJECT (mhsink, "joined thread %u", n);
+      shard->thread = NULL;
+    }
   }
 
   /* free the clients */
@@ -2166,18 +2653,21 @@ gst_multi_handle_sink_stop (GstBaseSink * bsink)
   mhclass->stop_post (mhsink);
 
   /* remove all queued buffers */
-  if (mhsink->bufqueue) {
+  if (mhsink->bufqueue_len) {
     GST_DEBUG_OBJECT (mhsink, "Emptying bufqueue with %d buffers",
-        mhsink->bufqueue->len);
-    for (i = mhsink->bufqueue->len - 1; i >= 0; --i) {
-      buf = g_array_index (mhsink->bufqueue, GstBuffer *, i);
+        mhsink->bufqueue_len);
+    for (i = mhsink->bufqueue_len - 1; i >= 0; --i) {
+      buf = BUFQUEUE_BUFFER (mhsink, i);
       GST_LOG_OBJECT (mhsink, "Removing buffer %p (%d) with refcount %d", buf,
           i, GST_MINI_OBJECT_REFCOUNT (buf));
       gst_buffer_unref (buf);
-      mhsink->bufqueue = g_array_remove_index (mhsink->bufqueue, i);
     }
-    /* freeing the array is done in _finalize */
+    mhsink->bufqueue_len = 0;
+    /* freeing the ring is done in _finalize */
   }
+  /* all clients are gone, they don't refer to the shards anymore */
+  gst_multi_handle_sink_free_shards (mhsink);
+
   GST_OBJECT_FLAG_UNSET (mhsink, GST_MULTI_HANDLE_SINK_OPEN);
 
   return TRUE;
@@ -2189,12 +2679,15 @@ gst_multi_handle_sink_change_state (GstElement * element,
 {
   GstMultiHandleSink *sink;
   GstStateChangeReturn ret;
+  guint i;
 
   sink = GST_MULTI_HANDLE_SINK (element);
 
-  /* we disallow changing the state from the streaming thread */
-  if (g_thread_self () == sink->thread)
-    return GST_STATE_CHANGE_FAILURE;
+  /* we disallow changing the state from the streaming threads */
+  for (i = 0; i < sink->n_shards; i++) {
+    if (g_thread_self () == sink->shards[i].thread)
+      return GST_STATE_CHANGE_FAILURE;
+  }
 
 
   switch (transition) {
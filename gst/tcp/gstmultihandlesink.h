@@ -129,6 +129,8 @@ typedef union
   GSocket *socket;
 } GstMultiSinkHandle;
 
+typedef struct _GstMultiHandleShard GstMultiHandleShard;
+
 /* structure for a client
  */
 typedef struct {
@@ -136,7 +138,8 @@ typedef struct {
 
   gchar debug[30];              /* a debug string used in debug calls to
                                    identify the client */
-  gint bufpos;                  /* position of this client in the global queue */
+  gint64 bufseq;                /* sequence number of the next buffer to send,
+                                   see CLIENT_BUFPOS() */
   gint flushcount;              /* the remaining number of buffers to flush out or -1 if the 
                                    client is not flushing. */
 
@@ -150,6 +153,12 @@ typedef struct {
   gboolean new_connection;
   gboolean currently_removing;
 
+  GstMultiHandleShard *shard;   /* the I/O thread serving this client */
+  GList *link;                  /* link of the client in the shard list */
+  gboolean io_unlocked;         /* doing I/O without the shard lock */
+  gboolean free_pending;        /* removed during unlocked I/O, freed when
+                                   the I/O is done */
+
 
   /* method to sync client when connecting */
   GstSyncMethod sync_method;
@@ -162,6 +171,7 @@ typedef struct {
 
   /* stats */
   guint64 bytes_sent;
+  guint64 bytes_sent_zerocopy;
   guint64 connect_time;
   guint64 disconnect_time;
   guint64 last_activity_time;
@@ -176,6 +186,42 @@ typedef struct {
 #define CLIENTS_LOCK(mhsink)            (g_rec_mutex_lock(&(mhsink)->clientslock))
 #define CLIENTS_UNLOCK(mhsink)          (g_rec_mutex_unlock(&(mhsink)->clientslock))
 
+#define SHARD_LOCK_INIT(shard)          (g_rec_mutex_init(&(shard)->lock))
+#define SHARD_LOCK_CLEAR(shard)         (g_rec_mutex_clear(&(shard)->lock))
+#define SHARD_LOCK(shard)               (g_rec_mutex_lock(&(shard)->lock))
+#define SHARD_UNLOCK(shard)             (g_rec_mutex_unlock(&(shard)->lock))
+
+/* buffers in the queue are addressed by position, 0 being the newest buffer.
+ * Clients store the sequence number of the next buffer they will send so
+ * that their position moves along when buffers are queued. A position of -1
+ * means that the client is waiting for the next buffer. */
+#define BUFQUEUE_BUFFER(mhsink,pos) \
+    ((mhsink)->bufqueue[((mhsink)->bufqueue_seq - 1 - (pos)) & \
+        ((mhsink)->bufqueue_size - 1)])
+#define CLIENT_BUFPOS(mhsink,client) \
+    ((gint) ((mhsink)->bufqueue_seq - 1 - (client)->bufseq))
+#define CLIENT_SET_BUFPOS(mhsink,client,pos) \
+    ((client)->bufseq = (mhsink)->bufqueue_seq - 1 - (pos))
+
+/* an I/O thread and the clients it serves. The clients are assigned to the
+ * least loaded shard when they are added and never move to another shard.
+ *
+ * The shard lock protects the list of clients of the shard and the state of
+ * those clients. The clients lock of the sink protects the buffer queue, the
+ * handle hash and the number of clients of the shards. When both are needed,
+ * the shard lock is taken first. */
+struct _GstMultiHandleShard {
+  GstMultiHandleSink *sink;
+  guint index;          /* index in the shards array of the sink */
+  GThread *thread;
+
+  GRecMutex lock;       /* lock to protect the clients of the shard */
+  GList *clients;       /* the clients served by this thread */
+  guint clients_cookie; /* Cookie to detect changes to the clients list */
+
+  guint n_clients;      /* protected by the clients lock */
+};
+
 gint gst_multi_handle_sink_setup_dscp_client (GstMultiHandleSink * sink, GstMultiHandleClient * client);
 gint
 gst_multi_handle_sink_new_client_position (GstMultiHandleSink * sink,
@@ -192,10 +238,9 @@ struct _GstMultiHandleSink {
   /*< private >*/
   guint64 bytes_to_serve; /* how much bytes we must serve */
   guint64 bytes_served; /* how much bytes have we served */
+  guint64 bytes_served_zerocopy; /* how much of those were not copied */
 
-  GRecMutex clientslock;  /* lock to protect the clients list */
-  GList *clients;       /* list of clients we are serving */
-  guint clients_cookie; /* Cookie to detect changes to the clients list */
+  GRecMutex clientslock;  /* lock to protect the queue and the hash */
 
   GHashTable *handle_hash;  /* index of handle -> GstMultiHandleClient */
 
@@ -207,10 +252,17 @@ struct _GstMultiHandleSink {
 
   gint qos_dscp;
 
-  GArray *bufqueue;     /* global queue of buffers */
+  GstBuffer **bufqueue; /* global queue of buffers, a ring of bufqueue_size
+                           slots indexed by sequence number */
+  guint bufqueue_size;  /* allocated slots, a power of 2 */
+  guint bufqueue_len;   /* number of queued buffers */
+  gint64 bufqueue_seq;  /* sequence number of the next buffer to queue */
 
   gboolean running;     /* the thread state */
-  GThread *thread;      /* the sender thread */
+  guint n_threads;      /* configured number of I/O threads, 0 = auto */
+  GstMultiHandleShard *shards; /* the sender threads */
+  guint n_shards;
+  GstMultiHandleShard *adding_shard; /* shard of the client being added */
 
   /* these values are used to check if a client is reading fast
    * enough and to control receovery */
@@ -247,7 +299,8 @@ struct _GstMultiHandleSinkClass {
   void          (*stop_pre)     (GstMultiHandleSink *sink);
   void          (*stop_post)    (GstMultiHandleSink *sink);
   gboolean      (*start_pre)    (GstMultiHandleSink *sink);
-  gpointer      (*thread)       (GstMultiHandleSink *sink);
+  gpointer      (*thread)       (GstMultiHandleSink *sink,
+                                 GstMultiHandleShard *shard);
   /* called by subclass when it has a new buffer to queue for a client */
   gboolean      (*client_queue_buffer)
                                 (GstMultiHandleSink *sink,
@@ -287,8 +340,19 @@ void          gst_multi_handle_sink_remove_flush (GstMultiHandleSink *sink, GstM
 GstStructure*  gst_multi_handle_sink_get_stats    (GstMultiHandleSink *sink, GstMultiSinkHandle handle);
 void gst_multi_handle_sink_remove_client_link (GstMultiHandleSink * sink,
     GList * link);
-
-void gst_multi_handle_sink_client_init (GstMultiHandleClient * client, GstSyncMethod sync_method);
+GstMultiHandleClient * gst_multi_handle_sink_lock_client (GstMultiHandleSink * sink,
+    GstMultiSinkHandle handle);
+
+void gst_multi_handle_sink_client_init (GstMultiHandleSink * sink, GstMultiHandleClient * client, GstSyncMethod sync_method);
+void gst_multi_handle_sink_client_io_begin (GstMultiHandleSink * sink, GstMultiHandleClient * client);
+gboolean gst_multi_handle_sink_client_io_end (GstMultiHandleSink * sink, GstMultiHandleClient * client);
+GstBuffer * gst_multi_handle_sink_client_take_buffer (GstMultiHandleSink * sink, GstMultiHandleClient * client);
+GstBuffer * gst_multi_handle_sink_client_peek_buffer (GstMultiHandleSink * sink, GstMultiHandleClient * client, gint n);
+void gst_multi_handle_sink_client_commit_peeked (GstMultiHandleSink * sink, GstMultiHandleClient * client,
+    GstBuffer ** peeked, guint n_peeked, gsize wrote);
+
+GstMemory * gst_multi_handle_sink_find_zerocopy_memory (GstBuffer * buf, gsize offset, gsize * skip, guint * idx, guint * n_copy);
+gssize gst_multi_handle_sink_send_memory (int fd, GstMemory * mem, gsize skip);
 
 #define GST_TYPE_RECOVER_POLICY (gst_multi_handle_sink_recover_policy_get_type())
 GType gst_multi_handle_sink_recover_policy_get_type (void);
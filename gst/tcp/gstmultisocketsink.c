@@ -106,6 +106,8 @@
 #include <gst/net/gstnetcontrolmessagemeta.h>
 
 #include <string.h>
+#include <limits.h>
+#include <errno.h>
 
 #include "gstmultisocketsink.h"
 
@@ -169,7 +171,8 @@ static void gst_multi_socket_sink_emit_client_removed (GstMultiHandleSink * mhs,
 static void gst_multi_socket_sink_stop_pre (GstMultiHandleSink * mhsink);
 static void gst_multi_socket_sink_stop_post (GstMultiHandleSink * mhsink);
 static gboolean gst_multi_socket_sink_start_pre (GstMultiHandleSink * mhsink);
-static gpointer gst_multi_socket_sink_thread (GstMultiHandleSink * mhsink);
+static gpointer gst_multi_socket_sink_thread (GstMultiHandleSink * mhsink,
+    GstMultiHandleShard * shard);
 static GstMultiHandleClient
     * gst_multi_socket_sink_new_client (GstMultiHandleSink * mhsink,
     GstMultiSinkHandle handle, GstSyncMethod sync_method);
@@ -551,7 +554,7 @@ gst_multi_socket_sink_new_client (GstMultiHandleSink * mhsink,
 
   mhclient->handle.socket = G_SOCKET (g_object_ref (handle.socket));
 
-  gst_multi_handle_sink_client_init (mhclient, sync_method);
+  gst_multi_handle_sink_client_init (mhsink, mhclient, sync_method);
   mhsinkclass->handle_debug (handle, mhclient->debug);
 
   /* set the socket to non blocking */
@@ -770,21 +773,62 @@ gst_buffer_get_cmsg_list (GstBuffer * buf, GSocketControlMessage ** msgs,
 
 #define CMSG_MAX 255
 
+/* the maximum number of memories and bytes of the queued buffers that are
+ * gathered in one write */
+#if defined (IOV_MAX) && IOV_MAX < 64
+#define MAX_WRITE_VECTORS IOV_MAX
+#else
+#define MAX_WRITE_VECTORS 64
+#endif
+#define MAX_WRITE_BYTES (128 * 1024)
+
+/* writes @buffers with one call, starting at @bufoffset in the first buffer.
+ * The control messages of the first buffer are sent along. When the data
+ * starts with fd backed memory, only that memory is written, without copying
+ * it, and @zerocopy is set to TRUE. */
 static gssize
 gst_multi_socket_sink_write (GstMultiSocketSink * sink,
-    GSocket * sock, GstBuffer * buffer, gsize bufoffset,
-    GCancellable * cancellable, GError ** err)
+    GSocket * sock, GstBuffer ** buffers, guint n_buffers, gsize bufoffset,
+    gboolean * zerocopy, GCancellable * cancellable, GError ** err)
 {
-  GstMapInfo maps[8];
-  GOutputVector vec[8];
-  guint mems_mapped;
+  GstMapInfo maps[MAX_WRITE_VECTORS];
+  GOutputVector vec[MAX_WRITE_VECTORS];
+  guint mems_mapped, i, idx, n_copy;
   gssize wrote;
   GSocketControlMessage *cmsgs[CMSG_MAX];
-  gsize msg_count;
-
-  mems_mapped = map_n_memory_output_vector (buffer, bufoffset, vec, maps, 8);
+  gsize msg_count, skip;
+  GstMemory *mem;
+
+  *zerocopy = FALSE;
+  msg_count = gst_buffer_get_cmsg_list (buffers[0], cmsgs, CMSG_MAX);
+
+  mem = gst_multi_handle_sink_find_zerocopy_memory (buffers[0], bufoffset,
+      &skip, &idx, &n_copy);
+  if (mem != NULL && msg_count == 0) {
+    wrote = gst_multi_handle_sink_send_memory (g_socket_get_fd (sock), mem,
+        skip);
+    if (wrote >= 0) {
+      *zerocopy = TRUE;
+      return wrote;
+    } else if (errno != EINVAL && errno != ENOSYS) {
+      gint errsv = errno;
+
+      g_set_error (err, G_IO_ERROR, g_io_error_from_errno (errsv),
+          "Error sending data: %s", g_strerror (errsv));
+      return -1;
+    }
+    GST_LOG_OBJECT (sink, "copying memory %p, can't send it directly: %s",
+        mem, g_strerror (errno));
+  }
 
-  msg_count = gst_buffer_get_cmsg_list (buffer, cmsgs, CMSG_MAX);
+  /* copy up to the next memory that can be sent directly */
+  mems_mapped = map_n_memory_output_vector (buffers[0], bufoffset, vec, maps,
+      MIN (n_copy, MAX_WRITE_VECTORS));
+  for (i = 1; i < n_buffers && mems_mapped < MAX_WRITE_VECTORS; i++) {
+    mems_mapped += map_n_memory_output_vector (buffers[i], 0,
+        vec + mems_mapped, maps + mems_mapped,
+        MAX_WRITE_VECTORS - mems_mapped);
+  }
 
   wrote =
       g_socket_send_message (sock, NULL, vec, mems_mapped, cmsgs, msg_count, 0,
@@ -793,6 +837,111 @@ gst_multi_socket_sink_write (GstMultiSocketSink * sink,
   return wrote;
 }
 
+static void
+unref_buffers (GstBuffer ** buffers, guint n_buffers)
+{
+  guint i;
+
+  for (i = 0; i < n_buffers; i++)
+    gst_buffer_unref (buffers[i]);
+}
+
+/* take the next buffer from the queue and add it to the sending queue of
+ * the client */
+static void
+gst_multi_socket_sink_client_pick_buffer (GstMultiSocketSink * sink,
+    GstSocketClient * client)
+{
+  GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
+  GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
+  GstMultiHandleSinkClass *mhsinkclass =
+      GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
+  GstBuffer *buf;
+
+  buf = gst_multi_handle_sink_client_take_buffer (mhsink, mhclient);
+
+  /* queueing a buffer will ref it */
+  mhsinkclass->client_queue_buffer (mhsink, mhclient, buf);
+}
+
+/* Collect the buffers for one write, starting with the buffer the client is
+ * working on. A client that is behind gets more buffers from the queue so
+ * that it can catch up with fewer calls. Those are only peeked at, they are
+ * taken from the queue once they are written, see
+ * gst_multi_handle_sink_client_commit_peeked(). @n_sending is set to the
+ * number of buffers from the sending queue, the others were peeked. Buffers
+ * with fd backed memory are written on their own so that the memory can be
+ * sent without copying. The buffers are reffed, they need to stay alive
+ * while we write without the lock. */
+static guint
+gst_multi_socket_sink_client_gather (GstMultiSocketSink * sink,
+    GstSocketClient * client, GstBuffer ** buffers, guint * n_sending)
+{
+  GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
+  GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
+  GSocketControlMessage *cmsg;
+  GSList *walk;
+  guint n_buffers, n_vectors, idx, n_copy;
+  gsize bytes, offset, skip;
+
+  walk = mhclient->sending;
+  n_buffers = n_vectors = bytes = 0;
+  *n_sending = 0;
+
+  while (n_buffers < MAX_WRITE_VECTORS && n_vectors < MAX_WRITE_VECTORS
+      && bytes < MAX_WRITE_BYTES) {
+    GstBuffer *buf;
+    guint n_mem;
+    gsize size;
+
+    if (walk != NULL) {
+      buf = GST_BUFFER_CAST (walk->data);
+    } else {
+      /* nothing left in the sending queue, see if there are more buffers
+       * for the client in the queue */
+      buf = gst_multi_handle_sink_client_peek_buffer (mhsink, mhclient,
+          n_buffers - *n_sending);
+      if (buf == NULL)
+        break;
+    }
+
+    n_mem = gst_buffer_n_memory (buf);
+    size = gst_buffer_get_size (buf);
+    offset = n_buffers == 0 ? mhclient->bufoffset : 0;
+
+    if (n_buffers == 0) {
+      /* the first buffer is always written, as far as it fits */
+      size -= offset;
+      n_mem = MIN (n_mem, MAX_WRITE_VECTORS);
+    } else if (size == 0 || n_vectors + n_mem > MAX_WRITE_VECTORS
+        || gst_buffer_get_cmsg_list (buf, &cmsg, 1) > 0) {
+      /* control messages go with the first byte of a write */
+      break;
+    }
+
+    if (gst_multi_handle_sink_find_zerocopy_memory (buf, offset, &skip,
+            &idx, &n_copy) != NULL || n_copy != G_MAXUINT) {
+      /* fd backed memory is written on its own */
+      if (n_buffers == 0) {
+        buffers[n_buffers++] = gst_buffer_ref (buf);
+        *n_sending = 1;
+      }
+      break;
+    }
+
+    buffers[n_buffers++] = gst_buffer_ref (buf);
+    n_vectors += n_mem;
+    bytes += size;
+
+    if (walk != NULL) {
+      walk = walk->next;
+      *n_sending = n_buffers;
+    }
+  }
+
+  return n_buffers;
+}
+
 /* Handle a write on a client,
  * which indicates a read request from a client.
  *
@@ -813,7 +962,13 @@ gst_multi_socket_sink_write (GstMultiSocketSink * sink,
  * When the sending returns a partial buffer we stop sending more data as
  * the next send operation could block.
  *
- * This functions returns FALSE if some error occured.
+ * Called with the shard lock and the clients lock, they are released while
+ * writing so that the other I/O threads and the streaming thread are not
+ * blocked by the socket calls.
+ *
+ * This functions returns FALSE if some error occured. When the client was
+ * removed while writing, TRUE is returned and the client must not be used
+ * anymore.
  */
 static gboolean
 gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
@@ -826,8 +981,6 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
   GError *err = NULL;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
   GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
-  GstMultiHandleSinkClass *mhsinkclass =
-      GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
 
 
   g_get_current_time (&nowtv);
@@ -839,7 +992,7 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
   do {
     if (!mhclient->sending) {
       /* client is not working on a buffer */
-      if (mhclient->bufpos == -1) {
+      if (CLIENT_BUFPOS (mhsink, mhclient) == -1) {
         /* client is too fast, remove from write queue until new buffer is
          * available */
         gst_multi_socket_sink_stop_sending (sink, client);
@@ -851,8 +1004,6 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
         return TRUE;
       } else {
         /* client can pick a buffer from the global queue */
-        GstBuffer *buf;
-        GstClockTime timestamp;
 
         /* for new connections, we need to find a good spot in the
          * bufqueue to start streaming from */
@@ -863,7 +1014,7 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
           if (position >= 0) {
             /* we got a valid spot in the queue */
             mhclient->new_connection = FALSE;
-            mhclient->bufpos = position;
+            CLIENT_SET_BUFPOS (mhsink, mhclient, position);
           } else {
             /* cannot send data to this client yet */
             gst_multi_socket_sink_stop_sending (sink, client);
@@ -875,26 +1026,7 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
         if (mhclient->flushcount == 0)
           goto flushed;
 
-        /* grab buffer */
-        buf = g_array_index (mhsink->bufqueue, GstBuffer *, mhclient->bufpos);
-        mhclient->bufpos--;
-
-        /* update stats */
-        timestamp = GST_BUFFER_TIMESTAMP (buf);
-        if (mhclient->first_buffer_ts == GST_CLOCK_TIME_NONE)
-          mhclient->first_buffer_ts = timestamp;
-        if (timestamp != -1)
-          mhclient->last_buffer_ts = timestamp;
-
-        /* decrease flushcount */
-        if (mhclient->flushcount != -1)
-          mhclient->flushcount--;
-
-        GST_LOG_OBJECT (sink, "%s client %p at position %d",
-            mhclient->debug, client, mhclient->bufpos);
-
-        /* queueing a buffer will ref it */
-        mhsinkclass->client_queue_buffer (mhsink, mhclient, buf);
+        gst_multi_socket_sink_client_pick_buffer (sink, client);
 
         /* need to start from the first byte for this new buffer */
         mhclient->bufoffset = 0;
@@ -904,13 +1036,34 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
     /* see if we need to send something */
     if (mhclient->sending) {
       gssize wrote;
-      GstBuffer *head;
-
-      /* pick first buffer from list */
-      head = GST_BUFFER (mhclient->sending->data);
+      gsize bufoffset;
+      GSocket *socket;
+      GstBuffer *buffers[MAX_WRITE_VECTORS];
+      guint n_buffers, n_sending;
+      gboolean zerocopy;
+
+      /* pick the first buffer from the list and the ones that can be
+       * written along with it */
+      n_buffers = gst_multi_socket_sink_client_gather (sink, client, buffers,
+          &n_sending);
+      bufoffset = mhclient->bufoffset;
+      socket = mhclient->handle.socket;
+
+      gst_multi_handle_sink_client_io_begin (mhsink, mhclient);
+      wrote = gst_multi_socket_sink_write (sink, socket, buffers, n_buffers,
+          bufoffset, &zerocopy, sink->cancellable, &err);
+      if (!gst_multi_handle_sink_client_io_end (mhsink, mhclient)) {
+        GST_LOG_OBJECT (sink, "client %p was removed while writing", client);
+        unref_buffers (buffers, n_buffers);
+        g_clear_error (&err);
+        return TRUE;
+      }
 
-      wrote = gst_multi_socket_sink_write (sink, mhclient->handle.socket, head,
-          mhclient->bufoffset, sink->cancellable, &err);
+      /* the peeked buffers that were written are taken from the queue */
+      if (wrote > 0)
+        gst_multi_handle_sink_client_commit_peeked (mhsink, mhclient,
+            buffers + n_sending, n_buffers - n_sending, wrote);
+      unref_buffers (buffers, n_buffers);
 
       if (wrote < 0) {
         /* hmm error.. */
@@ -926,13 +1079,24 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
           goto write_error;
         }
       } else {
-        if (wrote < (gst_buffer_get_size (head) - mhclient->bufoffset)) {
-          /* partial write, try again now */
-          GST_LOG_OBJECT (sink,
-              "partial write on %p of %" G_GSSIZE_FORMAT " bytes",
-              mhclient->handle.socket, wrote);
-          mhclient->bufoffset += wrote;
-        } else {
+        gsize left = wrote;
+
+        GST_LOG_OBJECT (sink, "wrote %" G_GSSIZE_FORMAT " bytes of %u "
+            "buffers on %p%s", wrote, n_buffers, mhclient->handle.socket,
+            zerocopy ? " without copying" : "");
+
+        /* drop the buffers that were written completely */
+        while (mhclient->sending) {
+          GstBuffer *head = GST_BUFFER (mhclient->sending->data);
+          gsize size = gst_buffer_get_size (head) - mhclient->bufoffset;
+
+          if (left < size) {
+            /* partial write, try again now */
+            mhclient->bufoffset += left;
+            break;
+          }
+          left -= size;
+
           if (sink->send_dispatched) {
             gst_pad_push_event (GST_BASE_SINK_PAD (mhsink),
                 gst_event_new_custom (GST_EVENT_CUSTOM_UPSTREAM,
@@ -950,6 +1114,10 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
         mhclient->bytes_sent += wrote;
         mhclient->last_activity_time = now;
         mhsink->bytes_served += wrote;
+        if (zerocopy) {
+          mhclient->bytes_sent_zerocopy += wrote;
+          mhsink->bytes_served_zerocopy += wrote;
+        }
       }
     }
   } while (more);
@@ -995,13 +1163,14 @@ ensure_condition (GstMultiSocketSink * sink, GstSocketClient * client,
     g_source_destroy (client->source);
     g_source_unref (client->source);
   }
-  if (condition && sink->main_context) {
+  if (condition && sink->contexts) {
     client->source = g_socket_create_source (mhclient->handle.socket,
         condition, sink->cancellable);
     g_source_set_callback (client->source,
         (GSourceFunc) gst_multi_socket_sink_socket_condition,
         gst_object_ref (sink), (GDestroyNotify) gst_object_unref);
-    g_source_attach (client->source, sink->main_context);
+    /* dispatched by the I/O thread of the client */
+    g_source_attach (client->source, sink->contexts[mhclient->shard->index]);
   } else {
     client->source = NULL;
     condition = 0;
@@ -1049,20 +1218,16 @@ gst_multi_socket_sink_socket_condition (GstMultiSinkHandle handle,
   GstSocketClient *client;
   gboolean ret = TRUE;
   GstMultiHandleClient *mhclient;
+  GstMultiHandleShard *shard;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
-  GstMultiHandleSinkClass *mhsinkclass =
-      GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
 
-  CLIENTS_LOCK (mhsink);
-  clink = g_hash_table_lookup (mhsink->handle_hash,
-      mhsinkclass->handle_hash_key (handle));
-  if (clink == NULL) {
-    ret = FALSE;
-    goto done;
-  }
+  mhclient = gst_multi_handle_sink_lock_client (mhsink, handle);
+  if (mhclient == NULL)
+    return FALSE;
 
-  client = clink->data;
-  mhclient = (GstMultiHandleClient *) client;
+  client = (GstSocketClient *) mhclient;
+  clink = mhclient->link;
+  shard = mhclient->shard;
 
   if (mhclient->status != GST_CLIENT_STATUS_FLUSHING
       && mhclient->status != GST_CLIENT_STATUS_OK) {
@@ -1092,8 +1257,13 @@ gst_multi_socket_sink_socket_condition (GstMultiSinkHandle handle,
     }
   }
   if ((condition & G_IO_OUT)) {
-    /* handle client write */
-    if (!gst_multi_socket_sink_handle_client_write (sink, client)) {
+    gboolean ok;
+
+    /* handle client write, it needs the queue */
+    CLIENTS_LOCK (mhsink);
+    ok = gst_multi_socket_sink_handle_client_write (sink, client);
+    CLIENTS_UNLOCK (mhsink);
+    if (!ok) {
       gst_multi_handle_sink_remove_client_link (mhsink, clink);
       ret = FALSE;
       goto done;
@@ -1101,7 +1271,7 @@ gst_multi_socket_sink_socket_condition (GstMultiSinkHandle handle,
   }
 
 done:
-  CLIENTS_UNLOCK (mhsink);
+  SHARD_UNLOCK (shard);
 
   return ret;
 }
@@ -1111,53 +1281,68 @@ gst_multi_socket_sink_timeout (GstMultiSocketSink * sink)
 {
   GstClockTime now;
   GTimeVal nowtv;
-  GList *clients;
+  GList *clients, *next;
+  guint cookie, i;
   GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
 
   g_get_current_time (&nowtv);
   now = GST_TIMEVAL_TO_TIME (nowtv);
 
-  CLIENTS_LOCK (mhsink);
-  for (clients = mhsink->clients; clients; clients = clients->next) {
-    GstSocketClient *client;
-    GstMultiHandleClient *mhclient;
-
-    client = clients->data;
-    mhclient = (GstMultiHandleClient *) client;
-    if (mhsink->timeout > 0
-        && now - mhclient->last_activity_time > mhsink->timeout) {
-      mhclient->status = GST_CLIENT_STATUS_SLOW;
-      gst_multi_handle_sink_remove_client_link (mhsink, clients);
+  for (i = 0; i < mhsink->n_shards; i++) {
+    GstMultiHandleShard *shard = &mhsink->shards[i];
+
+    SHARD_LOCK (shard);
+  restart:
+    cookie = shard->clients_cookie;
+    for (clients = shard->clients; clients; clients = next) {
+      GstSocketClient *client;
+      GstMultiHandleClient *mhclient;
+
+      if (cookie != shard->clients_cookie)
+        goto restart;
+
+      client = clients->data;
+      mhclient = (GstMultiHandleClient *) client;
+      next = g_list_next (clients);
+      if (mhsink->timeout > 0
+          && now - mhclient->last_activity_time > mhsink->timeout) {
+        mhclient->status = GST_CLIENT_STATUS_SLOW;
+        gst_multi_handle_sink_remove_client_link (mhsink, clients);
+      }
     }
+    SHARD_UNLOCK (shard);
   }
-  CLIENTS_UNLOCK (mhsink);
 
   return FALSE;
 }
 
-/* we handle the client communication in another thread so that we do not block
- * the gstreamer thread while we select() on the client fds */
+/* we handle the client communication in other threads so that we do not block
+ * the gstreamer thread while we select() on the client fds. Each thread
+ * iterates its own context with the sources of its clients, the first one
+ * also checks the timeouts of all clients. */
 static gpointer
-gst_multi_socket_sink_thread (GstMultiHandleSink * mhsink)
+gst_multi_socket_sink_thread (GstMultiHandleSink * mhsink,
+    GstMultiHandleShard * shard)
 {
   GstMultiSocketSink *sink = GST_MULTI_SOCKET_SINK (mhsink);
+  GMainContext *context = sink->contexts[shard->index];
   GSource *timeout = NULL;
 
   while (mhsink->running) {
-    if (mhsink->timeout > 0) {
+    if (mhsink->timeout > 0 && shard->index == 0) {
       timeout = g_timeout_source_new (mhsink->timeout / GST_MSECOND);
 
       g_source_set_callback (timeout,
           (GSourceFunc) gst_multi_socket_sink_timeout, gst_object_ref (sink),
           (GDestroyNotify) gst_object_unref);
-      g_source_attach (timeout, sink->main_context);
+      g_source_attach (timeout, context);
     }
 
     /* Returns after handling all pending events or when
      * _wakeup() was called. In any case we have to add
      * a new timeout because something happened.
      */
-    g_main_context_iteration (sink->main_context, TRUE);
+    g_main_context_iteration (context, TRUE);
 
     if (timeout) {
       g_source_destroy (timeout);
@@ -1213,21 +1398,29 @@ gst_multi_socket_sink_start_pre (GstMultiHandleSink * mhsink)
   GstMultiHandleSinkClass *mhsinkclass =
       GST_MULTI_HANDLE_SINK_GET_CLASS (mhsink);
   GList *clients;
+  guint i;
 
   GST_INFO_OBJECT (mssink, "starting");
 
-  mssink->main_context = g_main_context_new ();
+  mssink->contexts = g_new (GMainContext *, mhsink->n_shards);
+  for (i = 0; i < mhsink->n_shards; i++)
+    mssink->contexts[i] = g_main_context_new ();
+  mssink->main_context = mssink->contexts[0];
+
+  for (i = 0; i < mhsink->n_shards; i++) {
+    GstMultiHandleShard *shard = &mhsink->shards[i];
 
-  CLIENTS_LOCK (mhsink);
-  for (clients = mhsink->clients; clients; clients = clients->next) {
-    GstSocketClient *client = clients->data;
-    GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
+    SHARD_LOCK (shard);
+    for (clients = shard->clients; clients; clients = clients->next) {
+      GstSocketClient *client = clients->data;
+      GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
 
-    if (client->source)
-      continue;
-    mhsinkclass->hash_adding (mhsink, mhclient);
+      if (client->source)
+        continue;
+      mhsinkclass->hash_adding (mhsink, mhclient);
+    }
+    SHARD_UNLOCK (shard);
   }
-  CLIENTS_UNLOCK (mhsink);
 
   return TRUE;
 }
@@ -1238,22 +1431,38 @@ multisocketsink_hash_remove (gpointer key, gpointer value, gpointer data)
   return TRUE;
 }
 
+static void
+gst_multi_socket_sink_wakeup (GstMultiSocketSink * sink)
+{
+  GstMultiHandleSink *mhsink = GST_MULTI_HANDLE_SINK (sink);
+  guint i;
+
+  if (sink->contexts == NULL)
+    return;
+
+  for (i = 0; i < mhsink->n_shards; i++)
+    g_main_context_wakeup (sink->contexts[i]);
+}
+
 static void
 gst_multi_socket_sink_stop_pre (GstMultiHandleSink * mhsink)
 {
   GstMultiSocketSink *mssink = GST_MULTI_SOCKET_SINK (mhsink);
 
-  if (mssink->main_context)
-    g_main_context_wakeup (mssink->main_context);
+  gst_multi_socket_sink_wakeup (mssink);
 }
 
 static void
 gst_multi_socket_sink_stop_post (GstMultiHandleSink * mhsink)
 {
   GstMultiSocketSink *mssink = GST_MULTI_SOCKET_SINK (mhsink);
+  guint i;
 
-  if (mssink->main_context) {
-    g_main_context_unref (mssink->main_context);
+  if (mssink->contexts) {
+    for (i = 0; i < mhsink->n_shards; i++)
+      g_main_context_unref (mssink->contexts[i]);
+    g_free (mssink->contexts);
+    mssink->contexts = NULL;
     mssink->main_context = NULL;
   }
 
@@ -1270,8 +1479,7 @@ gst_multi_socket_sink_unlock (GstBaseSink * bsink)
 
   GST_DEBUG_OBJECT (sink, "set to flushing");
   g_cancellable_cancel (sink->cancellable);
-  if (sink->main_context)
-    g_main_context_wakeup (sink->main_context);
+  gst_multi_socket_sink_wakeup (sink);
 
   return TRUE;
 }
@@ -66,7 +66,8 @@ struct _GstMultiSocketSink {
   GstMultiHandleSink element;
 
   /*< private >*/
-  GMainContext *main_context;
+  GMainContext **contexts;      /* one context for each I/O thread */
+  GMainContext *main_context;   /* the context of the first I/O thread */
   GCancellable *cancellable;
   gboolean send_messages;
   gboolean send_dispatched;
@@ -67,6 +67,8 @@ G_DEFINE_TYPE (GstVideoConvert, gst_video_convert, GST_TYPE_VIDEO_FILTER);
 #define DEFAULT_PROP_MATRIX_MODE GST_VIDEO_MATRIX_MODE_FULL
 #define DEFAULT_PROP_GAMMA_MODE GST_VIDEO_GAMMA_MODE_NONE
 #define DEFAULT_PROP_PRIMARIES_MODE GST_VIDEO_PRIMARIES_MODE_NONE
+#define DEFAULT_PROP_N_THREADS 1
+#define DEFAULT_PROP_STATS_INTERVAL 0
 
 enum
 {
@@ -79,7 +81,9 @@ enum
   PROP_CHROMA_MODE,
   PROP_MATRIX_MODE,
   PROP_GAMMA_MODE,
-  PROP_PRIMARIES_MODE
+  PROP_PRIMARIES_MODE,
+  PROP_N_THREADS,
+  PROP_STATS_INTERVAL
 };
 
 #define CSP_VIDEO_CAPS GST_VIDEO_CAPS_MAKE (GST_VIDEO_FORMATS_ALL) ";" \
@@ -464,7 +468,10 @@ gst_video_convert_set_info (GstVideoFilter * filter,
           GST_VIDEO_CONVERTER_OPT_GAMMA_MODE,
           GST_TYPE_VIDEO_GAMMA_MODE, space->gamma_mode,
           GST_VIDEO_CONVERTER_OPT_PRIMARIES_MODE,
-          GST_TYPE_VIDEO_PRIMARIES_MODE, space->primaries_mode, NULL));
+          GST_TYPE_VIDEO_PRIMARIES_MODE, space->primaries_mode,
+          GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT,
+          space->n_threads, GST_VIDEO_CONVERTER_OPT_STATS, G_TYPE_BOOLEAN,
+          space->stats_interval > 0, NULL));
   if (space->convert == NULL)
     goto no_convert;
 
@@ -576,6 +583,17 @@ gst_video_convert_class_init (GstVideoConvertClass * klass)
           "Primaries Conversion Mode", gst_video_primaries_mode_get_type (),
           DEFAULT_PROP_PRIMARIES_MODE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = number of processors)", 0,
+          G_MAXUINT, DEFAULT_PROP_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+      g_param_spec_uint ("stats-interval", "Stats Interval",
+          "Post an element message with the time spent in each conversion "
+          "stage every this many frames (0 = disabled)", 0, G_MAXUINT,
+          DEFAULT_PROP_STATS_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -590,6 +608,8 @@ gst_video_convert_init (GstVideoConvert * space)
   space->matrix_mode = DEFAULT_PROP_MATRIX_MODE;
   space->gamma_mode = DEFAULT_PROP_GAMMA_MODE;
   space->primaries_mode = DEFAULT_PROP_PRIMARIES_MODE;
+  space->n_threads = DEFAULT_PROP_N_THREADS;
+  space->stats_interval = DEFAULT_PROP_STATS_INTERVAL;
 }
 
 void
@@ -628,6 +648,12 @@ gst_video_convert_set_property (GObject * object, guint property_id,
     case PROP_DITHER_QUANTIZATION:
       csp->dither_quantization = g_value_get_uint (value);
       break;
+    case PROP_N_THREADS:
+      csp->n_threads = g_value_get_uint (value);
+      break;
+    case PROP_STATS_INTERVAL:
+      csp->stats_interval = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -670,12 +696,45 @@ gst_video_convert_get_property (GObject * object, guint property_id,
     case PROP_DITHER_QUANTIZATION:
       g_value_set_uint (value, csp->dither_quantization);
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, csp->n_threads);
+      break;
+    case PROP_STATS_INTERVAL:
+      g_value_set_uint (value, csp->stats_interval);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
   }
 }
 
+static void
+gst_video_convert_post_stats (GstVideoConvert * space)
+{
+  GstVideoFilter *filter = GST_VIDEO_FILTER_CAST (space);
+  GstStructure *stats;
+  guint64 frames;
+
+  /* NULL when the converter was made before stats were enabled */
+  stats = gst_video_converter_get_stats (space->convert);
+  if (stats == NULL)
+    return;
+
+  if (!gst_structure_get_uint64 (stats, "frames", &frames) ||
+      frames % space->stats_interval != 0) {
+    gst_structure_free (stats);
+    return;
+  }
+
+  gst_structure_set (stats,
+      "in-format", G_TYPE_STRING, GST_VIDEO_INFO_NAME (&filter->in_info),
+      "out-format", G_TYPE_STRING, GST_VIDEO_INFO_NAME (&filter->out_info),
+      NULL);
+
+  gst_element_post_message (GST_ELEMENT_CAST (space),
+      gst_message_new_element (GST_OBJECT_CAST (space), stats));
+}
+
 static GstFlowReturn
 gst_video_convert_transform_frame (GstVideoFilter * filter,
     GstVideoFrame * in_frame, GstVideoFrame * out_frame)
@@ -691,6 +750,9 @@ gst_video_convert_transform_frame (GstVideoFilter * filter,
 
   gst_video_converter_frame (space->convert, in_frame, out_frame);
 
+  if (space->stats_interval > 0)
+    gst_video_convert_post_stats (space);
+
   return GST_FLOW_OK;
 }
 
@@ -56,6 +56,8 @@ struct _GstVideoConvert {
   GstVideoGammaMode gamma_mode;
   GstVideoPrimariesMode primaries_mode;
   gdouble alpha_value;
+  guint n_threads;
+  guint stats_interval;
 };
 
 struct _GstVideoConvertClass
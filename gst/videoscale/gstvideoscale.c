@@ -77,6 +77,7 @@
 #include <gst/video/gstvideopool.h>
 
 #include "gstvideoscale.h"
+#include "gstvideoscaleladder.h"
 
 #define GST_CAT_DEFAULT video_scale_debug
 GST_DEBUG_CATEGORY_STATIC (video_scale_debug);
@@ -90,6 +91,7 @@ GST_DEBUG_CATEGORY_EXTERN (GST_CAT_PERFORMANCE);
 #define DEFAULT_PROP_SUBMETHOD    1
 #define DEFAULT_PROP_ENVELOPE     2.0
 #define DEFAULT_PROP_GAMMA_DECODE FALSE
+#define DEFAULT_PROP_N_THREADS    1
 
 enum
 {
@@ -102,6 +104,7 @@ enum
   PROP_SUBMETHOD,
   PROP_ENVELOPE,
   PROP_GAMMA_DECODE,
+  PROP_N_THREADS,
 };
 
 #undef GST_VIDEO_SIZE_RANGE
@@ -187,6 +190,14 @@ static GstCaps *gst_video_scale_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter);
 static GstCaps *gst_video_scale_fixate_caps (GstBaseTransform * base,
     GstPadDirection direction, GstCaps * caps, GstCaps * othercaps);
+static gboolean gst_video_scale_propose_allocation (GstBaseTransform * trans,
+    GstQuery * decide_query, GstQuery * query);
+static gboolean gst_video_scale_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query);
+static GstFlowReturn gst_video_scale_prepare_output_buffer (GstBaseTransform *
+    trans, GstBuffer * inbuf, GstBuffer ** outbuf);
+static GstFlowReturn gst_video_scale_transform (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer * outbuf);
 
 static gboolean gst_video_scale_set_info (GstVideoFilter * filter,
     GstCaps * in, GstVideoInfo * in_info, GstCaps * out,
@@ -260,6 +271,11 @@ gst_video_scale_class_init (GstVideoScaleClass * klass)
           "Decode gamma before scaling", DEFAULT_PROP_GAMMA_DECODE,
           G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use (0 = number of processors)", 0,
+          G_MAXUINT, DEFAULT_PROP_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_set_static_metadata (element_class,
       "Video scaler", "Filter/Converter/Video/Scaler",
@@ -274,6 +290,13 @@ gst_video_scale_class_init (GstVideoScaleClass * klass)
       GST_DEBUG_FUNCPTR (gst_video_scale_transform_caps);
   trans_class->fixate_caps = GST_DEBUG_FUNCPTR (gst_video_scale_fixate_caps);
   trans_class->src_event = GST_DEBUG_FUNCPTR (gst_video_scale_src_event);
+  trans_class->propose_allocation =
+      GST_DEBUG_FUNCPTR (gst_video_scale_propose_allocation);
+  trans_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_video_scale_decide_allocation);
+  trans_class->prepare_output_buffer =
+      GST_DEBUG_FUNCPTR (gst_video_scale_prepare_output_buffer);
+  trans_class->transform = GST_DEBUG_FUNCPTR (gst_video_scale_transform);
 
   filter_class->set_info = GST_DEBUG_FUNCPTR (gst_video_scale_set_info);
   filter_class->transform_frame =
@@ -291,6 +314,7 @@ gst_video_scale_init (GstVideoScale * videoscale)
   videoscale->dither = DEFAULT_PROP_DITHER;
   videoscale->envelope = DEFAULT_PROP_ENVELOPE;
   videoscale->gamma_decode = DEFAULT_PROP_GAMMA_DECODE;
+  videoscale->n_threads = DEFAULT_PROP_N_THREADS;
 }
 
 static void
@@ -298,6 +322,10 @@ gst_video_scale_finalize (GstVideoScale * videoscale)
 {
   if (videoscale->convert)
     gst_video_converter_free (videoscale->convert);
+  if (videoscale->crop_convert)
+    gst_video_converter_free (videoscale->crop_convert);
+  if (videoscale->options)
+    gst_structure_free (videoscale->options);
 
   G_OBJECT_CLASS (parent_class)->finalize (G_OBJECT (videoscale));
 }
@@ -350,6 +378,11 @@ gst_video_scale_set_property (GObject * object, guint prop_id,
       vscale->gamma_decode = g_value_get_boolean (value);
       GST_OBJECT_UNLOCK (vscale);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (vscale);
+      vscale->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (vscale);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -403,6 +436,11 @@ gst_video_scale_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_boolean (value, vscale->gamma_decode);
       GST_OBJECT_UNLOCK (vscale);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (vscale);
+      g_value_set_uint (value, vscale->n_threads);
+      GST_OBJECT_UNLOCK (vscale);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -467,16 +505,17 @@ gst_video_scale_transform_caps (GstBaseTransform * trans,
   return ret;
 }
 
-static gboolean
-gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
-    GstVideoInfo * in_info, GstCaps * out, GstVideoInfo * out_info)
+/* the borders needed to show a @in_w x @in_h picture with the given pixel
+ * aspect ratio in @out_info without changing its display aspect ratio */
+static void
+gst_video_scale_compute_borders (GstVideoScale * videoscale, gint in_w,
+    gint in_h, gint in_par_n, gint in_par_d, GstVideoInfo * out_info,
+    gint * borders_w, gint * borders_h)
 {
-  GstVideoScale *videoscale = GST_VIDEO_SCALE (filter);
   gint from_dar_n, from_dar_d, to_dar_n, to_dar_d;
 
-  if (!gst_util_fraction_multiply (in_info->width,
-          in_info->height, in_info->par_n, in_info->par_d, &from_dar_n,
-          &from_dar_d)) {
+  if (!gst_util_fraction_multiply (in_w, in_h, in_par_n, in_par_d,
+          &from_dar_n, &from_dar_d)) {
     from_dar_n = from_dar_d = -1;
   }
 
@@ -486,7 +525,7 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
     to_dar_n = to_dar_d = -1;
   }
 
-  videoscale->borders_w = videoscale->borders_h = 0;
+  *borders_w = *borders_h = 0;
   if (to_dar_n != from_dar_n || to_dar_d != from_dar_d) {
     if (videoscale->add_borders) {
       gint n, d, to_h, to_w;
@@ -496,13 +535,13 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
               out_info->par_d, out_info->par_n, &n, &d)) {
         to_h = gst_util_uint64_scale_int (out_info->width, d, n);
         if (to_h <= out_info->height) {
-          videoscale->borders_h = out_info->height - to_h;
-          videoscale->borders_w = 0;
+          *borders_h = out_info->height - to_h;
+          *borders_w = 0;
         } else {
           to_w = gst_util_uint64_scale_int (out_info->height, n, d);
           g_assert (to_w <= out_info->width);
-          videoscale->borders_h = 0;
-          videoscale->borders_w = out_info->width - to_w;
+          *borders_h = 0;
+          *borders_w = out_info->width - to_w;
         }
       } else {
         GST_WARNING_OBJECT (videoscale, "Can't calculate borders");
@@ -511,6 +550,17 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
       GST_WARNING_OBJECT (videoscale, "Can't keep DAR!");
     }
   }
+}
+
+static gboolean
+gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
+    GstVideoInfo * in_info, GstCaps * out, GstVideoInfo * out_info)
+{
+  GstVideoScale *videoscale = GST_VIDEO_SCALE (filter);
+
+  gst_video_scale_compute_borders (videoscale, in_info->width,
+      in_info->height, in_info->par_n, in_info->par_d, out_info,
+      &videoscale->borders_w, &videoscale->borders_h);
 
   if (in_info->width == out_info->width && in_info->height == out_info->height
       && videoscale->borders_w == 0 && videoscale->borders_h == 0) {
@@ -606,7 +656,8 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
         GST_VIDEO_MATRIX_MODE_NONE, GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
         GST_TYPE_VIDEO_DITHER_METHOD, GST_VIDEO_DITHER_NONE,
         GST_VIDEO_CONVERTER_OPT_CHROMA_MODE, GST_TYPE_VIDEO_CHROMA_MODE,
-        GST_VIDEO_CHROMA_MODE_NONE, NULL);
+        GST_VIDEO_CHROMA_MODE_NONE, GST_VIDEO_CONVERTER_OPT_THREADS,
+        G_TYPE_UINT, videoscale->n_threads, NULL);
 
     if (videoscale->gamma_decode) {
       gst_structure_set (options,
@@ -616,16 +667,24 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
 
     if (videoscale->convert)
       gst_video_converter_free (videoscale->convert);
+    if (videoscale->options)
+      gst_structure_free (videoscale->options);
+    videoscale->options = gst_structure_copy (options);
     videoscale->convert = gst_video_converter_new (in_info, out_info, options);
   }
 
-  GST_DEBUG_OBJECT (videoscale, "from=%dx%d (par=%d/%d dar=%d/%d), size %"
-      G_GSIZE_FORMAT " -> to=%dx%d (par=%d/%d dar=%d/%d borders=%d:%d), "
+  if (videoscale->crop_convert) {
+    gst_video_converter_free (videoscale->crop_convert);
+    videoscale->crop_convert = NULL;
+  }
+
+  GST_DEBUG_OBJECT (videoscale, "from=%dx%d (par=%d/%d), size %"
+      G_GSIZE_FORMAT " -> to=%dx%d (par=%d/%d borders=%d:%d), "
       "size %" G_GSIZE_FORMAT,
       in_info->width, in_info->height, in_info->par_n, in_info->par_d,
-      from_dar_n, from_dar_d, in_info->size, out_info->width,
-      out_info->height, out_info->par_n, out_info->par_d, to_dar_n, to_dar_d,
-      videoscale->borders_w, videoscale->borders_h, out_info->size);
+      in_info->size, out_info->width, out_info->height, out_info->par_n,
+      out_info->par_d, videoscale->borders_w, videoscale->borders_h,
+      out_info->size);
 
   return TRUE;
 }
@@ -1072,16 +1131,181 @@ done:
     (gpointer)(((guint8*)(GST_VIDEO_FRAME_PLANE_DATA (frame, 0))) + \
      GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0) * (line))
 
+static gboolean
+gst_video_scale_propose_allocation (GstBaseTransform * trans,
+    GstQuery * decide_query, GstQuery * query)
+{
+  if (!GST_BASE_TRANSFORM_CLASS (parent_class)->propose_allocation (trans,
+          decide_query, query))
+    return FALSE;
+
+  /* passthrough, downstream answered */
+  if (decide_query == NULL)
+    return TRUE;
+
+  /* we can read the crop region straight out of the larger frame, which
+   * saves upstream from copying it out first */
+  if (gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL))
+    gst_query_add_allocation_meta (query, GST_VIDEO_CROP_META_API_TYPE, NULL);
+
+  return TRUE;
+}
+
+static gboolean
+gst_video_scale_decide_allocation (GstBaseTransform * trans, GstQuery * query)
+{
+  GstVideoScale *videoscale = GST_VIDEO_SCALE_CAST (trans);
+
+  videoscale->downstream_crop_meta =
+      gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL)
+      && gst_query_find_allocation_meta (query, GST_VIDEO_CROP_META_API_TYPE,
+      NULL);
+
+  GST_DEBUG_OBJECT (videoscale, "downstream supports crop meta: %d",
+      videoscale->downstream_crop_meta);
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->decide_allocation (trans,
+      query);
+}
+
+/* when all we would do is cut out the crop region without scaling it, and
+ * downstream can handle the crop meta itself, the input buffer can be pushed
+ * as is. The crop rectangle, not the caps size, is the picture: it is
+ * forwarded only when it already has the output size and pixel aspect
+ * ratio, which also means no borders are needed around it. */
+static gboolean
+gst_video_scale_can_forward_crop (GstVideoScale * videoscale, GstBuffer * buf)
+{
+  GstVideoFilter *filter = GST_VIDEO_FILTER_CAST (videoscale);
+  GstVideoInfo *in_info = &filter->in_info;
+  GstVideoInfo *out_info = &filter->out_info;
+  GstVideoCropMeta *crop;
+
+  if (!videoscale->downstream_crop_meta)
+    return FALSE;
+
+  if (gst_buffer_get_video_meta (buf) == NULL)
+    return FALSE;
+
+  crop = gst_buffer_get_video_crop_meta (buf);
+  if (crop == NULL)
+    return FALSE;
+
+  if (crop->width != (guint) GST_VIDEO_INFO_WIDTH (out_info) ||
+      crop->height != (guint) GST_VIDEO_INFO_HEIGHT (out_info))
+    return FALSE;
+
+  return GST_VIDEO_INFO_PAR_N (in_info) * GST_VIDEO_INFO_PAR_D (out_info) ==
+      GST_VIDEO_INFO_PAR_N (out_info) * GST_VIDEO_INFO_PAR_D (in_info);
+}
+
+static GstFlowReturn
+gst_video_scale_prepare_output_buffer (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer ** outbuf)
+{
+  GstVideoScale *videoscale = GST_VIDEO_SCALE_CAST (trans);
+
+  if (!gst_base_transform_is_passthrough (trans) &&
+      gst_video_scale_can_forward_crop (videoscale, inbuf)) {
+    GST_CAT_LOG_OBJECT (GST_CAT_PERFORMANCE, trans,
+        "forwarding cropped buffer");
+    *outbuf = inbuf;
+    return GST_FLOW_OK;
+  }
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->prepare_output_buffer (trans,
+      inbuf, outbuf);
+}
+
+static GstFlowReturn
+gst_video_scale_transform (GstBaseTransform * trans, GstBuffer * inbuf,
+    GstBuffer * outbuf)
+{
+  /* forwarded with its crop meta, nothing to do */
+  if (inbuf == outbuf)
+    return GST_FLOW_OK;
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->transform (trans, inbuf,
+      outbuf);
+}
+
+static GstVideoConverter *
+gst_video_scale_get_crop_converter (GstVideoScale * videoscale,
+    GstVideoFrame * in_frame, GstVideoCropMeta * crop)
+{
+  GstVideoFilter *filter = GST_VIDEO_FILTER_CAST (videoscale);
+  GstStructure *options;
+  gint borders_w, borders_h;
+
+  if (videoscale->crop_convert &&
+      videoscale->crop_x == crop->x && videoscale->crop_y == crop->y &&
+      videoscale->crop_w == crop->width && videoscale->crop_h == crop->height
+      && videoscale->crop_frame_w == GST_VIDEO_FRAME_WIDTH (in_frame)
+      && videoscale->crop_frame_h == GST_VIDEO_FRAME_HEIGHT (in_frame))
+    return videoscale->crop_convert;
+
+  if (videoscale->crop_convert)
+    gst_video_converter_free (videoscale->crop_convert);
+
+  videoscale->crop_x = crop->x;
+  videoscale->crop_y = crop->y;
+  videoscale->crop_w = crop->width;
+  videoscale->crop_h = crop->height;
+  videoscale->crop_frame_w = GST_VIDEO_FRAME_WIDTH (in_frame);
+  videoscale->crop_frame_h = GST_VIDEO_FRAME_HEIGHT (in_frame);
+
+  GST_DEBUG_OBJECT (videoscale, "crop %ux%u+%u+%u from %ux%u frame",
+      videoscale->crop_w, videoscale->crop_h, videoscale->crop_x,
+      videoscale->crop_y, videoscale->crop_frame_w, videoscale->crop_frame_h);
+
+  /* the crop rectangle is the picture, so letterbox it after its own
+   * aspect ratio rather than the one of the caps */
+  gst_video_scale_compute_borders (videoscale, videoscale->crop_w,
+      videoscale->crop_h, GST_VIDEO_INFO_PAR_N (&filter->in_info),
+      GST_VIDEO_INFO_PAR_D (&filter->in_info), &filter->out_info,
+      &borders_w, &borders_h);
+
+  GST_DEBUG_OBJECT (videoscale, "crop borders %d:%d", borders_w, borders_h);
+
+  /* the frame info has the size of the full frame from the video meta */
+  options = gst_structure_copy (videoscale->options);
+  gst_structure_set (options,
+      GST_VIDEO_CONVERTER_OPT_DEST_X, G_TYPE_INT, borders_w / 2,
+      GST_VIDEO_CONVERTER_OPT_DEST_Y, G_TYPE_INT, borders_h / 2,
+      GST_VIDEO_CONVERTER_OPT_DEST_WIDTH, G_TYPE_INT,
+      GST_VIDEO_INFO_WIDTH (&filter->out_info) - borders_w,
+      GST_VIDEO_CONVERTER_OPT_DEST_HEIGHT, G_TYPE_INT,
+      GST_VIDEO_INFO_HEIGHT (&filter->out_info) - borders_h,
+      GST_VIDEO_CONVERTER_OPT_SRC_X, G_TYPE_INT, (gint) videoscale->crop_x,
+      GST_VIDEO_CONVERTER_OPT_SRC_Y, G_TYPE_INT, (gint) videoscale->crop_y,
+      GST_VIDEO_CONVERTER_OPT_SRC_WIDTH, G_TYPE_INT, (gint) videoscale->crop_w,
+      GST_VIDEO_CONVERTER_OPT_SRC_HEIGHT, G_TYPE_INT,
+      (gint) videoscale->crop_h,
+      NULL);
+  videoscale->crop_convert = gst_video_converter_new (&in_frame->info,
+      &filter->out_info, options);
+
+  return videoscale->crop_convert;
+}
+
 static GstFlowReturn
 gst_video_scale_transform_frame (GstVideoFilter * filter,
     GstVideoFrame * in_frame, GstVideoFrame * out_frame)
 {
   GstVideoScale *videoscale = GST_VIDEO_SCALE_CAST (filter);
   GstFlowReturn ret = GST_FLOW_OK;
+  GstVideoConverter *convert = videoscale->convert;
+  GstVideoCropMeta *crop;
 
   GST_CAT_DEBUG_OBJECT (GST_CAT_PERFORMANCE, filter, "doing video scaling");
 
-  gst_video_converter_frame (videoscale->convert, in_frame, out_frame);
+  crop = gst_buffer_get_video_crop_meta (in_frame->buffer);
+  if (crop)
+    convert = gst_video_scale_get_crop_converter (videoscale, in_frame, crop);
+
+  /* borders are only written outside of the active area, which is scaled or
+   * plane-copied into place */
+  gst_video_converter_frame (convert, in_frame, out_frame);
 
   return ret;
 }
@@ -1132,6 +1356,10 @@ plugin_init (GstPlugin * plugin)
           GST_TYPE_VIDEO_SCALE))
     return FALSE;
 
+  if (!gst_element_register (plugin, "videoscaleladder", GST_RANK_NONE,
+          GST_TYPE_VIDEO_SCALE_LADDER))
+    return FALSE;
+
   GST_DEBUG_CATEGORY_INIT (video_scale_debug, "videoscale", 0,
       "videoscale element");
   GST_DEBUG_CATEGORY_GET (GST_CAT_PERFORMANCE, "GST_PERFORMANCE");
@@ -88,11 +88,21 @@ struct _GstVideoScale {
   int submethod;
   double envelope;
   gboolean gamma_decode;
+  guint n_threads;
 
   GstVideoConverter *convert;
+  GstStructure *options;
 
   gint borders_h;
   gint borders_w;
+
+  /* input with a GstVideoCropMeta */
+  GstVideoConverter *crop_convert;
+  guint crop_x, crop_y, crop_w, crop_h;
+  guint crop_frame_w, crop_frame_h;
+
+  /* downstream understands GstVideoMeta and GstVideoCropMeta */
+  gboolean downstream_crop_meta;
 };
 
 struct _GstVideoScaleClass {
@@ -0,0 +1,963 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:element-videoscaleladder
+ * @see_also: videoscale, tee
+ *
+ * This element resizes one input video stream to several output sizes at
+ * once, as needed for adaptive bitrate encoding. Each requested source pad
+ * negotiates its own size with downstream; the format, framerate and
+ * colorimetry of the input are kept so that no color conversion is needed.
+ * When downstream leaves the width, the height or the pixel-aspect-ratio
+ * open, it is chosen so that the output keeps the display aspect ratio of
+ * the input.
+ *
+ * Compared to a tee followed by one videoscale per branch, the input frame
+ * is only mapped once and, when #GstVideoScaleLadder:cascade is enabled,
+ * every output is produced from the smallest already scaled output that is
+ * still at least as large as itself instead of from the full size input.
+ * Each source pad allocates its frames from its own buffer pool.
+ *
+ * <refsect2>
+ * <title>Example pipelines</title>
+ * |[
+ * gst-launch-1.0 -v videotestsrc ! video/x-raw,width=1920,height=1080 ! videoscaleladder name=l \
+ *     l. ! video/x-raw,width=1280,height=720 ! queue ! fakesink \
+ *     l. ! video/x-raw,width=854,height=480 ! queue ! fakesink \
+ *     l. ! video/x-raw,width=640,height=360 ! queue ! fakesink
+ * ]| Produce a 720p, 480p and 360p rendition of a 1080p stream.
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <gst/video/gstvideometa.h>
+#include <gst/video/gstvideopool.h>
+
+#include "gstvideoscaleladder.h"
+
+GST_DEBUG_CATEGORY_STATIC (video_scale_ladder_debug);
+#define GST_CAT_DEFAULT video_scale_ladder_debug
+
+#define DEFAULT_PROP_METHOD       GST_VIDEO_RESAMPLER_METHOD_LINEAR
+#define DEFAULT_PROP_CASCADE      TRUE
+#define DEFAULT_PROP_N_THREADS    1
+
+enum
+{
+  PROP_0,
+  PROP_METHOD,
+  PROP_CASCADE,
+  PROP_N_THREADS,
+};
+
+
+#define GST_VIDEO_FORMATS GST_VIDEO_FORMATS_ALL
+
+static GstStaticPadTemplate gst_video_scale_ladder_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (GST_VIDEO_FORMATS))
+    );
+
+static GstStaticPadTemplate gst_video_scale_ladder_src_template =
+GST_STATIC_PAD_TEMPLATE ("src_%u",
+    GST_PAD_SRC,
+    GST_PAD_REQUEST,
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (GST_VIDEO_FORMATS))
+    );
+
+/* source pad of the ladder, one per rendition */
+#define GST_TYPE_VIDEO_SCALE_LADDER_PAD \
+  (gst_video_scale_ladder_pad_get_type())
+#define GST_VIDEO_SCALE_LADDER_PAD(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_VIDEO_SCALE_LADDER_PAD,GstVideoScaleLadderPad))
+
+typedef struct _GstVideoScaleLadderPad GstVideoScaleLadderPad;
+typedef struct _GstVideoScaleLadderPadClass GstVideoScaleLadderPadClass;
+
+struct _GstVideoScaleLadderPad
+{
+  GstPad parent;
+
+  /* only touched from the streaming thread */
+  gboolean negotiated;
+  GstVideoInfo info;
+  GstBufferPool *pool;
+
+  /* converter and the info of the frame it reads from, which is either the
+   * input or the output of a larger rung */
+  GstVideoConverter *convert;
+  GstVideoInfo convert_info;
+};
+
+struct _GstVideoScaleLadderPadClass
+{
+  GstPadClass parent_class;
+};
+
+static GType gst_video_scale_ladder_pad_get_type (void);
+G_DEFINE_TYPE (GstVideoScaleLadderPad, gst_video_scale_ladder_pad,
+    GST_TYPE_PAD);
+
+static void
+gst_video_scale_ladder_pad_reset (GstVideoScaleLadderPad * pad)
+{
+  if (pad->pool) {
+    gst_buffer_pool_set_active (pad->pool, FALSE);
+    gst_object_unref (pad->pool);
+    pad->pool = NULL;
+  }
+  if (pad->convert) {
+    gst_video_converter_free (pad->convert);
+    pad->convert = NULL;
+  }
+  pad->negotiated = FALSE;
+}
+
+static void
+gst_video_scale_ladder_pad_finalize (GObject * object)
+{
+  gst_video_scale_ladder_pad_reset (GST_VIDEO_SCALE_LADDER_PAD (object));
+
+  G_OBJECT_CLASS (gst_video_scale_ladder_pad_parent_class)->finalize (object);
+}
+
+static void
+gst_video_scale_ladder_pad_class_init (GstVideoScaleLadderPadClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+
+  gobject_class->finalize = gst_video_scale_ladder_pad_finalize;
+}
+
+static void
+gst_video_scale_ladder_pad_init (GstVideoScaleLadderPad * pad)
+{
+  gst_video_info_init (&pad->info);
+  gst_video_info_init (&pad->convert_info);
+}
+
+static void gst_video_scale_ladder_finalize (GObject * object);
+static void gst_video_scale_ladder_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec);
+static void gst_video_scale_ladder_get_property (GObject * object,
+    guint prop_id, GValue * value, GParamSpec * pspec);
+
+static GstPad *gst_video_scale_ladder_request_new_pad (GstElement * element,
+    GstPadTemplate * templ, const gchar * name, const GstCaps * caps);
+static void gst_video_scale_ladder_release_pad (GstElement * element,
+    GstPad * pad);
+static GstStateChangeReturn gst_video_scale_ladder_change_state (GstElement *
+    element, GstStateChange transition);
+
+static gboolean gst_video_scale_ladder_sink_event (GstPad * pad,
+    GstObject * parent, GstEvent * event);
+static gboolean gst_video_scale_ladder_sink_query (GstPad * pad,
+    GstObject * parent, GstQuery * query);
+static GstFlowReturn gst_video_scale_ladder_chain (GstPad * pad,
+    GstObject * parent, GstBuffer * buffer);
+
+#define gst_video_scale_ladder_parent_class parent_class
+G_DEFINE_TYPE (GstVideoScaleLadder, gst_video_scale_ladder, GST_TYPE_ELEMENT);
+
+static void
+gst_video_scale_ladder_class_init (GstVideoScaleLadderClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+  GstElementClass *element_class = (GstElementClass *) klass;
+
+  GST_DEBUG_CATEGORY_INIT (video_scale_ladder_debug, "videoscaleladder", 0,
+      "videoscaleladder element");
+
+  gobject_class->finalize = gst_video_scale_ladder_finalize;
+  gobject_class->set_property = gst_video_scale_ladder_set_property;
+  gobject_class->get_property = gst_video_scale_ladder_get_property;
+
+  g_object_class_install_property (gobject_class, PROP_METHOD,
+      g_param_spec_enum ("method", "method", "method",
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, DEFAULT_PROP_METHOD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CASCADE,
+      g_param_spec_boolean ("cascade", "Cascade",
+          "Scale each output from the next larger output instead of the input",
+          DEFAULT_PROP_CASCADE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Threads",
+          "Maximum number of threads to use per output", 0, G_MAXUINT,
+          DEFAULT_PROP_N_THREADS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  gst_element_class_set_static_metadata (element_class,
+      "Video scaler ladder", "Filter/Converter/Video/Scaler",
+      "Resizes video to several sizes at once", "GStreamer maintainers");
+
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&gst_video_scale_ladder_sink_template));
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&gst_video_scale_ladder_src_template));
+
+  element_class->request_new_pad =
+      GST_DEBUG_FUNCPTR (gst_video_scale_ladder_request_new_pad);
+  element_class->release_pad =
+      GST_DEBUG_FUNCPTR (gst_video_scale_ladder_release_pad);
+  element_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_video_scale_ladder_change_state);
+}
+
+static void
+gst_video_scale_ladder_init (GstVideoScaleLadder * ladder)
+{
+  ladder->sinkpad =
+      gst_pad_new_from_static_template (&gst_video_scale_ladder_sink_template,
+      "sink");
+  gst_pad_set_event_function (ladder->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_video_scale_ladder_sink_event));
+  gst_pad_set_query_function (ladder->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_video_scale_ladder_sink_query));
+  gst_pad_set_chain_function (ladder->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_video_scale_ladder_chain));
+  gst_element_add_pad (GST_ELEMENT (ladder), ladder->sinkpad);
+
+  ladder->method = DEFAULT_PROP_METHOD;
+  ladder->cascade = DEFAULT_PROP_CASCADE;
+  ladder->n_threads = DEFAULT_PROP_N_THREADS;
+
+  ladder->flow_combiner = gst_flow_combiner_new ();
+  gst_video_info_init (&ladder->in_info);
+}
+
+static void
+gst_video_scale_ladder_finalize (GObject * object)
+{
+  GstVideoScaleLadder *ladder = GST_VIDEO_SCALE_LADDER (object);
+
+  gst_flow_combiner_free (ladder->flow_combiner);
+  g_list_free (ladder->srcpads);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+static void
+gst_video_scale_ladder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVideoScaleLadder *ladder = GST_VIDEO_SCALE_LADDER (object);
+
+  switch (prop_id) {
+    case PROP_METHOD:
+      GST_OBJECT_LOCK (ladder);
+      ladder->method = g_value_get_enum (value);
+      GST_OBJECT_UNLOCK (ladder);
+      break;
+    case PROP_CASCADE:
+      GST_OBJECT_LOCK (ladder);
+      ladder->cascade = g_value_get_boolean (value);
+      GST_OBJECT_UNLOCK (ladder);
+      break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (ladder);
+      ladder->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (ladder);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_video_scale_ladder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoScaleLadder *ladder = GST_VIDEO_SCALE_LADDER (object);
+
+  switch (prop_id) {
+    case PROP_METHOD:
+      GST_OBJECT_LOCK (ladder);
+      g_value_set_enum (value, ladder->method);
+      GST_OBJECT_UNLOCK (ladder);
+      break;
+    case PROP_CASCADE:
+      GST_OBJECT_LOCK (ladder);
+      g_value_set_boolean (value, ladder->cascade);
+      GST_OBJECT_UNLOCK (ladder);
+      break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (ladder);
+      g_value_set_uint (value, ladder->n_threads);
+      GST_OBJECT_UNLOCK (ladder);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static GstPad *
+gst_video_scale_ladder_request_new_pad (GstElement * element,
+    GstPadTemplate * templ, const gchar * name, const GstCaps * caps)
+{
+  GstVideoScaleLadder *ladder = GST_VIDEO_SCALE_LADDER (element);
+  GstPad *srcpad;
+  gchar *pad_name;
+
+  GST_OBJECT_LOCK (ladder);
+  if (name)
+    pad_name = g_strdup (name);
+  else
+    pad_name = g_strdup_printf ("src_%u", ladder->n_srcpads);
+  ladder->n_srcpads++;
+  GST_OBJECT_UNLOCK (ladder);
+
+  srcpad = g_object_new (GST_TYPE_VIDEO_SCALE_LADDER_PAD,
+      "name", pad_name, "direction", templ->direction, "template", templ,
+      NULL);
+  g_free (pad_name);
+
+  gst_pad_set_active (srcpad, TRUE);
+
+  GST_OBJECT_LOCK (ladder);
+  ladder->srcpads = g_list_append (ladder->srcpads, srcpad);
+  gst_flow_combiner_add_pad (ladder->flow_combiner, srcpad);
+  GST_OBJECT_UNLOCK (ladder);
+
+  if (!gst_element_add_pad (element, srcpad))
+    goto add_failed;
+
+  GST_DEBUG_OBJECT (ladder, "created pad %" GST_PTR_FORMAT, srcpad);
+
+  return srcpad;
+
+  /* ERRORS */
+add_failed:
+  {
+    GST_WARNING_OBJECT (ladder, "failed to add pad");
+    GST_OBJECT_LOCK (ladder);
+    ladder->srcpads = g_list_remove (ladder->srcpads, srcpad);
+    gst_flow_combiner_remove_pad (ladder->flow_combiner, srcpad);
+    GST_OBJECT_UNLOCK (ladder);
+    gst_object_unref (srcpad);
+    return NULL;
+  }
+}
+
+static void
+gst_video_scale_ladder_release_pad (GstElement * element, GstPad * pad)
+{
+  GstVideoScaleLadder *ladder = GST_VIDEO_SCALE_LADDER (element);
+
+  GST_DEBUG_OBJECT (ladder, "releasing pad %" GST_PTR_FORMAT, pad);
+
+  GST_OBJECT_LOCK (ladder);
+  ladder->srcpads = g_list_remove (ladder->srcpads, pad);
+  gst_flow_combiner_remove_pad (ladder->flow_combiner, pad);
+  GST_OBJECT_UNLOCK (ladder);
+
+  gst_pad_set_active (pad, FALSE);
+  gst_element_remove_pad (element, pad);
+}
+
+static gboolean
+copy_sticky_events (GstPad * pad, GstEvent ** event, gpointer user_data)
+{
+  GstPad *srcpad = user_data;
+
+  /* caps are negotiated per source pad */
+  if (GST_EVENT_TYPE (*event) != GST_EVENT_CAPS)
+    gst_pad_store_sticky_event (srcpad, *event);
+
+  return TRUE;
+}
+
+static gboolean
+gst_video_scale_ladder_setup_pool (GstVideoScaleLadder * ladder,
+    GstVideoScaleLadderPad * srcpad, GstCaps * caps)
+{
+  GstQuery *query;
+  GstBufferPool *pool = NULL;
+  GstStructure *config;
+  guint size, min, max;
+
+  query = gst_query_new_allocation (caps, TRUE);
+  if (!gst_pad_peer_query (GST_PAD (srcpad), query))
+    GST_DEBUG_OBJECT (srcpad, "peer ALLOCATION query failed");
+
+  if (gst_query_get_n_allocation_pools (query) > 0) {
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &size, &min, &max);
+    size = MAX (size, srcpad->info.size);
+  } else {
+    size = srcpad->info.size;
+    min = max = 0;
+  }
+
+  if (pool == NULL)
+    pool = gst_video_buffer_pool_new ();
+
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, size, min, max);
+  if (gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL))
+    gst_buffer_pool_config_add_option (config,
+        GST_BUFFER_POOL_OPTION_VIDEO_META);
+
+  if (!gst_buffer_pool_set_config (pool, config)) {
+    /* downstream pool did not like our parameters, use our own */
+    GST_DEBUG_OBJECT (srcpad, "failed to configure pool, using our own");
+    gst_object_unref (pool);
+    pool = gst_video_buffer_pool_new ();
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_set_params (config, caps, srcpad->info.size, 0, 0);
+    if (!gst_buffer_pool_set_config (pool, config))
+      goto config_failed;
+  }
+  gst_query_unref (query);
+
+  if (!gst_buffer_pool_set_active (pool, TRUE))
+    goto activate_failed;
+
+  srcpad->pool = pool;
+
+  return TRUE;
+
+  /* ERRORS */
+config_failed:
+  {
+    GST_ERROR_OBJECT (srcpad, "failed to configure pool");
+    gst_query_unref (query);
+    gst_object_unref (pool);
+    return FALSE;
+  }
+activate_failed:
+  {
+    GST_ERROR_OBJECT (srcpad, "failed to activate pool");
+    gst_object_unref (pool);
+    return FALSE;
+  }
+}
+
+/* fixate the width, height and pixel-aspect-ratio in @s so that the output
+ * has the same display aspect ratio as the input where downstream allows */
+static void
+gst_video_scale_ladder_fixate_size (GstVideoScaleLadder * ladder,
+    GstStructure * s)
+{
+  const GstVideoInfo *in_info = &ladder->in_info;
+  gint dar_n, dar_d, par_n, par_d, width, height;
+  gboolean have_width, have_height;
+
+  if (!gst_util_fraction_multiply (in_info->width, in_info->height,
+          in_info->par_n, in_info->par_d, &dar_n, &dar_d)) {
+    dar_n = in_info->width;
+    dar_d = in_info->height;
+  }
+
+  /* downstream doesn't care about the pixel-aspect-ratio, we can pick any */
+  if (!gst_structure_has_field (s, "pixel-aspect-ratio"))
+    gst_structure_set (s, "pixel-aspect-ratio", GST_TYPE_FRACTION_RANGE, 1,
+        G_MAXINT, G_MAXINT, 1, NULL);
+
+  have_width = gst_structure_get_int (s, "width", &width);
+  have_height = gst_structure_get_int (s, "height", &height);
+
+  if (have_width && have_height) {
+    /* the size is fixed, pick the pixel-aspect-ratio that keeps the
+     * display aspect ratio */
+    if (!gst_util_fraction_multiply (dar_n, dar_d, height, width, &par_n,
+            &par_d)) {
+      par_n = in_info->par_n;
+      par_d = in_info->par_d;
+    }
+    gst_structure_fixate_field_nearest_fraction (s, "pixel-aspect-ratio",
+        par_n, par_d);
+    return;
+  }
+
+  gst_structure_fixate_field_nearest_fraction (s, "pixel-aspect-ratio",
+      in_info->par_n, in_info->par_d);
+  gst_structure_get_fraction (s, "pixel-aspect-ratio", &par_n, &par_d);
+
+  if (!have_height) {
+    if (!have_width) {
+      /* nothing fixed, start from the input height */
+      gst_structure_fixate_field_nearest_int (s, "height", in_info->height);
+      gst_structure_get_int (s, "height", &height);
+    } else {
+      height = gst_util_uint64_scale_int_round (width,
+          dar_d * par_n, dar_n * par_d);
+      gst_structure_fixate_field_nearest_int (s, "height", MAX (height, 1));
+      return;
+    }
+  }
+  width = gst_util_uint64_scale_int_round (height, dar_n * par_d,
+      dar_d * par_n);
+  gst_structure_fixate_field_nearest_int (s, "width", MAX (width, 1));
+}
+
+/* negotiate a size for @srcpad with downstream. Everything but the size and
+ * pixel-aspect-ratio is taken from the input so no conversion is needed. */
+static gboolean
+gst_video_scale_ladder_negotiate_pad (GstVideoScaleLadder * ladder,
+    GstVideoScaleLadderPad * srcpad)
+{
+  GstCaps *filter, *caps;
+  GstStructure *s;
+
+  gst_video_scale_ladder_pad_reset (srcpad);
+
+  filter = gst_video_info_to_caps (&ladder->in_info);
+  s = gst_caps_get_structure (filter, 0);
+  gst_structure_set (s, "width", GST_TYPE_INT_RANGE, 1, 32767,
+      "height", GST_TYPE_INT_RANGE, 1, 32767, NULL);
+  gst_structure_remove_field (s, "pixel-aspect-ratio");
+
+  caps = gst_pad_peer_query_caps (GST_PAD (srcpad), filter);
+  gst_caps_unref (filter);
+
+  if (gst_caps_is_empty (caps))
+    goto no_caps;
+
+  caps = gst_caps_truncate (caps);
+  caps = gst_caps_make_writable (caps);
+  gst_video_scale_ladder_fixate_size (ladder, gst_caps_get_structure (caps,
+          0));
+  caps = gst_caps_fixate (caps);
+
+  if (!gst_video_info_from_caps (&srcpad->info, caps))
+    goto invalid_caps;
+
+  GST_DEBUG_OBJECT (srcpad, "negotiated %" GST_PTR_FORMAT, caps);
+
+  gst_pad_sticky_events_foreach (ladder->sinkpad, copy_sticky_events, srcpad);
+  if (!gst_pad_set_caps (GST_PAD (srcpad), caps))
+    goto set_caps_failed;
+
+  if (!gst_video_scale_ladder_setup_pool (ladder, srcpad, caps))
+    goto no_pool;
+
+  gst_caps_unref (caps);
+  srcpad->negotiated = TRUE;
+
+  return TRUE;
+
+  /* ERRORS */
+no_caps:
+  {
+    GST_WARNING_OBJECT (srcpad, "no compatible caps downstream");
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+invalid_caps:
+  {
+    GST_WARNING_OBJECT (srcpad, "invalid caps %" GST_PTR_FORMAT, caps);
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+set_caps_failed:
+  {
+    GST_WARNING_OBJECT (srcpad, "failed to set caps %" GST_PTR_FORMAT, caps);
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+no_pool:
+  {
+    gst_caps_unref (caps);
+    return FALSE;
+  }
+}
+
+static GstVideoConverter *
+gst_video_scale_ladder_get_converter (GstVideoScaleLadder * ladder,
+    GstVideoScaleLadderPad * srcpad, const GstVideoInfo * in_info)
+{
+  GstVideoResamplerMethod method;
+  guint n_threads;
+
+  if (srcpad->convert && gst_video_info_is_equal (&srcpad->convert_info,
+          in_info))
+    return srcpad->convert;
+
+  if (srcpad->convert)
+    gst_video_converter_free (srcpad->convert);
+
+  GST_OBJECT_LOCK (ladder);
+  method = ladder->method;
+  n_threads = ladder->n_threads;
+  GST_OBJECT_UNLOCK (ladder);
+
+  GST_DEBUG_OBJECT (srcpad, "scaling from %dx%d to %dx%d",
+      GST_VIDEO_INFO_WIDTH (in_info), GST_VIDEO_INFO_HEIGHT (in_info),
+      GST_VIDEO_INFO_WIDTH (&srcpad->info),
+      GST_VIDEO_INFO_HEIGHT (&srcpad->info));
+
+  /* input and output have the same format so the converter takes its plane
+   * scaling fastpath without unpacking to an intermediate format */
+  srcpad->convert_info = *in_info;
+  srcpad->convert = gst_video_converter_new ((GstVideoInfo *) in_info,
+      &srcpad->info,
+      gst_structure_new ("GstVideoScaleLadder",
+          GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, method,
+          GST_VIDEO_CONVERTER_OPT_DITHER_METHOD, GST_TYPE_VIDEO_DITHER_METHOD,
+          GST_VIDEO_DITHER_NONE,
+          GST_VIDEO_CONVERTER_OPT_CHROMA_MODE, GST_TYPE_VIDEO_CHROMA_MODE,
+          GST_VIDEO_CHROMA_MODE_NONE,
+          GST_VIDEO_CONVERTER_OPT_MATRIX_MODE, GST_TYPE_VIDEO_MATRIX_MODE,
+          GST_VIDEO_MATRIX_MODE_NONE,
+          GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, n_threads, NULL));
+
+  return srcpad->convert;
+}
+
+static gint
+compare_area (gconstpointer a, gconstpointer b)
+{
+  const GstVideoScaleLadderPad *pa = *(GstVideoScaleLadderPad **) a;
+  const GstVideoScaleLadderPad *pb = *(GstVideoScaleLadderPad **) b;
+  gint64 aa = (gint64) pa->info.width * pa->info.height;
+  gint64 ab = (gint64) pb->info.width * pb->info.height;
+
+  return aa < ab ? 1 : aa > ab ? -1 : 0;
+}
+
+static GstFlowReturn
+gst_video_scale_ladder_chain (GstPad * pad, GstObject * parent,
+    GstBuffer * buffer)
+{
+  GstVideoScaleLadder *ladder = GST_VIDEO_SCALE_LADDER (parent);
+  GstVideoScaleLadderPad **rungs;
+  GstVideoFrame in_frame, *out_frames;
+  GstBuffer **outbufs;
+  GstFlowReturn ret = GST_FLOW_OK;
+  gboolean cascade;
+  guint i, j, n_rungs;
+  GList *walk;
+
+  if (!ladder->have_info)
+    goto not_negotiated;
+
+  GST_OBJECT_LOCK (ladder);
+  cascade = ladder->cascade;
+  n_rungs = g_list_length (ladder->srcpads);
+  rungs = g_newa (GstVideoScaleLadderPad *, n_rungs + 1);
+  for (i = 0, walk = ladder->srcpads; walk; walk = walk->next, i++)
+    rungs[i] = gst_object_ref (walk->data);
+  GST_OBJECT_UNLOCK (ladder);
+
+  /* (re)negotiate and drop the rungs that can't be negotiated */
+  for (i = 0, j = 0; i < n_rungs; i++) {
+    GstVideoScaleLadderPad *srcpad = rungs[i];
+
+    if ((gst_pad_check_reconfigure (GST_PAD (srcpad)) || !srcpad->negotiated)
+        && !gst_video_scale_ladder_negotiate_pad (ladder, srcpad)) {
+      if (gst_pad_is_linked (GST_PAD (srcpad)))
+        ret = gst_flow_combiner_update_pad_flow (ladder->flow_combiner,
+            GST_PAD (srcpad), GST_FLOW_NOT_NEGOTIATED);
+      gst_pad_mark_reconfigure (GST_PAD (srcpad));
+      gst_object_unref (srcpad);
+      continue;
+    }
+    rungs[j++] = srcpad;
+  }
+  n_rungs = j;
+
+  if (n_rungs == 0) {
+    gst_buffer_unref (buffer);
+    return ret;
+  }
+
+  if (!gst_video_frame_map (&in_frame, &ladder->in_info, buffer, GST_MAP_READ))
+    goto invalid_buffer;
+
+  /* largest first so that smaller rungs can be made from larger ones */
+  qsort (rungs, n_rungs, sizeof (GstVideoScaleLadderPad *), compare_area);
+
+  out_frames = g_newa (GstVideoFrame, n_rungs);
+  outbufs = g_newa (GstBuffer *, n_rungs);
+
+  for (i = 0; i < n_rungs; i++) {
+    GstVideoScaleLadderPad *srcpad = rungs[i];
+    GstVideoFrame *src_frame = &in_frame;
+    GstVideoConverter *convert;
+    GstFlowReturn res;
+
+    outbufs[i] = NULL;
+
+    res = gst_buffer_pool_acquire_buffer (srcpad->pool, &outbufs[i], NULL);
+    if (res != GST_FLOW_OK) {
+      GST_DEBUG_OBJECT (srcpad, "could not acquire buffer: %s",
+          gst_flow_get_name (res));
+      outbufs[i] = NULL;
+      ret = gst_flow_combiner_update_pad_flow (ladder->flow_combiner,
+          GST_PAD (srcpad), res);
+      continue;
+    }
+
+    if (!gst_video_frame_map (&out_frames[i], &srcpad->info, outbufs[i],
+            GST_MAP_READWRITE)) {
+      GST_WARNING_OBJECT (srcpad, "could not map output buffer");
+      gst_buffer_unref (outbufs[i]);
+      outbufs[i] = NULL;
+      continue;
+    }
+
+    /* pick the smallest rung produced so far that still covers our size */
+    if (cascade) {
+      for (j = 0; j < i; j++) {
+        if (outbufs[j] == NULL)
+          continue;
+        if (GST_VIDEO_FRAME_WIDTH (&out_frames[j]) >= srcpad->info.width &&
+            GST_VIDEO_FRAME_HEIGHT (&out_frames[j]) >= srcpad->info.height)
+          src_frame = &out_frames[j];
+      }
+    }
+
+    convert = gst_video_scale_ladder_get_converter (ladder, srcpad,
+        &src_frame->info);
+    gst_video_converter_frame (convert, src_frame, &out_frames[i]);
+  }
+
+  for (i = 0; i < n_rungs; i++) {
+    if (outbufs[i] != NULL)
+      gst_video_frame_unmap (&out_frames[i]);
+  }
+  gst_video_frame_unmap (&in_frame);
+
+  for (i = 0; i < n_rungs; i++) {
+    GstVideoScaleLadderPad *srcpad = rungs[i];
+
+    if (outbufs[i] != NULL) {
+      GstFlowReturn res;
+
+      gst_buffer_copy_into (outbufs[i], buffer,
+          GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+
+      res = gst_pad_push (GST_PAD (srcpad), outbufs[i]);
+      ret = gst_flow_combiner_update_pad_flow (ladder->flow_combiner,
+          GST_PAD (srcpad), res);
+    }
+    gst_object_unref (srcpad);
+  }
+  gst_buffer_unref (buffer);
+
+  return ret;
+
+  /* ERRORS */
+not_negotiated:
+  {
+    GST_ELEMENT_ERROR (ladder, CORE, NEGOTIATION, (NULL),
+        ("received buffer before caps"));
+    gst_buffer_unref (buffer);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+invalid_buffer:
+  {
+    GST_ELEMENT_WARNING (ladder, CORE, NOT_IMPLEMENTED, (NULL),
+        ("invalid video buffer received"));
+    for (i = 0; i < n_rungs; i++)
+      gst_object_unref (rungs[i]);
+    gst_buffer_unref (buffer);
+    return GST_FLOW_OK;
+  }
+}
+
+static void
+gst_video_scale_ladder_mark_renegotiate (GstVideoScaleLadder * ladder)
+{
+  GList *walk;
+
+  GST_OBJECT_LOCK (ladder);
+  for (walk = ladder->srcpads; walk; walk = walk->next)
+    GST_VIDEO_SCALE_LADDER_PAD (walk->data)->negotiated = FALSE;
+  GST_OBJECT_UNLOCK (ladder);
+}
+
+static gboolean
+gst_video_scale_ladder_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstVideoScaleLadder *ladder = GST_VIDEO_SCALE_LADDER (parent);
+  gboolean res;
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+    {
+      GstCaps *caps;
+      GstVideoInfo info;
+
+      gst_event_parse_caps (event, &caps);
+      if (!gst_video_info_from_caps (&info, caps)) {
+        GST_WARNING_OBJECT (ladder, "invalid caps %" GST_PTR_FORMAT, caps);
+        res = FALSE;
+      } else {
+        ladder->in_info = info;
+        ladder->have_info = TRUE;
+        /* source pads negotiate their own caps on the next buffer */
+        gst_video_scale_ladder_mark_renegotiate (ladder);
+        res = TRUE;
+      }
+      gst_event_unref (event);
+      break;
+    }
+    case GST_EVENT_SEGMENT:
+    {
+      GList *walk;
+
+      /* keep the segment until the source pads have caps, it is sent
+       * before the next buffer */
+      GST_OBJECT_LOCK (ladder);
+      for (walk = ladder->srcpads; walk; walk = walk->next)
+        gst_pad_store_sticky_event (walk->data, event);
+      GST_OBJECT_UNLOCK (ladder);
+      gst_event_unref (event);
+      res = TRUE;
+      break;
+    }
+    case GST_EVENT_FLUSH_STOP:
+      gst_flow_combiner_reset (ladder->flow_combiner);
+      res = gst_pad_event_default (pad, parent, event);
+      break;
+    default:
+      res = gst_pad_event_default (pad, parent, event);
+      break;
+  }
+  return res;
+}
+
+/* removes the size and pixel-aspect-ratio, the ladder can change those */
+static GstCaps *
+strip_size (GstCaps * caps)
+{
+  guint i, n;
+
+  caps = gst_caps_make_writable (caps);
+  n = gst_caps_get_size (caps);
+  for (i = 0; i < n; i++) {
+    GstStructure *s = gst_caps_get_structure (caps, i);
+
+    gst_structure_set (s, "width", GST_TYPE_INT_RANGE, 1, G_MAXINT,
+        "height", GST_TYPE_INT_RANGE, 1, G_MAXINT, NULL);
+    gst_structure_remove_field (s, "pixel-aspect-ratio");
+  }
+  return gst_caps_simplify (caps);
+}
+
+/* every output keeps the format, framerate and colorimetry of the input so
+ * the input must be acceptable to all source pads, in any size */
+static GstCaps *
+gst_video_scale_ladder_get_sink_caps (GstVideoScaleLadder * ladder,
+    GstPad * pad)
+{
+  GstCaps *templ, *caps;
+  GList *srcpads, *walk;
+
+  templ = gst_pad_get_pad_template_caps (pad);
+  caps = gst_caps_ref (templ);
+
+  GST_OBJECT_LOCK (ladder);
+  srcpads = g_list_copy (ladder->srcpads);
+  g_list_foreach (srcpads, (GFunc) gst_object_ref, NULL);
+  GST_OBJECT_UNLOCK (ladder);
+
+  for (walk = srcpads; walk; walk = walk->next) {
+    GstCaps *peercaps, *tmp;
+
+    peercaps = gst_pad_peer_query_caps (walk->data, templ);
+    peercaps = strip_size (peercaps);
+    tmp = gst_caps_intersect (caps, peercaps);
+    gst_caps_unref (peercaps);
+    gst_caps_unref (caps);
+    caps = tmp;
+
+    if (gst_caps_is_empty (caps))
+      break;
+  }
+  g_list_free_full (srcpads, gst_object_unref);
+  gst_caps_unref (templ);
+
+  GST_DEBUG_OBJECT (pad, "returning caps %" GST_PTR_FORMAT, caps);
+
+  return caps;
+}
+
+static gboolean
+gst_video_scale_ladder_sink_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  gboolean res;
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_CAPS:
+    {
+      GstCaps *filter, *caps;
+
+      gst_query_parse_caps (query, &filter);
+      caps = gst_video_scale_ladder_get_sink_caps (GST_VIDEO_SCALE_LADDER
+          (parent), pad);
+      if (filter) {
+        GstCaps *tmp = caps;
+
+        caps = gst_caps_intersect_full (filter, tmp, GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref (tmp);
+      }
+      gst_query_set_caps_result (query, caps);
+      gst_caps_unref (caps);
+      res = TRUE;
+      break;
+    }
+    case GST_QUERY_ALLOCATION:
+      /* every output has its own size and pool, nothing to share upstream */
+      res = FALSE;
+      break;
+    default:
+      res = gst_pad_query_default (pad, parent, query);
+      break;
+  }
+  return res;
+}
+
+static GstStateChangeReturn
+gst_video_scale_ladder_change_state (GstElement * element,
+    GstStateChange transition)
+{
+  GstVideoScaleLadder *ladder = GST_VIDEO_SCALE_LADDER (element);
+  GstStateChangeReturn ret;
+  GList *walk;
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      GST_OBJECT_LOCK (ladder);
+      for (walk = ladder->srcpads; walk; walk = walk->next)
+        gst_video_scale_ladder_pad_reset (walk->data);
+      ladder->have_info = FALSE;
+      gst_flow_combiner_reset (ladder->flow_combiner);
+      GST_OBJECT_UNLOCK (ladder);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
@@ -42,10 +42,13 @@
 #endif
 
 #include <string.h>
+#include <math.h>
 #include <gst/gst.h>
 #include <gst/base/gstbasetransform.h>
 #include <gst/audio/audio.h>
 #include <gst/audio/gstaudiofilter.h>
+#include <gst/controller/gstdirectcontrolbinding.h>
+#include <gst/controller/gsttimedvaluecontrolsource.h>
 
 #ifdef HAVE_ORC
 #include <orc/orcfunctions.h>
@@ -78,6 +81,20 @@
 #define VOLUME_MAX_INT32             G_MAXINT32
 #define VOLUME_MIN_INT32             G_MININT32
 
+/* controlled volume is generated in ramp segments of this many samples. The
+ * control binding is probed VOLUME_RAMP_PROBES times per segment, segments
+ * whose probes lie on a line within VOLUME_RAMP_EPSILON are generated from
+ * their end points. Segments with a control point inside them and all other
+ * segments are looked up sample by sample */
+#define VOLUME_RAMP_SEGMENT          64
+#define VOLUME_RAMP_PROBES           4
+#define VOLUME_RAMP_EPSILON          1e-9
+
+/* sample index inside a ramp segment, the orc ramp functions compute the gain
+ * of each sample as start + index * step from it */
+static gdouble volume_ramp_index_f64[VOLUME_RAMP_SEGMENT];
+static gfloat volume_ramp_index_f32[VOLUME_RAMP_SEGMENT];
+
 #define GST_CAT_DEFAULT gst_volume_debug
 GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
 
@@ -130,34 +147,46 @@ static void volume_process_double (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_controlled_double (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes);
+static void volume_process_ramp_double (GstVolume * self, gpointer bytes,
+    gdouble start, gdouble step, guint channels, guint n_bytes);
 static void volume_process_float (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_controlled_float (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes);
+static void volume_process_ramp_float (GstVolume * self, gpointer bytes,
+    gdouble start, gdouble step, guint channels, guint n_bytes);
 static void volume_process_int32 (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_int32_clamp (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_controlled_int32_clamp (GstVolume * self,
     gpointer bytes, gdouble * volume, guint channels, guint n_bytes);
+static void volume_process_ramp_int32_clamp (GstVolume * self, gpointer bytes,
+    gdouble start, gdouble step, guint channels, guint n_bytes);
 static void volume_process_int24 (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_int24_clamp (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_controlled_int24_clamp (GstVolume * self,
     gpointer bytes, gdouble * volume, guint channels, guint n_bytes);
+static void volume_process_ramp_int24_clamp (GstVolume * self, gpointer bytes,
+    gdouble start, gdouble step, guint channels, guint n_bytes);
 static void volume_process_int16 (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_int16_clamp (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_controlled_int16_clamp (GstVolume * self,
     gpointer bytes, gdouble * volume, guint channels, guint n_bytes);
+static void volume_process_ramp_int16_clamp (GstVolume * self, gpointer bytes,
+    gdouble start, gdouble step, guint channels, guint n_bytes);
 static void volume_process_int8 (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_int8_clamp (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_controlled_int8_clamp (GstVolume * self,
     gpointer bytes, gdouble * volume, guint channels, guint n_bytes);
+static void volume_process_ramp_int8_clamp (GstVolume * self, gpointer bytes,
+    gdouble start, gdouble step, guint channels, guint n_bytes);
 
 
 /* helper functions */
@@ -169,6 +198,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
 
   self->process = NULL;
   self->process_controlled = NULL;
+  self->process_ramp = NULL;
 
   format = GST_AUDIO_INFO_FORMAT (info);
 
@@ -184,6 +214,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int32;
       }
       self->process_controlled = volume_process_controlled_int32_clamp;
+      self->process_ramp = volume_process_ramp_int32_clamp;
       break;
     case GST_AUDIO_FORMAT_S24:
       /* only clamp if the gain is greater than 1.0 */
@@ -193,6 +224,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int24;
       }
       self->process_controlled = volume_process_controlled_int24_clamp;
+      self->process_ramp = volume_process_ramp_int24_clamp;
       break;
     case GST_AUDIO_FORMAT_S16:
       /* only clamp if the gain is greater than 1.0 */
@@ -202,6 +234,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int16;
       }
       self->process_controlled = volume_process_controlled_int16_clamp;
+      self->process_ramp = volume_process_ramp_int16_clamp;
       break;
     case GST_AUDIO_FORMAT_S8:
       /* only clamp if the gain is greater than 1.0 */
@@ -211,14 +244,17 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int8;
       }
       self->process_controlled = volume_process_controlled_int8_clamp;
+      self->process_ramp = volume_process_ramp_int8_clamp;
       break;
     case GST_AUDIO_FORMAT_F32:
       self->process = volume_process_float;
       self->process_controlled = volume_process_controlled_float;
+      self->process_ramp = volume_process_ramp_float;
       break;
     case GST_AUDIO_FORMAT_F64:
       self->process = volume_process_double;
       self->process_controlled = volume_process_controlled_double;
+      self->process_ramp = volume_process_ramp_double;
       break;
     default:
       break;
@@ -302,6 +338,7 @@ gst_volume_class_init (GstVolumeClass * klass)
   GstBaseTransformClass *trans_class;
   GstAudioFilterClass *filter_class;
   GstCaps *caps;
+  gint i;
 
   gobject_class = (GObjectClass *) klass;
   element_class = (GstElementClass *) klass;
@@ -336,6 +373,11 @@ gst_volume_class_init (GstVolumeClass * klass)
   trans_class->transform_ip_on_passthrough = FALSE;
 
   filter_class->setup = GST_DEBUG_FUNCPTR (volume_setup);
+
+  for (i = 0; i < VOLUME_RAMP_SEGMENT; i++) {
+    volume_ramp_index_f64[i] = i;
+    volume_ramp_index_f32[i] = i;
+  }
 }
 
 static void
@@ -380,6 +422,28 @@ volume_process_controlled_double (GstVolume * self, gpointer bytes,
   }
 }
 
+static void
+volume_process_ramp_double (GstVolume * self, gpointer bytes, gdouble start,
+    gdouble step, guint channels, guint n_bytes)
+{
+  gdouble *data = (gdouble *) bytes;
+  guint num_samples = n_bytes / (sizeof (gdouble) * channels);
+  guint i, j;
+  gdouble vol;
+
+  if (channels == 1) {
+    volume_orc_process_ramp_f64_1ch (data, volume_ramp_index_f64, start, step,
+        num_samples);
+  } else {
+    for (i = 0; i < num_samples; i++) {
+      vol = start + i * step;
+      for (j = 0; j < channels; j++) {
+        *data++ *= vol;
+      }
+    }
+  }
+}
+
 static void
 volume_process_float (GstVolume * self, gpointer bytes, guint n_bytes)
 {
@@ -412,6 +476,28 @@ volume_process_controlled_float (GstVolume * self, gpointer bytes,
   }
 }
 
+static void
+volume_process_ramp_float (GstVolume * self, gpointer bytes, gdouble start,
+    gdouble step, guint channels, guint n_bytes)
+{
+  gfloat *data = (gfloat *) bytes;
+  guint num_samples = n_bytes / (sizeof (gfloat) * channels);
+  guint i, j;
+  gdouble vol;
+
+  if (channels == 1) {
+    volume_orc_process_ramp_f32_1ch (data, volume_ramp_index_f32, start, step,
+        num_samples);
+  } else {
+    for (i = 0; i < num_samples; i++) {
+      vol = start + i * step;
+      for (j = 0; j < channels; j++) {
+        *data++ *= vol;
+      }
+    }
+  }
+}
+
 static void
 volume_process_int32 (GstVolume * self, gpointer bytes, guint n_bytes)
 {
@@ -457,6 +543,24 @@ volume_process_controlled_int32_clamp (GstVolume * self, gpointer bytes,
   }
 }
 
+static void
+volume_process_ramp_int32_clamp (GstVolume * self, gpointer bytes,
+    gdouble start, gdouble step, guint channels, guint n_bytes)
+{
+  gint32 *data = (gint32 *) bytes;
+  guint i, j;
+  guint num_samples = n_bytes / (sizeof (gint32) * channels);
+  gdouble vol, val;
+
+  for (i = 0; i < num_samples; i++) {
+    vol = start + i * step;
+    for (j = 0; j < channels; j++) {
+      val = *data * vol;
+      *data++ = (gint32) CLAMP (val, VOLUME_MIN_INT32, VOLUME_MAX_INT32);
+    }
+  }
+}
+
 #if (G_BYTE_ORDER == G_LITTLE_ENDIAN)
 #define get_unaligned_i24(_x) ( (((guint8*)_x)[0]) | ((((guint8*)_x)[1]) << 8) | ((((gint8*)_x)[2]) << 16) )
 
@@ -542,6 +646,25 @@ volume_process_controlled_int24_clamp (GstVolume * self, gpointer bytes,
   }
 }
 
+static void
+volume_process_ramp_int24_clamp (GstVolume * self, gpointer bytes,
+    gdouble start, gdouble step, guint channels, guint n_bytes)
+{
+  gint8 *data = (gint8 *) bytes;        /* treat the data as a byte stream */
+  guint i, j;
+  guint num_samples = n_bytes / (sizeof (gint8) * 3 * channels);
+  gdouble vol, val;
+
+  for (i = 0; i < num_samples; i++) {
+    vol = start + i * step;
+    for (j = 0; j < channels; j++) {
+      val = get_unaligned_i24 (data) * vol;
+      val = CLAMP (val, VOLUME_MIN_INT24, VOLUME_MAX_INT24);
+      write_unaligned_u24 (data, (gint32) val);
+    }
+  }
+}
+
 static void
 volume_process_int16 (GstVolume * self, gpointer bytes, guint n_bytes)
 {
@@ -590,6 +713,29 @@ volume_process_controlled_int16_clamp (GstVolume * self, gpointer bytes,
   }
 }
 
+static void
+volume_process_ramp_int16_clamp (GstVolume * self, gpointer bytes,
+    gdouble start, gdouble step, guint channels, guint n_bytes)
+{
+  gint16 *data = (gint16 *) bytes;
+  guint i, j;
+  guint num_samples = n_bytes / (sizeof (gint16) * channels);
+  gdouble vol, val;
+
+  if (channels == 1) {
+    volume_orc_process_ramp_int16_1ch (data, volume_ramp_index_f32, start, step,
+        num_samples);
+  } else {
+    for (i = 0; i < num_samples; i++) {
+      vol = start + i * step;
+      for (j = 0; j < channels; j++) {
+        val = *data * vol;
+        *data++ = (gint16) CLAMP (val, VOLUME_MIN_INT16, VOLUME_MAX_INT16);
+      }
+    }
+  }
+}
+
 static void
 volume_process_int8 (GstVolume * self, gpointer bytes, guint n_bytes)
 {
@@ -638,6 +784,227 @@ volume_process_controlled_int8_clamp (GstVolume * self, gpointer bytes,
   }
 }
 
+static void
+volume_process_ramp_int8_clamp (GstVolume * self, gpointer bytes,
+    gdouble start, gdouble step, guint channels, guint n_bytes)
+{
+  gint8 *data = (gint8 *) bytes;
+  guint i, j;
+  guint num_samples = n_bytes / (sizeof (gint8) * channels);
+  gdouble val, vol;
+
+  for (i = 0; i < num_samples; i++) {
+    vol = start + i * step;
+    for (j = 0; j < channels; j++) {
+      val = *data * vol;
+      *data++ = (gint8) CLAMP (val, VOLUME_MIN_INT8, VOLUME_MAX_INT8);
+    }
+  }
+}
+
+/* TRUE when the probes of a segment lie on a line. Only timed value control
+ * sources get here, they are linear or constant between control points or
+ * need a lookup anyway, like cubic interpolation */
+static gboolean
+volume_ramp_is_linear (const gdouble * probes)
+{
+  gdouble start = probes[0], end = probes[VOLUME_RAMP_PROBES], f;
+  guint i;
+
+  if (isnan (start) || isnan (end))
+    return FALSE;
+
+  for (i = 1; i < VOLUME_RAMP_PROBES; i++) {
+    /* no control value at this probe, look up the segment */
+    if (isnan (probes[i]))
+      return FALSE;
+
+    f = (gdouble) i / VOLUME_RAMP_PROBES;
+    if (fabs (probes[i] - (start + (end - start) * f)) > VOLUME_RAMP_EPSILON)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+static void
+volume_ramp_linear (gdouble * volumes, gdouble start, gdouble end, guint len)
+{
+  gdouble step = (end - start) / VOLUME_RAMP_SEGMENT;
+  guint i;
+
+  for (i = 0; i < len; i++)
+    volumes[i] = start + i * step;
+}
+
+/* returns the control source of @cb when its values only change shape at
+ * control points, NULL for all other sources */
+static GstTimedValueControlSource *
+volume_get_timed_value_source (GstControlBinding * cb)
+{
+  GstControlSource *cs = NULL;
+
+  if (!GST_IS_DIRECT_CONTROL_BINDING (cb))
+    return NULL;
+
+  g_object_get (cb, "control-source", &cs, NULL);
+  if (cs && !GST_IS_TIMED_VALUE_CONTROL_SOURCE (cs)) {
+    gst_object_unref (cs);
+    cs = NULL;
+  }
+  return (GstTimedValueControlSource *) cs;
+}
+
+/* the probes can't see a notch or a step that falls between them, mark all
+ * segments with a control point inside them for a per-sample lookup */
+static void
+volume_split_ramp (GstVolume * self, GstTimedValueControlSource * tvcs,
+    GstClockTime ts, GstClockTime interval, guint n_segments)
+{
+  GstClockTime seg_duration = interval * VOLUME_RAMP_SEGMENT;
+  GSequenceIter *iter;
+  GstControlPoint *cp;
+  guint64 offset, seg;
+
+  GST_TIMED_VALUE_CONTROL_SOURCE_LOCK (tvcs);
+  if (tvcs->values == NULL)
+    goto done;
+
+  iter = gst_timed_value_control_source_find_control_point_iter (tvcs, ts);
+  if (iter == NULL)
+    iter = g_sequence_get_begin_iter (tvcs->values);
+
+  for (; !g_sequence_iter_is_end (iter); iter = g_sequence_iter_next (iter)) {
+    cp = g_sequence_get (iter);
+    if (cp->timestamp <= ts)
+      continue;
+
+    offset = cp->timestamp - ts;
+    seg = offset / seg_duration;
+    if (seg >= n_segments)
+      break;
+
+    /* a control point on a segment boundary just starts the next ramp */
+    if (offset % seg_duration != 0)
+      self->probes[seg * VOLUME_RAMP_PROBES + 1] = NAN;
+  }
+
+done:
+  GST_TIMED_VALUE_CONTROL_SOURCE_UNLOCK (tvcs);
+}
+
+/* probe the ramp segments of @nsamples values of @cb starting at @ts into
+ * self->probes. Returns FALSE for control sources that need to be looked up
+ * sample by sample */
+static gboolean
+volume_probe_ramp (GstVolume * self, GstControlBinding * cb, GstClockTime ts,
+    GstClockTime interval, guint nsamples)
+{
+  guint n_segments = (nsamples + VOLUME_RAMP_SEGMENT - 1) /
+      VOLUME_RAMP_SEGMENT;
+  guint n_probes = n_segments * VOLUME_RAMP_PROBES + 1;
+  GstClockTime probe_interval =
+      interval * (VOLUME_RAMP_SEGMENT / VOLUME_RAMP_PROBES);
+  GstTimedValueControlSource *tvcs;
+  guint i;
+
+  tvcs = volume_get_timed_value_source (cb);
+  if (tvcs == NULL)
+    return FALSE;
+
+  if (self->probes_count < n_probes) {
+    self->probes = g_realloc (self->probes, sizeof (gdouble) * n_probes);
+    self->probes_count = n_probes;
+  }
+  /* bindings leave the values untouched where there is no control value */
+  for (i = 0; i < n_probes; i++)
+    self->probes[i] = NAN;
+
+  if (!gst_control_binding_get_value_array (cb, ts, probe_interval, n_probes,
+          (gpointer) self->probes)) {
+    gst_object_unref (tvcs);
+    return FALSE;
+  }
+
+  volume_split_ramp (self, tvcs, ts, interval, n_segments);
+  gst_object_unref (tvcs);
+
+  return TRUE;
+}
+
+/* fill self->volumes with @nsamples values of @cb starting at @ts. Ramps are
+ * generated from the probed segment end points so the binding only needs to
+ * be evaluated for segments that contain a control point or that are not
+ * linear. Control sources without control points are always
+ * looked up sample by sample. */
+static gboolean
+volume_get_ramp (GstVolume * self, GstControlBinding * cb, GstClockTime ts,
+    GstClockTime interval, guint nsamples)
+{
+  guint n_segments = (nsamples + VOLUME_RAMP_SEGMENT - 1) /
+      VOLUME_RAMP_SEGMENT;
+  gdouble *probes, *volumes;
+  guint i, len;
+
+  if (!volume_probe_ramp (self, cb, ts, interval, nsamples))
+    return gst_control_binding_get_value_array (cb, ts, interval, nsamples,
+        (gpointer) self->volumes);
+
+  for (i = 0; i < n_segments; i++) {
+    probes = self->probes + i * VOLUME_RAMP_PROBES;
+    volumes = self->volumes + i * VOLUME_RAMP_SEGMENT;
+    len = MIN (VOLUME_RAMP_SEGMENT, nsamples - i * VOLUME_RAMP_SEGMENT);
+
+    if (volume_ramp_is_linear (probes)) {
+      volume_ramp_linear (volumes, probes[0], probes[VOLUME_RAMP_PROBES], len);
+    } else if (!gst_control_binding_get_value_array (cb,
+            ts + i * VOLUME_RAMP_SEGMENT * interval, interval, len,
+            (gpointer) volumes)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/* apply @nsamples values of @cb starting at @ts to @data. Linear ramp
+ * segments are applied directly with self->process_ramp, which computes the
+ * gain from the start and step of the segment. Only the other segments are
+ * looked up into self->volumes, when that fails they get the current volume.
+ * Returns FALSE without touching @data when the ramps can't be probed. */
+static gboolean
+volume_apply_ramp (GstVolume * self, GstControlBinding * cb, GstClockTime ts,
+    GstClockTime interval, guint8 * data, guint bpf, guint channels,
+    guint nsamples)
+{
+  guint n_segments = (nsamples + VOLUME_RAMP_SEGMENT - 1) /
+      VOLUME_RAMP_SEGMENT;
+  gdouble *probes, start, step;
+  guint i, len;
+
+  if (!volume_probe_ramp (self, cb, ts, interval, nsamples))
+    return FALSE;
+
+  for (i = 0; i < n_segments; i++) {
+    probes = self->probes + i * VOLUME_RAMP_PROBES;
+    len = MIN (VOLUME_RAMP_SEGMENT, nsamples - i * VOLUME_RAMP_SEGMENT);
+
+    if (volume_ramp_is_linear (probes)) {
+      start = probes[0];
+      step = (probes[VOLUME_RAMP_PROBES] - start) / VOLUME_RAMP_SEGMENT;
+      self->process_ramp (self, data, start, step, channels, len * bpf);
+    } else {
+      if (!gst_control_binding_get_value_array (cb,
+              ts + i * VOLUME_RAMP_SEGMENT * interval, interval, len,
+              (gpointer) self->volumes))
+        volume_orc_memset_f64 (self->volumes, self->current_volume, len);
+      self->process_controlled (self, data, self->volumes, channels, len * bpf);
+    }
+    data += len * bpf;
+  }
+
+  return TRUE;
+}
+
 /* GstBaseTransform vmethod implementations */
 
 /* get notified of caps and plug in the correct process function */
@@ -673,6 +1040,10 @@ volume_stop (GstBaseTransform * base)
   self->volumes = NULL;
   self->volumes_count = 0;
 
+  g_free (self->probes);
+  self->probes = NULL;
+  self->probes_count = 0;
+
   g_free (self->mutes);
   self->mutes = NULL;
   self->mutes_count = 0;
@@ -760,10 +1131,17 @@ volume_transform_ip (GstBaseTransform * base, GstBuffer * outbuf)
         self->volumes_count = nsamples;
       }
 
+      /* without a mute binding linear ramps don't need self->volumes */
+      if (volume_cb && !mute_cb && self->volumes &&
+          volume_apply_ramp (self, volume_cb, ts, interval, map.data,
+              width * channels, channels, nsamples)) {
+        gst_object_unref (volume_cb);
+        goto done;
+      }
+
       if (volume_cb && self->volumes) {
         have_volumes =
-            gst_control_binding_get_value_array (volume_cb, ts, interval,
-            nsamples, (gpointer) self->volumes);
+            volume_get_ramp (self, volume_cb, ts, interval, nsamples);
         gst_object_replace ((GstObject **) & volume_cb, NULL);
       }
       if (!have_volumes) {
@@ -56,6 +56,7 @@ struct _GstVolume {
 
   void (*process)(GstVolume*, gpointer, guint);
   void (*process_controlled)(GstVolume*, gpointer, gdouble *, guint, guint);
+  void (*process_ramp)(GstVolume*, gpointer, gdouble, gdouble, guint, guint);
 
   gboolean mute;
   gfloat volume;
@@ -75,6 +76,8 @@ struct _GstVolume {
   guint mutes_count;
   gdouble *volumes;
   guint volumes_count;
+  gdouble *probes;
+  guint probes_count;
 };
 
 struct _GstVolumeClass {
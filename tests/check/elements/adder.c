@@ -29,6 +29,8 @@
 #endif
 
 #include <unistd.h>
+#include <math.h>
+#include <string.h>
 
 #include <gst/check/gstcheck.h>
 #include <gst/check/gstconsistencychecker.h>
@@ -1257,6 +1259,528 @@ GST_START_TEST (test_flush_start_flush_stop)
 GST_END_TEST;
 
 
+typedef struct
+{
+  gdouble amplitude;
+  gint n_buffers;
+  gboolean s16;
+} MixCheck;
+
+/* the inputs are square waves in phase, so the mix is one as well */
+static void
+check_mix_amplitude_cb (GstElement * fakesink, GstBuffer * buffer,
+    GstPad * pad, gpointer user_data)
+{
+  MixCheck *check = user_data;
+  GstMapInfo map;
+  gsize i;
+
+  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  if (check->s16) {
+    const gint16 *data = (const gint16 *) map.data;
+
+    /* a few steps of rounding in the sources and the integer volume */
+    for (i = 0; i < map.size / sizeof (gint16); i++)
+      fail_unless (fabs (fabs (data[i] / 32767.0) - check->amplitude) < 1e-4,
+          "sample %" G_GSIZE_FORMAT ": %d", i, data[i]);
+  } else {
+    const gfloat *data = (const gfloat *) map.data;
+
+    for (i = 0; i < map.size / sizeof (gfloat); i++)
+      fail_unless (fabs (fabs (data[i]) - check->amplitude) < 1e-6, "sample %"
+          G_GSIZE_FORMAT ": %f", i, data[i]);
+  }
+  gst_buffer_unmap (buffer, &map);
+  check->n_buffers++;
+}
+
+static void
+add_square_sources (GstElement * bin, GstElement * adder, const gdouble * amp,
+    gint n_sources, const gchar * format)
+{
+  GstCaps *caps;
+  gint i;
+
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, format,
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, 44100, "channels", G_TYPE_INT, 1, NULL);
+
+  for (i = 0; i < n_sources; i++) {
+    GstElement *src;
+
+    src = gst_element_factory_make ("audiotestsrc", NULL);
+    g_object_set (src, "wave", 1, NULL);        /* square */
+    g_object_set (src, "volume", amp[i], "num-buffers", 5, NULL);
+    gst_bin_add (GST_BIN (bin), src);
+    fail_unless (gst_element_link_filtered (src, adder, caps));
+  }
+  gst_caps_unref (caps);
+}
+
+static void
+run_until_eos (GstElement * bin)
+{
+  GstMessage *msg;
+  GstBus *bus;
+
+  fail_unless (gst_element_set_state (bin,
+          GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE);
+
+  bus = gst_element_get_bus (bin);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (bin, GST_STATE_NULL);
+}
+
+/* check that the pad volume and mute are applied while mixing */
+GST_START_TEST (test_mix_volume)
+{
+  static const gdouble amp[] = { 0.25, 0.25, 0.25 };
+  MixCheck check = { 0.375, 0 };
+  GstElement *bin, *adder, *sink;
+  GstPad *pad;
+
+  bin = gst_pipeline_new ("pipeline");
+  adder = gst_element_factory_make ("adder", "adder");
+  sink = gst_element_factory_make ("fakesink", "sink");
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", (GCallback) check_mix_amplitude_cb,
+      &check);
+  gst_bin_add_many (GST_BIN (bin), adder, sink, NULL);
+  fail_unless (gst_element_link (adder, sink));
+  add_square_sources (bin, adder, amp, 3, GST_AUDIO_NE (F32));
+
+  /* 0.25 at volume 1.0, 0.25 at volume 0.5 and a muted input */
+  pad = gst_element_get_static_pad (adder, "sink_1");
+  g_object_set (pad, "volume", 0.5, NULL);
+  gst_object_unref (pad);
+  pad = gst_element_get_static_pad (adder, "sink_2");
+  g_object_set (pad, "mute", TRUE, NULL);
+  gst_object_unref (pad);
+
+  run_until_eos (bin);
+  fail_unless_equals_int (check.n_buffers, 5);
+
+  gst_object_unref (bin);
+}
+
+GST_END_TEST;
+
+/* check that a mix-minus pad outputs the mix without its own sink pad */
+GST_START_TEST (test_mix_minus)
+{
+  static const gdouble amp[] = { 0.25, 0.125, 0.0625 };
+  MixCheck check = { 0.4375, 0 }, check_minus = { 0.1875, 0 };
+  GstElement *bin, *adder, *sink, *minus_sink;
+  GstPad *minus_pad, *pad;
+
+  bin = gst_pipeline_new ("pipeline");
+  adder = gst_element_factory_make ("adder", "adder");
+  sink = gst_element_factory_make ("fakesink", "sink");
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", (GCallback) check_mix_amplitude_cb,
+      &check);
+  minus_sink = gst_element_factory_make ("fakesink", "minus_sink");
+  g_object_set (minus_sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (minus_sink, "handoff",
+      (GCallback) check_mix_amplitude_cb, &check_minus);
+  gst_bin_add_many (GST_BIN (bin), adder, sink, minus_sink, NULL);
+  fail_unless (gst_element_link (adder, sink));
+  add_square_sources (bin, adder, amp, 3, GST_AUDIO_NE (F32));
+
+  /* needs an existing sink pad */
+  fail_unless (gst_element_get_request_pad (adder, "src_5") == NULL);
+  minus_pad = gst_element_get_request_pad (adder, "src_0");
+  fail_unless (minus_pad != NULL);
+  /* only one mix-minus pad per sink pad */
+  fail_unless (gst_element_get_request_pad (adder, "src_0") == NULL);
+
+  pad = gst_element_get_static_pad (minus_sink, "sink");
+  fail_unless_equals_int (gst_pad_link (minus_pad, pad), GST_PAD_LINK_OK);
+  gst_object_unref (pad);
+
+  run_until_eos (bin);
+  fail_unless_equals_int (check.n_buffers, 5);
+  fail_unless_equals_int (check_minus.n_buffers, 5);
+
+  gst_element_release_request_pad (adder, minus_pad);
+  gst_object_unref (minus_pad);
+  gst_object_unref (bin);
+}
+
+GST_END_TEST;
+
+static GstPad *
+link_minus_sink (GstElement * bin, GstElement * adder, const gchar * name,
+    MixCheck * check)
+{
+  GstElement *minus_sink;
+  GstPad *minus_pad, *pad;
+
+  minus_sink = gst_element_factory_make ("fakesink", NULL);
+  g_object_set (minus_sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (minus_sink, "handoff",
+      (GCallback) check_mix_amplitude_cb, check);
+  gst_bin_add (GST_BIN (bin), minus_sink);
+
+  minus_pad = gst_element_get_request_pad (adder, name);
+  fail_unless (minus_pad != NULL);
+  pad = gst_element_get_static_pad (minus_sink, "sink");
+  fail_unless_equals_int (gst_pad_link (minus_pad, pad), GST_PAD_LINK_OK);
+  gst_object_unref (pad);
+
+  return minus_pad;
+}
+
+/* integer mixes only saturate the outputs, a mix-minus output is computed
+ * from the unclipped sum */
+GST_START_TEST (test_mix_minus_s16)
+{
+  static const gdouble amp[] = { 0.75, 0.5, 0.25 };
+  MixCheck check = { 1.0, 0, TRUE }, check_minus = { 0.75, 0, TRUE };
+  GstElement *bin, *adder, *sink;
+  GstPad *minus_pad;
+
+  bin = gst_pipeline_new ("pipeline");
+  adder = gst_element_factory_make ("adder", "adder");
+  sink = gst_element_factory_make ("fakesink", "sink");
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", (GCallback) check_mix_amplitude_cb,
+      &check);
+  gst_bin_add_many (GST_BIN (bin), adder, sink, NULL);
+  fail_unless (gst_element_link (adder, sink));
+  add_square_sources (bin, adder, amp, 3, GST_AUDIO_NE (S16));
+
+  minus_pad = link_minus_sink (bin, adder, "src_0", &check_minus);
+
+  run_until_eos (bin);
+  fail_unless_equals_int (check.n_buffers, 5);
+  fail_unless_equals_int (check_minus.n_buffers, 5);
+
+  gst_element_release_request_pad (adder, minus_pad);
+  gst_object_unref (minus_pad);
+  gst_object_unref (bin);
+}
+
+GST_END_TEST;
+
+/* the pad volume applies to the mix-minus outputs of the other pads, a muted
+ * pad gets the complete mix */
+GST_START_TEST (test_mix_minus_volume)
+{
+  static const gdouble amp[] = { 0.25, 0.25, 0.25 };
+  MixCheck check = { 0.375, 0 };
+  MixCheck check_minus1 = { 0.25, 0 }, check_minus2 = { 0.375, 0 };
+  GstElement *bin, *adder, *sink;
+  GstPad *minus_pad1, *minus_pad2, *pad;
+
+  bin = gst_pipeline_new ("pipeline");
+  adder = gst_element_factory_make ("adder", "adder");
+  sink = gst_element_factory_make ("fakesink", "sink");
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", (GCallback) check_mix_amplitude_cb,
+      &check);
+  gst_bin_add_many (GST_BIN (bin), adder, sink, NULL);
+  fail_unless (gst_element_link (adder, sink));
+  add_square_sources (bin, adder, amp, 3, GST_AUDIO_NE (F32));
+
+  pad = gst_element_get_static_pad (adder, "sink_1");
+  g_object_set (pad, "volume", 0.5, NULL);
+  gst_object_unref (pad);
+  pad = gst_element_get_static_pad (adder, "sink_2");
+  g_object_set (pad, "mute", TRUE, NULL);
+  gst_object_unref (pad);
+
+  minus_pad1 = link_minus_sink (bin, adder, "src_1", &check_minus1);
+  minus_pad2 = link_minus_sink (bin, adder, "src_2", &check_minus2);
+
+  run_until_eos (bin);
+  fail_unless_equals_int (check.n_buffers, 5);
+  fail_unless_equals_int (check_minus1.n_buffers, 5);
+  fail_unless_equals_int (check_minus2.n_buffers, 5);
+
+  gst_element_release_request_pad (adder, minus_pad1);
+  gst_object_unref (minus_pad1);
+  gst_element_release_request_pad (adder, minus_pad2);
+  gst_object_unref (minus_pad2);
+  gst_object_unref (bin);
+}
+
+GST_END_TEST;
+
+static void
+collect_bytes_cb (GstElement * fakesink, GstBuffer * buffer, GstPad * pad,
+    gpointer user_data)
+{
+  GByteArray *bytes = user_data;
+  GstMapInfo map;
+
+  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  g_byte_array_append (bytes, map.data, map.size);
+  gst_buffer_unmap (buffer, &map);
+}
+
+/* mix @n_inputs inputs of @n_samples mono samples of @format pushed by appsrc
+ * and compare the output with @expected */
+static void
+check_mix_samples (const gchar * format, gint sample_size, gint n_samples,
+    const gpointer * inputs, gint n_inputs, gconstpointer expected)
+{
+  GstElement *bin, *adder, *sink;
+  GByteArray *bytes;
+  GstCaps *caps;
+  gint i;
+
+  bin = gst_pipeline_new ("pipeline");
+  adder = gst_element_factory_make ("adder", "adder");
+  sink = gst_element_factory_make ("fakesink", "sink");
+  bytes = g_byte_array_new ();
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", (GCallback) collect_bytes_cb, bytes);
+  gst_bin_add_many (GST_BIN (bin), adder, sink, NULL);
+  fail_unless (gst_element_link (adder, sink));
+
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, format,
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, 8000, "channels", G_TYPE_INT, 1, NULL);
+
+  for (i = 0; i < n_inputs; i++) {
+    GstElement *src;
+    GstBuffer *buf;
+    GstFlowReturn flow;
+
+    src = gst_element_factory_make ("appsrc", NULL);
+    g_object_set (src, "caps", caps, "format", GST_FORMAT_TIME, NULL);
+    gst_bin_add (GST_BIN (bin), src);
+    fail_unless (gst_element_link (src, adder));
+
+    buf = gst_buffer_new_allocate (NULL, n_samples * sample_size, NULL);
+    gst_buffer_fill (buf, 0, inputs[i], n_samples * sample_size);
+    GST_BUFFER_PTS (buf) = 0;
+    GST_BUFFER_DURATION (buf) =
+        gst_util_uint64_scale_int (n_samples, GST_SECOND, 8000);
+    g_signal_emit_by_name (src, "push-buffer", buf, &flow);
+    fail_unless_equals_int (flow, GST_FLOW_OK);
+    gst_buffer_unref (buf);
+    g_signal_emit_by_name (src, "end-of-stream", &flow);
+  }
+  gst_caps_unref (caps);
+
+  run_until_eos (bin);
+
+  fail_unless_equals_int (bytes->len, n_samples * sample_size);
+  fail_unless (memcmp (bytes->data, expected, bytes->len) == 0);
+
+  g_byte_array_unref (bytes);
+  gst_object_unref (bin);
+}
+
+/* the last two samples of every format saturate */
+GST_START_TEST (test_mix_s8)
+{
+  static const gint8 in0[] = { 10, -20, 100, -100 };
+  static const gint8 in1[] = { 20, -30, 100, -100 };
+  static const gint8 in2[] = { -5, 5, 1, -1 };
+  static const gint8 out[] = { 25, -45, G_MAXINT8, G_MININT8 };
+  const gpointer inputs[] = { (gpointer) in0, (gpointer) in1, (gpointer) in2 };
+
+  check_mix_samples ("S8", 1, 4, inputs, 3, out);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_mix_s16)
+{
+  static const gint16 in0[] = { 1000, -2000, 30000, -30000 };
+  static const gint16 in1[] = { 2000, -3000, 10000, -10000 };
+  static const gint16 in2[] = { -500, 500, 1, -1 };
+  static const gint16 out[] = { 2500, -4500, G_MAXINT16, G_MININT16 };
+  const gpointer inputs[] = { (gpointer) in0, (gpointer) in1, (gpointer) in2 };
+
+  check_mix_samples (GST_AUDIO_NE (S16), 2, 4, inputs, 3, out);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_mix_s32)
+{
+  static const gint32 in0[] =
+      { 100000, -200000, G_MAXINT32 - 5, G_MININT32 + 5 };
+  static const gint32 in1[] = { 200000, -300000, 10, -10 };
+  static const gint32 in2[] = { -50000, 50000, 1, -1 };
+  static const gint32 out[] = { 250000, -450000, G_MAXINT32, G_MININT32 };
+  const gpointer inputs[] = { (gpointer) in0, (gpointer) in1, (gpointer) in2 };
+
+  check_mix_samples (GST_AUDIO_NE (S32), 4, 4, inputs, 3, out);
+}
+
+GST_END_TEST;
+
+/* unsigned samples are the signed ones above shifted by the midpoint */
+GST_START_TEST (test_mix_u8)
+{
+  static const guint8 in0[] = { 138, 108, 228, 28 };
+  static const guint8 in1[] = { 148, 98, 228, 28 };
+  static const guint8 in2[] = { 123, 133, 129, 127 };
+  static const guint8 out[] = { 153, 83, G_MAXUINT8, 0 };
+  const gpointer inputs[] = { (gpointer) in0, (gpointer) in1, (gpointer) in2 };
+
+  check_mix_samples ("U8", 1, 4, inputs, 3, out);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_mix_u16)
+{
+  static const guint16 in0[] = { 33768, 30768, 62768, 2768 };
+  static const guint16 in1[] = { 34768, 29768, 42768, 22768 };
+  static const guint16 in2[] = { 32268, 33268, 32769, 32767 };
+  static const guint16 out[] = { 35268, 28268, G_MAXUINT16, 0 };
+  const gpointer inputs[] = { (gpointer) in0, (gpointer) in1, (gpointer) in2 };
+
+  check_mix_samples (GST_AUDIO_NE (U16), 2, 4, inputs, 3, out);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_mix_u32)
+{
+  static const guint32 in0[] = { 0x80000000U + 100000, 0x80000000U - 200000,
+    G_MAXUINT32 - 5, 5
+  };
+  static const guint32 in1[] = { 0x80000000U + 200000, 0x80000000U - 300000,
+    0x80000000U + 10, 0x80000000U - 10
+  };
+  static const guint32 in2[] = { 0x80000000U - 50000, 0x80000000U + 50000,
+    0x80000000U + 1, 0x80000000U - 1
+  };
+  static const guint32 out[] = { 0x80000000U + 250000, 0x80000000U - 450000,
+    G_MAXUINT32, 0
+  };
+  const gpointer inputs[] = { (gpointer) in0, (gpointer) in1, (gpointer) in2 };
+
+  check_mix_samples (GST_AUDIO_NE (U32), 4, 4, inputs, 3, out);
+}
+
+GST_END_TEST;
+
+/* floats are not clipped */
+GST_START_TEST (test_mix_f32)
+{
+  static const gfloat in0[] = { 0.5, -0.25, 0.75, -0.75 };
+  static const gfloat in1[] = { 0.25, -0.5, 0.5, -0.5 };
+  static const gfloat in2[] = { 0.125, 0.125, 0.0, 0.0 };
+  static const gfloat out[] = { 0.875, -0.625, 1.25, -1.25 };
+  const gpointer inputs[] = { (gpointer) in0, (gpointer) in1, (gpointer) in2 };
+
+  check_mix_samples (GST_AUDIO_NE (F32), 4, 4, inputs, 3, out);
+}
+
+GST_END_TEST;
+
+/* set to something larger to do benchmarks */
+#define MIX_BUFFERS 10
+
+typedef struct
+{
+  gint n_inputs;
+  gint n_buffers;
+} ManyInputsCheck;
+
+/* every input is the same square wave of amplitude a, so the mix is n * a or
+ * saturated */
+static void
+check_many_inputs_cb (GstElement * fakesink, GstBuffer * buffer,
+    GstPad * pad, gpointer user_data)
+{
+  ManyInputsCheck *check = user_data;
+  GstMapInfo map;
+  const gint16 *data;
+  gint a, expected;
+  gsize i;
+
+  a = 0.05 * G_MAXINT16;
+  expected = MIN (check->n_inputs * a, G_MAXINT16);
+
+  gst_buffer_map (buffer, &map, GST_MAP_READ);
+  data = (const gint16 *) map.data;
+  for (i = 0; i < map.size / sizeof (gint16); i++) {
+    if (data[i] >= 0)
+      fail_unless_equals_int (data[i], expected);
+    else
+      fail_unless_equals_int (data[i], MAX (-check->n_inputs * a,
+              G_MININT16));
+  }
+  gst_buffer_unmap (buffer, &map);
+  check->n_buffers++;
+}
+
+static void
+run_mix_inputs (gint n_inputs)
+{
+  ManyInputsCheck check = { n_inputs, 0 };
+  GstElement *bin, *sink;
+  GstMessage *msg;
+  GString *desc;
+  GstBus *bus;
+  gint64 start;
+  gint i;
+
+  desc = g_string_new ("adder name=mix ! fakesink name=sink sync=false"
+      " signal-handoffs=true");
+  for (i = 0; i < n_inputs; i++) {
+    /* a square wave is cheap to generate, 8 inputs stay below full scale
+     * and 32 or more saturate */
+    g_string_append_printf (desc, " audiotestsrc wave=square volume=0.05"
+        " num-buffers=%d samplesperbuffer=1024"
+        " ! audio/x-raw,format=%s,channels=2 ! mix.", MIX_BUFFERS,
+        GST_AUDIO_NE (S16));
+  }
+  bin = gst_parse_launch (desc->str, NULL);
+  fail_unless (bin != NULL);
+  g_string_free (desc, TRUE);
+
+  sink = gst_bin_get_by_name (GST_BIN (bin), "sink");
+  g_signal_connect (sink, "handoff", (GCallback) check_many_inputs_cb,
+      &check);
+  gst_object_unref (sink);
+
+  start = g_get_monotonic_time ();
+  fail_unless (gst_element_set_state (bin,
+          GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE);
+
+  bus = gst_element_get_bus (bin);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  GST_DEBUG ("%d inputs: %" G_GINT64_FORMAT " us for %d buffers", n_inputs,
+      g_get_monotonic_time () - start, MIX_BUFFERS);
+
+  gst_element_set_state (bin, GST_STATE_NULL);
+  gst_object_unref (bin);
+
+  fail_unless_equals_int (check.n_buffers, MIX_BUFFERS);
+}
+
+GST_START_TEST (test_mix_many_inputs)
+{
+  run_mix_inputs (8);
+  run_mix_inputs (32);
+  run_mix_inputs (64);
+}
+
+GST_END_TEST;
+
+
 static Suite *
 adder_suite (void)
 {
@@ -1277,6 +1801,18 @@ adder_suite (void)
   tcase_add_test (tc_chain, test_duration_unknown_overrides);
   tcase_add_test (tc_chain, test_loop);
   tcase_add_test (tc_chain, test_flush_start_flush_stop);
+  tcase_add_test (tc_chain, test_mix_volume);
+  tcase_add_test (tc_chain, test_mix_s8);
+  tcase_add_test (tc_chain, test_mix_s16);
+  tcase_add_test (tc_chain, test_mix_s32);
+  tcase_add_test (tc_chain, test_mix_u8);
+  tcase_add_test (tc_chain, test_mix_u16);
+  tcase_add_test (tc_chain, test_mix_u32);
+  tcase_add_test (tc_chain, test_mix_f32);
+  tcase_add_test (tc_chain, test_mix_minus);
+  tcase_add_test (tc_chain, test_mix_minus_s16);
+  tcase_add_test (tc_chain, test_mix_minus_volume);
+  tcase_add_test (tc_chain, test_mix_many_inputs);
 
   /* Use a longer timeout */
 #ifdef HAVE_VALGRIND
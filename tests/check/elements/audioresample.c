@@ -1086,6 +1086,131 @@ GST_START_TEST (test_fft)
 
 GST_END_TEST;
 
+/* set to something larger to do benchmarks */
+#define N_BENCH_BUFFERS 4
+
+static GstBuffer *
+run_channels_pipeline (gint channels, guint n_threads, gdouble * elapsed)
+{
+  GstElement *audioresample;
+  GstBuffer *inbuffer, *outbuffer;
+  GstMapInfo map;
+  GTimer *timer;
+  GList *l;
+  gfloat *data;
+  const gint nsamples = 4800;
+  gint i, j;
+
+  audioresample = setup_audioresample (channels, 0, 48000, 44100,
+      GST_AUDIO_NE (F32));
+  g_object_set (audioresample, "n-threads", n_threads, NULL);
+
+  fail_unless (gst_element_set_state (audioresample,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  inbuffer = gst_buffer_new_and_alloc (nsamples * channels * sizeof (gfloat));
+  gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+  data = (gfloat *) map.data;
+  for (i = 0; i < nsamples; i++)
+    for (j = 0; j < channels; j++)
+      data[i * channels + j] = sinf (i * 0.01f * (j + 1));
+  gst_buffer_unmap (inbuffer, &map);
+
+  timer = g_timer_new ();
+  for (i = 0; i < N_BENCH_BUFFERS; i++) {
+    GstBuffer *buffer = gst_buffer_copy (inbuffer);
+
+    GST_BUFFER_TIMESTAMP (buffer) =
+        GST_FRAMES_TO_CLOCK_TIME (i * nsamples, 48000);
+    GST_BUFFER_DURATION (buffer) = GST_FRAMES_TO_CLOCK_TIME (nsamples, 48000);
+    GST_BUFFER_OFFSET (buffer) = i * nsamples;
+    GST_BUFFER_OFFSET_END (buffer) = (i + 1) * nsamples;
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+  *elapsed = g_timer_elapsed (timer, NULL);
+  g_timer_destroy (timer);
+  gst_buffer_unref (inbuffer);
+
+  fail_unless_equals_int (g_list_length (buffers), N_BENCH_BUFFERS);
+  outbuffer = gst_buffer_new ();
+  for (l = buffers; l; l = l->next)
+    outbuffer = gst_buffer_append (outbuffer, gst_buffer_ref (l->data));
+
+  cleanup_audioresample (audioresample);
+
+  return outbuffer;
+}
+
+GST_START_TEST (test_channel_groups)
+{
+  static const gint channels[] = { 2, 8, 32, 64 };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (channels); i++) {
+    GstBuffer *serial, *threaded;
+    GstMapInfo map;
+    gdouble serial_time, threaded_time;
+
+    serial = run_channels_pipeline (channels[i], 1, &serial_time);
+    /* use more groups than there are CPUs on small machines */
+    threaded = run_channels_pipeline (channels[i], 4, &threaded_time);
+
+    /* every channel group runs the same code on its own channels */
+    gst_buffer_map (serial, &map, GST_MAP_READ);
+    fail_unless_equals_int (gst_buffer_get_size (threaded), map.size);
+    fail_unless (gst_buffer_memcmp (threaded, 0, map.data, map.size) == 0);
+    gst_buffer_unmap (serial, &map);
+
+    GST_DEBUG ("%d channels 48000->44100: serial %f, threaded %f "
+        "(%f frames/s)", channels[i], serial_time, threaded_time,
+        N_BENCH_BUFFERS * 4800 / threaded_time);
+
+    gst_buffer_unref (serial);
+    gst_buffer_unref (threaded);
+  }
+}
+
+GST_END_TEST;
+
+/* the AVX2/FMA kernels round differently than the SSE ones but must compute
+ * the same filter. On CPUs without AVX2 both runs use the same code */
+GST_START_TEST (test_avx2_sse_equivalence)
+{
+  static const gint channels[] = { 1, 2, 8 };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (channels); i++) {
+    GstBuffer *avx2, *sse;
+    GstMapInfo avx2_map, sse_map;
+    const gfloat *a, *b;
+    gdouble elapsed;
+    gsize j;
+
+    avx2 = run_channels_pipeline (channels[i], 1, &elapsed);
+    g_setenv ("GST_AUDIORESAMPLE_NO_AVX2", "1", TRUE);
+    sse = run_channels_pipeline (channels[i], 1, &elapsed);
+    g_unsetenv ("GST_AUDIORESAMPLE_NO_AVX2");
+
+    gst_buffer_map (avx2, &avx2_map, GST_MAP_READ);
+    gst_buffer_map (sse, &sse_map, GST_MAP_READ);
+    fail_unless_equals_int (avx2_map.size, sse_map.size);
+    a = (const gfloat *) avx2_map.data;
+    b = (const gfloat *) sse_map.data;
+    for (j = 0; j < avx2_map.size / sizeof (gfloat); j++) {
+      fail_unless (fabs (a[j] - b[j]) < 1e-5, "%d channels, sample %"
+          G_GSIZE_FORMAT ": %f != %f", channels[i], j, a[j], b[j]);
+    }
+    gst_buffer_unmap (avx2, &avx2_map);
+    gst_buffer_unmap (sse, &sse_map);
+
+    gst_buffer_unref (avx2);
+    gst_buffer_unref (sse);
+  }
+}
+
+GST_END_TEST;
+
 static Suite *
 audioresample_suite (void)
 {
@@ -1100,6 +1225,8 @@ audioresample_suite (void)
   tcase_add_test (tc_chain, test_live_switch);
   tcase_add_test (tc_chain, test_timestamp_drift);
   tcase_add_test (tc_chain, test_fft);
+  tcase_add_test (tc_chain, test_channel_groups);
+  tcase_add_test (tc_chain, test_avx2_sse_equivalence);
 
 #ifndef GST_DISABLE_PARSE
   tcase_set_timeout (tc_chain, 360);
@@ -18,13 +18,19 @@
  * Boston, MA 02110-1301, USA.
  */
 
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
 #ifdef HAVE_FIONREAD_IN_SYS_FILIO
 #include <sys/filio.h>
 #endif
 
 #include <gst/check/gstcheck.h>
+#include <gst/allocators/gstfdmemory.h>
 
 static GstPad *mysrcpad;
 
@@ -797,6 +803,424 @@ GST_START_TEST (test_client_next_keyframe)
 
 GST_END_TEST;
 
+static gint
+open_tmp_file (const gchar * data, gsize size)
+{
+  GError *error = NULL;
+  gchar *filename;
+  gint fd;
+
+  fd = g_file_open_tmp (NULL, &filename, &error);
+  fail_if (fd < 0);
+  unlink (filename);
+  g_free (filename);
+
+  if (data)
+    fail_if (write (fd, data, size) != size);
+  else
+    fail_if (ftruncate (fd, size) < 0);
+
+  return fd;
+}
+
+static void
+wait_num_handles (GstElement * sink, gint num)
+{
+  gint handles;
+
+  do {
+    g_usleep (1000);
+    g_object_get (sink, "num-handles", &handles, NULL);
+  } while (handles != num);
+}
+
+/* fd backed memory is sent with sendfile, unless it is mapped privately and
+ * the file may not have the contents of the memory */
+GST_START_TEST (test_sending_fd_memory)
+{
+  GstElement *sink;
+  GstAllocator *allocator;
+  GstBuffer *buffer;
+  GstCaps *caps;
+  const char file_data[] = "served straight from the file";
+  gsize len = strlen (file_data);
+  guint64 zerocopy;
+  int pfd[2];
+  gint fd;
+
+  fd = open_tmp_file (file_data, len);
+
+  sink = setup_multifdsink ();
+  fail_if (pipe (pfd) == -1);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+  g_signal_emit_by_name (sink, "add", pfd[1]);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+
+  allocator = gst_fd_allocator_new ();
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer,
+      gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, (gpointer) "head ",
+          5, 0, 5, NULL, NULL));
+  gst_buffer_append_memory (buffer, gst_fd_allocator_alloc (allocator, fd,
+          len, GST_FD_MEMORY_FLAG_NONE));
+  fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+
+  fail_unless_read ("client", pfd[0], 5, "head ");
+  fail_unless_read ("client", pfd[0], 29, file_data);
+  wait_bytes_served (sink, 5 + len);
+
+  g_object_get (sink, "bytes-served-zerocopy", &zerocopy, NULL);
+#ifdef HAVE_SYS_SENDFILE_H
+  fail_unless_equals_uint64 (zerocopy, len);
+#else
+  fail_unless_equals_uint64 (zerocopy, 0);
+#endif
+
+  /* the private mapping is copied */
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer, gst_fd_allocator_alloc (allocator,
+          dup (fd), len, GST_FD_MEMORY_FLAG_MAP_PRIVATE));
+  fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+
+  fail_unless_read ("client", pfd[0], 29, file_data);
+  wait_bytes_served (sink, 5 + 2 * len);
+
+  g_object_get (sink, "bytes-served-zerocopy", &zerocopy, NULL);
+#ifdef HAVE_SYS_SENDFILE_H
+  fail_unless_equals_uint64 (zerocopy, len);
+#else
+  fail_unless_equals_uint64 (zerocopy, 0);
+#endif
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multifdsink (sink);
+  gst_object_unref (allocator);
+  gst_caps_unref (caps);
+  close (pfd[0]);
+  close (pfd[1]);
+}
+
+GST_END_TEST;
+
+/* a region of a privately mapped fd memory shares the mapping of its parent,
+ * its modified contents have to be sent and not the file */
+GST_START_TEST (test_sending_fd_memory_private_region)
+{
+  GstElement *sink;
+  GstAllocator *allocator;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstBuffer *buffer, *region;
+  GstCaps *caps;
+  const char file_data[] = "served straight from the file";
+  gsize len = strlen (file_data);
+  guint64 zerocopy;
+  int pfd[2];
+  gint fd;
+
+  fd = open_tmp_file (file_data, len);
+
+  sink = setup_multifdsink ();
+  fail_if (pipe (pfd) == -1);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+  g_signal_emit_by_name (sink, "add", pfd[1]);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+
+  allocator = gst_fd_allocator_new ();
+  mem = gst_fd_allocator_alloc (allocator, fd, len,
+      GST_FD_MEMORY_FLAG_MAP_PRIVATE | GST_FD_MEMORY_FLAG_KEEP_MAPPED);
+
+  /* the changes only exist in the private mapping, which is kept */
+  fail_unless (gst_memory_map (mem, &map, GST_MAP_READWRITE));
+  memcpy (map.data, "SERVED", 6);
+  gst_memory_unmap (mem, &map);
+
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer, mem);
+  region = gst_buffer_copy_region (buffer, GST_BUFFER_COPY_MEMORY, 0, 12);
+  gst_buffer_unref (buffer);
+
+  mem = gst_buffer_peek_memory (region, 0);
+  fail_unless (gst_is_fd_memory (mem));
+  fail_unless (gst_fd_memory_get_flags (mem) & GST_FD_MEMORY_FLAG_MAP_PRIVATE);
+
+  fail_unless (gst_pad_push (mysrcpad, region) == GST_FLOW_OK);
+
+  fail_unless_read ("client", pfd[0], 12, "SERVED strai");
+  wait_bytes_served (sink, 12);
+
+  g_object_get (sink, "bytes-served-zerocopy", &zerocopy, NULL);
+  fail_unless_equals_uint64 (zerocopy, 0);
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multifdsink (sink);
+  gst_object_unref (allocator);
+  gst_caps_unref (caps);
+  close (pfd[0]);
+  close (pfd[1]);
+}
+
+GST_END_TEST;
+
+/* a client that goes away while a file is being sent to it is removed, the
+ * SIGPIPE of sendfile must not reach the application */
+GST_START_TEST (test_sending_fd_memory_peer_closed)
+{
+  GstElement *sink;
+  GstAllocator *allocator;
+  GstBuffer *buffer;
+  GstCaps *caps;
+  gsize len = 4 * 1024 * 1024;
+  gchar data[1024];
+  int pfd[2];
+  gint fd;
+
+  fd = open_tmp_file (NULL, len);
+
+  sink = setup_multifdsink ();
+  fail_if (pipe (pfd) == -1);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+  g_signal_emit_by_name (sink, "add", pfd[1]);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+
+  allocator = gst_fd_allocator_new ();
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer, gst_fd_allocator_alloc (allocator, fd,
+          len, GST_FD_MEMORY_FLAG_NONE));
+  fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+
+  /* the pipe is much smaller than the file, read a bit and go away */
+  fail_unless (read (pfd[0], data, sizeof (data)) > 0);
+  close (pfd[0]);
+
+  wait_num_handles (sink, 0);
+
+  /* the sink keeps working */
+  buffer = gst_buffer_new_and_alloc (4);
+  fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multifdsink (sink);
+  gst_object_unref (allocator);
+  gst_caps_unref (caps);
+  close (pfd[1]);
+}
+
+GST_END_TEST;
+
+#define GATHER_BUF_SIZE 10000
+#define GATHER_N_BUFS 10
+
+/* queue GATHER_N_BUFS buffers for a client that bursts all of them, so that
+ * they are gathered into one write. Buffer i has timestamp i seconds and
+ * is filled with 'a' + i */
+static GstElement *
+setup_gather_client (gint fd)
+{
+  GstElement *sink;
+  GstBuffer *buffer;
+  GstCaps *caps;
+  gint i;
+
+  sink = setup_multifdsink ();
+  g_object_set (sink, "bytes-min", GATHER_BUF_SIZE * GATHER_N_BUFS,
+      "sync-method", 3, "burst-format", GST_FORMAT_BYTES, "burst-value",
+      (guint64) GATHER_BUF_SIZE * GATHER_N_BUFS, NULL);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+  gst_caps_unref (caps);
+
+  for (i = 0; i < GATHER_N_BUFS; i++) {
+    /* the last buffer makes the client writable */
+    if (i == GATHER_N_BUFS - 1)
+      g_signal_emit_by_name (sink, "add", fd);
+
+    buffer = gst_buffer_new_and_alloc (GATHER_BUF_SIZE);
+    gst_buffer_memset (buffer, 0, 'a' + i, GATHER_BUF_SIZE);
+    GST_BUFFER_TIMESTAMP (buffer) = i * GST_SECOND;
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  return sink;
+}
+
+/* the first write of the client fills the pipe or socket and stops in the
+ * middle of a buffer. The client only took the buffers that were written */
+static void
+check_gathered_partial_write (GstElement * sink, gint fd, gint readfd)
+{
+  guint8 data[4096];
+  GstStructure *stats;
+  guint64 sent = 0, last_ts;
+  gsize total = 0;
+  gssize i, n;
+
+  while (sent == 0) {
+    g_usleep (1000);
+    g_signal_emit_by_name (sink, "get-stats", fd, &stats);
+    fail_unless (gst_structure_get_uint64 (stats, "bytes-sent", &sent));
+    fail_unless (gst_structure_get_uint64 (stats, "last-buffer-ts",
+            &last_ts));
+    gst_structure_free (stats);
+  }
+  GST_DEBUG ("first write sent %" G_GUINT64_FORMAT " bytes", sent);
+  fail_unless_equals_uint64 (last_ts / GST_SECOND,
+      MIN (sent / GATHER_BUF_SIZE, GATHER_N_BUFS - 1));
+
+  /* everything arrives in order, across the partial writes */
+  while (total < GATHER_BUF_SIZE * GATHER_N_BUFS) {
+    n = read (readfd, data, MIN (sizeof (data),
+            GATHER_BUF_SIZE * GATHER_N_BUFS - total));
+    fail_unless (n > 0);
+    for (i = 0; i < n; i++) {
+      fail_unless_equals_int (data[i], 'a' + (total + i) / GATHER_BUF_SIZE);
+    }
+    total += n;
+  }
+  wait_bytes_served (sink, GATHER_BUF_SIZE * GATHER_N_BUFS);
+}
+
+/* a pipe is written with writev */
+GST_START_TEST (test_gather_partial_writev)
+{
+  GstElement *sink;
+  int pfd[2];
+
+  fail_if (pipe (pfd) == -1);
+
+  /* the pipe holds less than the burst */
+  sink = setup_gather_client (pfd[1]);
+  check_gathered_partial_write (sink, pfd[1], pfd[0]);
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multifdsink (sink);
+  close (pfd[0]);
+  close (pfd[1]);
+}
+
+GST_END_TEST;
+
+/* a socket is written with sendmsg */
+GST_START_TEST (test_gather_partial_sendmsg)
+{
+  GstElement *sink;
+  gint sndbuf = 4096;
+  int sv[2];
+
+  fail_if (socketpair (PF_UNIX, SOCK_STREAM, 0, sv) == -1);
+  fail_if (setsockopt (sv[1], SOL_SOCKET, SO_SNDBUF, &sndbuf,
+          sizeof (sndbuf)) < 0);
+
+  sink = setup_gather_client (sv[1]);
+  check_gathered_partial_write (sink, sv[1], sv[0]);
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multifdsink (sink);
+  close (sv[0]);
+  close (sv[1]);
+}
+
+GST_END_TEST;
+
+#define THREADS_CLIENTS 32
+#define THREADS_BUFFERS 100
+
+/* read @len bytes from @fd and check that they are the buffers @first to
+ * @first + @len / 16 - 1 made by gst_new_buffer() */
+static void
+read_new_buffers (gint fd, gint first, gsize len)
+{
+  gchar data[THREADS_BUFFERS * 16], expected[16];
+  gsize total = 0;
+  gssize n;
+  gint i;
+
+  while (total < len) {
+    n = read (fd, data + total, len - total);
+    fail_unless (n > 0);
+    total += n;
+  }
+  for (i = 0; i < len / 16; i++) {
+    g_snprintf (expected, 16, "deadbee%08x", first + i);
+    fail_unless (memcmp (data + i * 16, expected, 16) == 0,
+        "fd %d got wrong buffer %d", fd, first + i);
+  }
+}
+
+/* serve the clients from 4 threads, remove half of them while streaming
+ * and check that the others get all the data and the removed ones no more
+ * data */
+GST_START_TEST (test_many_clients_threads)
+{
+  GstElement *sink;
+  GstCaps *caps;
+  int sv[THREADS_CLIENTS][2];
+  gint i;
+
+  sink = setup_multifdsink ();
+  g_object_set (sink, "n-threads", 4, NULL);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+
+  for (i = 0; i < THREADS_CLIENTS; i++) {
+    fail_if (socketpair (PF_UNIX, SOCK_STREAM, 0, sv[i]) == -1);
+    g_signal_emit_by_name (sink, "add", sv[i][1]);
+  }
+  fail_unless_num_handles (sink, THREADS_CLIENTS);
+
+  for (i = 0; i < THREADS_BUFFERS / 2; i++)
+    fail_unless (gst_pad_push (mysrcpad, gst_new_buffer (i)) == GST_FLOW_OK);
+  wait_bytes_served (sink, (guint64) THREADS_CLIENTS * THREADS_BUFFERS / 2
+      * 16);
+
+  for (i = 0; i < THREADS_CLIENTS; i++)
+    read_new_buffers (sv[i][0], 0, THREADS_BUFFERS / 2 * 16);
+
+  /* remove every other client, the threads keep serving the rest */
+  for (i = 0; i < THREADS_CLIENTS; i += 2)
+    g_signal_emit_by_name (sink, "remove", sv[i][1]);
+  fail_unless_num_handles (sink, THREADS_CLIENTS / 2);
+
+  for (i = THREADS_BUFFERS / 2; i < THREADS_BUFFERS; i++)
+    fail_unless (gst_pad_push (mysrcpad, gst_new_buffer (i)) == GST_FLOW_OK);
+  wait_bytes_served (sink, (guint64) THREADS_CLIENTS * THREADS_BUFFERS * 3 / 4
+      * 16);
+
+  for (i = 0; i < THREADS_CLIENTS; i++) {
+    if (i % 2 == 0)
+      fail_if_can_read ("removed client", sv[i][0]);
+    else
+      read_new_buffers (sv[i][0], THREADS_BUFFERS / 2,
+          THREADS_BUFFERS / 2 * 16);
+  }
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multifdsink (sink);
+  gst_caps_unref (caps);
+
+  for (i = 0; i < THREADS_CLIENTS; i++) {
+    close (sv[i][0]);
+    close (sv[i][1]);
+  }
+}
+
+GST_END_TEST;
+
 /* FIXME: add test simulating chained oggs where:
  * sync-method is burst-on-connect
  * (when multifdsink actually does burst-on-connect based on byte size, not
@@ -820,6 +1244,12 @@ multifdsink_suite (void)
   tcase_add_test (tc_chain, test_burst_client_bytes_keyframe);
   tcase_add_test (tc_chain, test_burst_client_bytes_with_keyframe);
   tcase_add_test (tc_chain, test_client_next_keyframe);
+  tcase_add_test (tc_chain, test_sending_fd_memory);
+  tcase_add_test (tc_chain, test_sending_fd_memory_private_region);
+  tcase_add_test (tc_chain, test_sending_fd_memory_peer_closed);
+  tcase_add_test (tc_chain, test_gather_partial_writev);
+  tcase_add_test (tc_chain, test_gather_partial_sendmsg);
+  tcase_add_test (tc_chain, test_many_clients_threads);
 
   return s;
 }
@@ -18,15 +18,25 @@
  * Boston, MA 02110-1301, USA.
  */
 
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/resource.h>
 #ifdef HAVE_FIONREAD_IN_SYS_FILIO
 #include <sys/filio.h>
 #endif
 
 #include <gio/gio.h>
+#ifdef HAVE_GIO_UNIX_2_0
+#include <gio/gunixfdmessage.h>
+#endif /* HAVE_GIO_UNIX_2_0 */
 #include <gst/check/gstcheck.h>
+#include <gst/net/gstnetcontrolmessagemeta.h>
+#include <gst/allocators/gstfdmemory.h>
 
 static GstPad *mysrcpad;
 
@@ -307,6 +317,58 @@ GST_START_TEST (test_sending_buffers_with_9_gstmemories)
 
 GST_END_TEST;
 
+GST_START_TEST (test_sending_fd_memory)
+{
+  TestSinkAndSocket tsas = { 0 };
+  GstAllocator *allocator;
+  GstBuffer *buffer;
+  GError *error = NULL;
+  const char file_data[] = "served straight from the file";
+  const char expected[] = "head served straight from the file tail";
+  gchar data[sizeof (expected)];
+  int len = sizeof (expected) - 1;
+  guint64 zerocopy;
+  gchar *filename;
+  gint fd;
+
+  fd = g_file_open_tmp (NULL, &filename, &error);
+  fail_if (fd < 0);
+  fail_if (write (fd, file_data, strlen (file_data)) != strlen (file_data));
+  unlink (filename);
+  g_free (filename);
+
+  setup_sink_with_socket (&tsas);
+
+  /* fd memory between two regular memories */
+  allocator = gst_fd_allocator_new ();
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer,
+      gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, (gpointer) "head ",
+          5, 0, 5, NULL, NULL));
+  gst_buffer_append_memory (buffer, gst_fd_allocator_alloc (allocator, fd,
+          strlen (file_data), GST_FD_MEMORY_FLAG_NONE));
+  gst_buffer_append_memory (buffer,
+      gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, (gpointer) " tail",
+          5, 0, 5, NULL, NULL));
+  fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+
+  fail_unless (read_handle_n_bytes_exactly (tsas.srcsocket, data, len));
+  fail_unless (strncmp (data, expected, len) == 0);
+  wait_bytes_served (tsas.sink, len);
+
+  g_object_get (tsas.sink, "bytes-served-zerocopy", &zerocopy, NULL);
+#ifdef HAVE_SYS_SENDFILE_H
+  fail_unless_equals_uint64 (zerocopy, strlen (file_data));
+#else
+  fail_unless_equals_uint64 (zerocopy, 0);
+#endif
+
+  teardown_sink_with_socket (&tsas);
+  gst_object_unref (allocator);
+}
+
+GST_END_TEST;
+
 /* from the given two data buffers, create two streamheader buffers and
  * some caps that match it, and store them in the given pointers
  * returns  one ref to each of the buffers and the caps */
@@ -965,6 +1027,386 @@ GST_START_TEST (test_client_next_keyframe)
 
 GST_END_TEST;
 
+/* set to something larger to do benchmarks, reference numbers are taken with
+ * 1000 and 10000 clients and a queue of 10000 buffers. Every client uses two
+ * file descriptors. */
+#define QUEUE_CLIENTS_SMALL 10
+#define QUEUE_CLIENTS_LARGE 100
+#define QUEUE_BUFFERS 1000
+
+static void
+run_queue_benchmark (gint n_clients)
+{
+  GstElement *sink;
+  GstCaps *caps;
+  GSocket **socket;
+  struct rlimit rl;
+  gint64 start, elapsed;
+  guint queued;
+  gchar ref[16];
+  gint i;
+
+  /* make sure we have enough file descriptors */
+  fail_if (getrlimit (RLIMIT_NOFILE, &rl) < 0);
+  rl.rlim_cur = rl.rlim_max;
+  setrlimit (RLIMIT_NOFILE, &rl);
+  fail_if (getrlimit (RLIMIT_NOFILE, &rl) < 0);
+  if (rl.rlim_cur != RLIM_INFINITY)
+    n_clients = MIN (n_clients, (gint) (rl.rlim_cur - 64) / 2);
+
+  sink = setup_multisocketsink ();
+  /* keep all buffers around, like a large burst-on-connect queue */
+  g_object_set (sink, "buffers-min", QUEUE_BUFFERS, NULL);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+
+  socket = g_new0 (GSocket *, 2 * n_clients);
+  for (i = 0; i < n_clients; i++) {
+    fail_unless (setup_handles (&socket[2 * i], &socket[2 * i + 1]));
+    g_signal_emit_by_name (sink, "add", socket[2 * i]);
+  }
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < QUEUE_BUFFERS; i++)
+    fail_unless (gst_pad_push (mysrcpad, gst_new_buffer (i)) == GST_FLOW_OK);
+  elapsed = g_get_monotonic_time () - start;
+
+  GST_DEBUG ("%d clients: queued %d buffers in %" G_GINT64_FORMAT " us",
+      n_clients, QUEUE_BUFFERS, elapsed);
+
+  g_object_get (sink, "buffers-queued", &queued, NULL);
+  fail_unless_equals_int (queued, QUEUE_BUFFERS);
+
+  /* the queue was reallocated while clients were reading from it, they must
+   * still get all buffers in order */
+  for (i = 0; i < QUEUE_BUFFERS; i++) {
+    g_snprintf (ref, 16, "deadbee%08x", i);
+    fail_unless_read ("first client", socket[1], 16, ref);
+    fail_unless_read ("last client", socket[2 * n_clients - 1], 16, ref);
+  }
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multisocketsink (sink);
+  gst_caps_unref (caps);
+
+  for (i = 0; i < 2 * n_clients; i++)
+    g_object_unref (socket[i]);
+  g_free (socket);
+}
+
+GST_START_TEST (test_queue_many_clients)
+{
+  run_queue_benchmark (QUEUE_CLIENTS_SMALL);
+  run_queue_benchmark (QUEUE_CLIENTS_LARGE);
+}
+
+GST_END_TEST;
+
+/* connect a TCP client to @listener and return both ends of the connection */
+static gboolean
+setup_loopback_handles (GSocket * listener, GSocket ** sinkhandle,
+    GSocket ** srchandle)
+{
+  GError *error = NULL;
+  GSocketAddress *addr;
+
+  addr = g_socket_get_local_address (listener, &error);
+  fail_if (error);
+
+  *srchandle = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_STREAM,
+      G_SOCKET_PROTOCOL_TCP, &error);
+  fail_if (error);
+  fail_unless (g_socket_connect (*srchandle, addr, NULL, &error));
+  fail_if (error);
+  g_object_unref (addr);
+
+  *sinkhandle = g_socket_accept (listener, NULL, &error);
+  fail_if (error);
+  fail_if (*sinkhandle == NULL);
+
+  return TRUE;
+}
+
+/* set to something larger to do benchmarks, reference numbers are taken with
+ * 5000 clients. All the data for a client fits in the socket buffers so that
+ * the time is spent in the sink and not in reading the clients. */
+#define STRESS_CLIENTS 200
+#define STRESS_BUFFERS 500
+
+static void
+run_threads_benchmark (gint n_clients, guint n_threads)
+{
+  GstElement *sink;
+  GstCaps *caps;
+  GSocket *listener;
+  GSocketAddress *addr;
+  GInetAddress *iaddr;
+  GSocket **socket;
+  GError *error = NULL;
+  struct rlimit rl;
+  gint64 start, elapsed;
+  guint64 served, total;
+  gchar *expected, *data;
+  gint i;
+
+  /* make sure we have enough file descriptors */
+  fail_if (getrlimit (RLIMIT_NOFILE, &rl) < 0);
+  rl.rlim_cur = rl.rlim_max;
+  setrlimit (RLIMIT_NOFILE, &rl);
+  fail_if (getrlimit (RLIMIT_NOFILE, &rl) < 0);
+  if (rl.rlim_cur != RLIM_INFINITY)
+    n_clients = MIN (n_clients, (gint) (rl.rlim_cur - 64) / 2);
+
+  listener = g_socket_new (G_SOCKET_FAMILY_IPV4, G_SOCKET_TYPE_STREAM,
+      G_SOCKET_PROTOCOL_TCP, &error);
+  fail_if (error);
+  iaddr = g_inet_address_new_loopback (G_SOCKET_FAMILY_IPV4);
+  addr = g_inet_socket_address_new (iaddr, 0);
+  fail_unless (g_socket_bind (listener, addr, TRUE, &error));
+  fail_unless (g_socket_listen (listener, &error));
+  g_object_unref (addr);
+  g_object_unref (iaddr);
+
+  sink = setup_multisocketsink ();
+  g_object_set (sink, "n-threads", n_threads, NULL);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+
+  socket = g_new0 (GSocket *, 2 * n_clients);
+  for (i = 0; i < n_clients; i++) {
+    fail_unless (setup_loopback_handles (listener, &socket[2 * i],
+            &socket[2 * i + 1]));
+    g_signal_emit_by_name (sink, "add", socket[2 * i]);
+  }
+  fail_unless_num_handles (sink, n_clients);
+
+  /* wait until all clients got all buffers */
+  total = (guint64) n_clients * STRESS_BUFFERS * 16;
+  start = g_get_monotonic_time ();
+  for (i = 0; i < STRESS_BUFFERS; i++)
+    fail_unless (gst_pad_push (mysrcpad, gst_new_buffer (i)) == GST_FLOW_OK);
+  do {
+    g_usleep (1000);
+    g_object_get (sink, "bytes-served", &served, NULL);
+    elapsed = g_get_monotonic_time () - start;
+    fail_if (elapsed > 60 * G_USEC_PER_SEC, "served only %" G_GUINT64_FORMAT
+        " of %" G_GUINT64_FORMAT " bytes", served, total);
+  } while (served < total);
+
+  GST_DEBUG ("%d clients, %u threads: served %d buffers in %" G_GINT64_FORMAT
+      " us", n_clients, n_threads, STRESS_BUFFERS, elapsed);
+
+  /* every client got every buffer, in order */
+  expected = g_malloc (STRESS_BUFFERS * 16);
+  data = g_malloc (STRESS_BUFFERS * 16);
+  for (i = 0; i < STRESS_BUFFERS; i++)
+    g_snprintf (expected + i * 16, 16, "deadbee%08x", i);
+  for (i = 0; i < n_clients; i++) {
+    fail_unless (read_handle_n_bytes_exactly (socket[2 * i + 1], data,
+            STRESS_BUFFERS * 16));
+    fail_unless (memcmp (data, expected, STRESS_BUFFERS * 16) == 0,
+        "client %d got wrong data", i);
+  }
+  g_free (expected);
+  g_free (data);
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multisocketsink (sink);
+  gst_caps_unref (caps);
+
+  for (i = 0; i < 2 * n_clients; i++)
+    g_object_unref (socket[i]);
+  g_free (socket);
+  g_object_unref (listener);
+}
+
+GST_START_TEST (test_many_clients_threads)
+{
+  run_threads_benchmark (STRESS_CLIENTS, 1);
+  run_threads_benchmark (STRESS_CLIENTS, 4);
+  run_threads_benchmark (STRESS_CLIENTS, 0);
+}
+
+GST_END_TEST;
+
+#define GATHER_BUF_SIZE 10000
+#define GATHER_N_BUFS 10
+
+/* a client that bursts all queued buffers gets them gathered into one
+ * write. The socket holds less than that, so the write stops in the middle
+ * of a buffer and the client only takes the buffers that were written */
+GST_START_TEST (test_gather_partial_write)
+{
+  GstElement *sink;
+  GSocket *sinksocket, *srcsocket;
+  GstBuffer *buffer;
+  GstCaps *caps;
+  GstStructure *stats;
+  guint8 data[4096];
+  guint64 sent = 0, last_ts;
+  gint sndbuf = 4096;
+  gsize total = 0;
+  gssize n, j;
+  gint i;
+
+  sink = setup_multisocketsink ();
+  g_object_set (sink, "bytes-min", GATHER_BUF_SIZE * GATHER_N_BUFS,
+      "sync-method", 3, "burst-format", GST_FORMAT_BYTES, "burst-value",
+      (guint64) GATHER_BUF_SIZE * GATHER_N_BUFS, NULL);
+  fail_unless (setup_handles (&sinksocket, &srcsocket));
+  fail_if (setsockopt (g_socket_get_fd (sinksocket), SOL_SOCKET, SO_SNDBUF,
+          &sndbuf, sizeof (sndbuf)) < 0);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+  gst_caps_unref (caps);
+
+  for (i = 0; i < GATHER_N_BUFS; i++) {
+    /* the last buffer makes the client writable */
+    if (i == GATHER_N_BUFS - 1)
+      g_signal_emit_by_name (sink, "add", sinksocket);
+
+    buffer = gst_buffer_new_and_alloc (GATHER_BUF_SIZE);
+    gst_buffer_memset (buffer, 0, 'a' + i, GATHER_BUF_SIZE);
+    GST_BUFFER_TIMESTAMP (buffer) = i * GST_SECOND;
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  while (sent == 0) {
+    g_usleep (1000);
+    g_signal_emit_by_name (sink, "get-stats", sinksocket, &stats);
+    fail_unless (gst_structure_get_uint64 (stats, "bytes-sent", &sent));
+    fail_unless (gst_structure_get_uint64 (stats, "last-buffer-ts",
+            &last_ts));
+    gst_structure_free (stats);
+  }
+  GST_DEBUG ("first write sent %" G_GUINT64_FORMAT " bytes", sent);
+  fail_unless_equals_uint64 (last_ts / GST_SECOND,
+      MIN (sent / GATHER_BUF_SIZE, GATHER_N_BUFS - 1));
+
+  /* everything arrives in order, across the partial writes */
+  while (total < GATHER_BUF_SIZE * GATHER_N_BUFS) {
+    n = read_handle (srcsocket, data, MIN (sizeof (data),
+            GATHER_BUF_SIZE * GATHER_N_BUFS - total));
+    fail_unless (n > 0);
+    for (j = 0; j < n; j++) {
+      fail_unless_equals_int (data[j], 'a' + (total + j) / GATHER_BUF_SIZE);
+    }
+    total += n;
+  }
+  wait_bytes_served (sink, GATHER_BUF_SIZE * GATHER_N_BUFS);
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multisocketsink (sink);
+  g_object_unref (sinksocket);
+  g_object_unref (srcsocket);
+}
+
+GST_END_TEST;
+
+#ifdef HAVE_GIO_UNIX_2_0
+/* receive up to @count bytes, returns the number of bytes received and adds
+ * the number of control messages that came with them to @n_msgs */
+static gsize
+receive_with_messages (GSocket * socket, gchar * data, gsize count,
+    gint * n_msgs)
+{
+  GInputVector vec = { data, count };
+  GSocketControlMessage **msgs = NULL;
+  gint i, n = 0;
+  gssize received;
+
+  received = g_socket_receive_message (socket, NULL, &vec, 1, &msgs, &n,
+      NULL, NULL, NULL);
+  fail_unless (received > 0);
+  for (i = 0; i < n; i++) {
+    fail_unless (G_IS_UNIX_FD_MESSAGE (msgs[i]));
+    g_object_unref (msgs[i]);
+  }
+  g_free (msgs);
+  *n_msgs += n;
+
+  return received;
+}
+
+/* control messages go with the first byte of the buffer that carries them,
+ * a gathered write never starts before such a buffer */
+GST_START_TEST (test_gather_control_message)
+{
+  GstElement *sink;
+  GSocket *sinksocket, *srcsocket;
+  GSocketControlMessage *msg;
+  GstBuffer *buffer;
+  GstCaps *caps;
+  const gchar *contents[] = { "aaaa", "bbbb", "cccc", "dddd" };
+  gchar data[16];
+  gsize total;
+  int pfd[2];
+  gint i, n_msgs;
+
+  sink = setup_multisocketsink ();
+  g_object_set (sink, "bytes-min", 16, "sync-method", 3, "burst-format",
+      GST_FORMAT_BYTES, "burst-value", (guint64) 16, NULL);
+  fail_unless (setup_handles (&sinksocket, &srcsocket));
+  fail_if (pipe (pfd) == -1);
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  caps = gst_caps_from_string ("application/x-gst-check");
+  gst_check_setup_events (mysrcpad, sink, caps, GST_FORMAT_BYTES);
+  gst_caps_unref (caps);
+
+  for (i = 0; i < G_N_ELEMENTS (contents); i++) {
+    /* the last buffer makes the client writable */
+    if (i == G_N_ELEMENTS (contents) - 1)
+      g_signal_emit_by_name (sink, "add", sinksocket);
+
+    buffer = gst_buffer_new_and_alloc (4);
+    gst_buffer_fill (buffer, 0, contents[i], 4);
+    if (i == 1) {
+      msg = g_unix_fd_message_new ();
+      fail_unless (g_unix_fd_message_append_fd ((GUnixFDMessage *) msg,
+              pfd[0], NULL));
+      gst_buffer_add_net_control_message_meta (buffer, msg);
+      g_object_unref (msg);
+    }
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  /* the first buffer is written on its own, without the fd */
+  n_msgs = 0;
+  fail_unless_equals_int (receive_with_messages (srcsocket, data, 4,
+          &n_msgs), 4);
+  fail_unless_equals_int (n_msgs, 0);
+  fail_unless (memcmp (data, "aaaa", 4) == 0);
+
+  /* the fd comes with the second buffer, the others follow it */
+  total = 0;
+  while (total < 12)
+    total += receive_with_messages (srcsocket, data + total, 12 - total,
+        &n_msgs);
+  fail_unless_equals_int (n_msgs, 1);
+  fail_unless (memcmp (data, "bbbbccccdddd", 12) == 0);
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_multisocketsink (sink);
+  g_object_unref (sinksocket);
+  g_object_unref (srcsocket);
+  close (pfd[0]);
+  close (pfd[1]);
+}
+
+GST_END_TEST;
+#endif /* HAVE_GIO_UNIX_2_0 */
+
 /* FIXME: add test simulating chained oggs where:
  * sync-method is burst-on-connect
  * (when multisocketsink actually does burst-on-connect based on byte size, not
@@ -982,12 +1424,19 @@ multisocketsink_suite (void)
   tcase_add_test (tc_chain, test_no_clients);
   tcase_add_test (tc_chain, test_add_client);
   tcase_add_test (tc_chain, test_sending_buffers_with_9_gstmemories);
+  tcase_add_test (tc_chain, test_sending_fd_memory);
   tcase_add_test (tc_chain, test_streamheader);
   tcase_add_test (tc_chain, test_change_streamheader);
   tcase_add_test (tc_chain, test_burst_client_bytes);
   tcase_add_test (tc_chain, test_burst_client_bytes_keyframe);
   tcase_add_test (tc_chain, test_burst_client_bytes_with_keyframe);
   tcase_add_test (tc_chain, test_client_next_keyframe);
+  tcase_add_test (tc_chain, test_queue_many_clients);
+  tcase_add_test (tc_chain, test_many_clients_threads);
+  tcase_add_test (tc_chain, test_gather_partial_write);
+#ifdef HAVE_GIO_UNIX_2_0
+  tcase_add_test (tc_chain, test_gather_control_message);
+#endif /* HAVE_GIO_UNIX_2_0 */
 
   return s;
 }
@@ -24,6 +24,7 @@
 #include <gst/base/gstbasesink.h>
 
 #include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
 #include <string.h>
 
 /* kids, don't do this at home, skipping checks is *BAD* */
@@ -973,6 +974,333 @@ GST_START_TEST (test_basetransform_negotiation)
 
 GST_END_TEST;
 
+GST_START_TEST (test_crop_meta)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+  GstVideoCropMeta *crop;
+  GstMapInfo map;
+  gint x, y;
+
+  h = gst_harness_new ("videoscale");
+  gst_harness_set_src_caps_str (h, "video/x-raw,format=GRAY8,"
+      "width=320,height=240,framerate=30/1,pixel-aspect-ratio=1/1");
+  gst_harness_set_sink_caps_str (h, "video/x-raw,format=GRAY8,"
+      "width=160,height=120,framerate=30/1,pixel-aspect-ratio=1/1");
+
+  /* a 640x480 frame where only the bottom right quarter is the picture */
+  buf = gst_buffer_new_allocate (NULL, 640 * 480, NULL);
+  gst_buffer_map (buf, &map, GST_MAP_WRITE);
+  for (y = 0; y < 480; y++)
+    memset (map.data + y * 640, 0x10, 640);
+  for (y = 240; y < 480; y++)
+    memset (map.data + y * 640 + 320, 0xa0, 320);
+  gst_buffer_unmap (buf, &map);
+
+  gst_buffer_add_video_meta (buf, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_FORMAT_GRAY8, 640, 480);
+  crop = gst_buffer_add_video_crop_meta (buf);
+  crop->x = 320;
+  crop->y = 240;
+  crop->width = 320;
+  crop->height = 240;
+
+  buf = gst_harness_push_and_pull (h, buf);
+  fail_unless (buf != NULL);
+  fail_unless (gst_buffer_get_video_crop_meta (buf) == NULL);
+
+  gst_buffer_map (buf, &map, GST_MAP_READ);
+  fail_unless (map.size >= 160 * 120);
+  for (y = 0; y < 120; y++)
+    for (x = 0; x < 160; x++)
+      fail_unless_equals_int (map.data[y * 160 + x], 0xa0);
+  gst_buffer_unmap (buf, &map);
+  gst_buffer_unref (buf);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+/* a 640x480 GRAY8 frame, 0x10 everywhere except the 0xa0 crop rectangle */
+static GstBuffer *
+create_crop_buffer (guint x, guint y, guint width, guint height)
+{
+  GstBuffer *buf;
+  GstVideoCropMeta *crop;
+  GstMapInfo map;
+  guint i;
+
+  buf = gst_buffer_new_allocate (NULL, 640 * 480, NULL);
+  gst_buffer_map (buf, &map, GST_MAP_WRITE);
+  memset (map.data, 0x10, 640 * 480);
+  for (i = y; i < y + height; i++)
+    memset (map.data + i * 640 + x, 0xa0, width);
+  gst_buffer_unmap (buf, &map);
+
+  gst_buffer_add_video_meta (buf, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_FORMAT_GRAY8, 640, 480);
+  crop = gst_buffer_add_video_crop_meta (buf);
+  crop->x = x;
+  crop->y = y;
+  crop->width = width;
+  crop->height = height;
+
+  return buf;
+}
+
+static GstPadProbeReturn
+allocation_crop_meta_probe (GstPad * pad, GstPadProbeInfo * info,
+    gpointer user_data)
+{
+  GstQuery *query = GST_PAD_PROBE_INFO_QUERY (info);
+
+  if (GST_QUERY_TYPE (query) == GST_QUERY_ALLOCATION &&
+      !gst_query_find_allocation_meta (query, GST_VIDEO_CROP_META_API_TYPE,
+          NULL)) {
+    gst_query_add_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL);
+    gst_query_add_allocation_meta (query, GST_VIDEO_CROP_META_API_TYPE, NULL);
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+GST_START_TEST (test_crop_meta_forward)
+{
+  GstHarness *h;
+  GstBuffer *inbuf, *outbuf;
+  GstVideoCropMeta *crop;
+
+  h = gst_harness_new ("videoscale");
+  gst_pad_add_probe (h->sinkpad, GST_PAD_PROBE_TYPE_QUERY_DOWNSTREAM,
+      allocation_crop_meta_probe, NULL, NULL);
+  gst_harness_set_src_caps_str (h, "video/x-raw,format=GRAY8,"
+      "width=640,height=480,framerate=30/1,pixel-aspect-ratio=1/1");
+  gst_harness_set_sink_caps_str (h, "video/x-raw,format=GRAY8,"
+      "width=320,height=240,framerate=30/1,pixel-aspect-ratio=1/1");
+
+  /* the crop rectangle already has the output size, downstream crops */
+  inbuf = create_crop_buffer (320, 240, 320, 240);
+  outbuf = gst_harness_push_and_pull (h, gst_buffer_ref (inbuf));
+  fail_unless (outbuf == inbuf);
+
+  crop = gst_buffer_get_video_crop_meta (outbuf);
+  fail_unless (crop != NULL);
+  fail_unless_equals_int (crop->x, 320);
+  fail_unless_equals_int (crop->y, 240);
+  fail_unless_equals_int (crop->width, 320);
+  fail_unless_equals_int (crop->height, 240);
+  gst_buffer_unref (outbuf);
+  gst_buffer_unref (inbuf);
+
+  /* a different size has to be scaled */
+  inbuf = create_crop_buffer (0, 0, 640, 480);
+  outbuf = gst_harness_push_and_pull (h, gst_buffer_ref (inbuf));
+  fail_unless (outbuf != inbuf);
+  fail_unless (gst_buffer_get_video_crop_meta (outbuf) == NULL);
+  gst_buffer_unref (outbuf);
+  gst_buffer_unref (inbuf);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_crop_meta_letterbox)
+{
+  GstHarness *h;
+  GstBuffer *buf;
+  GstMapInfo map;
+  guint8 border;
+  gint x, y;
+
+  h = gst_harness_new ("videoscale");
+  gst_harness_set_src_caps_str (h, "video/x-raw,format=GRAY8,"
+      "width=640,height=480,framerate=30/1,pixel-aspect-ratio=1/1");
+  gst_harness_set_sink_caps_str (h, "video/x-raw,format=GRAY8,"
+      "width=320,height=240,framerate=30/1,pixel-aspect-ratio=1/1");
+
+  /* the caps have the same aspect ratio, but the 160x240 crop rectangle
+   * is 2:3 and is pillarboxed into the 4:3 output */
+  buf = create_crop_buffer (320, 240, 160, 240);
+  buf = gst_harness_push_and_pull (h, buf);
+  fail_unless (buf != NULL);
+  fail_unless (gst_buffer_get_video_crop_meta (buf) == NULL);
+
+  gst_buffer_map (buf, &map, GST_MAP_READ);
+  fail_unless (map.size >= 320 * 240);
+  border = map.data[0];
+  fail_if (border == 0xa0);
+  for (y = 0; y < 240; y++) {
+    for (x = 0; x < 320; x++) {
+      if (x < 80 || x >= 240)
+        fail_unless_equals_int (map.data[y * 320 + x], border);
+      else
+        fail_unless_equals_int (map.data[y * 320 + x], 0xa0);
+    }
+  }
+  gst_buffer_unmap (buf, &map);
+  gst_buffer_unref (buf);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static void
+on_ladder_handoff (GstElement * element, GstBuffer * buffer, GstPad * pad,
+    gpointer user_data)
+{
+  gint *expected = user_data;
+  GstVideoInfo info;
+  GstVideoFrame frame;
+  GstCaps *caps;
+  guint8 *p;
+  gint x, y;
+
+  caps = gst_pad_get_current_caps (pad);
+  fail_unless (caps != NULL);
+  fail_unless (gst_video_info_from_caps (&info, caps));
+  gst_caps_unref (caps);
+
+  fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&info), expected[0]);
+  fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&info), expected[1]);
+  fail_unless_equals_int (GST_VIDEO_INFO_PAR_N (&info), expected[2]);
+  fail_unless_equals_int (GST_VIDEO_INFO_PAR_D (&info), expected[3]);
+
+  /* scaling the white input gives white everywhere */
+  fail_unless (gst_video_frame_map (&frame, &info, buffer, GST_MAP_READ));
+  for (y = 0; y < GST_VIDEO_INFO_HEIGHT (&info); y++) {
+    p = GST_VIDEO_FRAME_COMP_DATA (&frame, 0) +
+        y * GST_VIDEO_FRAME_COMP_STRIDE (&frame, 0);
+    for (x = 0; x < GST_VIDEO_INFO_WIDTH (&info); x++)
+      fail_unless_equals_int (p[x], 235);
+  }
+  gst_video_frame_unmap (&frame);
+
+  expected[4]++;
+}
+
+static void
+test_ladder (gboolean cascade)
+{
+  GstElement *pipeline, *ladder, *sink;
+  GstMessage *msg;
+  /* width, height, pixel-aspect-ratio and number of buffers */
+  gint sizes[5][5] = {
+    {640, 360, 1, 1, 0}, {320, 180, 1, 1, 0}, {160, 90, 1, 1, 0},
+    /* only one dimension given, the other one keeps the aspect ratio */
+    {427, 240, 1, 1, 0},
+    /* both given, the pixel-aspect-ratio keeps the aspect ratio */
+    {640, 480, 4, 3, 0}
+  };
+  gint i;
+
+  pipeline = gst_parse_launch ("videotestsrc num-buffers=5 pattern=white ! "
+      "video/x-raw,format=I420,width=1280,height=720,"
+      "pixel-aspect-ratio=1/1 ! videoscaleladder name=ladder "
+      "ladder. ! video/x-raw,width=160,height=90 ! queue ! fakesink name=sink2 "
+      "ladder. ! video/x-raw,width=640,height=360 ! queue ! fakesink name=sink0 "
+      "ladder. ! video/x-raw,width=320,height=180 ! queue ! fakesink name=sink1 "
+      "ladder. ! video/x-raw,height=240 ! queue ! fakesink name=sink3 "
+      "ladder. ! video/x-raw,width=640,height=480 ! queue ! fakesink name=sink4",
+      NULL);
+  fail_unless (pipeline != NULL);
+
+  ladder = gst_bin_get_by_name (GST_BIN (pipeline), "ladder");
+  g_object_set (ladder, "cascade", cascade, NULL);
+  gst_object_unref (ladder);
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+    gchar *name = g_strdup_printf ("sink%d", i);
+
+    sink = gst_bin_get_by_name (GST_BIN (pipeline), name);
+    g_object_set (sink, "signal-handoffs", TRUE, NULL);
+    g_signal_connect (sink, "handoff", G_CALLBACK (on_ladder_handoff),
+        sizes[i]);
+    gst_object_unref (sink);
+    g_free (name);
+  }
+
+  fail_unless_equals_int (gst_element_set_state (pipeline, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_ASYNC);
+
+  msg = gst_bus_timed_pop_filtered (GST_ELEMENT_BUS (pipeline), -1,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++)
+    fail_unless_equals_int (sizes[i][4], 5);
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+}
+
+GST_START_TEST (test_ladder_direct)
+{
+  test_ladder (FALSE);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_ladder_cascade)
+{
+  test_ladder (TRUE);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_ladder_caps_query)
+{
+  GstElement *ladder, *capsfilter;
+  GstCaps *caps, *filter;
+  GstPad *srcpad, *sinkpad;
+  guint i;
+
+  ladder = gst_element_factory_make ("videoscaleladder", NULL);
+  capsfilter = gst_element_factory_make ("capsfilter", NULL);
+  fail_unless (ladder && capsfilter);
+
+  caps = gst_caps_from_string ("video/x-raw,format=NV12,width=320,"
+      "height=240,pixel-aspect-ratio=1/1");
+  g_object_set (capsfilter, "caps", caps, NULL);
+  gst_caps_unref (caps);
+
+  srcpad = gst_element_get_request_pad (ladder, "src_%u");
+  sinkpad = gst_element_get_static_pad (capsfilter, "sink");
+  fail_unless_equals_int (gst_pad_link (srcpad, sinkpad), GST_PAD_LINK_OK);
+  gst_object_unref (sinkpad);
+
+  /* downstream limits the format but not the size */
+  sinkpad = gst_element_get_static_pad (ladder, "sink");
+  caps = gst_pad_query_caps (sinkpad, NULL);
+  fail_if (gst_caps_is_empty (caps));
+  for (i = 0; i < gst_caps_get_size (caps); i++) {
+    GstStructure *s = gst_caps_get_structure (caps, i);
+
+    fail_unless_equals_string (gst_structure_get_string (s, "format"),
+        "NV12");
+    fail_if (gst_structure_has_field_typed (s, "width", G_TYPE_INT));
+    fail_if (gst_structure_has_field (s, "pixel-aspect-ratio"));
+  }
+  gst_caps_unref (caps);
+
+  filter = gst_caps_from_string ("video/x-raw,format=I420");
+  caps = gst_pad_query_caps (sinkpad, filter);
+  fail_unless (gst_caps_is_empty (caps));
+  gst_caps_unref (caps);
+  gst_caps_unref (filter);
+
+  gst_object_unref (sinkpad);
+  gst_element_release_request_pad (ladder, srcpad);
+  gst_object_unref (srcpad);
+  gst_object_unref (ladder);
+  gst_object_unref (capsfilter);
+}
+
+GST_END_TEST;
+
 static Suite *
 videoscale_suite (void)
 {
@@ -1039,6 +1367,12 @@ videoscale_suite (void)
   tcase_add_test (tc_chain, test_reverse_negotiation);
 #endif
   tcase_add_test (tc_chain, test_basetransform_negotiation);
+  tcase_add_test (tc_chain, test_crop_meta);
+  tcase_add_test (tc_chain, test_crop_meta_forward);
+  tcase_add_test (tc_chain, test_crop_meta_letterbox);
+  tcase_add_test (tc_chain, test_ladder_direct);
+  tcase_add_test (tc_chain, test_ladder_cascade);
+  tcase_add_test (tc_chain, test_ladder_caps_query);
 
   return s;
 }
@@ -21,6 +21,7 @@
  */
 
 #include <unistd.h>
+#include <math.h>
 
 #include <gst/base/gstbasetransform.h>
 #include <gst/check/gstcheck.h>
@@ -1863,6 +1864,261 @@ GST_START_TEST (test_controller_defaults_at_ts0)
 GST_END_TEST;
 
 
+/* set to something larger to do benchmarks */
+#define RAMP_BUFFERS 50
+#define RAMP_SAMPLES 1024
+
+GST_START_TEST (test_controller_ramp)
+{
+  GstControlSource *cs;
+  GstTimedValueControlSource *tvcs;
+  GstControlBinding *cb;
+  GstElement *volume;
+  GstBuffer *inbuffer, *outbuffer;
+  GstCaps *caps;
+  GstSegment seg;
+  GstMapInfo map;
+  GstClockTime ts, interval;
+  gfloat *in;
+  gdouble *expected;
+  gint64 start, time_ramp, time_lookup;
+  gint i, j;
+
+  volume = setup_volume ();
+
+  cs = gst_interpolation_control_source_new ();
+  g_object_set (cs, "mode", GST_INTERPOLATION_MODE_LINEAR, NULL);
+  cb = gst_direct_control_binding_new (GST_OBJECT_CAST (volume), "volume", cs);
+  gst_object_add_control_binding (GST_OBJECT_CAST (volume), cb);
+
+  /* fade in, duck and hold with control points that do not fall on ramp
+   * segment boundaries */
+  tvcs = (GstTimedValueControlSource *) cs;
+  gst_timed_value_control_source_set (tvcs, 0 * GST_SECOND, 0.0);
+  gst_timed_value_control_source_set (tvcs, GST_SECOND / 3, 0.1);
+  gst_timed_value_control_source_set (tvcs, GST_SECOND / 2, 0.025);
+  gst_timed_value_control_source_set (tvcs, GST_SECOND / 2 + 1234567, 0.05);
+
+  fail_unless (gst_element_set_state (volume,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  caps = gst_caps_from_string (VOLUME_CAPS_STRING_F32);
+  gst_check_setup_events (mysrcpad, volume, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  gst_segment_init (&seg, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad,
+          gst_event_new_segment (&seg)) == TRUE);
+
+  interval = gst_util_uint64_scale_int (1, GST_SECOND, 44100);
+  expected = g_new (gdouble, RAMP_SAMPLES);
+  time_ramp = time_lookup = 0;
+
+  for (i = 0; i < RAMP_BUFFERS; i++) {
+    ts = gst_util_uint64_scale_int (i * RAMP_SAMPLES, GST_SECOND, 44100);
+
+    inbuffer = gst_buffer_new_and_alloc (RAMP_SAMPLES * sizeof (gfloat));
+    gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+    in = (gfloat *) map.data;
+    for (j = 0; j < RAMP_SAMPLES; j++)
+      in[j] = 1.0;
+    gst_buffer_unmap (inbuffer, &map);
+    GST_BUFFER_TIMESTAMP (inbuffer) = ts;
+
+    start = g_get_monotonic_time ();
+    fail_unless (gst_pad_push (mysrcpad, inbuffer) == GST_FLOW_OK);
+    time_ramp += g_get_monotonic_time () - start;
+
+    /* what the element used to do for every buffer */
+    start = g_get_monotonic_time ();
+    fail_unless (gst_control_binding_get_value_array (cb, ts, interval,
+            RAMP_SAMPLES, expected));
+    time_lookup += g_get_monotonic_time () - start;
+
+    fail_unless_equals_int (g_list_length (buffers), 1);
+    outbuffer = GST_BUFFER (buffers->data);
+    gst_buffer_map (outbuffer, &map, GST_MAP_READ);
+    in = (gfloat *) map.data;
+    for (j = 0; j < RAMP_SAMPLES; j++)
+      fail_unless (fabs (in[j] - expected[j]) < 1e-6,
+          "sample %d: %f != %f", i * RAMP_SAMPLES + j, in[j], expected[j]);
+    gst_buffer_unmap (outbuffer, &map);
+
+    g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+    buffers = NULL;
+  }
+
+  GST_DEBUG ("ramp segments %" G_GINT64_FORMAT " us, per-sample lookup alone %"
+      G_GINT64_FORMAT " us for %d samples", time_ramp, time_lookup,
+      RAMP_BUFFERS * RAMP_SAMPLES);
+
+  g_free (expected);
+  gst_object_unref (cs);
+  cleanup_volume (volume);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_controller_ramp_notch)
+{
+  GstControlSource *cs;
+  GstTimedValueControlSource *tvcs;
+  GstControlBinding *cb;
+  GstElement *volume;
+  GstBuffer *inbuffer, *outbuffer;
+  GstCaps *caps;
+  GstSegment seg;
+  GstMapInfo map;
+  GstClockTime interval;
+  gfloat *in;
+  gdouble *expected;
+  gint j;
+
+  volume = setup_volume ();
+
+  cs = gst_interpolation_control_source_new ();
+  g_object_set (cs, "mode", GST_INTERPOLATION_MODE_LINEAR, NULL);
+  cb = gst_direct_control_binding_new (GST_OBJECT_CAST (volume), "volume", cs);
+  gst_object_add_control_binding (GST_OBJECT_CAST (volume), cb);
+
+  /* a flat volume with a short notch in the third segment, the probes at
+   * samples 144 and 160 both see the flat volume */
+  interval = gst_util_uint64_scale_int (1, GST_SECOND, 44100);
+  tvcs = (GstTimedValueControlSource *) cs;
+  gst_timed_value_control_source_set (tvcs, 0, 0.05);
+  gst_timed_value_control_source_set (tvcs, 146 * interval, 0.05);
+  gst_timed_value_control_source_set (tvcs, 150 * interval, 0.0);
+  gst_timed_value_control_source_set (tvcs, 154 * interval, 0.05);
+  /* and a step in the middle of the fifth segment */
+  gst_timed_value_control_source_set (tvcs, 291 * interval, 0.05);
+  gst_timed_value_control_source_set (tvcs, 292 * interval, 0.1);
+  gst_timed_value_control_source_set (tvcs, GST_SECOND, 0.1);
+
+  fail_unless (gst_element_set_state (volume,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  caps = gst_caps_from_string (VOLUME_CAPS_STRING_F32);
+  gst_check_setup_events (mysrcpad, volume, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  gst_segment_init (&seg, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad,
+          gst_event_new_segment (&seg)) == TRUE);
+
+  inbuffer = gst_buffer_new_and_alloc (RAMP_SAMPLES * sizeof (gfloat));
+  gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+  in = (gfloat *) map.data;
+  for (j = 0; j < RAMP_SAMPLES; j++)
+    in[j] = 1.0;
+  gst_buffer_unmap (inbuffer, &map);
+  GST_BUFFER_TIMESTAMP (inbuffer) = 0;
+
+  fail_unless (gst_pad_push (mysrcpad, inbuffer) == GST_FLOW_OK);
+
+  expected = g_new (gdouble, RAMP_SAMPLES);
+  fail_unless (gst_control_binding_get_value_array (cb, 0, interval,
+          RAMP_SAMPLES, expected));
+  fail_unless (expected[150] < 0.001);
+
+  fail_unless_equals_int (g_list_length (buffers), 1);
+  outbuffer = GST_BUFFER (buffers->data);
+  gst_buffer_map (outbuffer, &map, GST_MAP_READ);
+  in = (gfloat *) map.data;
+  for (j = 0; j < RAMP_SAMPLES; j++)
+    fail_unless (fabs (in[j] - expected[j]) < 1e-6,
+        "sample %d: %f != %f", j, in[j], expected[j]);
+  gst_buffer_unmap (outbuffer, &map);
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  buffers = NULL;
+
+  g_free (expected);
+  gst_object_unref (cs);
+  cleanup_volume (volume);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_controller_ramp_s16)
+{
+  GstControlSource *cs;
+  GstTimedValueControlSource *tvcs;
+  GstControlBinding *cb;
+  GstElement *volume;
+  GstBuffer *inbuffer, *outbuffer;
+  GstCaps *caps;
+  GstSegment seg;
+  GstMapInfo map;
+  GstClockTime interval;
+  gint16 *in;
+  gdouble *expected;
+  gint j;
+
+  volume = setup_volume ();
+
+  cs = gst_interpolation_control_source_new ();
+  g_object_set (cs, "mode", GST_INTERPOLATION_MODE_LINEAR, NULL);
+  cb = gst_direct_control_binding_new (GST_OBJECT_CAST (volume), "volume", cs);
+  gst_object_add_control_binding (GST_OBJECT_CAST (volume), cb);
+
+  /* a fade out and back in, the segments of the ramps are applied with the
+   * gain computed from their start and step */
+  tvcs = (GstTimedValueControlSource *) cs;
+  gst_timed_value_control_source_set (tvcs, 0, 0.1);
+  gst_timed_value_control_source_set (tvcs, GST_SECOND / 2, 0.0);
+  gst_timed_value_control_source_set (tvcs, GST_SECOND, 0.1);
+
+  fail_unless (gst_element_set_state (volume,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  caps = gst_caps_from_string (VOLUME_CAPS_STRING_S16);
+  gst_check_setup_events (mysrcpad, volume, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  gst_segment_init (&seg, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad,
+          gst_event_new_segment (&seg)) == TRUE);
+
+  inbuffer = gst_buffer_new_and_alloc (RAMP_SAMPLES * sizeof (gint16));
+  gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+  in = (gint16 *) map.data;
+  for (j = 0; j < RAMP_SAMPLES; j++)
+    in[j] = (j & 1) ? -32768 : 32767;
+  gst_buffer_unmap (inbuffer, &map);
+  GST_BUFFER_TIMESTAMP (inbuffer) = 0;
+
+  fail_unless (gst_pad_push (mysrcpad, inbuffer) == GST_FLOW_OK);
+
+  interval = gst_util_uint64_scale_int (1, GST_SECOND, 44100);
+  expected = g_new (gdouble, RAMP_SAMPLES);
+  fail_unless (gst_control_binding_get_value_array (cb, 0, interval,
+          RAMP_SAMPLES, expected));
+
+  fail_unless_equals_int (g_list_length (buffers), 1);
+  outbuffer = GST_BUFFER (buffers->data);
+  gst_buffer_map (outbuffer, &map, GST_MAP_READ);
+  in = (gint16 *) map.data;
+  for (j = 0; j < RAMP_SAMPLES; j++) {
+    gdouble val = ((j & 1) ? -32768 : 32767) * expected[j];
+
+    fail_unless (fabs (in[j] - val) <= 1.0,
+        "sample %d: %d != %f", j, in[j], val);
+  }
+  gst_buffer_unmap (outbuffer, &map);
+
+  g_list_free_full (buffers, (GDestroyNotify) gst_buffer_unref);
+  buffers = NULL;
+
+  g_free (expected);
+  gst_object_unref (cs);
+  cleanup_volume (volume);
+}
+
+GST_END_TEST;
+
 static Suite *
 volume_suite (void)
 {
@@ -1906,6 +2162,9 @@ volume_suite (void)
   tcase_add_test (tc_chain, test_controller_usability);
   tcase_add_test (tc_chain, test_controller_processing);
   tcase_add_test (tc_chain, test_controller_defaults_at_ts0);
+  tcase_add_test (tc_chain, test_controller_ramp);
+  tcase_add_test (tc_chain, test_controller_ramp_notch);
+  tcase_add_test (tc_chain, test_controller_ramp_s16);
 
   return s;
 }
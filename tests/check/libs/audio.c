@@ -28,7 +28,9 @@
 #include <gst/check/gstcheck.h>
 
 #include <gst/audio/audio.h>
+#include <gst/audio/gstaudioutilsprivate.h>
 #include <string.h>
+#include <math.h>
 
 GST_START_TEST (test_buffer_clipping_time)
 {
@@ -612,6 +614,1148 @@ GST_START_TEST (test_fill_silence)
 
 GST_END_TEST;
 
+#define RESAMPLE_FREQ 1000.0
+#define RESAMPLE_AMPLITUDE 0.5
+
+static gdouble
+resample_expected (gsize frame, gint rate)
+{
+  return RESAMPLE_AMPLITUDE * sin (2.0 * G_PI * RESAMPLE_FREQ * frame / rate);
+}
+
+/* push one second of a sine in chunks through @resampler and check the
+ * output against the ideal sine at the output rate, after the startup
+ * transient. Returns the number of produced frames */
+static gsize
+check_resampler (GstAudioResampler * resampler, GstAudioFormat format,
+    gint in_rate, gint out_rate, gsize chunk, gdouble max_error)
+{
+  const GstAudioFormatInfo *finfo = gst_audio_format_get_info (format);
+  gint bps = GST_AUDIO_FORMAT_INFO_WIDTH (finfo) / 8;
+  gpointer in[1], out[1];
+  gsize in_pos = 0, produced = 0;
+
+  in[0] = g_malloc (chunk * 2 * bps);
+  out[0] = g_malloc ((chunk * out_rate / in_rate + 2) * 2 * bps);
+
+  while (in_pos < in_rate) {
+    gsize i, n, n_out;
+
+    n = MIN (chunk, in_rate - in_pos);
+    n_out = gst_audio_resampler_get_out_frames (resampler, n);
+    fail_unless (gst_audio_resampler_get_in_frames (resampler, n_out) <= n);
+
+    for (i = 0; i < n; i++) {
+      gdouble v = resample_expected (in_pos + i, in_rate);
+
+      if (format == GST_AUDIO_FORMAT_S16) {
+        ((gint16 *) in[0])[i * 2] = v * G_MAXINT16;
+        ((gint16 *) in[0])[i * 2 + 1] = -v * G_MAXINT16;
+      } else {
+        ((gdouble *) in[0])[i * 2] = v;
+        ((gdouble *) in[0])[i * 2 + 1] = -v;
+      }
+    }
+    gst_audio_resampler_resample (resampler, in, n, out, n_out);
+
+    for (i = 0; i < n_out; i++) {
+      gdouble l, r, e = resample_expected (produced + i, out_rate);
+
+      if (format == GST_AUDIO_FORMAT_S16) {
+        l = ((gint16 *) out[0])[i * 2] / (gdouble) G_MAXINT16;
+        r = ((gint16 *) out[0])[i * 2 + 1] / (gdouble) G_MAXINT16;
+      } else {
+        l = ((gdouble *) out[0])[i * 2];
+        r = ((gdouble *) out[0])[i * 2 + 1];
+      }
+      if (produced + i < 500)
+        continue;
+      fail_unless (fabs (l - e) < max_error, "frame %" G_GSIZE_FORMAT
+          ": %f != %f", produced + i, l, e);
+      fail_unless (fabs (r + e) < max_error);
+    }
+    in_pos += n;
+    produced += n_out;
+  }
+  g_free (in[0]);
+  g_free (out[0]);
+
+  return produced;
+}
+
+GST_START_TEST (test_audio_resampler)
+{
+  static const gint rates[][2] = {
+    {44100, 48000}, {48000, 44100}, {8000, 48000}, {48000, 8000}
+  };
+  GstAudioFormat formats[] = { GST_AUDIO_FORMAT_S16, GST_AUDIO_FORMAT_F64 };
+  GstAudioResamplerFilterMode modes[] = {
+    GST_AUDIO_RESAMPLER_FILTER_MODE_FULL,
+    GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED
+  };
+  gint i, j, k;
+
+  for (i = 0; i < G_N_ELEMENTS (rates); i++) {
+    for (j = 0; j < G_N_ELEMENTS (formats); j++) {
+      for (k = 0; k < G_N_ELEMENTS (modes); k++) {
+        GstAudioResampler *resampler;
+        GstStructure *options;
+        gint in_rate = rates[i][0], out_rate = rates[i][1];
+        gsize latency, produced;
+
+        options = gst_structure_new ("options",
+            GST_AUDIO_RESAMPLER_OPT_FILTER_MODE,
+            GST_TYPE_AUDIO_RESAMPLER_FILTER_MODE, modes[k], NULL);
+        resampler = gst_audio_resampler_new (GST_AUDIO_RESAMPLER_FLAG_NONE,
+            formats[j], 2, in_rate, out_rate, options);
+        gst_structure_free (options);
+        fail_unless (resampler != NULL);
+
+        latency = gst_audio_resampler_get_max_latency (resampler);
+        fail_unless (latency > 0);
+        /* nothing comes out before the filter is filled */
+        fail_unless (gst_audio_resampler_get_out_frames (resampler,
+                latency - 1) == 0);
+        fail_unless (gst_audio_resampler_get_out_frames (resampler,
+                latency) >= 1);
+        fail_unless (gst_audio_resampler_get_in_frames (resampler,
+                1) == latency);
+
+        produced = check_resampler (resampler, formats[j], in_rate, out_rate,
+            331, formats[j] == GST_AUDIO_FORMAT_S16 ? 0.002 : 0.0001);
+        /* everything but the latency was output */
+        fail_unless (produced <= out_rate);
+        fail_unless (produced + (latency * out_rate / in_rate) + 1 >=
+            out_rate);
+
+        gst_audio_resampler_free (resampler);
+      }
+    }
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_audio_converter_resample)
+{
+  GstAudioInfo in_info, out_info;
+  GstAudioConverter *convert;
+  gint16 in[1024 * 2];
+  gfloat out[1200];
+  gsize i, pos = 0, produced = 0, latency;
+
+  gst_audio_info_set_format (&in_info, GST_AUDIO_FORMAT_S16, 44100, 2, NULL);
+  gst_audio_info_set_format (&out_info, GST_AUDIO_FORMAT_F32, 48000, 1, NULL);
+
+  convert = gst_audio_converter_new (&in_info, &out_info, NULL);
+  fail_unless (convert != NULL);
+
+  latency = gst_audio_converter_get_max_latency (convert);
+  fail_unless (latency > 0);
+  fail_unless (gst_audio_converter_get_out_frames (convert, latency) >= 1);
+
+  while (pos < 44100) {
+    gpointer inp[1] = { in }, outp[1] = {
+    out};
+    gsize n = MIN (1024, 44100 - pos), consumed, n_out;
+
+    for (i = 0; i < n; i++) {
+      in[i * 2] = in[i * 2 + 1] =
+          resample_expected (pos + i, 44100) * G_MAXINT16;
+    }
+    /* not enough room for all output, the converter consumes less */
+    fail_unless (gst_audio_converter_samples (convert, 0, inp, n, outp,
+            G_N_ELEMENTS (out) / 2, &consumed, &n_out));
+    fail_unless (consumed <= n);
+    fail_unless (n_out <= G_N_ELEMENTS (out) / 2);
+
+    if (consumed < n) {
+      gpointer inp2[1] = { in + consumed * 2 }, outp2[1] = {
+      out + n_out};
+      gsize consumed2, n_out2;
+
+      fail_unless (n_out == G_N_ELEMENTS (out) / 2);
+      fail_unless (gst_audio_converter_samples (convert, 0, inp2,
+              n - consumed, outp2, G_N_ELEMENTS (out) - n_out, &consumed2,
+              &n_out2));
+      fail_unless (consumed2 == n - consumed);
+      n_out += n_out2;
+    }
+
+    for (i = 0; i < n_out; i++) {
+      if (produced + i < 500)
+        continue;
+      fail_unless (fabs (out[i] - resample_expected (produced + i,
+                  48000)) < 0.002);
+    }
+    pos += n;
+    produced += n_out;
+  }
+  fail_unless (produced + latency * 48000 / 44100 + 1 >= 48000);
+
+  gst_audio_converter_free (convert);
+}
+
+GST_END_TEST;
+
+/* a ringbuffer without device, the test plays the role of the device
+ * thread and calls gst_audio_ring_buffer_advance() itself */
+typedef struct
+{
+  GstAudioRingBuffer parent;
+} GstTestRingBuffer;
+
+typedef struct
+{
+  GstAudioRingBufferClass parent_class;
+} GstTestRingBufferClass;
+
+GType gst_test_ring_buffer_get_type (void);
+G_DEFINE_TYPE (GstTestRingBuffer, gst_test_ring_buffer,
+    GST_TYPE_AUDIO_RING_BUFFER);
+
+static gboolean
+test_ring_buffer_acquire (GstAudioRingBuffer * buf,
+    GstAudioRingBufferSpec * spec)
+{
+  buf->size = spec->segtotal * spec->segsize;
+  buf->memory = g_malloc0 (buf->size);
+  return TRUE;
+}
+
+static gboolean
+test_ring_buffer_release (GstAudioRingBuffer * buf)
+{
+  g_free (buf->memory);
+  buf->memory = NULL;
+  return TRUE;
+}
+
+static gboolean
+test_ring_buffer_true (GstAudioRingBuffer * buf)
+{
+  return TRUE;
+}
+
+static void
+gst_test_ring_buffer_class_init (GstTestRingBufferClass * klass)
+{
+  GstAudioRingBufferClass *rclass = (GstAudioRingBufferClass *) klass;
+
+  rclass->acquire = test_ring_buffer_acquire;
+  rclass->release = test_ring_buffer_release;
+  rclass->start = test_ring_buffer_true;
+  rclass->pause = test_ring_buffer_true;
+  rclass->resume = test_ring_buffer_true;
+  rclass->stop = test_ring_buffer_true;
+}
+
+static void
+gst_test_ring_buffer_init (GstTestRingBuffer * buf)
+{
+}
+
+/* set to something larger to do benchmarks */
+#define RB_SEGMENTS 50
+#define RB_SEGTOTAL 4
+#define RB_SEG_FRAMES 96        /* 2ms at 48kHz */
+
+typedef struct
+{
+  GstAudioRingBuffer *buf;
+  gint64 advanced[RB_SEGMENTS + 1];
+  gint written;
+  gint xruns;
+} RingBufferDevice;
+
+static gpointer
+ring_buffer_device_thread (gpointer data)
+{
+  RingBufferDevice *dev = data;
+  gint i;
+
+  for (i = 0; i < RB_SEGMENTS; i++) {
+    g_usleep (RB_SEG_FRAMES * G_USEC_PER_SEC / 48000);
+    /* the next segment to play (playback) was not written yet or the
+     * oldest segment (capture) was not read yet */
+    if (g_atomic_int_get (&dev->written) <= i + 1)
+      dev->xruns++;
+    dev->advanced[i + 1] = g_get_monotonic_time ();
+    gst_audio_ring_buffer_advance (dev->buf, 1);
+  }
+  return NULL;
+}
+
+/* segdone and segbase start at @segbase so that the free running segment
+ * counter can be made to wrap through 0 */
+static GstAudioRingBuffer *
+setup_ring_buffer (gboolean spsc, gint segbase)
+{
+  GstAudioRingBuffer *buf;
+
+  buf = g_object_new (gst_test_ring_buffer_get_type (), NULL);
+  gst_audio_info_set_format (&buf->spec.info, GST_AUDIO_FORMAT_S16, 48000, 2,
+      NULL);
+  buf->spec.type = GST_AUDIO_RING_BUFFER_FORMAT_TYPE_RAW;
+  buf->spec.segsize = RB_SEG_FRAMES * buf->spec.info.bpf;
+  buf->spec.segtotal = RB_SEGTOTAL;
+  buf->spec.seglatency = -1;
+
+  fail_unless (gst_audio_ring_buffer_open_device (buf));
+  fail_unless (gst_audio_ring_buffer_acquire (buf, &buf->spec));
+  gst_audio_ring_buffer_set_spsc (buf, spsc);
+  fail_unless (gst_audio_ring_buffer_is_spsc (buf) == spsc);
+  gst_audio_ring_buffer_set_flushing (buf, FALSE);
+  gst_audio_ring_buffer_may_start (buf, TRUE);
+
+  buf->segdone = segbase;
+  buf->segbase = segbase;
+
+  return buf;
+}
+
+static void
+cleanup_ring_buffer (GstAudioRingBuffer * buf)
+{
+  gst_audio_ring_buffer_stop (buf);
+  fail_unless (gst_audio_ring_buffer_release (buf));
+  fail_unless (gst_audio_ring_buffer_close_device (buf));
+  gst_object_unref (buf);
+}
+
+static void
+run_ring_buffer_latency (gboolean spsc, gint segbase)
+{
+  static const gint64 limits[] =
+      { 5, 10, 20, 50, 100, 200, 500, 1000, 2000, G_MAXINT64 };
+  guint histogram[G_N_ELEMENTS (limits)] = { 0, };
+  RingBufferDevice dev = { NULL, };
+  GstAudioRingBuffer *buf;
+  GThread *thread;
+  gint16 data[RB_SEG_FRAMES * 2] = { 0, };
+  guint fast;
+  gint i;
+  guint j;
+
+  buf = setup_ring_buffer (spsc, segbase);
+  fail_unless (gst_audio_ring_buffer_start (buf));
+
+  dev.buf = buf;
+  thread = NULL;
+  for (i = 0; i < RB_SEGMENTS + RB_SEGTOTAL - 1; i++) {
+    guint64 sample = i * RB_SEG_FRAMES;
+    gint accum = 0;
+
+    fail_unless_equals_int (gst_audio_ring_buffer_commit (buf, &sample,
+            (guint8 *) data, RB_SEG_FRAMES, RB_SEG_FRAMES, &accum),
+        RB_SEG_FRAMES);
+    g_atomic_int_inc (&dev.written);
+
+    if (i >= RB_SEGTOTAL) {
+      /* time between the device releasing a segment and the writer
+       * filling it again */
+      gint64 latency =
+          g_get_monotonic_time () - dev.advanced[i - RB_SEGTOTAL + 1];
+
+      j = 0;
+      while (latency >= limits[j])
+        j++;
+      histogram[j]++;
+    }
+
+    /* start the device once the ringbuffer is filled */
+    if (i == RB_SEGTOTAL - 1)
+      thread = g_thread_new ("device", ring_buffer_device_thread, &dev);
+  }
+  g_thread_join (thread);
+
+  GST_DEBUG ("spsc %d: %d xruns in %d segments", spsc, dev.xruns,
+      RB_SEGMENTS);
+  fast = 0;
+  for (j = 0; j < G_N_ELEMENTS (limits); j++) {
+    GST_DEBUG ("  < %" G_GINT64_FORMAT " us: %u", limits[j], histogram[j]);
+    if (limits[j] <= 2000)
+      fast += histogram[j];
+  }
+
+  /* the writer is blocked on a full ringbuffer and woken up as soon as a
+   * segment is free, it is only late when it was not scheduled in time. A
+   * missed wakeup would make it wait for the next segment, 2ms later */
+  fail_unless (fast >= (RB_SEGMENTS - 1) / 2, "only %u of %d refills in time",
+      fast, RB_SEGMENTS - 1);
+  fail_unless (dev.xruns <= RB_SEGMENTS / 5, "%d xruns", dev.xruns);
+  fail_unless_equals_int (buf->segdone - buf->segbase, RB_SEGMENTS);
+
+  cleanup_ring_buffer (buf);
+}
+
+GST_START_TEST (test_ring_buffer_spsc_latency)
+{
+  run_ring_buffer_latency (FALSE, 0);
+  run_ring_buffer_latency (TRUE, 0);
+}
+
+GST_END_TEST;
+
+/* the segment counters are free running, a writer waiting for segment 0
+ * must be woken up like any other */
+GST_START_TEST (test_ring_buffer_spsc_wrap)
+{
+  run_ring_buffer_latency (TRUE, -RB_SEGTOTAL);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_ring_buffer_spsc_capture)
+{
+  RingBufferDevice dev = { NULL, };
+  GstAudioRingBuffer *buf;
+  GThread *thread;
+  gint16 data[RB_SEG_FRAMES * 2];
+  gint i;
+
+  buf = setup_ring_buffer (TRUE, -RB_SEGTOTAL);
+  fail_unless (gst_audio_ring_buffer_start (buf));
+
+  /* the device checks this for overruns, nothing was read yet */
+  dev.buf = buf;
+  dev.written = RB_SEGTOTAL;
+  thread = g_thread_new ("device", ring_buffer_device_thread, &dev);
+
+  /* every read blocks until the device captured the segment */
+  for (i = 0; i < RB_SEGMENTS; i++) {
+    GstClockTime timestamp;
+
+    fail_unless_equals_int (gst_audio_ring_buffer_read (buf,
+            i * RB_SEG_FRAMES, (guint8 *) data, RB_SEG_FRAMES, &timestamp),
+        RB_SEG_FRAMES);
+    fail_unless (buf->segdone - buf->segbase > i);
+    g_atomic_int_set (&dev.written, i + RB_SEGTOTAL + 1);
+  }
+  g_thread_join (thread);
+
+  GST_DEBUG ("%d overruns in %d segments", dev.xruns, RB_SEGMENTS);
+  fail_unless (dev.xruns <= RB_SEGMENTS / 5, "%d overruns", dev.xruns);
+
+  cleanup_ring_buffer (buf);
+}
+
+GST_END_TEST;
+
+static gpointer
+ring_buffer_flush_thread (gpointer data)
+{
+  GstAudioRingBuffer *buf = data;
+
+  g_usleep (10000);
+  gst_audio_ring_buffer_set_flushing (buf, TRUE);
+  return NULL;
+}
+
+/* flushing unblocks a writer waiting on a full ringbuffer and a reader
+ * waiting on an empty one */
+GST_START_TEST (test_ring_buffer_spsc_flush)
+{
+  GstAudioRingBuffer *buf;
+  GThread *thread;
+  gint16 data[RB_SEG_FRAMES * 2] = { 0, };
+  GstClockTime timestamp;
+  guint64 sample;
+  gint accum = 0;
+  gint i;
+
+  buf = setup_ring_buffer (TRUE, 0);
+  fail_unless (gst_audio_ring_buffer_start (buf));
+
+  for (i = 0; i < RB_SEGTOTAL; i++) {
+    sample = i * RB_SEG_FRAMES;
+    fail_unless_equals_int (gst_audio_ring_buffer_commit (buf, &sample,
+            (guint8 *) data, RB_SEG_FRAMES, RB_SEG_FRAMES, &accum),
+        RB_SEG_FRAMES);
+  }
+
+  /* the ringbuffer is full and no device is running */
+  thread = g_thread_new ("flush", ring_buffer_flush_thread, buf);
+  sample = RB_SEGTOTAL * RB_SEG_FRAMES;
+  fail_unless_equals_int (gst_audio_ring_buffer_commit (buf, &sample,
+          (guint8 *) data, RB_SEG_FRAMES, RB_SEG_FRAMES, &accum), 0);
+  g_thread_join (thread);
+  fail_unless (gst_audio_ring_buffer_is_flushing (buf));
+
+  /* nothing was captured */
+  gst_audio_ring_buffer_set_flushing (buf, FALSE);
+  fail_unless (gst_audio_ring_buffer_start (buf));
+  thread = g_thread_new ("flush", ring_buffer_flush_thread, buf);
+  fail_unless_equals_int (gst_audio_ring_buffer_read (buf, 0,
+          (guint8 *) data, RB_SEG_FRAMES, &timestamp), 0);
+  g_thread_join (thread);
+
+  cleanup_ring_buffer (buf);
+}
+
+GST_END_TEST;
+
+#define STATS_CAPS "audio/x-raw, format = (string) " GST_AUDIO_NE (S16) \
+    ", rate = (int) 8000, channels = (int) 1, layout = (string) interleaved"
+#define STATS_RATE 8000
+#define STATS_FRAMES 80         /* 10ms */
+
+static GstStaticPadTemplate stats_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (STATS_CAPS));
+static GstStaticPadTemplate stats_src_template =
+GST_STATIC_PAD_TEMPLATE ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (STATS_CAPS));
+
+/* audio sink and source with a device that plays and captures silence in
+ * real time */
+typedef struct
+{
+  GstAudioSink parent;
+} GstTestAudioSink;
+
+typedef struct
+{
+  GstAudioSinkClass parent_class;
+} GstTestAudioSinkClass;
+
+GType gst_test_audio_sink_get_type (void);
+G_DEFINE_TYPE (GstTestAudioSink, gst_test_audio_sink, GST_TYPE_AUDIO_SINK);
+
+typedef struct
+{
+  GstAudioSrc parent;
+} GstTestAudioSrc;
+
+typedef struct
+{
+  GstAudioSrcClass parent_class;
+} GstTestAudioSrcClass;
+
+GType gst_test_audio_src_get_type (void);
+G_DEFINE_TYPE (GstTestAudioSrc, gst_test_audio_src, GST_TYPE_AUDIO_SRC);
+
+static gboolean
+test_audio_sink_true (GstAudioSink * sink)
+{
+  return TRUE;
+}
+
+static gboolean
+test_audio_sink_prepare (GstAudioSink * sink, GstAudioRingBufferSpec * spec)
+{
+  return TRUE;
+}
+
+static gint
+test_audio_sink_write (GstAudioSink * sink, gpointer data, guint length)
+{
+  g_usleep (length / 2 * G_USEC_PER_SEC / STATS_RATE);
+  return length;
+}
+
+static guint
+test_audio_sink_delay (GstAudioSink * sink)
+{
+  return 0;
+}
+
+static void
+gst_test_audio_sink_class_init (GstTestAudioSinkClass * klass)
+{
+  GstElementClass *eclass = (GstElementClass *) klass;
+  GstAudioSinkClass *sclass = (GstAudioSinkClass *) klass;
+
+  gst_element_class_add_pad_template (eclass,
+      gst_static_pad_template_get (&stats_sink_template));
+  gst_element_class_set_static_metadata (eclass, "Test audio sink", "Sink",
+      "Plays silence", "Test");
+
+  sclass->open = test_audio_sink_true;
+  sclass->prepare = test_audio_sink_prepare;
+  sclass->unprepare = test_audio_sink_true;
+  sclass->close = test_audio_sink_true;
+  sclass->write = test_audio_sink_write;
+  sclass->delay = test_audio_sink_delay;
+}
+
+static void
+gst_test_audio_sink_init (GstTestAudioSink * sink)
+{
+}
+
+static gboolean
+test_audio_src_true (GstAudioSrc * src)
+{
+  return TRUE;
+}
+
+static gboolean
+test_audio_src_prepare (GstAudioSrc * src, GstAudioRingBufferSpec * spec)
+{
+  return TRUE;
+}
+
+static guint
+test_audio_src_read (GstAudioSrc * src, gpointer data, guint length,
+    GstClockTime * timestamp)
+{
+  g_usleep (length / 2 * G_USEC_PER_SEC / STATS_RATE);
+  memset (data, 0, length);
+  return length;
+}
+
+static guint
+test_audio_src_delay (GstAudioSrc * src)
+{
+  return 0;
+}
+
+static void
+gst_test_audio_src_class_init (GstTestAudioSrcClass * klass)
+{
+  GstElementClass *eclass = (GstElementClass *) klass;
+  GstAudioSrcClass *sclass = (GstAudioSrcClass *) klass;
+
+  gst_element_class_add_pad_template (eclass,
+      gst_static_pad_template_get (&stats_src_template));
+  gst_element_class_set_static_metadata (eclass, "Test audio source",
+      "Source", "Captures silence", "Test");
+
+  sclass->open = test_audio_src_true;
+  sclass->prepare = test_audio_src_prepare;
+  sclass->unprepare = test_audio_src_true;
+  sclass->close = test_audio_src_true;
+  sclass->read = test_audio_src_read;
+  sclass->delay = test_audio_src_delay;
+}
+
+static void
+gst_test_audio_src_init (GstTestAudioSrc * src)
+{
+}
+
+static void
+get_audio_stats (GstElement * element, guint64 * dropped, guint * resyncs,
+    guint * skew_corrections, guint * fill)
+{
+  GstStructure *stats;
+  const GValue *histogram;
+  guint i;
+
+  g_object_get (element, "stats", &stats, NULL);
+  fail_unless (stats != NULL);
+  fail_unless (gst_structure_get_uint64 (stats, "dropped", dropped));
+  fail_unless (gst_structure_get_uint (stats, "resyncs", resyncs));
+  fail_unless (gst_structure_get_uint (stats, "skew-corrections",
+          skew_corrections));
+  histogram = gst_structure_get_value (stats, "fill-histogram");
+  fail_unless (histogram != NULL);
+  fail_unless_equals_int (gst_value_array_get_size (histogram), 4);
+  *fill = 0;
+  for (i = 0; i < 4; i++)
+    *fill += g_value_get_uint (gst_value_array_get_value (histogram, i));
+  gst_structure_free (stats);
+}
+
+static GstBuffer *
+create_stats_buffer (GstClockTime timestamp)
+{
+  GstBuffer *buffer;
+
+  buffer = gst_buffer_new_and_alloc (STATS_FRAMES * 2);
+  gst_buffer_memset (buffer, 0, 0, STATS_FRAMES * 2);
+  GST_BUFFER_TIMESTAMP (buffer) = timestamp;
+  GST_BUFFER_DURATION (buffer) = 10 * GST_MSECOND;
+
+  return buffer;
+}
+
+/* clipping to the segment is not a drop, a gap in the timestamps is a
+ * resync that inserts silence */
+GST_START_TEST (test_audio_base_sink_stats)
+{
+  GstElement *sink;
+  GstPad *srcpad;
+  GstClock *clock;
+  GstCaps *caps;
+  GstSegment segment;
+  GstStructure *stats;
+  guint64 dropped, inserted;
+  guint resyncs, skew_corrections, fill;
+  gint i;
+
+  sink = g_object_new (gst_test_audio_sink_get_type (), "discont-wait",
+      (guint64) 0, NULL);
+  srcpad = gst_check_setup_src_pad (sink, &stats_src_template);
+  gst_pad_set_active (srcpad, TRUE);
+
+  /* render on our own clock, without slaving */
+  clock = gst_element_provide_clock (sink);
+  gst_element_set_clock (sink, clock);
+
+  fail_unless_equals_int (gst_element_set_state (sink, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_ASYNC);
+
+  caps = gst_caps_from_string (STATS_CAPS);
+  gst_check_setup_events (srcpad, sink, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  /* the first buffer starts 5ms before the segment */
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  segment.start = 95 * GST_MSECOND;
+  segment.time = 95 * GST_MSECOND;
+  segment.base = 100 * GST_MSECOND;
+  fail_unless (gst_pad_push_event (srcpad, gst_event_new_segment (&segment)));
+
+  for (i = 0; i < 10; i++) {
+    fail_unless_equals_int (gst_pad_push (srcpad,
+            create_stats_buffer ((90 + i * 10) * GST_MSECOND)), GST_FLOW_OK);
+  }
+  get_audio_stats (sink, &dropped, &resyncs, &skew_corrections, &fill);
+  fail_unless_equals_uint64 (dropped, 0);
+  fail_unless_equals_int (resyncs, 0);
+  fail_unless_equals_int (skew_corrections, 0);
+  fail_unless_equals_int (fill, 10);
+
+  /* 100ms gap */
+  fail_unless_equals_int (gst_pad_push (srcpad,
+          create_stats_buffer (290 * GST_MSECOND)), GST_FLOW_OK);
+  g_object_get (sink, "stats", &stats, NULL);
+  fail_unless (gst_structure_get_uint64 (stats, "dropped", &dropped));
+  fail_unless (gst_structure_get_uint64 (stats, "inserted", &inserted));
+  fail_unless (gst_structure_get_uint (stats, "resyncs", &resyncs));
+  gst_structure_free (stats);
+  fail_unless_equals_uint64 (dropped, 0);
+  fail_unless_equals_uint64 (inserted, STATS_RATE / 10);
+  fail_unless_equals_int (resyncs, 1);
+
+  fail_unless_equals_int (gst_element_set_state (sink, GST_STATE_NULL),
+      GST_STATE_CHANGE_SUCCESS);
+  gst_object_unref (clock);
+  gst_check_teardown_src_pad (sink);
+  gst_check_teardown_element (sink);
+}
+
+GST_END_TEST;
+
+/* catching up with the running time on the first buffer of a slaved source
+ * is not a resync */
+GST_START_TEST (test_audio_base_src_stats)
+{
+  GstElement *src;
+  GstPad *sinkpad;
+  GstClock *clock;
+  guint64 dropped;
+  guint resyncs, skew_corrections, fill;
+
+  src = g_object_new (gst_test_audio_src_get_type (), NULL);
+  sinkpad = gst_check_setup_sink_pad (src, &stats_sink_template);
+  gst_pad_set_active (sinkpad, TRUE);
+
+  /* slave to the system clock */
+  clock = gst_system_clock_obtain ();
+  gst_element_set_clock (src, clock);
+  gst_element_set_base_time (src, gst_clock_get_time (clock));
+
+  fail_unless (gst_element_set_state (src,
+          GST_STATE_PLAYING) != GST_STATE_CHANGE_FAILURE);
+
+  g_mutex_lock (&check_mutex);
+  while (g_list_length (buffers) < 10)
+    g_cond_wait (&check_cond, &check_mutex);
+  g_mutex_unlock (&check_mutex);
+
+  get_audio_stats (src, &dropped, &resyncs, &skew_corrections, &fill);
+  fail_unless_equals_uint64 (dropped, 0);
+  fail_unless_equals_int (resyncs, 0);
+  fail_unless_equals_int (skew_corrections, 0);
+  fail_unless (fill >= 10);
+
+  fail_unless_equals_int (gst_element_set_state (src, GST_STATE_NULL),
+      GST_STATE_CHANGE_SUCCESS);
+  gst_object_unref (clock);
+  gst_check_drop_buffers ();
+  gst_check_teardown_sink_pad (src);
+  gst_check_teardown_element (src);
+}
+
+GST_END_TEST;
+
+/* set to something larger to do benchmarks */
+#define MIX_ITERATIONS 10
+#define MIX_FRAMES 4096
+
+static void
+run_channel_mix (gint in_channels, GstAudioChannelPosition * in_position,
+    gint out_channels, GstAudioChannelPosition * out_position)
+{
+  GstAudioChannelMix *mix_int, *mix_double;
+  gint32 *in_int, *out_int;
+  gdouble *in_double, *out_double;
+  gpointer in[1], out[1];
+  gint64 start, time_int, time_double;
+  gint i, j;
+
+  mix_int = gst_audio_channel_mix_new (GST_AUDIO_CHANNEL_MIX_FLAGS_NONE,
+      GST_AUDIO_FORMAT_S32, in_channels, in_position, out_channels,
+      out_position);
+  fail_unless (mix_int != NULL);
+  mix_double = gst_audio_channel_mix_new (GST_AUDIO_CHANNEL_MIX_FLAGS_NONE,
+      GST_AUDIO_FORMAT_F64, in_channels, in_position, out_channels,
+      out_position);
+  fail_unless (mix_double != NULL);
+
+  in_int = g_new (gint32, MIX_FRAMES * in_channels);
+  in_double = g_new (gdouble, MIX_FRAMES * in_channels);
+  out_int = g_new (gint32, MIX_FRAMES * out_channels);
+  out_double = g_new (gdouble, MIX_FRAMES * out_channels);
+
+  /* stay away from full scale, the mix of all channels should not clip */
+  for (i = 0; i < MIX_FRAMES * in_channels; i++) {
+    in_int[i] = g_random_int_range (-(1 << 26), 1 << 26);
+    in_double[i] = in_int[i] / 2147483648.0;
+  }
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < MIX_ITERATIONS; i++) {
+    in[0] = in_int;
+    out[0] = out_int;
+    gst_audio_channel_mix_samples (mix_int, in, out, MIX_FRAMES);
+  }
+  time_int = g_get_monotonic_time () - start;
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < MIX_ITERATIONS; i++) {
+    in[0] = in_double;
+    out[0] = out_double;
+    gst_audio_channel_mix_samples (mix_double, in, out, MIX_FRAMES);
+  }
+  time_double = g_get_monotonic_time () - start;
+
+  GST_DEBUG ("%d -> %d: S32 %" G_GINT64_FORMAT " us, F64 %" G_GINT64_FORMAT
+      " us for %d frames", in_channels, out_channels, time_int, time_double,
+      MIX_ITERATIONS * MIX_FRAMES);
+
+  /* the integer matrix has 10 bits of precision */
+  for (i = 0; i < MIX_FRAMES * out_channels; i++) {
+    fail_unless (fabs (out_int[i] / 2147483648.0 - out_double[i]) < 0.001,
+        "sample %d: %d != %f", i, out_int[i], out_double[i]);
+  }
+
+  /* mixing in place must give the same result */
+  if (in_channels >= out_channels) {
+    in[0] = out[0] = in_int;
+    gst_audio_channel_mix_samples (mix_int, in, out, MIX_FRAMES);
+    fail_unless (memcmp (in_int, out_int,
+            MIX_FRAMES * out_channels * sizeof (gint32)) == 0);
+  }
+
+  /* outputs that have their own position in the input are copied exactly
+   * when the layouts only differ in order */
+  if (in_channels == out_channels) {
+    for (j = 0; j < out_channels; j++) {
+      gint in_ch;
+
+      for (in_ch = 0; in_ch < in_channels; in_ch++)
+        if (in_position[in_ch] == out_position[j])
+          break;
+      fail_unless (in_ch < in_channels);
+
+      for (i = 0; i < MIX_FRAMES; i++) {
+        fail_unless_equals_int (out_int[i * out_channels + j],
+            (gint) (in_double[i * in_channels + in_ch] * 2147483648.0));
+        fail_unless_equals_float (out_double[i * out_channels + j],
+            in_double[i * in_channels + in_ch]);
+      }
+    }
+  }
+
+  g_free (in_int);
+  g_free (in_double);
+  g_free (out_int);
+  g_free (out_double);
+  gst_audio_channel_mix_free (mix_int);
+  gst_audio_channel_mix_free (mix_double);
+}
+
+GST_START_TEST (test_channel_mix)
+{
+  GstAudioChannelPosition stereo[] = {
+    GST_AUDIO_CHANNEL_POSITION_FRONT_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_FRONT_RIGHT
+  };
+  GstAudioChannelPosition surround51[] = {
+    GST_AUDIO_CHANNEL_POSITION_FRONT_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_FRONT_RIGHT,
+    GST_AUDIO_CHANNEL_POSITION_FRONT_CENTER,
+    GST_AUDIO_CHANNEL_POSITION_LFE1,
+    GST_AUDIO_CHANNEL_POSITION_REAR_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_REAR_RIGHT
+  };
+  GstAudioChannelPosition surround71[] = {
+    GST_AUDIO_CHANNEL_POSITION_FRONT_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_FRONT_RIGHT,
+    GST_AUDIO_CHANNEL_POSITION_FRONT_CENTER,
+    GST_AUDIO_CHANNEL_POSITION_LFE1,
+    GST_AUDIO_CHANNEL_POSITION_REAR_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_REAR_RIGHT,
+    GST_AUDIO_CHANNEL_POSITION_SIDE_LEFT,
+    GST_AUDIO_CHANNEL_POSITION_SIDE_RIGHT
+  };
+  GstAudioChannelPosition in16[16], out16[16];
+  gint i;
+
+  /* 16 positioned channels, reordered */
+  for (i = 0; i < 16; i++) {
+    in16[i] = (GstAudioChannelPosition) i;
+    out16[i] = (GstAudioChannelPosition) (15 - i);
+  }
+
+  run_channel_mix (2, stereo, 6, surround51);
+  run_channel_mix (6, surround51, 2, stereo);
+  run_channel_mix (8, surround71, 2, stereo);
+  run_channel_mix (16, in16, 16, out16);
+}
+
+GST_END_TEST;
+
+/* set to something larger to do benchmarks */
+#define QUANTIZE_ITERATIONS 10
+#define QUANTIZE_FRAMES 4096
+
+static void
+run_quantize (GstAudioDitherMethod dither, GstAudioNoiseShapingMethod ns,
+    gint channels)
+{
+  GstAudioQuantize *quant, *mono[8];
+  gint32 *in, *out, *in_mono, *out_mono;
+  gpointer inp[1], outp[1];
+  gint64 start, time_interleaved, time_mono;
+  gint i, j, k;
+
+  quant = gst_audio_quantize_new (dither, ns, GST_AUDIO_QUANTIZE_FLAG_NONE,
+      GST_AUDIO_FORMAT_S32, channels, 1 << 16);
+  fail_unless (quant != NULL);
+  for (j = 0; j < channels; j++) {
+    mono[j] = gst_audio_quantize_new (dither, ns,
+        GST_AUDIO_QUANTIZE_FLAG_NONE, GST_AUDIO_FORMAT_S32, 1, 1 << 16);
+    fail_unless (mono[j] != NULL);
+  }
+
+  in = g_new (gint32, QUANTIZE_FRAMES * channels);
+  out = g_new (gint32, QUANTIZE_FRAMES * channels);
+  in_mono = g_new (gint32, QUANTIZE_FRAMES * channels);
+  out_mono = g_new (gint32, QUANTIZE_FRAMES * channels);
+
+  time_interleaved = time_mono = 0;
+  for (k = 0; k < QUANTIZE_ITERATIONS; k++) {
+    for (i = 0; i < QUANTIZE_FRAMES; i++) {
+      for (j = 0; j < channels; j++) {
+        in[i * channels + j] = g_random_int_range (-(1 << 30), 1 << 30);
+        in_mono[j * QUANTIZE_FRAMES + i] = in[i * channels + j];
+      }
+    }
+
+    inp[0] = in;
+    outp[0] = out;
+    start = g_get_monotonic_time ();
+    gst_audio_quantize_samples (quant, inp, outp, QUANTIZE_FRAMES);
+    time_interleaved += g_get_monotonic_time () - start;
+
+    start = g_get_monotonic_time ();
+    for (j = 0; j < channels; j++) {
+      inp[0] = in_mono + j * QUANTIZE_FRAMES;
+      outp[0] = out_mono + j * QUANTIZE_FRAMES;
+      gst_audio_quantize_samples (mono[j], inp, outp, QUANTIZE_FRAMES);
+    }
+    time_mono += g_get_monotonic_time () - start;
+
+    for (i = 0; i < QUANTIZE_FRAMES * channels; i++)
+      fail_unless ((out[i] & 0xffff) == 0);
+
+    /* without dither the noise shaping state is per channel so the
+     * interleaved result must match quantizing each channel on its own */
+    if (dither == GST_AUDIO_DITHER_NONE) {
+      for (i = 0; i < QUANTIZE_FRAMES; i++)
+        for (j = 0; j < channels; j++)
+          fail_unless_equals_int (out[i * channels + j],
+              out_mono[j * QUANTIZE_FRAMES + i]);
+    }
+  }
+
+  GST_DEBUG ("dither %d, noise-shaping %d, %d channels: interleaved %"
+      G_GINT64_FORMAT " us, mono %" G_GINT64_FORMAT " us for %d frames",
+      dither, ns, channels, time_interleaved, time_mono,
+      QUANTIZE_ITERATIONS * QUANTIZE_FRAMES);
+
+  g_free (in);
+  g_free (out);
+  g_free (in_mono);
+  g_free (out_mono);
+  for (j = 0; j < channels; j++)
+    gst_audio_quantize_free (mono[j]);
+  gst_audio_quantize_free (quant);
+}
+
+GST_START_TEST (test_audio_quantize)
+{
+  static const gint channels[] = { 1, 2, 3, 6, 8 };
+  gint dither, ns, c;
+
+  for (dither = GST_AUDIO_DITHER_NONE; dither <= GST_AUDIO_DITHER_TPDF_HF;
+      dither++) {
+    for (ns = GST_AUDIO_NOISE_SHAPING_NONE; ns <= GST_AUDIO_NOISE_SHAPING_HIGH;
+        ns++) {
+      for (c = 0; c < G_N_ELEMENTS (channels); c++)
+        run_quantize (dither, ns, channels[c]);
+    }
+  }
+}
+
+GST_END_TEST;
+
+/* the linear congruential generator used for the dither */
+#define QUANTIZE_RANDOM_MUL 1103515245
+#define QUANTIZE_RANDOM_ADD 12345
+
+GST_START_TEST (test_audio_quantize_random)
+{
+  static const gint shifts[] = { 1, 8, 16, 24 };
+  /* odd chunk sizes so that the batches of random numbers are split */
+  static const gint chunks[] = { 1, 5, 8, 13, 64, 3, 100 };
+  GstAudioQuantize *quant, *other;
+  gint32 in[3 * 100], out[3 * 100], out2[3 * 100];
+  gpointer inp[1], outp[1];
+  guint32 state;
+  gint i, j, k, n, differ;
+
+  /* with a fixed seed RPDF dither of a half step exposes bit k of every
+   * random number, which must follow the sequence of the generator */
+  for (i = 0; i < G_N_ELEMENTS (shifts); i++) {
+    k = shifts[i];
+    quant = gst_audio_quantize_new (GST_AUDIO_DITHER_RPDF,
+        GST_AUDIO_NOISE_SHAPING_NONE, GST_AUDIO_QUANTIZE_FLAG_NONE,
+        GST_AUDIO_FORMAT_S32, 3, 1 << k);
+    fail_unless (quant != NULL);
+    _gst_audio_quantize_set_seed (quant, 1234);
+
+    for (j = 0; j < G_N_ELEMENTS (in); j++)
+      in[j] = 1 << (k - 1);
+
+    state = 1234;
+    for (j = 0; j < 4 * G_N_ELEMENTS (chunks); j++) {
+      gint frames = chunks[j % G_N_ELEMENTS (chunks)];
+
+      inp[0] = in;
+      outp[0] = out;
+      gst_audio_quantize_samples (quant, inp, outp, frames);
+
+      for (n = 0; n < frames * 3; n++) {
+        state = state * QUANTIZE_RANDOM_MUL + QUANTIZE_RANDOM_ADD;
+        fail_unless_equals_int (out[n], ((state >> k) & 1) << k);
+      }
+    }
+    gst_audio_quantize_free (quant);
+  }
+
+  /* without reseeding, every quantizer gets its own dither */
+  quant = gst_audio_quantize_new (GST_AUDIO_DITHER_TPDF,
+      GST_AUDIO_NOISE_SHAPING_NONE, GST_AUDIO_QUANTIZE_FLAG_NONE,
+      GST_AUDIO_FORMAT_S32, 3, 1 << 16);
+  other = gst_audio_quantize_new (GST_AUDIO_DITHER_TPDF,
+      GST_AUDIO_NOISE_SHAPING_NONE, GST_AUDIO_QUANTIZE_FLAG_NONE,
+      GST_AUDIO_FORMAT_S32, 3, 1 << 16);
+  for (j = 0; j < G_N_ELEMENTS (in); j++)
+    in[j] = 1 << 15;
+  inp[0] = in;
+  outp[0] = out;
+  gst_audio_quantize_samples (quant, inp, outp, 100);
+  outp[0] = out2;
+  gst_audio_quantize_samples (other, inp, outp, 100);
+  differ = 0;
+  for (j = 0; j < G_N_ELEMENTS (out); j++)
+    if (out[j] != out2[j])
+      differ++;
+  fail_unless (differ > 0);
+  gst_audio_quantize_free (quant);
+  gst_audio_quantize_free (other);
+}
+
+GST_END_TEST;
+
+#define NOISE_FRAMES 8192
+
+/* returns the ratio of the quantization error power in the lower half of
+ * the spectrum to the power in the upper half */
+static gdouble
+quantize_noise_ratio (GstAudioNoiseShapingMethod ns, gint channels)
+{
+  GstAudioQuantize *quant;
+  gint32 *in, *out;
+  gpointer inp[1], outp[1];
+  gdouble low = 0.0, high = 0.0;
+  gint i, c;
+
+  quant = gst_audio_quantize_new (GST_AUDIO_DITHER_TPDF, ns,
+      GST_AUDIO_QUANTIZE_FLAG_NONE, GST_AUDIO_FORMAT_S32, channels, 1 << 16);
+  fail_unless (quant != NULL);
+  _gst_audio_quantize_set_seed (quant, 1234);
+
+  in = g_new (gint32, NOISE_FRAMES * channels);
+  out = g_new (gint32, NOISE_FRAMES * channels);
+  for (i = 0; i < NOISE_FRAMES; i++)
+    for (c = 0; c < channels; c++)
+      in[i * channels + c] = (1 << 24) * sin (2.0 * G_PI * i / (97 + c));
+
+  inp[0] = in;
+  outp[0] = out;
+  gst_audio_quantize_samples (quant, inp, outp, NOISE_FRAMES);
+
+  for (i = 0; i < NOISE_FRAMES - 1; i++) {
+    for (c = 0; c < channels; c++) {
+      gdouble e0 = (gdouble) out[i * channels + c] - in[i * channels + c];
+      gdouble e1 = (gdouble) out[(i + 1) * channels + c] -
+          in[(i + 1) * channels + c];
+
+      low += (e0 + e1) * (e0 + e1);
+      high += (e0 - e1) * (e0 - e1);
+    }
+  }
+
+  g_free (in);
+  g_free (out);
+  gst_audio_quantize_free (quant);
+
+  return low / high;
+}
+
+GST_START_TEST (test_audio_quantize_noise_shaping)
+{
+  /* 2 channels use the interleaved versions of the noise shaping */
+  static const gint channels[] = { 1, 2 };
+  gint ns, c;
+
+  for (c = 0; c < G_N_ELEMENTS (channels); c++) {
+    gdouble ratio;
+
+    /* dither and quantization error are white */
+    ratio = quantize_noise_ratio (GST_AUDIO_NOISE_SHAPING_NONE, channels[c]);
+    GST_DEBUG ("%d channels, no noise shaping: %f", channels[c], ratio);
+    fail_unless (ratio > 0.8 && ratio < 1.25);
+
+    /* all noise shaping filters move the error to the high frequencies */
+    for (ns = GST_AUDIO_NOISE_SHAPING_ERROR_FEEDBACK;
+        ns <= GST_AUDIO_NOISE_SHAPING_HIGH; ns++) {
+      ratio = quantize_noise_ratio (ns, channels[c]);
+      GST_DEBUG ("%d channels, noise shaping %d: %f", channels[c], ns, ratio);
+      fail_unless (ratio < 0.5);
+    }
+  }
+}
+
+GST_END_TEST;
+
 static Suite *
 audio_suite (void)
 {
@@ -626,6 +1770,18 @@ audio_suite (void)
   tcase_add_test (tc_chain, test_multichannel_checks);
   tcase_add_test (tc_chain, test_multichannel_reorder);
   tcase_add_test (tc_chain, test_fill_silence);
+  tcase_add_test (tc_chain, test_audio_resampler);
+  tcase_add_test (tc_chain, test_audio_converter_resample);
+  tcase_add_test (tc_chain, test_ring_buffer_spsc_latency);
+  tcase_add_test (tc_chain, test_ring_buffer_spsc_wrap);
+  tcase_add_test (tc_chain, test_ring_buffer_spsc_capture);
+  tcase_add_test (tc_chain, test_ring_buffer_spsc_flush);
+  tcase_add_test (tc_chain, test_audio_base_sink_stats);
+  tcase_add_test (tc_chain, test_audio_base_src_stats);
+  tcase_add_test (tc_chain, test_channel_mix);
+  tcase_add_test (tc_chain, test_audio_quantize);
+  tcase_add_test (tc_chain, test_audio_quantize_random);
+  tcase_add_test (tc_chain, test_audio_quantize_noise_shaping);
 
   return s;
 }
@@ -73,6 +73,7 @@ struct _GstAudioDecoderTester
 
   gboolean setoutputformat_on_decoding;
   gboolean output_too_many_frames;
+  gboolean allocate_output_buffer;
 };
 
 struct _GstAudioDecoderTesterClass
@@ -149,11 +150,17 @@ gst_audio_decoder_tester_handle_frame (GstAudioDecoder * dec,
   /* the output is SE32LE stereo 44100 Hz */
   size = 2 * 4;
   g_assert (size == sizeof (guint64));
-  data = g_malloc0 (size);
 
-  memcpy (data, map.data, sizeof (guint64));
+  if (tester->allocate_output_buffer) {
+    output_buffer = gst_audio_decoder_allocate_output_buffer (dec, size);
+    gst_buffer_fill (output_buffer, 0, map.data, sizeof (guint64));
+  } else {
+    data = g_malloc0 (size);
+
+    memcpy (data, map.data, sizeof (guint64));
 
-  output_buffer = gst_buffer_new_wrapped (data, size);
+    output_buffer = gst_buffer_new_wrapped (data, size);
+  }
 
   gst_buffer_unmap (buffer, &map);
 
@@ -672,6 +679,55 @@ GST_START_TEST (audiodecoder_output_too_many_frames)
 
 GST_END_TEST;
 
+GST_START_TEST (audiodecoder_output_buffer_pool)
+{
+  GstBuffer *buffer, *first = NULL;
+  guint allocations;
+  guint64 i;
+
+  GstHarness *h = setup_audiodecodertester (NULL, NULL);
+
+  ((GstAudioDecoderTester *) h->element)->allocate_output_buffer = TRUE;
+
+  /* the tester decodes exactly one input buffer per frame */
+  fail_if (gst_audio_decoder_get_bypass_adapter (GST_AUDIO_DECODER
+          (h->element)));
+  gst_audio_decoder_set_bypass_adapter (GST_AUDIO_DECODER (h->element), TRUE);
+
+  /* the output buffers are released right away, so they should all be
+   * recycled through the pool of the decoder */
+  for (i = 0; i < NUM_BUFFERS; i++) {
+    GstMapInfo map;
+
+    fail_unless (gst_harness_push (h, create_test_buffer (i)) == GST_FLOW_OK);
+
+    buffer = gst_harness_pull (h);
+    fail_unless_equals_int (gst_buffer_get_size (buffer), sizeof (guint64));
+
+    /* the same buffer comes back from the pool every time */
+    fail_unless (buffer->pool != NULL);
+    if (first == NULL)
+      first = buffer;
+    fail_unless (buffer == first);
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    fail_unless_equals_uint64 (i, *(guint64 *) map.data);
+    gst_buffer_unmap (buffer, &map);
+
+    gst_buffer_unref (buffer);
+  }
+
+  g_object_get (h->element, "allocations", &allocations, NULL);
+  fail_unless_equals_int (allocations, 0);
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+  fail_unless_equals_int (0, gst_harness_buffers_in_queue (h));
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (audiodecoder_query_caps_with_fixed_caps_peer)
 {
   GstCaps *caps;
@@ -1036,6 +1092,7 @@ gst_audiodecoder_suite (void)
   tcase_add_test (tc, audiodecoder_eos_events_no_buffers);
   tcase_add_test (tc, audiodecoder_buffer_after_segment);
   tcase_add_test (tc, audiodecoder_output_too_many_frames);
+  tcase_add_test (tc, audiodecoder_output_buffer_pool);
 
   tcase_add_test (tc, audiodecoder_query_caps_with_fixed_caps_peer);
   tcase_add_test (tc, audiodecoder_query_caps_with_range_caps_peer);
@@ -41,6 +41,8 @@ typedef struct _GstAudioEncoderTesterClass GstAudioEncoderTesterClass;
 struct _GstAudioEncoderTester
 {
   GstAudioEncoder parent;
+
+  gboolean allocate_output_buffer;
 };
 
 struct _GstAudioEncoderTesterClass
@@ -80,6 +82,7 @@ static GstFlowReturn
 gst_audio_encoder_tester_handle_frame (GstAudioEncoder * enc,
     GstBuffer * buffer)
 {
+  GstAudioEncoderTester *tester = (GstAudioEncoderTester *) enc;
   guint8 *data;
   GstMapInfo map;
   guint64 input_num;
@@ -92,10 +95,16 @@ gst_audio_encoder_tester_handle_frame (GstAudioEncoder * enc,
   input_num = *((guint64 *) map.data);
   gst_buffer_unmap (buffer, &map);
 
-  data = g_malloc (sizeof (guint64));
-  *(guint64 *) data = input_num;
+  if (tester->allocate_output_buffer) {
+    output_buffer =
+        gst_audio_encoder_allocate_output_buffer (enc, sizeof (guint64));
+    gst_buffer_fill (output_buffer, 0, &input_num, sizeof (guint64));
+  } else {
+    data = g_malloc (sizeof (guint64));
+    *(guint64 *) data = input_num;
 
-  output_buffer = gst_buffer_new_wrapped (data, sizeof (guint64));
+    output_buffer = gst_buffer_new_wrapped (data, sizeof (guint64));
+  }
   GST_BUFFER_PTS (output_buffer) = GST_BUFFER_PTS (buffer);
   GST_BUFFER_DURATION (output_buffer) = GST_BUFFER_DURATION (buffer);
 
@@ -231,6 +240,47 @@ GST_START_TEST (audioencoder_playback)
 
 GST_END_TEST;
 
+GST_START_TEST (audioencoder_steady_state_allocations)
+{
+  GstBuffer *buffer, *first = NULL;
+  guint allocations;
+  guint64 i;
+
+  GstHarness *h = setup_audioencodertester ();
+
+  ((GstAudioEncoderTester *) h->element)->allocate_output_buffer = TRUE;
+
+  /* each input buffer is exactly one frame and is passed to the subclass
+   * as is, the output buffers are released right away and recycled through
+   * the pool of the encoder */
+  for (i = 0; i < NUM_BUFFERS; i++) {
+    GstMapInfo map;
+
+    fail_unless (gst_harness_push (h, create_test_buffer (i)) == GST_FLOW_OK);
+
+    buffer = gst_harness_pull (h);
+
+    /* the same buffer comes back from the pool every time */
+    fail_unless (buffer->pool != NULL);
+    if (first == NULL)
+      first = buffer;
+    fail_unless (buffer == first);
+
+    gst_buffer_map (buffer, &map, GST_MAP_READ);
+    fail_unless (i == *(guint64 *) map.data);
+    gst_buffer_unmap (buffer, &map);
+
+    gst_buffer_unref (buffer);
+  }
+
+  g_object_get (h->element, "allocations", &allocations, NULL);
+  fail_unless_equals_int (allocations, 0);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 
 GST_START_TEST (audioencoder_flush_events)
 {
@@ -406,6 +456,7 @@ gst_audioencoder_suite (void)
 
   suite_add_tcase (s, tc);
   tcase_add_test (tc, audioencoder_playback);
+  tcase_add_test (tc, audioencoder_steady_state_allocations);
 
   tcase_add_test (tc, audioencoder_tags_before_eos);
   tcase_add_test (tc, audioencoder_events_before_eos);
@@ -45,6 +45,11 @@ typedef struct _GstRtpDummyPayClass GstRtpDummyPayClass;
 struct _GstRtpDummyPay
 {
   GstRTPBasePayload payload;
+
+  guint packets_per_buffer;
+  gboolean pooled;
+  /* change the caps before this packet of every buffer, 0 for never */
+  guint outcaps_at;
 };
 
 struct _GstRtpDummyPayClass
@@ -91,6 +96,10 @@ gst_rtp_dummy_pay_class_init (GstRtpDummyPayClass * klass)
 static void
 gst_rtp_dummy_pay_init (GstRtpDummyPay * pay)
 {
+  pay->packets_per_buffer = 1;
+  pay->pooled = FALSE;
+  pay->outcaps_at = 0;
+
   gst_rtp_base_payload_set_options (GST_RTP_BASE_PAYLOAD (pay), "application",
       TRUE, "dummy", DEFAULT_CLOCK_RATE);
 }
@@ -104,7 +113,10 @@ rtp_dummy_pay_new (void)
 static GstFlowReturn
 gst_rtp_dummy_pay_handle_buffer (GstRTPBasePayload * pay, GstBuffer * buffer)
 {
+  GstRtpDummyPay *dummy = GST_RTP_DUMMY_PAY (pay);
+  GstFlowReturn ret = GST_FLOW_OK;
   GstBuffer *paybuffer;
+  guint i;
 
   GST_LOG ("payloading buffer pts=%" GST_TIME_FORMAT " offset=%"
       G_GUINT64_FORMAT, GST_TIME_ARGS (GST_BUFFER_PTS (buffer)),
@@ -118,24 +130,40 @@ gst_rtp_dummy_pay_handle_buffer (GstRTPBasePayload * pay, GstBuffer * buffer)
     }
   }
 
-  paybuffer = gst_rtp_buffer_new_allocate (0, 0, 0);
+  for (i = 0; i < dummy->packets_per_buffer && ret == GST_FLOW_OK; i++) {
+    if (dummy->outcaps_at != 0 && i == dummy->outcaps_at) {
+      if (!gst_rtp_base_payload_set_outcaps (GST_RTP_BASE_PAYLOAD (pay),
+              "custom-caps", G_TYPE_UINT, DEFAULT_CLOCK_RATE + 1, NULL)) {
+        gst_buffer_unref (buffer);
+        return GST_FLOW_NOT_NEGOTIATED;
+      }
+    }
+
+    if (dummy->pooled)
+      paybuffer = gst_rtp_base_payload_allocate_output_buffer (pay, 0, 0, 0);
+    else
+      paybuffer = gst_rtp_buffer_new_allocate (0, 0, 0);
 
-  GST_BUFFER_PTS (paybuffer) = GST_BUFFER_PTS (buffer);
-  GST_BUFFER_OFFSET (paybuffer) = GST_BUFFER_OFFSET (buffer);
+    GST_BUFFER_PTS (paybuffer) = GST_BUFFER_PTS (buffer);
+    GST_BUFFER_OFFSET (paybuffer) = GST_BUFFER_OFFSET (buffer);
 
-  gst_buffer_append (paybuffer, buffer);
+    gst_buffer_copy_into (paybuffer, buffer, GST_BUFFER_COPY_MEMORY, 0, -1);
 
-  GST_LOG ("payloaded buffer pts=%" GST_TIME_FORMAT " offset=%"
-      G_GUINT64_FORMAT, GST_TIME_ARGS (GST_BUFFER_PTS (paybuffer)),
-      GST_BUFFER_OFFSET (paybuffer));
+    GST_LOG ("payloaded buffer pts=%" GST_TIME_FORMAT " offset=%"
+        G_GUINT64_FORMAT, GST_TIME_ARGS (GST_BUFFER_PTS (paybuffer)),
+        GST_BUFFER_OFFSET (paybuffer));
 
-  if (GST_BUFFER_PTS (paybuffer) < BUFFER_BEFORE_LIST) {
-    return gst_rtp_base_payload_push (pay, paybuffer);
-  } else {
-    GstBufferList *list = gst_buffer_list_new ();
-    gst_buffer_list_add (list, paybuffer);
-    return gst_rtp_base_payload_push_list (pay, list);
+    if (GST_BUFFER_PTS (paybuffer) < BUFFER_BEFORE_LIST) {
+      ret = gst_rtp_base_payload_push (pay, paybuffer);
+    } else {
+      GstBufferList *list = gst_buffer_list_new ();
+      gst_buffer_list_add (list, paybuffer);
+      ret = gst_rtp_base_payload_push_list (pay, list);
+    }
   }
+  gst_buffer_unref (buffer);
+
+  return ret;
 }
 
 /* Helper functions and global state */
@@ -1856,6 +1884,250 @@ GST_START_TEST (rtp_base_payload_max_framerate_attribute)
 
 GST_END_TEST;
 
+static guint lists_received;
+static guint list_lengths[4];
+static guint list_custom_caps[4];
+
+/* records the lists and the caps they arrived with and collects their
+ * buffers */
+static GstFlowReturn
+collect_chain_list_func (GstPad * pad, GstObject * parent,
+    GstBufferList * list)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstCaps *caps;
+  guint i, len;
+
+  fail_unless (lists_received < G_N_ELEMENTS (list_lengths));
+
+  len = gst_buffer_list_length (list);
+  list_lengths[lists_received] = len;
+  list_custom_caps[lists_received] = 0;
+  caps = gst_pad_get_current_caps (pad);
+  if (caps) {
+    gst_structure_get_uint (gst_caps_get_structure (caps, 0), "custom-caps",
+        &list_custom_caps[lists_received]);
+    gst_caps_unref (caps);
+  }
+  lists_received++;
+
+  for (i = 0; i < len && ret == GST_FLOW_OK; i++)
+    ret = gst_check_chain_func (pad, parent,
+        gst_buffer_ref (gst_buffer_list_get (list, i)));
+  gst_buffer_list_unref (list);
+
+  return ret;
+}
+
+/* the packets of an input buffer are collected and pushed as one list in
+ * push-list mode. their headers must be the same as when they are pushed one
+ * by one: sequence numbers keep incrementing and the packets of one input
+ * buffer share its rtptime.
+ */
+GST_START_TEST (rtp_base_payload_push_list_mode_test)
+{
+  State *state;
+  GstRtpDummyPay *pay;
+  guint32 rtptime;
+  guint16 seq;
+  guint i;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl,
+      "perfect-rtptime", FALSE, NULL);
+  pay = GST_RTP_DUMMY_PAY (state->element);
+  pay->packets_per_buffer = 3;
+  pay->pooled = TRUE;
+  gst_rtp_base_payload_set_push_list (GST_RTP_BASE_PAYLOAD (pay), TRUE);
+  gst_pad_set_chain_list_function (state->sinkpad, collect_chain_list_func);
+  lists_received = 0;
+
+  set_state (state, GST_STATE_PLAYING);
+
+  push_buffer (state, "pts", 0 * GST_SECOND, NULL);
+
+  push_buffer (state, "pts", 1 * GST_SECOND, NULL);
+
+  set_state (state, GST_STATE_NULL);
+
+  fail_unless_equals_int (lists_received, 2);
+  fail_unless_equals_int (list_lengths[0], 3);
+  fail_unless_equals_int (list_lengths[1], 3);
+
+  validate_buffers_received (6);
+
+  get_buffer_field (0, "rtptime", &rtptime, "seq", &seq, NULL);
+
+  for (i = 0; i < 6; i++) {
+    validate_buffer (i,
+        "pts", (i / 3) * GST_SECOND,
+        "rtptime", rtptime + (i / 3) * DEFAULT_CLOCK_RATE, "seq", seq + i,
+        NULL);
+  }
+
+  validate_events_received (3);
+
+  validate_normal_start_events (0);
+
+  destroy_payloader (state);
+}
+
+GST_END_TEST;
+
+/* a subclass that changes the caps in the middle of an input buffer gets the
+ * packets it made so far pushed with the old caps, before the new caps
+ */
+GST_START_TEST (rtp_base_payload_push_list_caps_test)
+{
+  State *state;
+  GstRtpDummyPay *pay;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl, NULL);
+  pay = GST_RTP_DUMMY_PAY (state->element);
+  pay->packets_per_buffer = 3;
+  pay->outcaps_at = 2;
+  gst_rtp_base_payload_set_push_list (GST_RTP_BASE_PAYLOAD (pay), TRUE);
+  gst_pad_set_chain_list_function (state->sinkpad, collect_chain_list_func);
+  lists_received = 0;
+
+  set_state (state, GST_STATE_PLAYING);
+
+  push_buffer (state, "pts", 0 * GST_SECOND, NULL);
+
+  set_state (state, GST_STATE_NULL);
+
+  fail_unless_equals_int (lists_received, 2);
+  fail_unless_equals_int (list_lengths[0], 2);
+  fail_unless_equals_int (list_custom_caps[0], DEFAULT_CLOCK_RATE);
+  fail_unless_equals_int (list_lengths[1], 1);
+  fail_unless_equals_int (list_custom_caps[1], DEFAULT_CLOCK_RATE + 1);
+
+  validate_buffers_received (3);
+
+  destroy_payloader (state);
+}
+
+GST_END_TEST;
+
+/* header buffers from the pool come back without the payload that was
+ * appended to them and with a clean header.
+ */
+GST_START_TEST (rtp_base_payload_header_pool_test)
+{
+  GstRTPBasePayload *pay;
+  GstBuffer *buf, *reused;
+  GstRTPBuffer rtp = { NULL };
+
+  pay = GST_RTP_BASE_PAYLOAD (rtp_dummy_pay_new ());
+
+  buf = gst_rtp_base_payload_allocate_output_buffer (pay, 0, 0, 0);
+  fail_unless_equals_int (gst_buffer_get_size (buf),
+      gst_rtp_buffer_calc_header_len (0));
+
+  fail_unless (gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp));
+  gst_rtp_buffer_set_marker (&rtp, TRUE);
+  gst_rtp_buffer_set_seq (&rtp, 4242);
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_append_memory (buf, gst_allocator_alloc (NULL, 100, NULL));
+
+  gst_buffer_unref (buf);
+
+  reused = gst_rtp_base_payload_allocate_output_buffer (pay, 0, 0, 0);
+  fail_unless (reused == buf);
+  fail_unless_equals_int (gst_buffer_n_memory (reused), 1);
+  fail_unless_equals_int (gst_buffer_get_size (reused),
+      gst_rtp_buffer_calc_header_len (0));
+
+  fail_unless (gst_rtp_buffer_map (reused, GST_MAP_READ, &rtp));
+  fail_if (gst_rtp_buffer_get_marker (&rtp));
+  fail_unless_equals_int (gst_rtp_buffer_get_seq (&rtp), 0);
+  fail_unless_equals_int (gst_rtp_buffer_get_payload_len (&rtp), 0);
+  gst_rtp_buffer_unmap (&rtp);
+
+  gst_buffer_unref (reused);
+
+  /* other packets are not pooled */
+  buf = gst_rtp_base_payload_allocate_output_buffer (pay, 100, 0, 0);
+  fail_unless_equals_int (gst_buffer_get_size (buf),
+      gst_rtp_buffer_calc_packet_len (100, 0, 0));
+  gst_buffer_unref (buf);
+
+  g_object_unref (pay);
+}
+
+GST_END_TEST;
+
+/* set to something larger to do benchmarks */
+#define RATE_BUFFERS 100
+#define RATE_PACKETS 100
+
+static guint packets_received;
+
+static GstFlowReturn
+count_chain_func (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  packets_received++;
+  gst_buffer_unref (buffer);
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+count_chain_list_func (GstPad * pad, GstObject * parent, GstBufferList * list)
+{
+  packets_received += gst_buffer_list_length (list);
+  gst_buffer_list_unref (list);
+  return GST_FLOW_OK;
+}
+
+static void
+run_packet_rate (const gchar * name, gboolean pooled, gboolean push_list)
+{
+  State *state;
+  GstRtpDummyPay *pay;
+  gint64 start, elapsed;
+  guint i;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl, NULL);
+  pay = GST_RTP_DUMMY_PAY (state->element);
+  pay->packets_per_buffer = RATE_PACKETS;
+  pay->pooled = pooled;
+  gst_rtp_base_payload_set_push_list (GST_RTP_BASE_PAYLOAD (pay), push_list);
+
+  /* count the packets and free them, so that the pool can reuse them */
+  gst_pad_set_chain_function (state->sinkpad, count_chain_func);
+  gst_pad_set_chain_list_function (state->sinkpad, count_chain_list_func);
+  packets_received = 0;
+
+  set_state (state, GST_STATE_PLAYING);
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < RATE_BUFFERS; i++) {
+    GstBuffer *buf = gst_buffer_new_allocate (NULL, 1200, NULL);
+
+    GST_BUFFER_PTS (buf) = i * GST_MSECOND;
+    fail_unless_equals_int (gst_pad_push (state->srcpad, buf), GST_FLOW_OK);
+  }
+  elapsed = MAX (g_get_monotonic_time () - start, 1);
+
+  set_state (state, GST_STATE_NULL);
+
+  fail_unless_equals_int (packets_received, RATE_BUFFERS * RATE_PACKETS);
+
+  GST_DEBUG ("%s: %u packets in %" G_GINT64_FORMAT " us, %" G_GINT64_FORMAT
+      " packets per second", name, packets_received, elapsed,
+      (gint64) packets_received * G_USEC_PER_SEC / elapsed);
+
+  destroy_payloader (state);
+}
+
+GST_START_TEST (rtp_base_payload_packet_rate_benchmark)
+{
+  run_packet_rate ("allocated, pushed", FALSE, FALSE);
+  run_packet_rate ("pooled, pushed", TRUE, FALSE);
+  run_packet_rate ("pooled, push-list", TRUE, TRUE);
+}
+
+GST_END_TEST;
+
 static Suite *
 rtp_basepayloading_suite (void)
 {
@@ -1893,6 +2165,11 @@ rtp_basepayloading_suite (void)
   tcase_add_test (tc_chain, rtp_base_payload_framerate_attribute);
   tcase_add_test (tc_chain, rtp_base_payload_max_framerate_attribute);
 
+  tcase_add_test (tc_chain, rtp_base_payload_push_list_mode_test);
+  tcase_add_test (tc_chain, rtp_base_payload_push_list_caps_test);
+  tcase_add_test (tc_chain, rtp_base_payload_header_pool_test);
+  tcase_add_test (tc_chain, rtp_base_payload_packet_rate_benchmark);
+
   return s;
 }
 
@@ -36,6 +36,7 @@
 #include <gst/video/video.h>
 #include <gst/video/gstvideometa.h>
 #include <gst/video/video-overlay-composition.h>
+#include <gst/video/gstvideoutilsprivate.h>
 #include <string.h>
 
 /* These are from the current/old videotestsrc; we check our new public API
@@ -2137,6 +2138,152 @@ GST_START_TEST (test_video_scaler)
 
 GST_END_TEST;
 
+static const GstVideoFormat taps_formats[] = {
+  GST_VIDEO_FORMAT_GRAY8, GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_RGB,
+  GST_VIDEO_FORMAT_AYUV, GST_VIDEO_FORMAT_GRAY16_LE, GST_VIDEO_FORMAT_AYUV64
+};
+
+static const guint taps_sizes[] = { 4, 6, 8, 12 };
+
+#define TAPS_SRC_SIZE (48 * 40 * 4)
+#define TAPS_DEST_SIZE (64 * 48 * 4)
+
+/* scales 40x30 pixels from @src to 64x48 in @dest, with the generic ntap
+ * functions when @generic is set */
+static void
+scale_taps (GstVideoFormat format, guint n_taps, gboolean generic,
+    const guint16 * src, guint16 * dest, guint iterations)
+{
+  GstVideoScaler *hscale, *vscale;
+
+  hscale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, n_taps, 40, 64, NULL);
+  vscale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, n_taps, 30, 48, NULL);
+  _gst_video_scaler_set_generic_taps (hscale, generic);
+  _gst_video_scaler_set_generic_taps (vscale, generic);
+
+  while (iterations--)
+    gst_video_scaler_2d (hscale, vscale, format, (gpointer) src,
+        sizeof (guint16) * 48 * 4, dest, sizeof (guint16) * 64 * 4,
+        0, 0, 64, 48);
+
+  gst_video_scaler_free (hscale);
+  gst_video_scaler_free (vscale);
+}
+
+GST_START_TEST (test_video_scaler_taps)
+{
+  gint i, j, k;
+
+  /* a flat input must give the same flat output with all kernels */
+  for (i = 0; i < G_N_ELEMENTS (taps_formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (taps_sizes); j++) {
+      guint16 src[TAPS_SRC_SIZE], dest[TAPS_DEST_SIZE];
+
+      for (k = 0; k < G_N_ELEMENTS (src); k++)
+        src[k] = 0x7070;
+      memset (dest, 0, sizeof (dest));
+
+      scale_taps (taps_formats[i], taps_sizes[j], FALSE, src, dest, 1);
+
+      /* check the first line, it is computed with both scalers */
+      for (k = 0; k < 64; k++)
+        fail_unless_equals_int (dest[k], 0x7070);
+    }
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_video_scaler_taps_generic)
+{
+  GRand *rand;
+  gint i, j, k;
+
+  rand = g_rand_new_with_seed (0x1234);
+
+  /* the fixed tap kernels must give the same result as the generic ntap
+   * functions, also on input that makes the filters ring and clip */
+  for (i = 0; i < G_N_ELEMENTS (taps_formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (taps_sizes); j++) {
+      guint16 src[TAPS_SRC_SIZE], fixed[TAPS_DEST_SIZE];
+      guint16 generic[TAPS_DEST_SIZE];
+
+      for (k = 0; k < G_N_ELEMENTS (src); k++) {
+        /* hard edges every few pixels and noise in between */
+        if ((k / 12) & 1)
+          src[k] = 0xffff - g_rand_int_range (rand, 0, 0x0800);
+        else
+          src[k] = g_rand_int_range (rand, 0, 0x0800);
+      }
+      memset (fixed, 0, sizeof (fixed));
+      memset (generic, 0, sizeof (generic));
+
+      scale_taps (taps_formats[i], taps_sizes[j], FALSE, src, fixed, 1);
+      scale_taps (taps_formats[i], taps_sizes[j], TRUE, src, generic, 1);
+
+      for (k = 0; k < G_N_ELEMENTS (fixed); k++) {
+        fail_unless (fixed[k] == generic[k],
+            "%s %u taps: element %d differs, %u != %u",
+            gst_video_format_to_string (taps_formats[i]), taps_sizes[j], k,
+            fixed[k], generic[k]);
+      }
+    }
+  }
+
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
+#define TIME 0.01
+
+GST_START_TEST (test_video_scaler_taps_speed)
+{
+  GTimer *timer;
+  gint i, j, k;
+  guint16 src[TAPS_SRC_SIZE], dest[TAPS_DEST_SIZE];
+
+  for (k = 0; k < G_N_ELEMENTS (src); k++)
+    src[k] = k * 0x0101;
+
+  timer = g_timer_new ();
+
+  for (i = 0; i < G_N_ELEMENTS (taps_formats); i++) {
+    for (j = 0; j < G_N_ELEMENTS (taps_sizes); j++) {
+      gdouble elapsed[2];
+      gint count[2], g;
+
+      for (g = 0; g < 2; g++) {
+        /* warmup */
+        scale_taps (taps_formats[i], taps_sizes[j], g, src, dest, 1);
+
+        count[g] = 0;
+        g_timer_start (timer);
+        while (TRUE) {
+          scale_taps (taps_formats[i], taps_sizes[j], g, src, dest, 16);
+
+          count[g] += 16;
+          elapsed[g] = g_timer_elapsed (timer, NULL);
+          if (elapsed[g] >= TIME)
+            break;
+        }
+      }
+
+      GST_DEBUG ("%s %u taps: %f scales/sec, generic %f scales/sec",
+          gst_video_format_to_string (taps_formats[i]), taps_sizes[j],
+          count[0] / elapsed[0], count[1] / elapsed[1]);
+    }
+  }
+
+  g_timer_destroy (timer);
+}
+
+GST_END_TEST;
+
+#undef TIME
+
 #define WIDTH 320
 #define HEIGHT 240
 #define TIME 0.01
@@ -2326,6 +2473,708 @@ GST_END_TEST;
 #undef WIDTH
 #undef HEIGHT
 
+#define TIME 0.01
+
+static gdouble
+time_convert (GstVideoConverter * convert, GstVideoFrame * inframe,
+    GstVideoFrame * outframe, GTimer * timer)
+{
+  gdouble elapsed;
+  gint count;
+
+  /* warmup */
+  gst_video_converter_frame (convert, inframe, outframe);
+
+  count = 0;
+  g_timer_start (timer);
+  while (TRUE) {
+    gst_video_converter_frame (convert, inframe, outframe);
+
+    count++;
+    elapsed = g_timer_elapsed (timer, NULL);
+    if (elapsed >= TIME)
+      break;
+  }
+  return count / elapsed;
+}
+
+/* a triangle wave so that neighbouring samples never differ by more than
+ * one step, chroma resampling then only changes values slightly */
+#define RAMP(v) (64 + (((v) & 0xff) < 128 ? ((v) & 0xff) : 255 - ((v) & 0xff)))
+
+static GstBuffer *
+make_ramp_buffer (GstVideoInfo * info)
+{
+  GstVideoInfo ayuvinfo;
+  GstVideoFrame ayuvframe, frame;
+  GstBuffer *ayuvbuffer, *buffer;
+  GstVideoConverter *convert;
+  gint x, y;
+
+  gst_video_info_set_format (&ayuvinfo, GST_VIDEO_FORMAT_AYUV,
+      GST_VIDEO_INFO_WIDTH (info), GST_VIDEO_INFO_HEIGHT (info));
+  ayuvbuffer = gst_buffer_new_and_alloc (ayuvinfo.size);
+  gst_video_frame_map (&ayuvframe, &ayuvinfo, ayuvbuffer, GST_MAP_WRITE);
+  for (y = 0; y < GST_VIDEO_INFO_HEIGHT (info); y++) {
+    guint8 *p = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&ayuvframe, 0) +
+        y * GST_VIDEO_FRAME_PLANE_STRIDE (&ayuvframe, 0);
+
+    for (x = 0; x < GST_VIDEO_INFO_WIDTH (info); x++) {
+      p[4 * x + 0] = 0xff;
+      p[4 * x + 1] = RAMP (x + y);
+      p[4 * x + 2] = RAMP (x + y + 64);
+      p[4 * x + 3] = RAMP (x + 4096 - y);
+    }
+  }
+
+  buffer = gst_buffer_new_and_alloc (info->size);
+  gst_buffer_memset (buffer, 0, 0, -1);
+  gst_video_frame_map (&frame, info, buffer, GST_MAP_WRITE);
+  convert = gst_video_converter_new (&ayuvinfo, info, NULL);
+  gst_video_converter_frame (convert, &ayuvframe, &frame);
+  gst_video_converter_free (convert);
+  gst_video_frame_unmap (&frame);
+
+  gst_video_frame_unmap (&ayuvframe);
+  gst_buffer_unref (ayuvbuffer);
+
+  return buffer;
+}
+
+static void
+check_frames_close (GstVideoFrame * f1, GstVideoFrame * f2, gint tolerance)
+{
+  gint width = GST_VIDEO_FRAME_WIDTH (f1);
+  gint height = GST_VIDEO_FRAME_HEIGHT (f1);
+  guint8 *l1, *l2;
+  gint x, y;
+
+  l1 = g_malloc (width * 4);
+  l2 = g_malloc (width * 4);
+
+  for (y = 0; y < height; y++) {
+    UNPACK_FRAME (f1, l1, y, 0, width);
+    UNPACK_FRAME (f2, l2, y, 0, width);
+
+    for (x = 0; x < width * 4; x++) {
+      fail_unless (ABS (l1[x] - l2[x]) <= tolerance,
+          "%s line %d pixel %d component %d: %d != %d",
+          GST_VIDEO_FRAME_FORMAT_INFO (f1)->name, y, x / 4, x % 4, l1[x],
+          l2[x]);
+    }
+  }
+  g_free (l1);
+  g_free (l2);
+}
+
+static GstVideoConverter *
+convert_fused_new (GstVideoInfo * ininfo, GstVideoInfo * outinfo,
+    gboolean staged, gint crop_x, gint crop_y, gint crop_width)
+{
+  /* fastpaths are only used without extra quantization, use this to
+   * get the staged generic path, without dithering the quantization
+   * does not change the output */
+  return gst_video_converter_new (ininfo, outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
+          GST_TYPE_VIDEO_DITHER_METHOD, GST_VIDEO_DITHER_NONE,
+          GST_VIDEO_CONVERTER_OPT_DITHER_QUANTIZATION, G_TYPE_UINT,
+          staged ? 2 : 1,
+          GST_VIDEO_CONVERTER_OPT_SRC_X, G_TYPE_INT, crop_x,
+          GST_VIDEO_CONVERTER_OPT_SRC_Y, G_TYPE_INT, crop_y,
+          GST_VIDEO_CONVERTER_OPT_SRC_WIDTH, G_TYPE_INT, crop_width,
+          GST_VIDEO_CONVERTER_OPT_SRC_HEIGHT, G_TYPE_INT,
+          GST_VIDEO_INFO_HEIGHT (outinfo), NULL));
+}
+
+static const struct
+{
+  GstVideoFormat infmt, outfmt;
+  gboolean crop;
+  gboolean scale;
+} fused_pairs[] = {
+  {
+  GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_I420, FALSE, FALSE}, {
+  GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_YV12, FALSE, FALSE}, {
+  GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV12, FALSE, FALSE}, {
+  GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_NV12, FALSE, FALSE}, {
+  GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_BGRx, TRUE, FALSE}, {
+  GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_RGBA, TRUE, TRUE}, {
+  GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_RGBx, TRUE, TRUE}, {
+  GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_BGRx, TRUE, TRUE}, {
+  GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_RGBA, TRUE, TRUE}, {
+  GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_NV12, FALSE, FALSE}, {
+  GST_VIDEO_FORMAT_v210, GST_VIDEO_FORMAT_I420, FALSE, FALSE}
+};
+
+GST_START_TEST (test_video_convert_fused)
+{
+  /* odd crop offsets and sizes, the converter aligns the offsets to the
+   * chroma grid, the fused and staged paths must agree on the result. The
+   * last entry downscales the cropped width to the output width, the staged
+   * path also scales before the matrix when making the image smaller */
+  static const gint crops[][5] = { {0, 0, 0, 0, 0}, {3, 1, 7, 3, 0},
+  {2, 3, 9, 5, 0}, {1, 0, 5, 0, 27}
+  };
+  gint i, j;
+
+  /* compare the output of each fused kernel against the staged path */
+  for (i = 0; i < G_N_ELEMENTS (fused_pairs); i++) {
+    for (j = 0; j < G_N_ELEMENTS (crops); j++) {
+      GstVideoInfo ininfo, outinfo;
+      GstVideoFrame inframe, outframe, refframe;
+      GstBuffer *inbuffer, *outbuffer, *refbuffer;
+      GstVideoConverter *convert;
+      gint crop_x = crops[j][0], crop_y = crops[j][1];
+
+      if (j > 0 && !fused_pairs[i].crop)
+        continue;
+      if (crops[j][4] > 0 && !fused_pairs[i].scale)
+        continue;
+
+      gst_video_info_set_format (&ininfo, fused_pairs[i].infmt, 96, 48);
+      inbuffer = make_ramp_buffer (&ininfo);
+      gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+
+      gst_video_info_set_format (&outinfo, fused_pairs[i].outfmt,
+          96 - crops[j][2] - crops[j][4], 48 - crops[j][3]);
+      outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+      gst_buffer_memset (outbuffer, 0, 0, -1);
+      gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_WRITE);
+      refbuffer = gst_buffer_new_and_alloc (outinfo.size);
+      gst_buffer_memset (refbuffer, 0, 0, -1);
+      gst_video_frame_map (&refframe, &outinfo, refbuffer, GST_MAP_WRITE);
+
+      convert = convert_fused_new (&ininfo, &outinfo, FALSE, crop_x, crop_y,
+          96 - crops[j][2]);
+      fail_unless (convert != NULL);
+      gst_video_converter_frame (convert, &inframe, &outframe);
+      gst_video_converter_free (convert);
+
+      convert = convert_fused_new (&ininfo, &outinfo, TRUE, crop_x, crop_y,
+          96 - crops[j][2]);
+      fail_unless (convert != NULL);
+      gst_video_converter_frame (convert, &inframe, &refframe);
+      gst_video_converter_free (convert);
+
+      GST_DEBUG ("compare %s->%s crop %d,%d width %d",
+          gst_video_format_to_string (fused_pairs[i].infmt),
+          gst_video_format_to_string (fused_pairs[i].outfmt), crop_x,
+          crop_y, GST_VIDEO_INFO_WIDTH (&outinfo));
+      /* the staged path interpolates the chroma where the fused kernels
+       * take the nearest sample, the ramp keeps that difference small */
+      check_frames_close (&outframe, &refframe, 6);
+
+      gst_video_frame_unmap (&refframe);
+      gst_buffer_unref (refbuffer);
+      gst_video_frame_unmap (&outframe);
+      gst_buffer_unref (outbuffer);
+      gst_video_frame_unmap (&inframe);
+      gst_buffer_unref (inbuffer);
+    }
+  }
+}
+
+GST_END_TEST;
+
+/* converts up to 4K frames for a while, only run when GST_VIDEO_TEST_SPEED is
+ * set in the environment */
+GST_START_TEST (test_video_convert_fused_speed)
+{
+  static const gint sizes[][2] = { {1280, 720}, {1920, 1080}, {3840, 2160} };
+  GTimer *timer;
+  gint i, j;
+
+  timer = g_timer_new ();
+
+  for (i = 0; i < G_N_ELEMENTS (fused_pairs); i++) {
+    for (j = 0; j < G_N_ELEMENTS (sizes); j++) {
+      GstVideoInfo ininfo, outinfo;
+      GstVideoFrame inframe, outframe;
+      GstBuffer *inbuffer, *outbuffer;
+      GstVideoConverter *convert;
+      gdouble fused, staged;
+
+      gst_video_info_set_format (&ininfo, fused_pairs[i].infmt, sizes[j][0],
+          sizes[j][1]);
+      inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+      gst_buffer_memset (inbuffer, 0, 0, -1);
+      gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+
+      gst_video_info_set_format (&outinfo, fused_pairs[i].outfmt, sizes[j][0],
+          sizes[j][1]);
+      outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+      gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_WRITE);
+
+      convert = convert_fused_new (&ininfo, &outinfo, FALSE, 0, 0,
+          sizes[j][0]);
+      fail_unless (convert != NULL);
+      fused = time_convert (convert, &inframe, &outframe, timer);
+      gst_video_converter_free (convert);
+
+      convert = convert_fused_new (&ininfo, &outinfo, TRUE, 0, 0,
+          sizes[j][0]);
+      fail_unless (convert != NULL);
+      staged = time_convert (convert, &inframe, &outframe, timer);
+      gst_video_converter_free (convert);
+
+      GST_DEBUG ("%s->%s %dx%d: fused %f conversions/sec, staged %f",
+          gst_video_format_to_string (fused_pairs[i].infmt),
+          gst_video_format_to_string (fused_pairs[i].outfmt), sizes[j][0],
+          sizes[j][1], fused, staged);
+
+      gst_video_frame_unmap (&outframe);
+      gst_buffer_unref (outbuffer);
+      gst_video_frame_unmap (&inframe);
+      gst_buffer_unref (inbuffer);
+    }
+  }
+
+  g_timer_destroy (timer);
+}
+
+GST_END_TEST;
+
+static void
+convert_frame_threads (GstVideoInfo * ininfo, GstVideoInfo * outinfo,
+    GstVideoDitherMethod dither, guint n_threads,
+    GstVideoFrame * inframe, GstVideoFrame * outframe)
+{
+  GstVideoConverter *convert;
+
+  convert = gst_video_converter_new (ininfo, outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+          GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
+          GST_TYPE_VIDEO_DITHER_METHOD, dither,
+          GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, n_threads, NULL));
+  fail_unless (convert != NULL);
+  gst_video_converter_frame (convert, inframe, outframe);
+  gst_video_converter_free (convert);
+}
+
+GST_START_TEST (test_video_convert_threads)
+{
+  static const struct
+  {
+    GstVideoFormat infmt, outfmt;
+    gint inwidth, inheight, outwidth, outheight;
+    GstVideoDitherMethod dither;
+  } convs[] = {
+    /* generic path with chroma resampling and a downscale that holds
+     * more than 8 lines in the caches */
+    {
+    GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_RGBA, 320, 480, 200, 100,
+          GST_VIDEO_DITHER_NONE}, {
+    GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_I420, 320, 240, 400, 300,
+          GST_VIDEO_DITHER_NONE}, {
+    GST_VIDEO_FORMAT_AYUV, GST_VIDEO_FORMAT_RGB16, 320, 240, 320, 240,
+          GST_VIDEO_DITHER_BAYER}, {
+    /* fastpath on a shifted frame */
+    GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_YUY2, 320, 240, 320, 240,
+          GST_VIDEO_DITHER_NONE}, {
+    /* plane scaling */
+    GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_I420, 320, 240, 200, 500,
+          GST_VIDEO_DITHER_NONE}
+  };
+  static const guint threads[] = { 2, 3, 4, 7 };
+  gint i, j;
+
+  for (i = 0; i < G_N_ELEMENTS (convs); i++) {
+    GstVideoInfo ininfo, outinfo;
+    GstVideoFrame inframe, refframe;
+    GstBuffer *inbuffer, *refbuffer;
+    GstMapInfo refmap;
+
+    gst_video_info_set_format (&ininfo, convs[i].infmt, convs[i].inwidth,
+        convs[i].inheight);
+    inbuffer = make_ramp_buffer (&ininfo);
+    gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+
+    gst_video_info_set_format (&outinfo, convs[i].outfmt, convs[i].outwidth,
+        convs[i].outheight);
+
+    /* the single threaded reference */
+    refbuffer = gst_buffer_new_and_alloc (outinfo.size);
+    gst_buffer_memset (refbuffer, 0, 0, -1);
+    gst_video_frame_map (&refframe, &outinfo, refbuffer, GST_MAP_WRITE);
+    convert_frame_threads (&ininfo, &outinfo, convs[i].dither, 1,
+        &inframe, &refframe);
+    gst_video_frame_unmap (&refframe);
+    gst_buffer_map (refbuffer, &refmap, GST_MAP_READ);
+
+    for (j = 0; j < G_N_ELEMENTS (threads); j++) {
+      GstVideoFrame outframe;
+      GstBuffer *outbuffer;
+      GstMapInfo outmap;
+
+      outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+      gst_buffer_memset (outbuffer, 0, 0, -1);
+      gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_WRITE);
+      convert_frame_threads (&ininfo, &outinfo, convs[i].dither,
+          threads[j], &inframe, &outframe);
+      gst_video_frame_unmap (&outframe);
+
+      GST_DEBUG ("compare %s->%s with %u threads",
+          gst_video_format_to_string (convs[i].infmt),
+          gst_video_format_to_string (convs[i].outfmt), threads[j]);
+
+      gst_buffer_map (outbuffer, &outmap, GST_MAP_READ);
+      fail_unless_equals_int (outmap.size, refmap.size);
+      fail_unless (memcmp (outmap.data, refmap.data, refmap.size) == 0,
+          "%s->%s with %u threads differs from 1 thread",
+          gst_video_format_to_string (convs[i].infmt),
+          gst_video_format_to_string (convs[i].outfmt), threads[j]);
+      gst_buffer_unmap (outbuffer, &outmap);
+      gst_buffer_unref (outbuffer);
+    }
+
+    gst_buffer_unmap (refbuffer, &refmap);
+    gst_buffer_unref (refbuffer);
+    gst_video_frame_unmap (&inframe);
+    gst_buffer_unref (inbuffer);
+  }
+}
+
+GST_END_TEST;
+#undef RAMP
+
+GST_START_TEST (test_video_convert_tiled)
+{
+  static const GstVideoFormat outfmts[] = {
+    GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_BGRx,
+    GST_VIDEO_FORMAT_RGBA
+  };
+  static const gint sizes[][2] = { {320, 200}, {1920, 1080}, {3840, 2160} };
+  GTimer *timer;
+  gint i, j, x, y;
+
+  timer = g_timer_new ();
+
+  for (j = 0; j < G_N_ELEMENTS (sizes); j++) {
+    GstVideoInfo ininfo, nv12info;
+    GstVideoFrame inframe, nv12frame;
+    GstBuffer *inbuffer, *nv12buffer;
+    GstVideoConverter *convert;
+    GstMapInfo map;
+    guint8 *ayuv;
+    gint width = sizes[j][0], height = sizes[j][1];
+
+    gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_NV12_64Z32, width,
+        height);
+    inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+    gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+    for (x = 0; x < map.size; x++)
+      map.data[x] = (x * 7 + (x >> 11)) & 0xff;
+    gst_buffer_unmap (inbuffer, &map);
+    gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+
+    /* check the detiled planes against the generic unpack function */
+    gst_video_info_set_format (&nv12info, GST_VIDEO_FORMAT_NV12, width,
+        height);
+    nv12buffer = gst_buffer_new_and_alloc (nv12info.size);
+    gst_video_frame_map (&nv12frame, &nv12info, nv12buffer, GST_MAP_WRITE);
+
+    convert = gst_video_converter_new (&ininfo, &nv12info, NULL);
+    fail_unless (convert != NULL);
+    gst_video_converter_frame (convert, &inframe, &nv12frame);
+    gst_video_converter_free (convert);
+
+    ayuv = g_malloc (width * 4);
+    for (y = 0; y < height; y++) {
+      const guint8 *sy, *suv;
+
+      ininfo.finfo->unpack_func (ininfo.finfo, 0, ayuv, inframe.data,
+          inframe.info.stride, 0, y, width);
+
+      sy = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&nv12frame, 0) +
+          y * GST_VIDEO_FRAME_PLANE_STRIDE (&nv12frame, 0);
+      suv = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&nv12frame, 1) +
+          (y >> 1) * GST_VIDEO_FRAME_PLANE_STRIDE (&nv12frame, 1);
+      for (x = 0; x < width; x++) {
+        fail_unless_equals_int (sy[x], ayuv[4 * x + 1]);
+        fail_unless_equals_int (suv[x & ~1], ayuv[4 * x + 2]);
+        fail_unless_equals_int (suv[x | 1], ayuv[4 * x + 3]);
+      }
+    }
+    g_free (ayuv);
+
+    for (i = 0; i < G_N_ELEMENTS (outfmts); i++) {
+      GstVideoInfo outinfo;
+      GstVideoFrame outframe, refframe;
+      GstBuffer *outbuffer, *refbuffer;
+      gdouble direct, twopass;
+
+      gst_video_info_set_format (&outinfo, outfmts[i], width, height);
+      outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+      gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_WRITE);
+      refbuffer = gst_buffer_new_and_alloc (outinfo.size);
+      gst_video_frame_map (&refframe, &outinfo, refbuffer, GST_MAP_WRITE);
+
+      /* tiled -> linear in one pass */
+      convert = gst_video_converter_new (&ininfo, &outinfo, NULL);
+      fail_unless (convert != NULL);
+      direct = time_convert (convert, &inframe, &outframe, timer);
+      gst_video_converter_free (convert);
+
+      /* must give the same result as going through linear NV12 */
+      convert = gst_video_converter_new (&nv12info, &outinfo, NULL);
+      fail_unless (convert != NULL);
+      gst_video_converter_frame (convert, &nv12frame, &refframe);
+      gst_video_converter_free (convert);
+
+      for (x = 0; x < GST_VIDEO_FRAME_N_PLANES (&outframe); x++) {
+        gint h = GST_VIDEO_FRAME_COMP_HEIGHT (&outframe, x);
+        gint w = GST_VIDEO_FRAME_COMP_WIDTH (&outframe, x) *
+            GST_VIDEO_FRAME_COMP_PSTRIDE (&outframe, x);
+
+        for (y = 0; y < h; y++) {
+          fail_unless (memcmp ((guint8 *) GST_VIDEO_FRAME_PLANE_DATA
+                  (&outframe, x) + y * GST_VIDEO_FRAME_PLANE_STRIDE (&outframe,
+                      x), (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&refframe,
+                      x) + y * GST_VIDEO_FRAME_PLANE_STRIDE (&refframe, x),
+                  w) == 0);
+        }
+      }
+
+      /* the staged generic path detiles through the unpack function */
+      convert = gst_video_converter_new (&ininfo, &outinfo,
+          gst_structure_new ("options",
+              GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
+              GST_TYPE_VIDEO_DITHER_METHOD, GST_VIDEO_DITHER_NONE,
+              GST_VIDEO_CONVERTER_OPT_DITHER_QUANTIZATION, G_TYPE_UINT, 2,
+              NULL));
+      fail_unless (convert != NULL);
+      twopass = time_convert (convert, &inframe, &refframe, timer);
+      gst_video_converter_free (convert);
+
+      GST_DEBUG ("NV12_64Z32->%s %dx%d: direct %f conversions/sec (%f MB/s), "
+          "staged %f", gst_video_format_to_string (outfmts[i]), width, height,
+          direct, direct * ininfo.size / (1024.0 * 1024.0), twopass);
+
+      gst_video_frame_unmap (&refframe);
+      gst_buffer_unref (refbuffer);
+      gst_video_frame_unmap (&outframe);
+      gst_buffer_unref (outbuffer);
+    }
+
+    gst_video_frame_unmap (&nv12frame);
+    gst_buffer_unref (nv12buffer);
+    gst_video_frame_unmap (&inframe);
+    gst_buffer_unref (inbuffer);
+  }
+
+  g_timer_destroy (timer);
+}
+
+GST_END_TEST;
+
+static void
+fill_10bit_frame (GstVideoFrame * frame, gint flat)
+{
+  gint i, j, c;
+
+  for (c = 0; c < 3; c++) {
+    for (i = 0; i < GST_VIDEO_FRAME_COMP_HEIGHT (frame, c); i++) {
+      guint16 *d = (guint16 *) ((guint8 *) GST_VIDEO_FRAME_COMP_DATA (frame,
+              c) + i * GST_VIDEO_FRAME_COMP_STRIDE (frame, c));
+
+      for (j = 0; j < GST_VIDEO_FRAME_COMP_WIDTH (frame, c); j++) {
+        guint v = flat >= 0 ? flat : (j * (c + 3) + i * (7 - c) + c) & 0x3ff;
+
+        GST_WRITE_UINT16_LE (d + j, v);
+      }
+    }
+  }
+}
+
+static GstVideoConverter *
+convert_10bit_new (GstVideoInfo * ininfo, GstVideoInfo * outinfo,
+    GstVideoDitherMethod method)
+{
+  return gst_video_converter_new (ininfo, outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
+          GST_TYPE_VIDEO_DITHER_METHOD, method, NULL));
+}
+
+static void
+check_10bit_frames_equal (GstVideoFrame * f1, GstVideoFrame * f2)
+{
+  gint i, c;
+
+  for (c = 0; c < 3; c++) {
+    for (i = 0; i < GST_VIDEO_FRAME_COMP_HEIGHT (f1, c); i++) {
+      fail_unless (memcmp ((guint8 *) GST_VIDEO_FRAME_COMP_DATA (f1, c) +
+              i * GST_VIDEO_FRAME_COMP_STRIDE (f1, c),
+              (guint8 *) GST_VIDEO_FRAME_COMP_DATA (f2, c) +
+              i * GST_VIDEO_FRAME_COMP_STRIDE (f2, c),
+              GST_VIDEO_FRAME_COMP_WIDTH (f1, c) * 2) == 0);
+    }
+  }
+}
+
+GST_START_TEST (test_video_convert_10bit)
+{
+  static const GstVideoFormat repack[] = {
+    GST_VIDEO_FORMAT_P010_10LE, GST_VIDEO_FORMAT_v210
+  };
+  GstVideoInfo ininfo, outinfo, backinfo;
+  GstVideoFrame inframe, outframe, backframe;
+  GstBuffer *inbuffer, *outbuffer, *backbuffer;
+  GstVideoConverter *convert;
+  guint16 *ayuv;
+  gint width = 322, height = 242;
+  gint i, j, k, c;
+
+  gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_I420_10LE, width,
+      height);
+  inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READWRITE);
+  fill_10bit_frame (&inframe, -1);
+
+  backbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  gst_video_frame_map (&backframe, &ininfo, backbuffer, GST_MAP_READWRITE);
+  backinfo = ininfo;
+
+  ayuv = g_new (guint16, width * 4);
+
+  /* repacking is lossless and must match the generic unpack functions */
+  for (k = 0; k < G_N_ELEMENTS (repack); k++) {
+    gst_video_info_set_format (&outinfo, repack[k], width, height);
+    outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+    gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_READWRITE);
+
+    convert = gst_video_converter_new (&ininfo, &outinfo, NULL);
+    fail_unless (convert != NULL);
+    gst_video_converter_frame (convert, &inframe, &outframe);
+    gst_video_converter_free (convert);
+
+    for (i = 0; i < height; i++) {
+      outinfo.finfo->unpack_func (outinfo.finfo,
+          GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE, ayuv, outframe.data,
+          outframe.info.stride, 0, i, width);
+
+      for (j = 0; j < width; j++) {
+        for (c = 0; c < 3; c++) {
+          const guint16 *s;
+          gint x = j, y = i;
+
+          /* v210 repeats the chroma on both lines */
+          if (c > 0) {
+            x >>= 1;
+            y >>= 1;
+          }
+          s = (guint16 *) ((guint8 *) GST_VIDEO_FRAME_COMP_DATA (&inframe,
+                  c) + y * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, c));
+          fail_unless_equals_int (ayuv[4 * j + 1 + c],
+              GST_READ_UINT16_LE (s + x) << 6);
+        }
+      }
+    }
+
+    convert = gst_video_converter_new (&outinfo, &backinfo, NULL);
+    fail_unless (convert != NULL);
+    gst_video_converter_frame (convert, &outframe, &backframe);
+    gst_video_converter_free (convert);
+    check_10bit_frames_equal (&inframe, &backframe);
+
+    gst_video_frame_unmap (&outframe);
+    gst_buffer_unref (outbuffer);
+  }
+  g_free (ayuv);
+
+  /* without dithering the two lowest bits are dropped */
+  gst_video_info_set_format (&outinfo, GST_VIDEO_FORMAT_I420, width, height);
+  outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+  gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_READWRITE);
+
+  convert = convert_10bit_new (&ininfo, &outinfo, GST_VIDEO_DITHER_NONE);
+  gst_video_converter_frame (convert, &inframe, &outframe);
+  gst_video_converter_free (convert);
+
+  for (c = 0; c < 3; c++) {
+    for (i = 0; i < GST_VIDEO_FRAME_COMP_HEIGHT (&inframe, c); i++) {
+      const guint16 *s = (guint16 *) ((guint8 *)
+          GST_VIDEO_FRAME_COMP_DATA (&inframe, c) +
+          i * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, c));
+      const guint8 *d = (guint8 *) GST_VIDEO_FRAME_COMP_DATA (&outframe, c) +
+          i * GST_VIDEO_FRAME_COMP_STRIDE (&outframe, c);
+
+      for (j = 0; j < GST_VIDEO_FRAME_COMP_WIDTH (&inframe, c); j++)
+        fail_unless_equals_int (d[j], GST_READ_UINT16_LE (s + j) >> 2);
+    }
+  }
+
+  /* with ordered dithering a flat area keeps its average, 513 is 128.25 in
+   * 8 bits, from I420_10LE directly and from P010 */
+  fill_10bit_frame (&inframe, 513);
+  for (k = 0; k < 2; k++) {
+    GstVideoFrame *src = &inframe;
+    GstVideoInfo nv12info, p010info;
+    GstVideoFrame nv12frame, p010frame;
+    GstBuffer *nv12buffer = NULL, *p010buffer = NULL;
+    gdouble sum = 0.0;
+    const guint8 *d;
+    gint stride;
+
+    if (k == 0) {
+      convert = convert_10bit_new (&ininfo, &outinfo, GST_VIDEO_DITHER_BAYER);
+      gst_video_converter_frame (convert, &inframe, &outframe);
+      gst_video_converter_free (convert);
+      d = GST_VIDEO_FRAME_PLANE_DATA (&outframe, 0);
+      stride = GST_VIDEO_FRAME_PLANE_STRIDE (&outframe, 0);
+    } else {
+      gst_video_info_set_format (&p010info, GST_VIDEO_FORMAT_P010_10LE, width,
+          height);
+      p010buffer = gst_buffer_new_and_alloc (p010info.size);
+      gst_video_frame_map (&p010frame, &p010info, p010buffer,
+          GST_MAP_READWRITE);
+      convert = gst_video_converter_new (&ininfo, &p010info, NULL);
+      gst_video_converter_frame (convert, src, &p010frame);
+      gst_video_converter_free (convert);
+
+      gst_video_info_set_format (&nv12info, GST_VIDEO_FORMAT_NV12, width,
+          height);
+      nv12buffer = gst_buffer_new_and_alloc (nv12info.size);
+      gst_video_frame_map (&nv12frame, &nv12info, nv12buffer,
+          GST_MAP_READWRITE);
+      convert = convert_10bit_new (&p010info, &nv12info,
+          GST_VIDEO_DITHER_BAYER);
+      gst_video_converter_frame (convert, &p010frame, &nv12frame);
+      gst_video_converter_free (convert);
+      d = GST_VIDEO_FRAME_PLANE_DATA (&nv12frame, 0);
+      stride = GST_VIDEO_FRAME_PLANE_STRIDE (&nv12frame, 0);
+    }
+
+    for (i = 0; i < height; i++) {
+      for (j = 0; j < width; j++) {
+        fail_unless (d[i * stride + j] == 128 || d[i * stride + j] == 129);
+        sum += d[i * stride + j];
+      }
+    }
+    GST_DEBUG ("average %f", sum / (width * height));
+    fail_unless (ABS (sum / (width * height) - 128.25) < 0.01);
+
+    if (k == 1) {
+      gst_video_frame_unmap (&nv12frame);
+      gst_buffer_unref (nv12buffer);
+      gst_video_frame_unmap (&p010frame);
+      gst_buffer_unref (p010buffer);
+    }
+  }
+
+  gst_video_frame_unmap (&outframe);
+  gst_buffer_unref (outbuffer);
+  gst_video_frame_unmap (&backframe);
+  gst_buffer_unref (backbuffer);
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_convert)
 {
   GstVideoInfo ininfo, outinfo;
@@ -2387,6 +3236,255 @@ GST_START_TEST (test_video_convert)
 
 GST_END_TEST;
 
+GST_START_TEST (test_video_convert_cache)
+{
+  GstVideoInfo ininfo, outinfo, otherinfo;
+  GstVideoConverter *convert, *reused;
+  guint hits, misses, hits2, misses2;
+
+  gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_I420, 320, 240);
+  gst_video_info_set_format (&outinfo, GST_VIDEO_FORMAT_BGRx, 640, 480);
+  gst_video_info_set_format (&otherinfo, GST_VIDEO_FORMAT_BGRx, 320, 240);
+
+  gst_video_converter_get_cache_stats (&hits, &misses);
+
+  convert = gst_video_converter_new (&ininfo, &outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, 3, NULL));
+  fail_unless (convert != NULL);
+  gst_video_converter_free (convert);
+
+  /* same info and config, reuses the converter */
+  reused = gst_video_converter_new (&ininfo, &outinfo,
+      gst_structure_new ("other-options",
+          GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, 3, NULL));
+  fail_unless (reused == convert);
+  gst_video_converter_get_cache_stats (&hits2, &misses2);
+  fail_unless_equals_int (hits2, hits + 1);
+  fail_unless_equals_int (misses2, misses + 1);
+
+  /* a converter in use is not shared */
+  convert = gst_video_converter_new (&ininfo, &outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, 3, NULL));
+  fail_unless (convert != reused);
+  gst_video_converter_free (convert);
+  gst_video_converter_free (reused);
+
+  /* different config */
+  convert = gst_video_converter_new (&ininfo, &outinfo, NULL);
+  fail_unless (convert != reused);
+  gst_video_converter_free (convert);
+
+  /* different info */
+  convert = gst_video_converter_new (&ininfo, &otherinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+          GST_TYPE_VIDEO_RESAMPLER_METHOD, 3, NULL));
+  fail_unless (convert != reused);
+  gst_video_converter_free (convert);
+
+  gst_video_converter_get_cache_stats (&hits2, &misses2);
+  fail_unless_equals_int (hits2, hits + 1);
+  fail_unless_equals_int (misses2, misses + 4);
+
+  /* the bands of a threaded converter don't go through the cache */
+  convert = gst_video_converter_new (&ininfo, &outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT, 4, NULL));
+  fail_unless (convert != NULL);
+  gst_video_converter_free (convert);
+
+  gst_video_converter_get_cache_stats (&hits2, &misses2);
+  fail_unless_equals_int (hits2, hits + 1);
+  fail_unless_equals_int (misses2, misses + 5);
+}
+
+GST_END_TEST;
+
+static void
+get_table_stats (gboolean dither, guint * n_tables, guint * n_users)
+{
+  if (dither)
+    gst_video_dither_get_table_stats (n_tables, n_users);
+  else
+    gst_video_converter_get_table_stats (n_tables, n_users);
+}
+
+/* @dither selects whether the bayer dither patterns or the 8 bit matrix
+ * tables of the conversion are checked */
+static void
+convert_shared_tables (GstVideoFormat in_format, GstVideoFormat out_format,
+    gboolean dither)
+{
+  GstVideoInfo ininfo, outinfo;
+  GstVideoConverter *convert1, *convert2;
+  GstBuffer *inbuffer, *outbuffer1, *outbuffer2;
+  GstVideoFrame inframe, outframe;
+  GstMapInfo map1, map2;
+  guint tables0, tables1, tables2, users0, users1, users2;
+  guint misses0, misses1;
+  guint8 *data;
+  gsize i, size;
+
+  /* a size no other test uses, so no converter comes from the cache */
+  gst_video_info_set_format (&ininfo, in_format, 328, 248);
+  gst_video_info_set_format (&outinfo, out_format, 328, 248);
+
+  inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  gst_buffer_map (inbuffer, &map1, GST_MAP_WRITE);
+  data = map1.data;
+  size = map1.size;
+  for (i = 0; i < size; i++)
+    data[i] = (i * 7 + (i >> 9)) & 0xff;
+  gst_buffer_unmap (inbuffer, &map1);
+
+  outbuffer1 = gst_buffer_new_and_alloc (outinfo.size);
+  outbuffer2 = gst_buffer_new_and_alloc (outinfo.size);
+
+  gst_video_converter_get_cache_stats (NULL, &misses0);
+  get_table_stats (dither, &tables0, &users0);
+
+  convert1 = gst_video_converter_new (&ininfo, &outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_DITHER_METHOD, GST_TYPE_VIDEO_DITHER_METHOD,
+          GST_VIDEO_DITHER_BAYER, NULL));
+  get_table_stats (dither, &tables1, &users1);
+
+  convert2 = gst_video_converter_new (&ininfo, &outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_DITHER_METHOD, GST_TYPE_VIDEO_DITHER_METHOD,
+          GST_VIDEO_DITHER_BAYER, NULL));
+  get_table_stats (dither, &tables2, &users2);
+
+  gst_video_converter_get_cache_stats (NULL, &misses1);
+  fail_unless_equals_int (misses1 - misses0, 2);
+  fail_unless (convert1 != convert2);
+
+  /* the first converter uses the tables, the second one uses the same
+   * tables without making new ones */
+  fail_unless (users1 > users0);
+  fail_unless_equals_int (users2 - users1, users1 - users0);
+  fail_unless_equals_int (tables2, tables1);
+
+  gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+  gst_video_frame_map (&outframe, &outinfo, outbuffer1, GST_MAP_WRITE);
+  gst_video_converter_frame (convert1, &inframe, &outframe);
+  gst_video_frame_unmap (&outframe);
+  gst_video_frame_map (&outframe, &outinfo, outbuffer2, GST_MAP_WRITE);
+  gst_video_converter_frame (convert2, &inframe, &outframe);
+  gst_video_frame_unmap (&outframe);
+  gst_video_frame_unmap (&inframe);
+
+  gst_video_converter_free (convert1);
+  gst_video_converter_free (convert2);
+
+  gst_buffer_map (outbuffer1, &map1, GST_MAP_READ);
+  gst_buffer_map (outbuffer2, &map2, GST_MAP_READ);
+  fail_unless_equals_int (map1.size, map2.size);
+  fail_unless (memcmp (map1.data, map2.data, map1.size) == 0);
+  gst_buffer_unmap (outbuffer1, &map1);
+  gst_buffer_unmap (outbuffer2, &map2);
+
+  gst_buffer_unref (inbuffer);
+  gst_buffer_unref (outbuffer1);
+  gst_buffer_unref (outbuffer2);
+}
+
+GST_START_TEST (test_video_convert_shared_tables)
+{
+  /* 8 bit matrix lookup tables */
+  convert_shared_tables (GST_VIDEO_FORMAT_ARGB, GST_VIDEO_FORMAT_I420, FALSE);
+  convert_shared_tables (GST_VIDEO_FORMAT_BGRx, GST_VIDEO_FORMAT_NV12, FALSE);
+  /* bayer dither pattern */
+  convert_shared_tables (GST_VIDEO_FORMAT_ARGB64, GST_VIDEO_FORMAT_I420,
+      TRUE);
+  convert_shared_tables (GST_VIDEO_FORMAT_AYUV64, GST_VIDEO_FORMAT_RGB16,
+      TRUE);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_video_convert_stats)
+{
+  GstVideoInfo ininfo, outinfo;
+  GstVideoConverter *convert;
+  GstBuffer *inbuffer, *outbuffer;
+  GstVideoFrame inframe, outframe;
+  GstStructure *stats;
+  guint64 frames, time, stage, sum;
+  gboolean fastpath;
+  const gchar *stages[] = { "unpack", "upsample", "to-rgb", "hscale",
+    "vscale", "convert", "alpha", "to-yuv", "downsample", "dither", "pack"
+  };
+  gint i;
+
+  gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_I420, 320, 240);
+  gst_video_info_set_format (&outinfo, GST_VIDEO_FORMAT_RGBx, 400, 300);
+
+  inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  gst_buffer_memset (inbuffer, 0, 0x80, -1);
+  outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+  gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+  gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_WRITE);
+
+  /* disabled by default */
+  convert = gst_video_converter_new (&ininfo, &outinfo, NULL);
+  gst_video_converter_frame (convert, &inframe, &outframe);
+  fail_unless (gst_video_converter_get_stats (convert) == NULL);
+  gst_video_converter_free (convert);
+
+  convert = gst_video_converter_new (&ininfo, &outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_STATS, G_TYPE_BOOLEAN, TRUE, NULL));
+  for (i = 0; i < 3; i++)
+    gst_video_converter_frame (convert, &inframe, &outframe);
+
+  stats = gst_video_converter_get_stats (convert);
+  fail_unless (stats != NULL);
+  GST_DEBUG ("stats %" GST_PTR_FORMAT, stats);
+  fail_unless (gst_structure_get_uint64 (stats, "frames", &frames));
+  fail_unless_equals_int (frames, 3);
+  fail_unless (gst_structure_get_uint64 (stats, "time", &time));
+  fail_unless (gst_structure_get_boolean (stats, "fastpath", &fastpath));
+  fail_unless (!fastpath);
+
+  /* every stage only counts its own time, together they make up the total */
+  sum = 0;
+  for (i = 0; i < G_N_ELEMENTS (stages); i++) {
+    fail_unless (gst_structure_get_uint64 (stats, stages[i], &stage));
+    sum += stage;
+  }
+  fail_unless_equals_uint64 (sum, time);
+  gst_structure_free (stats);
+  gst_video_converter_free (convert);
+
+  /* fastpath conversions only have the total time */
+  gst_video_info_set_format (&outinfo, GST_VIDEO_FORMAT_YV12, 320, 240);
+  convert = gst_video_converter_new (&ininfo, &outinfo,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_STATS, G_TYPE_BOOLEAN, TRUE, NULL));
+  stats = gst_video_converter_get_stats (convert);
+  fail_unless (stats != NULL);
+  fail_unless (gst_structure_get_uint64 (stats, "frames", &frames));
+  fail_unless_equals_int (frames, 0);
+  fail_unless (gst_structure_get_boolean (stats, "fastpath", &fastpath));
+  fail_unless (fastpath);
+  fail_unless (!gst_structure_has_field (stats, "unpack"));
+  gst_structure_free (stats);
+  gst_video_converter_free (convert);
+
+  gst_video_frame_unmap (&outframe);
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+  gst_buffer_unref (outbuffer);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_transfer)
 {
   gint i, j;
@@ -2716,9 +3814,21 @@ video_suite (void)
   tcase_add_test (tc_chain, test_video_pack_unpack2);
   tcase_add_test (tc_chain, test_video_chroma);
   tcase_add_test (tc_chain, test_video_scaler);
+  tcase_add_test (tc_chain, test_video_scaler_taps);
+  tcase_add_test (tc_chain, test_video_scaler_taps_generic);
+  tcase_add_test (tc_chain, test_video_scaler_taps_speed);
   tcase_add_test (tc_chain, test_video_color_convert);
   tcase_add_test (tc_chain, test_video_size_convert);
   tcase_add_test (tc_chain, test_video_convert);
+  tcase_add_test (tc_chain, test_video_convert_fused);
+  if (g_getenv ("GST_VIDEO_TEST_SPEED"))
+    tcase_add_test (tc_chain, test_video_convert_fused_speed);
+  tcase_add_test (tc_chain, test_video_convert_threads);
+  tcase_add_test (tc_chain, test_video_convert_tiled);
+  tcase_add_test (tc_chain, test_video_convert_10bit);
+  tcase_add_test (tc_chain, test_video_convert_cache);
+  tcase_add_test (tc_chain, test_video_convert_shared_tables);
+  tcase_add_test (tc_chain, test_video_convert_stats);
   tcase_add_test (tc_chain, test_video_transfer);
   tcase_add_test (tc_chain, test_overlay_blend);
   tcase_add_test (tc_chain, test_video_center_rect);